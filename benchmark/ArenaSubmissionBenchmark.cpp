@@ -0,0 +1,378 @@
+#include "Model/BufferHeap.hpp"
+#include "Model/GeometryArena.hpp"
+#include "Model/Mesh.hpp"
+#include "Model/ObjLoader.hpp"
+#include "Model/UniformBlocks.hpp"
+#include "OpenGL/OpenGLDrawIndirect.hpp"
+#include "OpenGL/OpenGLShaderProgram.hpp"
+#include "OpenGL/OpenGLStateCache.hpp"
+#include "OpenGL/OpenGLStreamBuffer.hpp"
+#include "OpenGL/OpenGLTexture.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glad/glad.h"
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/mat4x4.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace Detail
+{
+
+constexpr GLsizei frameWidth{640};
+constexpr GLsizei frameHeight{480};
+constexpr std::size_t warmUpFrames{5};
+// Sub-meshes every model is cut into, alternating between the materials.
+constexpr std::size_t partCount{4};
+
+struct FrameTimes
+{
+    std::size_t drawCalls;
+    // Filling and uploading the Object blocks and submitting the draws.
+    double cpuMilliseconds;
+    // The same up to glFinish(), when the rasterizer is done.
+    double frameMilliseconds;
+};
+
+bool createContext();
+std::unique_ptr<OpenGL::OpenGLTexture> makeChecker(unsigned char red,
+                                                   unsigned char green,
+                                                   unsigned char blue);
+void splitParts(Model::MeshData &meshData);
+
+// A surfaceless EGL display needs no window system, so with
+// LIBGL_ALWAYS_SOFTWARE=1 Mesa runs llvmpipe in any sandbox.
+bool createContext()
+{
+    const auto getPlatformDisplay =
+        reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (!getPlatformDisplay)
+    {
+        return false;
+    }
+    const EGLDisplay display{getPlatformDisplay(
+        EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr)};
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+    {
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint attributes[]{EGL_CONTEXT_MAJOR_VERSION,
+                              4,
+                              EGL_CONTEXT_MINOR_VERSION,
+                              4,
+                              EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                              EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                              EGL_NONE};
+    const EGLContext context{eglCreateContext(
+        display, EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, attributes)};
+    return context != EGL_NO_CONTEXT &&
+           eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) &&
+           gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress));
+}
+
+std::unique_ptr<OpenGL::OpenGLTexture> makeChecker(unsigned char red,
+                                                   unsigned char green,
+                                                   unsigned char blue)
+{
+    constexpr GLsizei size{64};
+    std::vector<unsigned char> pixels;
+    for (GLsizei y{0}; y < size; ++y)
+    {
+        for (GLsizei x{0}; x < size; ++x)
+        {
+            const bool light{((x / 8) + (y / 8)) % 2 == 0};
+            pixels.push_back(light ? red : 255);
+            pixels.push_back(light ? green : 255);
+            pixels.push_back(light ? blue : 255);
+            pixels.push_back(255);
+        }
+    }
+    return std::unique_ptr<OpenGL::OpenGLTexture>{
+        new OpenGL::OpenGLTexture{size, size, GL_RGBA, pixels}};
+}
+
+// Cuts the triangles into partCount sub-meshes of two materials, the way
+// an OBJ with usemtl groups arrives.
+void splitParts(Model::MeshData &meshData)
+{
+    const std::size_t triangleCount{meshData.indices.size() / 3};
+    meshData.subMeshes.clear();
+    for (std::size_t part{0}; part < partCount; ++part)
+    {
+        const std::size_t first{triangleCount * part / partCount};
+        const std::size_t last{triangleCount * (part + 1) / partCount};
+        meshData.subMeshes.push_back(Model::SubMesh{
+            static_cast<std::uint32_t>(3 * first),
+            static_cast<std::uint32_t>(3 * (last - first)),
+            static_cast<std::int32_t>(part % 2)});
+    }
+}
+
+} // namespace Detail
+
+// Draws a grid of models, each of its own geometry and of sub-meshes with
+// two textured materials, once with a draw per sub-mesh of every Mesh and
+// once from the GeometryArena, and reports the draw calls and time of a
+// frame and whether both frames look the same. Runs without a window:
+//   LIBGL_ALWAYS_SOFTWARE=1 ArenaSubmissionBenchmark
+//       "resources/model/Utah_teapot_(solid)_texture.obj"
+//       src/Shader/BasicVertexShader.vs.glsl
+//       src/Shader/BasicFragmentShader.fs.glsl 256 50
+int main(int argc, char *argv[])
+{
+    if (argc <= 3)
+    {
+        std::cerr << "Expect: " << argv[0]
+                  << " [model name] [vertex shader] [fragment shader] "
+                     "[model count] [frame count]"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    const char *model{argv[1]};
+    const std::size_t modelCount{
+        argc > 4 ? static_cast<std::size_t>(std::atoi(argv[4])) : 256};
+    const std::size_t frameCount{
+        argc > 5 ? static_cast<std::size_t>(std::atoi(argv[5])) : 50};
+
+    if (!Detail::createContext())
+    {
+        std::cerr << "[Error]No OpenGL 4.4 context from a surfaceless EGL "
+                     "display"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    const GLADloadproc loader{
+        reinterpret_cast<GLADloadproc>(eglGetProcAddress)};
+    if (!OpenGL::OpenGLDrawIndirect::load(loader))
+    {
+        std::cerr << "[Error]No multi-draw indirect" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    OpenGL::OpenGLStreamBuffer::load(loader);
+    std::cout << glGetString(GL_RENDERER) << ", OpenGL "
+              << glGetString(GL_VERSION) << std::endl;
+
+    OpenGL::OpenGLShaderProgram program;
+    if (!program.addShaderFromFile(OpenGL::OpenGLShader::Type::Vertex,
+                                   argv[2]) ||
+        !program.addShaderFromFile(OpenGL::OpenGLShader::Type::Fragment,
+                                   argv[3]))
+    {
+        exit(EXIT_FAILURE);
+    }
+    program.link();
+    if (!program.linkStatus())
+    {
+        exit(EXIT_FAILURE);
+    }
+    program.bindUniformBlock("Camera", Model::cameraBlockBinding);
+    program.bindUniformBlock("Object", Model::objectBlockBinding);
+
+    Model::MeshData meshData;
+    Model::ObjLoader objLoader;
+    if (!objLoader.load(model, meshData))
+    {
+        std::cerr << "[Error]" << objLoader.errorMessage() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    Detail::splitParts(meshData);
+    const Model::MeshView view{meshData.view()};
+
+    // Rendered off screen, as a surfaceless context has no window.
+    GLuint frameBuffer{0};
+    GLuint renderBuffers[2]{0, 0};
+    glGenFramebuffers(1, &frameBuffer);
+    glGenRenderbuffers(2, renderBuffers);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderBuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, Detail::frameWidth,
+                          Detail::frameHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderBuffers[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24,
+                          Detail::frameWidth, Detail::frameHeight);
+    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+                              GL_RENDERBUFFER, renderBuffers[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+                              GL_RENDERBUFFER, renderBuffers[1]);
+    glViewport(0, 0, Detail::frameWidth, Detail::frameHeight);
+
+    const std::unique_ptr<OpenGL::OpenGLTexture> textures[]{
+        Detail::makeChecker(255, 64, 64), Detail::makeChecker(64, 64, 255)};
+    const std::vector<Model::Mesh::MaterialState> materials{
+        {textures[0].get(), glm::vec4{1.0f, 0.8f, 0.8f, 1.0f}},
+        {textures[1].get(), glm::vec4{0.8f, 1.0f, 0.8f, 1.0f}}};
+
+    // Models on a square grid filling the view.
+    const Model::Bounds &bounds{meshData.bounds};
+    const glm::vec3 extent{bounds.maximum - bounds.minimum};
+    const float spacing{1.2f * std::max({extent.x, extent.y, extent.z})};
+    const std::size_t side{static_cast<std::size_t>(
+        std::ceil(std::sqrt(static_cast<double>(modelCount))))};
+    std::vector<glm::mat4> placements;
+    for (std::size_t i{0}; i < modelCount; ++i)
+    {
+        placements.push_back(glm::translate(
+            glm::mat4{1.0f},
+            glm::vec3{spacing * (static_cast<float>(i % side) -
+                                 0.5f * static_cast<float>(side - 1)),
+                      0.0f,
+                      spacing * (static_cast<float>(i / side) -
+                                 0.5f * static_cast<float>(side - 1))}));
+    }
+    const float distance{spacing * static_cast<float>(side)};
+    glm::mat4 viewMatrix{glm::lookAt(glm::vec3{0.0f, distance, distance},
+                                     glm::vec3{0.0f}, glm::vec3{0, 1, 0})};
+    glm::mat4 projection{glm::perspective(
+        glm::radians(45.0f),
+        static_cast<float>(Detail::frameWidth) /
+            static_cast<float>(Detail::frameHeight),
+        0.1f * distance, 4.0f * distance)};
+
+    Model::BufferHeap vertexHeap{
+        OpenGL::OpenGLBufferObject::Type::ArrayBuffer};
+    Model::BufferHeap indexHeap{
+        OpenGL::OpenGLBufferObject::Type::ElementArrayBuffer};
+    std::vector<std::unique_ptr<Model::Mesh>> meshes;
+    Model::GeometryArena arena{program};
+    std::vector<Model::GeometryArena::Material> arenaMaterials;
+    for (const Model::Mesh::MaterialState &material : materials)
+    {
+        arenaMaterials.push_back(
+            arena.addMaterial(material.texture, material.color));
+    }
+    const Model::GeometryArena::Material fallback{
+        arena.addMaterial(nullptr, glm::vec4{1.0f})};
+    for (std::size_t i{0}; i < modelCount; ++i)
+    {
+        meshes.emplace_back(
+            new Model::Mesh{view, vertexHeap, indexHeap, program});
+        meshes.back()->setMaterials(materials);
+        meshes.back()->setModel(placements[i]);
+        arena.addDraw(arena.addGeometry(view, arenaMaterials, fallback),
+                      placements[i]);
+    }
+
+    Model::CameraUniformBuffer cameraBlocks{Model::cameraBlockBinding};
+    Model::ObjectUniformBuffer objectBlocks{Model::objectBlockBinding,
+                                            modelCount};
+    const auto renderFrame = [&](bool useArena) {
+        OpenGL::OpenGLStateCache::setDepthTest(true);
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        cameraBlocks.clear();
+        cameraBlocks.append(Model::CameraBlock{
+            viewMatrix, projection, projection * viewMatrix,
+            glm::vec4{0.0f, distance, distance, 1.0f}});
+        cameraBlocks.upload();
+        cameraBlocks.bind();
+
+        Detail::FrameTimes times{0, 0.0, 0.0};
+        Performance::Stopwatch stopwatch;
+        objectBlocks.clear();
+        if (useArena)
+        {
+            arena.writeObjects(objectBlocks);
+            objectBlocks.upload();
+            arena.draw(viewMatrix, projection);
+            times.drawCalls = arena.statistics().submissionCount;
+        }
+        else
+        {
+            for (auto &mesh : meshes)
+            {
+                mesh->writeObjects(objectBlocks);
+            }
+            objectBlocks.upload();
+            for (auto &mesh : meshes)
+            {
+                mesh->draw(viewMatrix, projection);
+                times.drawCalls += mesh->drawCallCount();
+            }
+        }
+        times.cpuMilliseconds = stopwatch.elapsedMilliseconds();
+        glFinish();
+        times.frameMilliseconds = stopwatch.elapsedMilliseconds();
+        OpenGL::OpenGLStateCache::endFrame();
+        return times;
+    };
+
+    std::vector<unsigned char> images[2];
+    std::cout << modelCount << " models of " << view.indexCount / 3
+              << " triangles in " << Detail::partCount << " sub-meshes, "
+              << frameCount << " frames" << std::endl;
+    std::cout << "path        draw calls   CPU ms  frame ms" << std::endl;
+    for (int useArena{0}; useArena < 2; ++useArena)
+    {
+        Detail::FrameTimes best{0, 0.0, 0.0};
+        for (std::size_t frame{0}; frame < Detail::warmUpFrames + frameCount;
+             ++frame)
+        {
+            const Detail::FrameTimes times{renderFrame(useArena != 0)};
+            if (frame == Detail::warmUpFrames ||
+                (frame > Detail::warmUpFrames &&
+                 times.cpuMilliseconds < best.cpuMilliseconds))
+            {
+                best.drawCalls = times.drawCalls;
+                best.cpuMilliseconds = times.cpuMilliseconds;
+            }
+            if (frame == Detail::warmUpFrames ||
+                (frame > Detail::warmUpFrames &&
+                 times.frameMilliseconds < best.frameMilliseconds))
+            {
+                best.frameMilliseconds = times.frameMilliseconds;
+            }
+        }
+
+        images[useArena].resize(4 * Detail::frameWidth * Detail::frameHeight);
+        glReadPixels(0, 0, Detail::frameWidth, Detail::frameHeight, GL_RGBA,
+                     GL_UNSIGNED_BYTE, images[useArena].data());
+        std::cout << (useArena ? "arena   " : "per mesh") << std::setw(14)
+                  << best.drawCalls << std::setw(9) << std::fixed
+                  << std::setprecision(3) << best.cpuMilliseconds
+                  << std::setw(10) << best.frameMilliseconds << std::endl;
+    }
+
+    // Both paths shade every sub-mesh with its own material, so they only
+    // differ where equal depths resolve in another order.
+    std::size_t differentPixels{0};
+    std::size_t coveredPixels{0};
+    for (std::size_t i{0}; i < images[0].size(); i += 4)
+    {
+        coveredPixels += images[0][i] || images[0][i + 1] || images[0][i + 2];
+        for (std::size_t channel{0}; channel < 3; ++channel)
+        {
+            if (std::abs(images[0][i + channel] - images[1][i + channel]) > 2)
+            {
+                ++differentPixels;
+                break;
+            }
+        }
+    }
+    const std::size_t pixelCount{images[0].size() / 4};
+    std::cout << "Pixels covered: " << coveredPixels << ", that differ: "
+              << differentPixels << " of " << pixelCount << std::endl;
+
+    glDeleteRenderbuffers(2, renderBuffers);
+    glDeleteFramebuffers(1, &frameBuffer);
+    if (!coveredPixels || differentPixels * 100 > pixelCount)
+    {
+        std::cerr << "[Error]The arena draws another image" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    return EXIT_SUCCESS;
+}
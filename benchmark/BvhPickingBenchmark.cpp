@@ -0,0 +1,143 @@
+#include "Model/TriangleBvh.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glm/geometric.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace Detail
+{
+
+// A rolling height field over [-1, 1]^2 with texture coordinates, standing in
+// for a scanned terrain or sculpt the user clicks on.
+Model::MeshData makeTerrain(std::size_t triangleCount)
+{
+    const std::size_t cells{static_cast<std::size_t>(
+        std::sqrt(static_cast<double>(triangleCount) / 2.0))};
+    const std::size_t width{cells + 1};
+
+    Model::MeshData meshData;
+    meshData.positions.reserve(3 * width * width);
+    meshData.textureCoordinates.reserve(2 * width * width);
+    for (std::size_t y{0}; y < width; ++y)
+    {
+        for (std::size_t x{0}; x < width; ++x)
+        {
+            const float u{static_cast<float>(x) / static_cast<float>(cells)};
+            const float v{static_cast<float>(y) / static_cast<float>(cells)};
+            meshData.positions.push_back(2.0f * u - 1.0f);
+            meshData.positions.push_back(2.0f * v - 1.0f);
+            meshData.positions.push_back(0.1f * std::sin(13.0f * u) *
+                                         std::cos(7.0f * v));
+            meshData.textureCoordinates.push_back(u);
+            meshData.textureCoordinates.push_back(v);
+        }
+    }
+
+    meshData.indices.reserve(6 * cells * cells);
+    for (std::size_t y{0}; y < cells; ++y)
+    {
+        for (std::size_t x{0}; x < cells; ++x)
+        {
+            const unsigned int a{static_cast<unsigned int>(y * width + x)};
+            const unsigned int b{a + 1};
+            const unsigned int c{static_cast<unsigned int>(a + width)};
+            const unsigned int d{c + 1};
+
+            for (unsigned int corner : {a, b, d, a, d, c})
+            {
+                meshData.indices.push_back(corner);
+            }
+        }
+    }
+
+    meshData.updateBounds();
+    return meshData;
+}
+
+// Rays from a camera above the terrain towards random points on it, the
+// way clicks land in the viewer.
+std::vector<Model::Ray> makeRays(std::size_t count)
+{
+    std::mt19937 engine{7};
+    std::uniform_real_distribution<float> distribution{-1.2f, 1.2f};
+
+    std::vector<Model::Ray> rays(count);
+    for (Model::Ray &ray : rays)
+    {
+        ray.origin = glm::vec3{0.5f, -2.0f, 3.0f};
+        const glm::vec3 target{distribution(engine), distribution(engine),
+                               0.0f};
+        ray.direction = target - ray.origin;
+        ray.minimumDistance = 0.0f;
+        ray.maximumDistance = 2.0f;
+    }
+    return rays;
+}
+
+} // namespace Detail
+
+// Builds the tree over terrains of the given sizes (in millions of
+// triangles) and times closest-hit and any-hit queries for a batch of
+// random picks.
+int main(int argc, char *argv[])
+{
+    std::vector<std::size_t> sizes;
+    for (int i{1}; i < argc; ++i)
+    {
+        sizes.push_back(static_cast<std::size_t>(std::atof(argv[i]) * 1e6));
+    }
+    if (sizes.empty())
+    {
+        sizes = {1000000, 5000000, 10000000};
+    }
+
+    const std::vector<Model::Ray> rays{Detail::makeRays(10000)};
+
+    std::cout << "   triangles     nodes  depth  build ms   closest us"
+                 "    any us    hits"
+              << std::endl;
+
+    for (std::size_t size : sizes)
+    {
+        const Model::MeshData meshData{Detail::makeTerrain(size)};
+
+        Model::TriangleBvh bvh;
+        bvh.build(meshData.view());
+
+        Performance::Stopwatch stopwatch;
+        std::size_t hits{0};
+        for (const Model::Ray &ray : rays)
+        {
+            Model::RayHit hit;
+            hits += bvh.closestHit(ray, hit) ? 1 : 0;
+        }
+        const double closestMilliseconds{stopwatch.elapsedMilliseconds()};
+
+        stopwatch.restart();
+        std::size_t anyHits{0};
+        for (const Model::Ray &ray : rays)
+        {
+            anyHits += bvh.anyHit(ray) ? 1 : 0;
+        }
+        const double anyMilliseconds{stopwatch.elapsedMilliseconds()};
+
+        const Model::TriangleBvh::Statistics &statistics{bvh.statistics()};
+        const double perRay{1000.0 / static_cast<double>(rays.size())};
+        std::cout << std::setw(12) << statistics.triangleCount << std::setw(10)
+                  << statistics.nodeCount << std::setw(7) << statistics.depth
+                  << std::setw(10) << std::fixed << std::setprecision(1)
+                  << statistics.buildMilliseconds << std::setw(13)
+                  << std::setprecision(2) << closestMilliseconds * perRay
+                  << std::setw(10) << anyMilliseconds * perRay << std::setw(8)
+                  << hits << (hits == anyHits ? "" : "  any-hit mismatch")
+                  << std::endl;
+    }
+
+    return 0;
+}
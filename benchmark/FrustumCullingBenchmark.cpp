@@ -0,0 +1,152 @@
+#include "Model/FrustumCuller.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glm/geometric.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/trigonometric.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace Detail
+{
+
+// Objects of random size scattered through a cube around the camera, so a
+// frustum looking along one axis sees a fraction of them.
+void scatter(Model::FrustumCuller &culler, std::vector<Model::Bounds> &boxes,
+             std::vector<Model::BoundingSphere> &spheres, std::size_t count)
+{
+    std::mt19937 engine{11};
+    std::uniform_real_distribution<float> position{-500.0f, 500.0f};
+    std::uniform_real_distribution<float> size{0.5f, 5.0f};
+
+    culler.clear();
+    boxes.clear();
+    spheres.clear();
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        const glm::vec3 center{position(engine), position(engine),
+                               position(engine)};
+        const glm::vec3 extent{size(engine), size(engine), size(engine)};
+        boxes.push_back(Model::Bounds{center - extent, center + extent});
+        spheres.push_back(Model::BoundingSphere{center, glm::length(extent)});
+        culler.add(boxes.back(), spheres.back());
+    }
+}
+
+// One object at a time with the same tests, to check the SIMD culler
+// against.
+std::size_t scalarCull(const glm::mat4 &viewProjection,
+                       const std::vector<Model::Bounds> &boxes,
+                       const std::vector<Model::BoundingSphere> &spheres,
+                       std::vector<unsigned char> &visible)
+{
+    const glm::mat4 m{viewProjection};
+    const glm::vec4 row0{m[0][0], m[1][0], m[2][0], m[3][0]};
+    const glm::vec4 row1{m[0][1], m[1][1], m[2][1], m[3][1]};
+    const glm::vec4 row2{m[0][2], m[1][2], m[2][2], m[3][2]};
+    const glm::vec4 row3{m[0][3], m[1][3], m[2][3], m[3][3]};
+    glm::vec4 planes[6]{row3 + row0, row3 - row0, row3 + row1,
+                        row3 - row1, row3 + row2, row3 - row2};
+    for (glm::vec4 &plane : planes)
+    {
+        plane /= glm::length(glm::vec3{plane});
+    }
+
+    std::size_t culled{0};
+    visible.resize(boxes.size());
+    for (std::size_t i{0}; i < boxes.size(); ++i)
+    {
+        bool inside{true};
+        for (const glm::vec4 &plane : planes)
+        {
+            const glm::vec3 normal{plane};
+            const glm::vec3 corner{
+                plane.x >= 0.0f ? boxes[i].maximum.x : boxes[i].minimum.x,
+                plane.y >= 0.0f ? boxes[i].maximum.y : boxes[i].minimum.y,
+                plane.z >= 0.0f ? boxes[i].maximum.z : boxes[i].minimum.z};
+            inside = inside &&
+                     glm::dot(normal, spheres[i].center) + plane.w >=
+                         -spheres[i].radius &&
+                     glm::dot(normal, corner) + plane.w >= 0.0f;
+        }
+        visible[i] = inside ? 1 : 0;
+        culled += inside ? 0 : 1;
+    }
+    return culled;
+}
+
+} // namespace Detail
+
+// Culls scenes of the given sizes (in thousands of objects) against a
+// camera turning in place, with the serial scalar loop and with the
+// parallel SIMD culler, averaged over a number of frames.
+int main(int argc, char *argv[])
+{
+    std::vector<std::size_t> sizes;
+    for (int i{1}; i < argc; ++i)
+    {
+        sizes.push_back(static_cast<std::size_t>(std::atof(argv[i]) * 1e3));
+    }
+    if (sizes.empty())
+    {
+        sizes = {10000, 100000, 1000000};
+    }
+
+    constexpr int frameCount{100};
+    const glm::mat4 projection{glm::perspective(
+        glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 1000.0f)};
+
+    std::cout << "     objects   visible    culled   scalar ms     SIMD ms"
+                 "  mismatches"
+              << std::endl;
+
+    for (std::size_t size : sizes)
+    {
+        Model::FrustumCuller culler;
+        std::vector<Model::Bounds> boxes;
+        std::vector<Model::BoundingSphere> spheres;
+        Detail::scatter(culler, boxes, spheres, size);
+
+        double scalarMilliseconds{0.0};
+        double simdMilliseconds{0.0};
+        std::size_t mismatches{0};
+        std::vector<unsigned char> expected;
+        std::vector<unsigned char> visible;
+        for (int frame{0}; frame < frameCount; ++frame)
+        {
+            const float angle{glm::radians(3.6f * static_cast<float>(frame))};
+            const glm::mat4 view{glm::lookAt(
+                glm::vec3{0.0f},
+                glm::vec3{std::sin(angle), 0.2f, std::cos(angle)},
+                glm::vec3{0.0f, 1.0f, 0.0f})};
+            const glm::mat4 viewProjection{projection * view};
+
+            Performance::Stopwatch stopwatch;
+            Detail::scalarCull(viewProjection, boxes, spheres, expected);
+            scalarMilliseconds += stopwatch.elapsedMilliseconds();
+
+            culler.cull(viewProjection, visible);
+            simdMilliseconds += culler.statistics().cullMilliseconds;
+
+            for (std::size_t i{0}; i < size; ++i)
+            {
+                mismatches += expected[i] != visible[i] ? 1 : 0;
+            }
+        }
+
+        const Model::FrustumCuller::Statistics &statistics{
+            culler.statistics()};
+        std::cout << std::setw(12) << statistics.objectCount << std::setw(10)
+                  << statistics.visibleCount << std::setw(10)
+                  << statistics.culledCount << std::setw(12) << std::fixed
+                  << std::setprecision(3) << scalarMilliseconds / frameCount
+                  << std::setw(12) << simdMilliseconds / frameCount
+                  << std::setw(12) << mismatches << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "Model/MeshSimplifier.hpp"
+#include "Model/ObjLoader.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+// Builds the level of detail chain of an OBJ model and reports every level.
+// Fails when the chain is empty, so a model with UV or normal seams, such
+// as the bundled teapot, checks that seam vertices still collapse:
+//   MeshSimplifierBenchmark "resources/model/Utah_teapot_(solid)_texture.obj"
+int main(int argc, char *argv[])
+{
+    if (argc <= 1)
+    {
+        std::cerr << "Expect: " << argv[0] << " [model name] [repeat count]"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    const char *model{argv[1]};
+    const int repeat{argc > 2 ? std::atoi(argv[2]) : 3};
+
+    Model::MeshData meshData;
+    Model::ObjLoader loader;
+    if (!loader.load(model, meshData))
+    {
+        std::cerr << "[Error]" << loader.errorMessage() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    const Model::MeshView view{meshData.view()};
+
+    Model::LevelOfDetailChain chain;
+    double best{0.0};
+    for (int i{0}; i < repeat; ++i)
+    {
+        Performance::Stopwatch stopwatch;
+        chain = Model::MeshSimplifier::buildChain(view);
+        const double milliseconds{stopwatch.elapsedMilliseconds()};
+        best = (i == 0 || milliseconds < best) ? milliseconds : best;
+    }
+
+    std::cout << model << ": " << view.vertexCount << " vertices, "
+              << view.indexCount / 3 << " triangles, chain built in "
+              << std::fixed << std::setprecision(1) << best << " ms"
+              << std::endl;
+    std::cout << "level  triangles     error" << std::endl;
+    for (std::size_t level{0}; level < chain.levels.size(); ++level)
+    {
+        std::cout << std::setw(5) << level + 1 << std::setw(11)
+                  << chain.levels[level].indexCount / 3 << std::setw(10)
+                  << std::setprecision(4) << chain.levels[level].error
+                  << std::endl;
+    }
+
+    if (chain.levels.empty())
+    {
+        std::cerr << "[Error]No level of detail for " << model << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    return EXIT_SUCCESS;
+}
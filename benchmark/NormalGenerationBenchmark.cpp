@@ -0,0 +1,144 @@
+#include "Model/NormalGenerator.hpp"
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+#include "glm/trigonometric.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Detail
+{
+
+// A wavy height field folded into a ridge along x = 0, so a crease angle
+// splits the vertices on the ridge. Vertices are shared between cells, the
+// way a welded OBJ without normals arrives.
+Model::MeshData makeRidgeGrid(std::size_t triangleCount)
+{
+    // An even number of cells puts the ridge on a column of vertices.
+    const std::size_t cells{
+        static_cast<std::size_t>(
+            std::sqrt(static_cast<double>(triangleCount) / 2.0)) &
+        ~std::size_t{1}};
+    const std::size_t width{cells + 1};
+
+    Model::MeshData meshData;
+    meshData.positions.reserve(3 * width * width);
+    for (std::size_t y{0}; y < width; ++y)
+    {
+        for (std::size_t x{0}; x < width; ++x)
+        {
+            const float u{static_cast<float>(x) / static_cast<float>(cells) *
+                              2.0f -
+                          1.0f};
+            const float v{static_cast<float>(y) / static_cast<float>(cells) *
+                              2.0f -
+                          1.0f};
+            meshData.positions.push_back(u);
+            meshData.positions.push_back(v);
+            meshData.positions.push_back(0.5f - std::fabs(u) +
+                                         0.05f * std::sin(20.0f * v));
+        }
+    }
+
+    meshData.indices.reserve(6 * cells * cells);
+    for (std::size_t y{0}; y < cells; ++y)
+    {
+        for (std::size_t x{0}; x < cells; ++x)
+        {
+            const unsigned int a{static_cast<unsigned int>(y * width + x)};
+            const unsigned int b{a + 1};
+            const unsigned int c{static_cast<unsigned int>(a + width)};
+            const unsigned int d{c + 1};
+
+            for (unsigned int corner : {a, b, d, a, d, c})
+            {
+                meshData.indices.push_back(corner);
+            }
+        }
+    }
+
+    meshData.updateBounds();
+    return meshData;
+}
+
+// Largest angle in degrees between the normals two runs gave each corner.
+float maximumDeviation(const Model::MeshData &lhs, const Model::MeshData &rhs)
+{
+    float deviation{0.0f};
+    for (std::size_t i{0}; i < lhs.indices.size(); ++i)
+    {
+        const float *a{lhs.normals.data() + 3 * lhs.indices[i]};
+        const float *b{rhs.normals.data() + 3 * rhs.indices[i]};
+        const float cosine{glm::clamp(
+            a[0] * b[0] + a[1] * b[1] + a[2] * b[2], -1.0f, 1.0f)};
+        deviation = std::max(deviation, glm::degrees(std::acos(cosine)));
+    }
+    return deviation;
+}
+
+Model::MeshData run(const char *name, const Model::MeshData &source,
+                    float creaseAngle, unsigned int threadCount, bool simd)
+{
+    Model::MeshData meshData{source};
+    Model::NormalGenerator generator{Model::NormalWeighting::AreaAngle,
+                                     creaseAngle, threadCount, simd};
+    generator.generate(meshData);
+
+    const Model::NormalGenerator::Statistics &statistics{
+        generator.statistics()};
+    std::cout << std::setw(18) << name << std::setw(8) << std::fixed
+              << std::setprecision(0) << creaseAngle << std::setw(12)
+              << statistics.triangleCount << std::setw(10)
+              << statistics.splitVertexCount << std::setw(10)
+              << std::setprecision(1) << statistics.generateMilliseconds
+              << std::setw(10)
+              << static_cast<double>(statistics.triangleCount) /
+                     statistics.generateMilliseconds / 1000.0
+              << std::endl;
+    return meshData;
+}
+
+} // namespace Detail
+
+// Generates normals for ridge grids of the given sizes (in millions of
+// triangles) with the serial scalar version and with the parallel SIMD one,
+// smooth and with a 45 degree crease.
+int main(int argc, char *argv[])
+{
+    std::vector<std::size_t> sizes;
+    for (int i{1}; i < argc; ++i)
+    {
+        sizes.push_back(static_cast<std::size_t>(std::atof(argv[i]) * 1e6));
+    }
+    if (sizes.empty())
+    {
+        sizes = {1000000, 5000000, 10000000, 50000000};
+    }
+
+    std::cout << "         generator   crease   triangles     split        "
+                 "ms   Mtris/s"
+              << std::endl;
+
+    for (std::size_t size : sizes)
+    {
+        const Model::MeshData source{Detail::makeRidgeGrid(size)};
+
+        for (float creaseAngle : {180.0f, 45.0f})
+        {
+            const Model::MeshData serial{
+                Detail::run("serial scalar", source, creaseAngle, 1, false)};
+            const Model::MeshData parallel{
+                Detail::run("parallel SIMD", source, creaseAngle, 0, true)};
+            std::cout << "    max deviation " << std::setprecision(4)
+                      << Detail::maximumDeviation(serial, parallel) << " deg"
+                      << std::endl;
+        }
+    }
+
+    return 0;
+}
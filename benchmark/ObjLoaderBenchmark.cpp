@@ -0,0 +1,95 @@
+#include "Model/ObjLoader.hpp"
+#include "Utils/Performance/MemoryUsage.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "tiny_obj_loader.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Peak RSS is a per process high-water mark, so each loader has to be
+// measured in its own run:
+//   ObjLoaderBenchmark model.obj mmap
+//   ObjLoaderBenchmark model.obj tinyobj
+int main(int argc, char *argv[])
+{
+    if (argc <= 2)
+    {
+        std::cerr << "Expect: " << argv[0]
+                  << " [model name] [mmap|tinyobj] [repeat count]"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    const char *model{argv[1]};
+    const bool useTinyObj{std::strcmp(argv[2], "tinyobj") == 0};
+    const int repeat{argc > 3 ? std::atoi(argv[3]) : 1};
+
+    double totalMilliseconds{0.0};
+    std::size_t vertexCount{0};
+    std::size_t triangleCount{0};
+
+    for (int i{0}; i < repeat; ++i)
+    {
+        if (useTinyObj)
+        {
+            Performance::Stopwatch stopwatch;
+
+            std::vector<tinyobj::shape_t> shapes;
+            std::vector<tinyobj::material_t> materials;
+            std::string errorMessage;
+            if (!tinyobj::LoadObj(shapes, materials, errorMessage, model))
+            {
+                std::cerr << "[Error]" << errorMessage << std::endl;
+                exit(EXIT_FAILURE);
+            }
+
+            // The copies OpenGLWindow::addModel used to make.
+            std::vector<float> positions;
+            std::vector<float> normals;
+            std::vector<float> textureCoordinates;
+            std::vector<unsigned int> indices;
+            for (auto &shape : shapes)
+            {
+                positions.insert(positions.end(), shape.mesh.positions.begin(),
+                                 shape.mesh.positions.end());
+                normals.insert(normals.end(), shape.mesh.normals.begin(),
+                               shape.mesh.normals.end());
+                textureCoordinates.insert(textureCoordinates.end(),
+                                          shape.mesh.texcoords.begin(),
+                                          shape.mesh.texcoords.end());
+                indices.insert(indices.end(), shape.mesh.indices.begin(),
+                               shape.mesh.indices.end());
+            }
+
+            totalMilliseconds += stopwatch.elapsedMilliseconds();
+            vertexCount = positions.size() / 3;
+            triangleCount = indices.size() / 3;
+        }
+        else
+        {
+            Model::MeshData meshData;
+            Model::ObjLoader loader;
+            if (!loader.load(model, meshData))
+            {
+                std::cerr << "[Error]" << loader.errorMessage() << std::endl;
+                exit(EXIT_FAILURE);
+            }
+
+            totalMilliseconds += loader.statistics().loadMilliseconds;
+            vertexCount = loader.statistics().vertexCount;
+            triangleCount = loader.statistics().triangleCount;
+        }
+    }
+
+    std::cout << (useTinyObj ? "tinyobj" : "mmap") << ": " << vertexCount
+              << " vertices, " << triangleCount << " triangles, "
+              << totalMilliseconds / repeat << " ms per load, peak RSS "
+              << Performance::PeakResidentSetSize() / 1024 << " KiB"
+              << std::endl;
+
+    return 0;
+}
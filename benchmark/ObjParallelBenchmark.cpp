@@ -0,0 +1,92 @@
+#include "Model/ObjLoader.hpp"
+#include "Utils/Parallel/ParallelFor.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Detail
+{
+
+template <typename T>
+bool sameBits(const std::vector<T> &lhs, const std::vector<T> &rhs)
+{
+    return lhs.size() == rhs.size() &&
+           (lhs.empty() ||
+            std::memcmp(lhs.data(), rhs.data(), sizeof(T) * lhs.size()) == 0);
+}
+
+bool sameMesh(const Model::MeshData &lhs, const Model::MeshData &rhs)
+{
+    return sameBits(lhs.positions, rhs.positions) &&
+           sameBits(lhs.normals, rhs.normals) &&
+           sameBits(lhs.textureCoordinates, rhs.textureCoordinates) &&
+           sameBits(lhs.indices, rhs.indices);
+}
+
+} // namespace Detail
+
+// Loads the model with 1..N threads, reports the speed-up against one thread
+// and checks that every run is bit-identical to the single threaded result.
+int main(int argc, char *argv[])
+{
+    if (argc <= 1)
+    {
+        std::cerr << "Expect: " << argv[0]
+                  << " [model name] [max thread count] [repeat count]"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    const char *model{argv[1]};
+    const unsigned int maxThreadCount{
+        argc > 2 ? static_cast<unsigned int>(std::atoi(argv[2]))
+                 : Parallel::HardwareThreadCount()};
+    const int repeat{argc > 3 ? std::atoi(argv[3]) : 3};
+
+    Model::MeshData reference;
+    double referenceMilliseconds{0.0};
+    bool identical{true};
+
+    std::cout << "threads      ms  speed-up  identical" << std::endl;
+
+    for (unsigned int threadCount{1}; threadCount <= maxThreadCount;
+         ++threadCount)
+    {
+        Model::ObjLoader loader{threadCount};
+        Model::MeshData meshData;
+        double best{0.0};
+
+        for (int i{0}; i < repeat; ++i)
+        {
+            if (!loader.load(model, meshData))
+            {
+                std::cerr << "[Error]" << loader.errorMessage() << std::endl;
+                exit(EXIT_FAILURE);
+            }
+
+            const double milliseconds{loader.statistics().loadMilliseconds};
+            best = (i == 0 || milliseconds < best) ? milliseconds : best;
+        }
+
+        if (threadCount == 1)
+        {
+            reference = std::move(meshData);
+            referenceMilliseconds = best;
+        }
+
+        const bool same{threadCount == 1 ||
+                        Detail::sameMesh(reference, meshData)};
+        identical = identical && same;
+
+        std::cout << std::setw(7) << threadCount << std::setw(8)
+                  << std::fixed << std::setprecision(1) << best
+                  << std::setw(9) << std::setprecision(2)
+                  << referenceMilliseconds / best << "x" << std::setw(11)
+                  << (same ? "yes" : "NO") << std::endl;
+    }
+
+    return identical ? EXIT_SUCCESS : EXIT_FAILURE;
+}
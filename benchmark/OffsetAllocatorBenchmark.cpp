@@ -0,0 +1,235 @@
+#include "Model/OffsetAllocator.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace Detail
+{
+
+// The usual free list: free ranges by offset, searched first fit and merged
+// with their neighbours when freed.
+class FirstFitAllocator
+{
+public:
+    explicit FirstFitAllocator(std::uint32_t capacity) : free_{{0, capacity}}
+    {
+    }
+
+    // Offset, or capacity + 1 on failure.
+    std::uint32_t allocate(std::uint32_t size)
+    {
+        for (auto range = free_.begin(); range != free_.end(); ++range)
+        {
+            if (range->second >= size)
+            {
+                const std::uint32_t offset{range->first};
+                const std::uint32_t rest{range->second - size};
+                free_.erase(range);
+                if (rest)
+                {
+                    free_.emplace(offset + size, rest);
+                }
+                return offset;
+            }
+        }
+        return failed;
+    }
+
+    void free(std::uint32_t offset, std::uint32_t size)
+    {
+        auto next = free_.lower_bound(offset);
+        if (next != free_.begin())
+        {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset)
+            {
+                offset = previous->first;
+                size += previous->second;
+                free_.erase(previous);
+            }
+        }
+        if (next != free_.end() && offset + size == next->first)
+        {
+            size += next->second;
+            free_.erase(next);
+        }
+        free_.emplace(offset, size);
+    }
+
+    std::size_t freeRangeCount() const noexcept { return free_.size(); }
+
+    static constexpr std::uint32_t failed{0xffffffffu};
+
+private:
+    std::map<std::uint32_t, std::uint32_t> free_;
+};
+
+constexpr std::uint32_t FirstFitAllocator::failed;
+
+struct Live
+{
+    std::uint32_t offset;
+    std::uint32_t size;
+    Model::OffsetAllocator::Allocation allocation;
+};
+
+// Sizes of small meshes, log-uniform from 256 bytes to 256 KiB.
+std::vector<std::uint32_t> meshSizes(std::size_t count)
+{
+    std::mt19937 engine{5};
+    std::uniform_real_distribution<double> exponent{8.0, 18.0};
+    std::vector<std::uint32_t> sizes(count);
+    for (std::uint32_t &size : sizes)
+    {
+        size = static_cast<std::uint32_t>(std::pow(2.0, exponent(engine)));
+    }
+    return sizes;
+}
+
+// Whether any two live ranges overlap or one leaves the capacity.
+bool overlaps(std::vector<Live> live, std::uint32_t capacity)
+{
+    std::sort(live.begin(), live.end(),
+              [](const Live &lhs, const Live &rhs) {
+                  return lhs.offset < rhs.offset;
+              });
+    for (std::size_t i{0}; i < live.size(); ++i)
+    {
+        const std::uint64_t end{std::uint64_t{live[i].offset} + live[i].size};
+        if (end > capacity ||
+            (i + 1 < live.size() && end > live[i + 1].offset))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace Detail
+
+// Fills a heap with the given numbers (in thousands) of mesh-sized ranges,
+// then frees and allocates them at random, the way parts are loaded and
+// unloaded, through the TLSF allocator and a first-fit free list.
+int main(int argc, char *argv[])
+{
+    std::vector<std::size_t> counts;
+    for (int i{1}; i < argc; ++i)
+    {
+        counts.push_back(static_cast<std::size_t>(std::atof(argv[i]) * 1e3));
+    }
+    if (counts.empty())
+    {
+        counts = {1000, 10000, 20000};
+    }
+
+    std::cout << "   ranges   churn   TLSF ns/op  first fit ns/op  "
+                 "free ranges  fragmentation  failed  overlaps"
+              << std::endl;
+
+    for (std::size_t count : counts)
+    {
+        const std::vector<std::uint32_t> sizes{Detail::meshSizes(2 * count)};
+        std::uint64_t total{0};
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            total += sizes[i];
+        }
+        // Room for the live set plus a quarter, as a heap block would have.
+        const std::uint32_t capacity{static_cast<std::uint32_t>(
+            std::min<std::uint64_t>(total + total / 4, 0xffffffffu))};
+        const std::size_t churn{4 * count};
+
+        // The same sequence of frees and sizes for both allocators.
+        std::mt19937 engine{17};
+        std::vector<std::size_t> victims(churn);
+        for (std::size_t i{0}; i < churn; ++i)
+        {
+            victims[i] = engine() % count;
+        }
+
+        Model::OffsetAllocator tlsf{capacity};
+        std::vector<Detail::Live> live;
+        std::size_t failed{0};
+        Performance::Stopwatch stopwatch;
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            const Model::OffsetAllocator::Allocation allocation{
+                tlsf.allocate(sizes[i])};
+            live.push_back(Detail::Live{allocation.offset, sizes[i],
+                                        allocation});
+        }
+        for (std::size_t i{0}; i < churn; ++i)
+        {
+            Detail::Live &victim{live[victims[i]]};
+            if (victim.allocation.node != Model::OffsetAllocator::noNode)
+            {
+                tlsf.free(victim.allocation);
+            }
+            const std::uint32_t size{sizes[count + i % count]};
+            victim.allocation = tlsf.allocate(size);
+            victim.offset = victim.allocation.offset;
+            victim.size = size;
+            failed += victim.allocation.node == Model::OffsetAllocator::noNode
+                          ? 1
+                          : 0;
+        }
+        const double tlsfNanoseconds{stopwatch.elapsedMilliseconds() * 1e6 /
+                                     static_cast<double>(count + 2 * churn)};
+
+        live.erase(std::remove_if(live.begin(), live.end(),
+                                  [](const Detail::Live &range) {
+                                      return range.allocation.node ==
+                                             Model::OffsetAllocator::noNode;
+                                  }),
+                   live.end());
+        const bool overlapping{Detail::overlaps(live, capacity)};
+        const Model::OffsetAllocator::Statistics statistics{
+            tlsf.statistics()};
+
+        Detail::FirstFitAllocator firstFit{capacity};
+        std::vector<std::pair<std::uint32_t, std::uint32_t>> ranges;
+        stopwatch.restart();
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            ranges.emplace_back(firstFit.allocate(sizes[i]), sizes[i]);
+        }
+        for (std::size_t i{0}; i < churn; ++i)
+        {
+            std::pair<std::uint32_t, std::uint32_t> &victim{
+                ranges[victims[i]]};
+            if (victim.first != Detail::FirstFitAllocator::failed)
+            {
+                firstFit.free(victim.first, victim.second);
+            }
+            victim.second = sizes[count + i % count];
+            victim.first = firstFit.allocate(victim.second);
+        }
+        const double firstFitNanoseconds{
+            stopwatch.elapsedMilliseconds() * 1e6 /
+            static_cast<double>(count + 2 * churn)};
+
+        std::cout << std::setw(9) << count << std::setw(8) << churn
+                  << std::fixed << std::setprecision(1) << std::setw(13)
+                  << tlsfNanoseconds << std::setw(17) << firstFitNanoseconds
+                  << std::setw(13) << statistics.freeRangeCount
+                  << std::setw(14) << std::setprecision(3)
+                  << (statistics.freeSize
+                          ? 1.0 - static_cast<double>(
+                                      statistics.largestFreeRange) /
+                                      statistics.freeSize
+                          : 0.0)
+                  << std::setw(8) << failed << std::setw(10)
+                  << (overlapping ? "yes" : "no") << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include "OpenGL/OpenGLStateCache.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace Detail
+{
+
+std::size_t driverCalls{0};
+
+void APIENTRY useProgram(GLuint) { ++driverCalls; }
+
+void APIENTRY bindVertexArray(GLuint) { ++driverCalls; }
+
+void APIENTRY activeTexture(GLenum) { ++driverCalls; }
+
+void APIENTRY bindTexture(GLenum, GLuint) { ++driverCalls; }
+
+void APIENTRY bindBufferRange(GLenum, GLuint, GLuint, GLintptr, GLsizeiptr)
+{
+    ++driverCalls;
+}
+
+void APIENTRY enable(GLenum) { ++driverCalls; }
+
+void APIENTRY polygonMode(GLenum, GLenum) { ++driverCalls; }
+
+void APIENTRY drawElements(GLenum, GLsizei, GLenum, const void *)
+{
+    ++driverCalls;
+}
+
+void installStubs()
+{
+    glad_glUseProgram = useProgram;
+    glad_glBindVertexArray = bindVertexArray;
+    glad_glActiveTexture = activeTexture;
+    glad_glBindTexture = bindTexture;
+    glad_glBindBufferRange = bindBufferRange;
+    glad_glEnable = enable;
+    glad_glPolygonMode = polygonMode;
+    glad_glDrawElements = drawElements;
+}
+
+struct Draw
+{
+    GLuint program;
+    GLuint vertexArray;
+    GLuint texture;
+};
+
+// Models of a few programs and textures, sorted by both as a renderer would,
+// each drawn once per placement.
+std::vector<Draw> makeDraws(std::size_t modelCount, std::size_t placements)
+{
+    constexpr GLuint programCount{2};
+    constexpr GLuint textureCount{8};
+
+    std::vector<Draw> draws;
+    draws.reserve(modelCount * placements);
+    for (std::size_t model{0}; model < modelCount; ++model)
+    {
+        const GLuint bucket{static_cast<GLuint>(model * programCount *
+                                                textureCount / modelCount)};
+        for (std::size_t placement{0}; placement < placements; ++placement)
+        {
+            draws.push_back(Draw{1 + bucket / textureCount,
+                                 static_cast<GLuint>(1 + model),
+                                 1 + bucket % textureCount});
+        }
+    }
+    return draws;
+}
+
+// What Mesh::draw did: bind everything, draw, release the vertex array.
+void drawDirect(const std::vector<Draw> &draws)
+{
+    glEnable(GL_DEPTH_TEST);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    for (std::size_t i{0}; i < draws.size(); ++i)
+    {
+        const Draw &draw{draws[i]};
+        glUseProgram(draw.program);
+        glBindBufferRange(GL_UNIFORM_BUFFER, 1, 1,
+                          static_cast<GLintptr>(256 * i), 112);
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(draw.vertexArray);
+        glBindTexture(GL_TEXTURE_2D, draw.texture);
+        glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, nullptr);
+        glBindVertexArray(0);
+    }
+}
+
+void drawCached(const std::vector<Draw> &draws)
+{
+    OpenGL::OpenGLStateCache::setDepthTest(true);
+    OpenGL::OpenGLStateCache::setPolygonMode(GL_FILL);
+    for (std::size_t i{0}; i < draws.size(); ++i)
+    {
+        const Draw &draw{draws[i]};
+        OpenGL::OpenGLStateCache::useProgram(draw.program);
+        OpenGL::OpenGLStateCache::bindBufferRange(
+            GL_UNIFORM_BUFFER, 1, 1, static_cast<GLintptr>(256 * i), 112);
+        OpenGL::OpenGLStateCache::bindVertexArray(draw.vertexArray);
+        OpenGL::OpenGLStateCache::bindTexture(0, draw.texture);
+        glDrawElements(GL_TRIANGLES, 3, GL_UNSIGNED_INT, nullptr);
+    }
+    OpenGL::OpenGLStateCache::endFrame();
+}
+
+void report(const char *name, double milliseconds, std::size_t frames)
+{
+    std::cout << std::setw(8) << name << std::fixed << std::setprecision(3)
+              << std::setw(12) << milliseconds / static_cast<double>(frames)
+              << std::setw(16) << driverCalls / frames << std::endl;
+    driverCalls = 0;
+}
+
+} // namespace Detail
+
+// Draws the given number of models (10k by default; the first argument
+// changes it, in thousands) in the given number of placements each (4 by
+// default), once binding state the way Mesh::draw used to and once through
+// OpenGLStateCache. The OpenGL entry points are stubs that count calls, so
+// the times are the CPU side only.
+int main(int argc, char *argv[])
+{
+    const std::size_t modelCount{
+        argc > 1 ? static_cast<std::size_t>(std::atof(argv[1]) * 1e3)
+                 : 10000};
+    const std::size_t placements{
+        argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : 4};
+    const std::size_t frames{20};
+
+    Detail::installStubs();
+    const std::vector<Detail::Draw> draws{
+        Detail::makeDraws(modelCount ? modelCount : 1, placements)};
+
+    std::cout << draws.size() << " draws a frame" << std::endl;
+    std::cout << "    path    ms/frame  GL calls/frame" << std::endl;
+
+    Performance::Stopwatch stopwatch;
+    for (std::size_t frame{0}; frame < frames; ++frame)
+    {
+        Detail::drawDirect(draws);
+    }
+    Detail::report("direct", stopwatch.elapsedMilliseconds(), frames);
+
+    stopwatch.restart();
+    for (std::size_t frame{0}; frame < frames; ++frame)
+    {
+        Detail::drawCached(draws);
+    }
+    Detail::report("cached", stopwatch.elapsedMilliseconds(), frames);
+
+    const OpenGL::OpenGLStateCache::Statistics &statistics{
+        OpenGL::OpenGLStateCache::statistics()};
+    std::cout << "Cache, last frame: " << statistics.issuedCount
+              << " issued, " << statistics.filteredCount << " filtered"
+              << std::endl;
+
+    return 0;
+}
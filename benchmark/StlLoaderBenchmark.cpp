@@ -0,0 +1,182 @@
+#include "Model/StlLoader.hpp"
+#include "Utils/Parallel/ParallelFor.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace Detail
+{
+
+void appendUnsigned(std::vector<char> &buffer, std::uint32_t value);
+void appendFloat(std::vector<char> &buffer, float value);
+bool writeSyntheticStl(const char *fileName, std::size_t triangleCount);
+
+void appendUnsigned(std::vector<char> &buffer, std::uint32_t value)
+{
+    for (int i{0}; i < 4; ++i)
+    {
+        buffer.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+void appendFloat(std::vector<char> &buffer, float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    appendUnsigned(buffer, bits);
+}
+
+// Writes a rippled square grid as binary STL, two triangles per cell. Rows
+// of cells are streamed out so that the generator itself stays small.
+bool writeSyntheticStl(const char *fileName, std::size_t triangleCount)
+{
+    const std::size_t side{static_cast<std::size_t>(
+        std::ceil(std::sqrt(static_cast<double>(triangleCount) / 2.0)))};
+    const std::size_t cellCount{triangleCount / 2};
+
+    std::ofstream file{fileName, std::ios::binary};
+    if (!file)
+    {
+        return false;
+    }
+
+    std::vector<char> buffer(80, '\0');
+    appendUnsigned(buffer, static_cast<std::uint32_t>(2 * cellCount));
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    const auto height = [](std::size_t x, std::size_t y) {
+        return static_cast<float>(std::sin(0.1 * static_cast<double>(x)) *
+                                  std::cos(0.1 * static_cast<double>(y)));
+    };
+
+    for (std::size_t cell{0}; cell < cellCount;)
+    {
+        buffer.clear();
+        for (std::size_t row{cell / side}; cell < cellCount && cell / side == row;
+             ++cell)
+        {
+            const std::size_t x{cell % side};
+            const std::size_t y{cell / side};
+            const float corners[4][3]{
+                {static_cast<float>(x), static_cast<float>(y), height(x, y)},
+                {static_cast<float>(x + 1), static_cast<float>(y),
+                 height(x + 1, y)},
+                {static_cast<float>(x + 1), static_cast<float>(y + 1),
+                 height(x + 1, y + 1)},
+                {static_cast<float>(x), static_cast<float>(y + 1),
+                 height(x, y + 1)}};
+            const int triangles[2][3]{{0, 1, 2}, {0, 2, 3}};
+
+            for (const auto &triangle : triangles)
+            {
+                // Leave the stored normal zero, as many exporters do.
+                for (int i{0}; i < 3; ++i)
+                {
+                    appendFloat(buffer, 0.0f);
+                }
+                for (int corner : triangle)
+                {
+                    for (float value : corners[corner])
+                    {
+                        appendFloat(buffer, value);
+                    }
+                }
+                buffer.push_back('\0');
+                buffer.push_back('\0');
+            }
+        }
+        file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    }
+
+    return static_cast<bool>(file);
+}
+
+} // namespace Detail
+
+// Loads an STL file with 1..N threads and reports triangles per second. With
+// --generate it first writes a synthetic binary STL of the given size in
+// millions of triangles.
+int main(int argc, char *argv[])
+{
+    if (argc <= 1)
+    {
+        std::cerr << "Expect: " << argv[0]
+                  << " [model name] [max thread count] [repeat count]\n"
+                  << "    or: " << argv[0]
+                  << " --generate [million triangles] [model name] "
+                     "[max thread count] [repeat count]"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    int argument{1};
+    if (std::string{argv[1]} == "--generate")
+    {
+        if (argc <= 3)
+        {
+            std::cerr << "--generate needs a size and a file name" << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        const double millions{std::atof(argv[2])};
+        const std::size_t triangleCount{
+            static_cast<std::size_t>(millions * 1e6)};
+        std::cout << "Writing " << triangleCount << " triangles to "
+                  << argv[3] << std::endl;
+        if (!Detail::writeSyntheticStl(argv[3], triangleCount))
+        {
+            std::cerr << "Cannot write " << argv[3] << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        argument = 3;
+    }
+
+    const char *model{argv[argument]};
+    const unsigned int maxThreadCount{
+        argc > argument + 1
+            ? static_cast<unsigned int>(std::atoi(argv[argument + 1]))
+            : Parallel::HardwareThreadCount()};
+    const int repeat{argc > argument + 2 ? std::atoi(argv[argument + 2]) : 3};
+
+    std::cout << "threads      ms  Mtriangles/s  vertices  peak RSS MiB"
+              << std::endl;
+
+    for (unsigned int threadCount{1}; threadCount <= maxThreadCount;
+         ++threadCount)
+    {
+        Model::StlLoader loader{threadCount};
+        Model::MeshData meshData;
+        double best{0.0};
+
+        for (int i{0}; i < repeat; ++i)
+        {
+            if (!loader.load(model, meshData))
+            {
+                std::cerr << "[Error]" << loader.errorMessage() << std::endl;
+                exit(EXIT_FAILURE);
+            }
+
+            const double milliseconds{loader.statistics().loadMilliseconds};
+            best = (i == 0 || milliseconds < best) ? milliseconds : best;
+        }
+
+        const Model::StlLoader::Statistics &statistics{loader.statistics()};
+        std::cout << std::setw(7) << threadCount << std::setw(8)
+                  << std::fixed << std::setprecision(1) << best
+                  << std::setw(14) << std::setprecision(2)
+                  << static_cast<double>(statistics.triangleCount) /
+                         (best * 1e3)
+                  << std::setw(10) << statistics.vertexCount << std::setw(14)
+                  << statistics.peakResidentSetSize / (1024 * 1024)
+                  << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,387 @@
+#include "Model/UniformBlocks.hpp"
+#include "OpenGL/OpenGLShaderProgram.hpp"
+#include "OpenGL/OpenGLUniformBuffer.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace Detail
+{
+
+// Stands in for the driver: the active uniforms the mesh shader had before
+// it read the Camera and Object blocks, plus the lighting and material
+// uniforms a larger shader would have.
+const char *const activeUniforms[]{
+    "mvp",
+    "positionOffset",
+    "positionScale",
+    "textureCoordinateOffset",
+    "textureCoordinateScale",
+    "octahedralNormals",
+    "instanced",
+    "model",
+    "view",
+    "projection",
+    "lightPosition",
+    "lightColor",
+    "ambient",
+    "diffuse",
+    "specular",
+    "shininess"};
+constexpr GLint activeUniformCount{
+    static_cast<GLint>(sizeof(activeUniforms) / sizeof(activeUniforms[0]))};
+
+std::size_t locationQueries{0};
+std::size_t uniformCalls{0};
+
+GLuint APIENTRY createProgram() { return 1; }
+
+void APIENTRY linkProgram(GLuint) {}
+
+void APIENTRY deleteProgram(GLuint) {}
+
+void APIENTRY getProgramiv(GLuint, GLenum name, GLint *value)
+{
+    switch (name)
+    {
+    case GL_ACTIVE_UNIFORMS:
+        *value = activeUniformCount;
+        break;
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+        *value = 64;
+        break;
+    default:
+        *value = GL_TRUE;
+        break;
+    }
+}
+
+void APIENTRY getActiveUniform(GLuint, GLuint index, GLsizei bufferSize,
+                               GLsizei *length, GLint *size, GLenum *type,
+                               GLchar *name)
+{
+    std::strncpy(name, activeUniforms[index],
+                 static_cast<std::size_t>(bufferSize));
+    *length = static_cast<GLsizei>(std::strlen(name));
+    *size = 1;
+    *type = GL_FLOAT;
+}
+
+// A driver looks names up by string as well; a linear scan over a shader
+// this size is about what that costs.
+GLint APIENTRY getUniformLocation(GLuint, const GLchar *name)
+{
+    ++locationQueries;
+    for (GLint i{0}; i < activeUniformCount; ++i)
+    {
+        if (std::strcmp(activeUniforms[i], name) == 0)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void APIENTRY uniform1i(GLint, GLint) { ++uniformCalls; }
+
+void APIENTRY uniformFloats(GLint, GLsizei, const GLfloat *)
+{
+    ++uniformCalls;
+}
+
+void APIENTRY uniformMatrix(GLint, GLsizei, GLboolean, const GLfloat *)
+{
+    ++uniformCalls;
+}
+
+void APIENTRY genBuffers(GLsizei, GLuint *buffers) { *buffers = 1; }
+
+void APIENTRY deleteBuffers(GLsizei, const GLuint *) {}
+
+void APIENTRY bindBuffer(GLenum, GLuint) { ++uniformCalls; }
+
+void APIENTRY bufferData(GLenum, GLsizeiptr, const void *, GLenum)
+{
+    ++uniformCalls;
+}
+
+void APIENTRY bufferSubData(GLenum, GLintptr, GLsizeiptr, const void *)
+{
+    ++uniformCalls;
+}
+
+void APIENTRY bindBufferRange(GLenum, GLuint, GLuint, GLintptr, GLsizeiptr)
+{
+    ++uniformCalls;
+}
+
+// The uniform buffer offset alignment of most desktop drivers.
+void APIENTRY getIntegerv(GLenum, GLint *value) { *value = 256; }
+
+void installStubs()
+{
+    glad_glCreateProgram = createProgram;
+    glad_glLinkProgram = linkProgram;
+    glad_glDeleteProgram = deleteProgram;
+    glad_glGetProgramiv = getProgramiv;
+    glad_glGetActiveUniform = getActiveUniform;
+    glad_glGetUniformLocation = getUniformLocation;
+    glad_glUniform1i = uniform1i;
+    glad_glUniform2fv = uniformFloats;
+    glad_glUniform3fv = uniformFloats;
+    glad_glUniformMatrix4fv = uniformMatrix;
+    glad_glGenBuffers = genBuffers;
+    glad_glDeleteBuffers = deleteBuffers;
+    glad_glBindBuffer = bindBuffer;
+    glad_glBufferData = bufferData;
+    glad_glBufferSubData = bufferSubData;
+    glad_glBindBufferRange = bindBufferRange;
+    glad_glGetIntegerv = getIntegerv;
+}
+
+struct MeshUniforms
+{
+    glm::mat4 mvp;
+    glm::vec3 positionOffset;
+    glm::vec3 positionScale;
+    glm::vec2 textureCoordinateOffset;
+    glm::vec2 textureCoordinateScale;
+    bool octahedralNormals;
+    bool instanced;
+};
+
+// Seven uniforms per mesh. Every mesh has its own matrix; the quantization
+// is shared by runs of meshes cut from the same model.
+std::vector<MeshUniforms> makeMeshes(std::size_t count, std::size_t run)
+{
+    std::mt19937 engine{3};
+    std::uniform_real_distribution<float> value{-1.0f, 1.0f};
+    std::vector<MeshUniforms> meshes(count);
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        MeshUniforms &mesh{meshes[i]};
+        mesh.mvp = glm::mat4{1.0f};
+        mesh.mvp[3] = glm::vec4{value(engine), value(engine), value(engine),
+                                1.0f};
+        if (i % run == 0)
+        {
+            mesh.positionOffset = glm::vec3{value(engine)};
+            mesh.positionScale = glm::vec3{value(engine)};
+            mesh.textureCoordinateOffset = glm::vec2{value(engine)};
+            mesh.textureCoordinateScale = glm::vec2{value(engine)};
+            mesh.octahedralNormals = value(engine) > 0.0f;
+        }
+        else
+        {
+            mesh.positionOffset = meshes[i - 1].positionOffset;
+            mesh.positionScale = meshes[i - 1].positionScale;
+            mesh.textureCoordinateOffset =
+                meshes[i - 1].textureCoordinateOffset;
+            mesh.textureCoordinateScale = meshes[i - 1].textureCoordinateScale;
+            mesh.octahedralNormals = meshes[i - 1].octahedralNormals;
+        }
+        mesh.instanced = false;
+    }
+    return meshes;
+}
+
+// What every setValue did before: query the location by name, then set it.
+void setQueried(GLuint program, const MeshUniforms &mesh)
+{
+    OpenGL::Detail::SetMatrix<4, 4>::execute(
+        glGetUniformLocation(program, "mvp"), false, mesh.mvp);
+    OpenGL::Detail::SetVector3<float>::execute(
+        glGetUniformLocation(program, "positionOffset"), mesh.positionOffset);
+    OpenGL::Detail::SetVector3<float>::execute(
+        glGetUniformLocation(program, "positionScale"), mesh.positionScale);
+    OpenGL::Detail::SetVector2<float>::execute(
+        glGetUniformLocation(program, "textureCoordinateOffset"),
+        mesh.textureCoordinateOffset);
+    OpenGL::Detail::SetVector2<float>::execute(
+        glGetUniformLocation(program, "textureCoordinateScale"),
+        mesh.textureCoordinateScale);
+    OpenGL::Detail::SetValue<bool>::execute(
+        glGetUniformLocation(program, "octahedralNormals"),
+        mesh.octahedralNormals);
+    OpenGL::Detail::SetValue<bool>::execute(
+        glGetUniformLocation(program, "instanced"), mesh.instanced);
+}
+
+// Not constant, so the names are hashed when called.
+const char *meshUniformNames[]{"mvp",
+                               "positionOffset",
+                               "positionScale",
+                               "textureCoordinateOffset",
+                               "textureCoordinateScale",
+                               "octahedralNormals",
+                               "instanced"};
+
+void setByString(const OpenGL::OpenGLShaderProgram &program,
+                 const MeshUniforms &mesh)
+{
+    program.setValue<4, 4>(meshUniformNames[0], mesh.mvp, false);
+    program.setValue(meshUniformNames[1], mesh.positionOffset);
+    program.setValue(meshUniformNames[2], mesh.positionScale);
+    program.setValue(meshUniformNames[3], mesh.textureCoordinateOffset);
+    program.setValue(meshUniformNames[4], mesh.textureCoordinateScale);
+    program.setValue(meshUniformNames[5], mesh.octahedralNormals);
+    program.setValue(meshUniformNames[6], mesh.instanced);
+}
+
+constexpr OpenGL::OpenGLUniformName mvpUniform{"mvp"};
+constexpr OpenGL::OpenGLUniformName positionOffsetUniform{"positionOffset"};
+constexpr OpenGL::OpenGLUniformName positionScaleUniform{"positionScale"};
+constexpr OpenGL::OpenGLUniformName textureCoordinateOffsetUniform{
+    "textureCoordinateOffset"};
+constexpr OpenGL::OpenGLUniformName textureCoordinateScaleUniform{
+    "textureCoordinateScale"};
+constexpr OpenGL::OpenGLUniformName octahedralNormalsUniform{
+    "octahedralNormals"};
+constexpr OpenGL::OpenGLUniformName instancedUniform{"instanced"};
+
+// Names hashed at compile time.
+void setByName(const OpenGL::OpenGLShaderProgram &program,
+               const MeshUniforms &mesh)
+{
+    program.setValue<4, 4>(mvpUniform, mesh.mvp, false);
+    program.setValue(positionOffsetUniform, mesh.positionOffset);
+    program.setValue(positionScaleUniform, mesh.positionScale);
+    program.setValue(textureCoordinateOffsetUniform,
+                     mesh.textureCoordinateOffset);
+    program.setValue(textureCoordinateScaleUniform,
+                     mesh.textureCoordinateScale);
+    program.setValue(octahedralNormalsUniform, mesh.octahedralNormals);
+    program.setValue(instancedUniform, mesh.instanced);
+}
+
+// The same values as Object blocks: appended for every mesh, sent by one
+// upload, then bound a range per draw.
+void setByBlocks(Model::ObjectUniformBuffer &objects,
+                 const std::vector<MeshUniforms> &meshes)
+{
+    objects.clear();
+    for (const MeshUniforms &mesh : meshes)
+    {
+        objects.append(Model::ObjectBlock{
+            mesh.mvp, mesh.positionOffset, mesh.octahedralNormals ? 1u : 0u,
+            mesh.positionScale, mesh.instanced ? 1u : 0u,
+            mesh.textureCoordinateOffset, mesh.textureCoordinateScale});
+    }
+    objects.upload();
+    for (std::size_t i{0}; i < meshes.size(); ++i)
+    {
+        objects.bind(i);
+    }
+}
+
+void report(const char *name, double milliseconds, std::size_t frames,
+            std::size_t setCount)
+{
+    std::cout << std::setw(22) << name << std::fixed << std::setprecision(3)
+              << std::setw(12) << milliseconds / static_cast<double>(frames)
+              << std::setw(10) << std::setprecision(1)
+              << milliseconds * 1e6 /
+                     static_cast<double>(frames * setCount)
+              << std::setw(14) << locationQueries / frames << std::setw(12)
+              << uniformCalls / frames << std::endl;
+    locationQueries = 0;
+    uniformCalls = 0;
+}
+
+} // namespace Detail
+
+// Sets the seven mesh uniforms for enough meshes to make about 100k
+// setValue calls a frame (by default; the first argument changes it), with
+// the quantization shared by runs of the given length (16 by default), by
+// querying locations the way setValue used to and through the uniform table
+// of OpenGLShaderProgram with run-time and compile-time hashed names, and
+// as Object blocks of one uniform buffer. The OpenGL entry points are
+// stubs, so the times are the CPU side only, and the blocks take the
+// orphaning upload of a context without glBufferStorage.
+//
+// The renderer draws with the blocks: its shaders read every per-draw value
+// from the Object block, and the only uniform it sets through the table is
+// the sampler of each program, once at link time. The table rows measure a
+// program that still sets its per-draw uniforms one by one.
+int main(int argc, char *argv[])
+{
+    const std::size_t setCount{
+        argc > 1 ? static_cast<std::size_t>(std::atof(argv[1]) * 1e3)
+                 : 100000};
+    const std::size_t run{
+        argc > 2 ? static_cast<std::size_t>(std::atoi(argv[2])) : 16};
+    const std::size_t frames{20};
+
+    Detail::installStubs();
+    const std::vector<Detail::MeshUniforms> meshes{
+        Detail::makeMeshes(setCount / 7, run ? run : 1)};
+
+    OpenGL::OpenGLShaderProgram program;
+    program.link();
+
+    std::cout << meshes.size() * 7 << " setValue calls a frame, "
+              << program.statistics().uniformCount << " active uniforms"
+              << std::endl;
+    std::cout << "                  path    ms/frame   ns/call  "
+                 "queries/frame  GL calls/frame"
+              << std::endl;
+
+    Performance::Stopwatch stopwatch;
+    for (std::size_t frame{0}; frame < frames; ++frame)
+    {
+        for (const Detail::MeshUniforms &mesh : meshes)
+        {
+            Detail::setQueried(program.id(), mesh);
+        }
+    }
+    Detail::report("location per call", stopwatch.elapsedMilliseconds(),
+                   frames, meshes.size() * 7);
+
+    stopwatch.restart();
+    for (std::size_t frame{0}; frame < frames; ++frame)
+    {
+        for (const Detail::MeshUniforms &mesh : meshes)
+        {
+            Detail::setByString(program, mesh);
+        }
+    }
+    Detail::report("table, run-time hash", stopwatch.elapsedMilliseconds(),
+                   frames, meshes.size() * 7);
+
+    stopwatch.restart();
+    for (std::size_t frame{0}; frame < frames; ++frame)
+    {
+        for (const Detail::MeshUniforms &mesh : meshes)
+        {
+            Detail::setByName(program, mesh);
+        }
+    }
+    Detail::report("table, constexpr hash", stopwatch.elapsedMilliseconds(),
+                   frames, meshes.size() * 7);
+
+    Model::ObjectUniformBuffer objects{Model::objectBlockBinding};
+    stopwatch.restart();
+    for (std::size_t frame{0}; frame < frames; ++frame)
+    {
+        Detail::setByBlocks(objects, meshes);
+    }
+    Detail::report("object blocks", stopwatch.elapsedMilliseconds(), frames,
+                   meshes.size() * 7);
+
+    const OpenGL::OpenGLShaderProgram::Statistics statistics{
+        program.statistics()};
+    std::cout << "Table: " << statistics.updateCount << " updates, "
+              << statistics.skippedCount << " skipped, "
+              << statistics.unknownCount << " unknown" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,232 @@
+#include "Model/MeshData.hpp"
+#include "Model/VertexLayout.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Detail
+{
+
+using Model::NormalAttribute;
+using Model::PositionAttribute;
+using Model::TextureCoordinateAttribute;
+
+using Interleaved =
+    Model::InterleavedLayout<PositionAttribute, NormalAttribute,
+                             TextureCoordinateAttribute>;
+
+// Regular grid of about vertexCount vertices with every stream, indexed in
+// row order the way a well ordered mesh is drawn.
+Model::MeshData makeGrid(std::size_t vertexCount)
+{
+    const std::size_t width{static_cast<std::size_t>(
+        std::sqrt(static_cast<double>(vertexCount)))};
+
+    Model::MeshData meshData;
+    for (std::size_t y{0}; y < width; ++y)
+    {
+        for (std::size_t x{0}; x < width; ++x)
+        {
+            const float u{static_cast<float>(x) / static_cast<float>(width)};
+            const float v{static_cast<float>(y) / static_cast<float>(width)};
+            meshData.positions.insert(meshData.positions.end(),
+                                      {u, std::sin(u * v), v});
+            meshData.normals.insert(meshData.normals.end(),
+                                    {0.0f, 1.0f, 0.0f});
+            meshData.textureCoordinates.insert(
+                meshData.textureCoordinates.end(), {u, v});
+        }
+    }
+
+    for (std::size_t y{0}; y + 1 < width; ++y)
+    {
+        for (std::size_t x{0}; x + 1 < width; ++x)
+        {
+            const unsigned int a{static_cast<unsigned int>(y * width + x)};
+            const unsigned int b{a + 1};
+            const unsigned int c{static_cast<unsigned int>(a + width)};
+            const unsigned int d{c + 1};
+            meshData.indices.insert(meshData.indices.end(),
+                                    {a, b, d, a, d, c});
+        }
+    }
+
+    return meshData;
+}
+
+// Same triangles in random order, which defeats the caches the way an
+// unoptimized mesh does.
+std::vector<unsigned int> shuffleTriangles(std::vector<unsigned int> indices)
+{
+    std::vector<std::size_t> order(indices.size() / 3);
+    for (std::size_t i{0}; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::shuffle(order.begin(), order.end(), std::mt19937{12345});
+
+    std::vector<unsigned int> shuffled(indices.size());
+    for (std::size_t i{0}; i < order.size(); ++i)
+    {
+        std::copy(indices.begin() + 3 * order[i],
+                  indices.begin() + 3 * order[i] + 3,
+                  shuffled.begin() + 3 * i);
+    }
+    return shuffled;
+}
+
+float load(const unsigned char *p) noexcept
+{
+    float value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+// The attribute reads a vertex shader does for each index: every stream for
+// the shading pass, positions only for a depth pass.
+double fetchInterleaved(const std::vector<unsigned char> &vertices,
+                        const std::vector<unsigned int> &indices,
+                        bool positionsOnly)
+{
+    constexpr std::size_t stride{Interleaved::stride};
+    constexpr std::size_t normalOffset{
+        Interleaved::offset<NormalAttribute>()};
+    constexpr std::size_t textureOffset{
+        Interleaved::offset<TextureCoordinateAttribute>()};
+
+    double sum{0.0};
+    for (const unsigned int index : indices)
+    {
+        const unsigned char *vertex{vertices.data() + stride * index};
+        float value{load(vertex) + load(vertex + 4) + load(vertex + 8)};
+        if (!positionsOnly)
+        {
+            value += load(vertex + normalOffset) +
+                     load(vertex + normalOffset + 4) +
+                     load(vertex + normalOffset + 8) +
+                     load(vertex + textureOffset) +
+                     load(vertex + textureOffset + 4);
+        }
+        sum += static_cast<double>(value);
+    }
+    return sum;
+}
+
+double fetchSplit(const Model::MeshData &meshData,
+                  const std::vector<unsigned int> &indices, bool positionsOnly)
+{
+    const float *positions{meshData.positions.data()};
+    const float *normals{meshData.normals.data()};
+    const float *textureCoordinates{meshData.textureCoordinates.data()};
+
+    double sum{0.0};
+    for (const unsigned int index : indices)
+    {
+        float value{positions[3 * index] + positions[3 * index + 1] +
+                    positions[3 * index + 2]};
+        if (!positionsOnly)
+        {
+            value += normals[3 * index] + normals[3 * index + 1] +
+                     normals[3 * index + 2] + textureCoordinates[2 * index] +
+                     textureCoordinates[2 * index + 1];
+        }
+        sum += static_cast<double>(value);
+    }
+    return sum;
+}
+
+void report(const char *layout, const char *order, const char *pass,
+            std::size_t fetches, double milliseconds, double checksum)
+{
+    std::cout << std::setw(12) << layout << std::setw(10) << order
+              << std::setw(11) << pass << std::setw(12) << fetches
+              << std::setw(10) << std::fixed << std::setprecision(1)
+              << milliseconds << std::setw(10) << std::setprecision(1)
+              << static_cast<double>(fetches) / milliseconds / 1000.0
+              << std::setw(14) << std::setprecision(0) << checksum
+              << std::endl;
+}
+
+} // namespace Detail
+
+// Vertex fetch throughput of the interleaved and split layouts over grids of
+// the given sizes (in millions of vertices). Fetches are emulated on the CPU
+// through the layout offsets, in draw order and in shuffled triangle order,
+// for a full shading pass and for a positions only pass.
+int main(int argc, char *argv[])
+{
+    std::vector<std::size_t> sizes;
+    for (int i{1}; i < argc; ++i)
+    {
+        sizes.push_back(static_cast<std::size_t>(std::atof(argv[i]) * 1e6));
+    }
+    if (sizes.empty())
+    {
+        sizes = {1000000, 4000000, 16000000};
+    }
+
+    std::cout << "Interleaved stride " << Detail::Interleaved::stride
+              << " bytes, split streams 12 + 12 + 8 bytes" << std::endl;
+
+    for (std::size_t size : sizes)
+    {
+        const Model::MeshData meshData{Detail::makeGrid(size)};
+        const Model::MeshView view{meshData.view()};
+
+        std::vector<unsigned char> interleaved(Detail::Interleaved::stride *
+                                               view.vertexCount);
+        Performance::Stopwatch packStopwatch;
+        Detail::Interleaved::pack(view, Model::VertexQuantization::identity(),
+                                  interleaved.data());
+        std::cout << std::endl
+                  << view.vertexCount << " vertices, " << view.indexCount / 3
+                  << " triangles, packed in " << std::fixed
+                  << std::setprecision(1)
+                  << packStopwatch.elapsedMilliseconds() << " ms" << std::endl;
+        std::cout << "      layout     order       pass     fetches        ms"
+                     "  Mfetch/s      checksum"
+                  << std::endl;
+
+        const std::vector<unsigned int> shuffled{
+            Detail::shuffleTriangles(meshData.indices)};
+
+        const struct
+        {
+            const char *name;
+            const std::vector<unsigned int> &indices;
+        } orders[]{{"draw", meshData.indices}, {"shuffled", shuffled}};
+
+        for (const auto &order : orders)
+        {
+            for (const bool positionsOnly : {false, true})
+            {
+                const char *pass{positionsOnly ? "positions" : "all"};
+
+                Performance::Stopwatch interleavedStopwatch;
+                const double interleavedSum{Detail::fetchInterleaved(
+                    interleaved, order.indices, positionsOnly)};
+                Detail::report("interleaved", order.name, pass,
+                               order.indices.size(),
+                               interleavedStopwatch.elapsedMilliseconds(),
+                               interleavedSum);
+
+                Performance::Stopwatch splitStopwatch;
+                const double splitSum{Detail::fetchSplit(
+                    meshData, order.indices, positionsOnly)};
+                Detail::report("split", order.name, pass,
+                               order.indices.size(),
+                               splitStopwatch.elapsedMilliseconds(), splitSum);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include "Model/Detail/VertexWeldTable.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace Detail
+{
+
+using Model::Detail::VertexKey;
+using Model::Detail::VertexWeldTable;
+
+struct KeyLess
+{
+    bool operator()(const VertexKey &lhs, const VertexKey &rhs) const noexcept
+    {
+        return std::tie(lhs.position, lhs.textureCoordinate, lhs.normal) <
+               std::tie(rhs.position, rhs.textureCoordinate, rhs.normal);
+    }
+};
+
+// Corners of a triangulated grid in face order, the way an OBJ export of a
+// regular surface references its vertices.
+std::vector<VertexKey> makeGridCorners(std::size_t cornerCount)
+{
+    const std::size_t cells{static_cast<std::size_t>(
+        std::sqrt(static_cast<double>(cornerCount) / 6.0))};
+    const std::size_t width{cells + 1};
+
+    std::vector<VertexKey> corners;
+    corners.reserve(6 * cells * cells);
+
+    for (std::size_t y{0}; y < cells; ++y)
+    {
+        for (std::size_t x{0}; x < cells; ++x)
+        {
+            const std::int32_t a{static_cast<std::int32_t>(y * width + x)};
+            const std::int32_t b{a + 1};
+            const std::int32_t c{static_cast<std::int32_t>(a + width)};
+            const std::int32_t d{c + 1};
+
+            for (std::int32_t corner : {a, b, d, a, d, c})
+            {
+                corners.push_back(VertexKey{corner, corner, corner});
+            }
+        }
+    }
+
+    return corners;
+}
+
+void report(const char *name, std::size_t corners, std::size_t unique,
+            double milliseconds)
+{
+    std::cout << std::setw(14) << name << std::setw(12) << corners
+              << std::setw(12) << unique << std::setw(10) << std::fixed
+              << std::setprecision(1) << milliseconds << std::setw(10)
+              << std::setprecision(1)
+              << static_cast<double>(unique) / milliseconds / 1000.0
+              << std::setw(10)
+              << static_cast<double>(corners) / milliseconds / 1000.0
+              << std::endl;
+}
+
+} // namespace Detail
+
+// Welds synthetic corner streams of the given sizes (in millions) with the
+// std::map scheme tinyobj uses and with VertexWeldTable.
+int main(int argc, char *argv[])
+{
+    std::vector<std::size_t> sizes;
+    for (int i{1}; i < argc; ++i)
+    {
+        sizes.push_back(static_cast<std::size_t>(std::atof(argv[i]) * 1e6));
+    }
+    if (sizes.empty())
+    {
+        sizes = {1000000, 5000000, 10000000, 50000000};
+    }
+
+    std::cout << "         table     corners      unique        ms  "
+                 "Muniq/s  Mcorn/s"
+              << std::endl;
+
+    for (std::size_t size : sizes)
+    {
+        const std::vector<Detail::VertexKey> corners{
+            Detail::makeGridCorners(size)};
+        std::vector<unsigned int> indices(corners.size());
+
+        {
+            Performance::Stopwatch stopwatch;
+            std::map<Detail::VertexKey, unsigned int, Detail::KeyLess> map;
+            for (std::size_t i{0}; i < corners.size(); ++i)
+            {
+                const auto result = map.emplace(
+                    corners[i], static_cast<unsigned int>(map.size()));
+                indices[i] = result.first->second;
+            }
+            Detail::report("std::map", corners.size(), map.size(),
+                           stopwatch.elapsedMilliseconds());
+        }
+
+        {
+            Performance::Stopwatch stopwatch;
+            Detail::VertexWeldTable table{
+                Detail::VertexWeldTable::estimateVertexCount(
+                    corners.size() / 6, corners.size() / 3)};
+            bool inserted;
+            for (std::size_t i{0}; i < corners.size(); ++i)
+            {
+                indices[i] = table.insert(corners[i], inserted);
+            }
+            Detail::report("weld table", corners.size(), table.size(),
+                           stopwatch.elapsedMilliseconds());
+        }
+    }
+
+    return 0;
+}
@@ -1,63 +1,88 @@
-#include "OpenGLWindow.hpp"
-
-#include "glm/vec2.hpp"
-
-#include <iostream>
-#include <memory>
-#include <stdexcept>
-#include <string>
-
-int main(int argc, char *argv[])
-{
-    if (argc <= 4)
-    {
-        std::cerr << "Not enough parameter\n";
-        std::cerr << "Expect: " << argv[0]
-                  << "[model name] [texture name] [vertex shader file name] "
-                     "[fragment shader file name]"
-                  << std::endl;
-        exit(EXIT_FAILURE);
-    }
-
-    std::string model{argv[1]};
-    std::string texture{argv[2]};
-    std::string vertexShader{argv[3]};
-    std::string fragmentShader{argv[4]};
-
-    std::cout << "Vertex Shader: " << vertexShader << "\n"
-              << "Fragment Shader: " << fragmentShader << "\n"
-              << "Model: " << model << "\n"
-              << "Texture: " << texture << std::endl;
-
-    std::unique_ptr<OpenGLWindow> window{nullptr};
-
-    try
-    {
-        window.reset(new OpenGLWindow{glm::ivec2{800, 600}, "Homework01",
-                                      glm::ivec2{3, 3}});
-    }
-    catch (std::runtime_error &e)
-    {
-        std::cerr << e.what() << std::endl;
-        exit(EXIT_FAILURE);
-    }
-
-    OpenGL::OpenGLShaderProgram *shaderProgram{window->addShader(
-        vertexShader.c_str(), fragmentShader.c_str(), nullptr)};
-
-    if (!shaderProgram)
-    {
-        std::cerr << "Failed to compile shader" << std::endl;
-        exit(EXIT_FAILURE);
-    }
-
-    if (!window->addModel(model.c_str(), texture.c_str(), *shaderProgram))
-    {
-        std::cerr << "Failed to add model" << std::endl;
-        exit(EXIT_FAILURE);
-    }
-
-    window->startRender();
-
-    return 0;
-}
+#include "OpenGLWindow.hpp"
+
+#include "glm/vec2.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+int main(int argc, char *argv[])
+{
+    if (argc <= 4)
+    {
+        std::cerr << "Not enough parameter\n";
+        std::cerr << "Expect: " << argv[0]
+                  << "[model name] [texture name] [vertex shader file name] "
+                     "[fragment shader file name] [out-of-core budget MiB] "
+                     "[vertex compression none|unorm16|half] [instances]"
+                  << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string model{argv[1]};
+    std::string texture{argv[2]};
+    std::string vertexShader{argv[3]};
+    std::string fragmentShader{argv[4]};
+    // Without a budget the whole model is loaded.
+    const std::size_t budgetMegabytes{
+        argc > 5 ? static_cast<std::size_t>(std::atoll(argv[5])) : 0};
+    const std::string compressionName{argc > 6 ? argv[6] : "none"};
+    const Model::VertexCompression compression{
+        compressionName == "unorm16" ? Model::VertexCompression::Normalized16
+        : compressionName == "half"  ? Model::VertexCompression::HalfFloat
+                                     : Model::VertexCompression::None};
+    // Draws the model as a grid of instances; not for out-of-core models.
+    const std::size_t instanceCount{
+        argc > 7 ? static_cast<std::size_t>(std::atoll(argv[7])) : 0};
+
+    std::cout << "Vertex Shader: " << vertexShader << "\n"
+              << "Fragment Shader: " << fragmentShader << "\n"
+              << "Model: " << model << "\n"
+              << "Texture: " << texture << std::endl;
+
+    std::unique_ptr<OpenGLWindow> window{nullptr};
+
+    try
+    {
+        window.reset(new OpenGLWindow{glm::ivec2{800, 600}, "Homework01",
+                                      glm::ivec2{3, 3}});
+    }
+    catch (std::runtime_error &e)
+    {
+        std::cerr << e.what() << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    OpenGL::OpenGLShaderProgram *shaderProgram{window->addShader(
+        vertexShader.c_str(), fragmentShader.c_str(), nullptr)};
+
+    if (!shaderProgram)
+    {
+        std::cerr << "Failed to compile shader" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    const bool added{
+        budgetMegabytes
+            ? window->addChunkedModel(model.c_str(), texture.c_str(),
+                                      *shaderProgram,
+                                      budgetMegabytes * 1024 * 1024)
+            : window->addModel(model.c_str(), texture.c_str(), *shaderProgram,
+                               compression)};
+    if (!added)
+    {
+        std::cerr << "Failed to add model" << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (!budgetMegabytes)
+    {
+        window->layOutInstances(instanceCount);
+    }
+
+    window->startRender();
+
+    return 0;
+}
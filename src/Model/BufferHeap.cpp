@@ -0,0 +1,218 @@
+#include "BufferHeap.hpp"
+
+#include "OpenGL/OpenGLStateCache.hpp"
+#include "Utils/Global.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace Model
+{
+
+BufferHeap::Range::Range() noexcept
+    : heap_{nullptr}, buffer_{}, offset_{0}, size_{0}, block_{0},
+      allocation_{0, OffsetAllocator::noNode}
+{
+}
+
+BufferHeap::Range::Range(Range &&other) noexcept
+    : heap_{other.heap_}, buffer_{std::move(other.buffer_)},
+      offset_{other.offset_}, size_{other.size_}, block_{other.block_},
+      allocation_{other.allocation_}
+{
+    other.heap_ = nullptr;
+}
+
+BufferHeap::Range &BufferHeap::Range::operator=(Range &&other) noexcept
+{
+    if (this != &other)
+    {
+        reset();
+        heap_ = other.heap_;
+        buffer_ = std::move(other.buffer_);
+        offset_ = other.offset_;
+        size_ = other.size_;
+        block_ = other.block_;
+        allocation_ = other.allocation_;
+        other.heap_ = nullptr;
+    }
+    return *this;
+}
+
+BufferHeap::Range::~Range() { reset(); }
+
+const std::shared_ptr<BufferHeap::BufferObjectType> &
+BufferHeap::Range::buffer() const noexcept
+{
+    return buffer_;
+}
+
+std::size_t BufferHeap::Range::offset() const noexcept { return offset_; }
+
+void BufferHeap::Range::reset() noexcept
+{
+    if (heap_)
+    {
+        heap_->free(*this);
+    }
+    heap_ = nullptr;
+    buffer_.reset();
+    offset_ = 0;
+    size_ = 0;
+}
+
+std::size_t BufferHeap::Range::size() const noexcept { return size_; }
+
+BufferHeap::BufferHeap(BufferObjectType::Type type, std::size_t blockSize)
+    : type_{type}, blockSize_{blockSize}, blocks_{}
+{
+    PROGRAM_ASSERT(blockSize > 0 &&
+                   blockSize <= std::numeric_limits<std::uint32_t>::max());
+}
+
+// The first block with room; a range is padded by alignment - 1 bytes so
+// its start can be moved to a multiple of alignment. A dedicated block
+// starts at 0, a multiple of any alignment, so it needs no padding.
+BufferHeap::Range BufferHeap::allocate(std::size_t size,
+                                       std::size_t alignment)
+{
+    PROGRAM_ASSERT(size > 0 && alignment > 0);
+
+    const std::size_t padded{size + alignment - 1};
+    if (padded > std::numeric_limits<std::uint32_t>::max())
+    {
+        const std::size_t block{addBlock(size, true)};
+        Range range;
+        range.heap_ = this;
+        range.buffer_ = blocks_[block]->buffer;
+        range.offset_ = 0;
+        range.size_ = size;
+        range.block_ = block;
+        return range;
+    }
+
+    OffsetAllocator::Allocation allocation{0, OffsetAllocator::noNode};
+    std::size_t block{0};
+    for (; block < blocks_.size(); ++block)
+    {
+        if (blocks_[block] && blocks_[block]->allocator)
+        {
+            allocation = blocks_[block]->allocator->allocate(
+                static_cast<std::uint32_t>(padded));
+            if (allocation.node != OffsetAllocator::noNode)
+            {
+                break;
+            }
+        }
+    }
+    if (allocation.node == OffsetAllocator::noNode)
+    {
+        block = addBlock(std::max(padded, blockSize_), false);
+        allocation = blocks_[block]->allocator->allocate(
+            static_cast<std::uint32_t>(padded));
+    }
+
+    Range range;
+    range.heap_ = this;
+    range.buffer_ = blocks_[block]->buffer;
+    range.offset_ = (allocation.offset + alignment - 1) / alignment * alignment;
+    range.size_ = size;
+    range.block_ = block;
+    range.allocation_ = allocation;
+    return range;
+}
+
+// Allocated through the copy target, so creating an index block leaves
+// the element buffer of the bound vertex array object alone. Only a shared
+// block, at most 4 GiB, has an allocator.
+std::size_t BufferHeap::addBlock(std::size_t size, bool dedicated)
+{
+    std::unique_ptr<Block> block{new Block{
+        std::shared_ptr<BufferObjectType>{new BufferObjectType{
+            type_, OpenGL::OpenGLBufferObject::UsagePattern::StaticDraw}},
+        size,
+        dedicated ? nullptr
+                  : std::unique_ptr<OffsetAllocator>{new OffsetAllocator{
+                        static_cast<std::uint32_t>(size)}}}};
+    OpenGL::OpenGLStateCache::bindBuffer(GL_COPY_WRITE_BUFFER,
+                                         block->buffer->id());
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), nullptr,
+                 GL_STATIC_DRAW);
+
+    const auto slot =
+        std::find(blocks_.begin(), blocks_.end(), std::unique_ptr<Block>{});
+    if (slot != blocks_.end())
+    {
+        *slot = std::move(block);
+        return static_cast<std::size_t>(slot - blocks_.begin());
+    }
+    blocks_.push_back(std::move(block));
+    return blocks_.size() - 1;
+}
+
+// An empty block is released unless it is the only one left; a dedicated
+// block is released with its range.
+void BufferHeap::free(Range &range) noexcept
+{
+    std::unique_ptr<Block> &block{blocks_[range.block_]};
+    if (!block->allocator)
+    {
+        block.reset();
+        return;
+    }
+    block->allocator->free(range.allocation_);
+    if (!block->allocator->empty())
+    {
+        return;
+    }
+
+    const std::size_t liveBlocks{static_cast<std::size_t>(
+        std::count_if(blocks_.begin(), blocks_.end(),
+                      [](const std::unique_ptr<Block> &other) {
+                          return other && other->allocator;
+                      }))};
+    if (liveBlocks > 1)
+    {
+        block.reset();
+    }
+}
+
+BufferHeap::Statistics BufferHeap::statistics() const noexcept
+{
+    Statistics statistics{};
+    std::size_t freeBytes{0};
+    std::size_t largestPerBlock{0};
+    for (const std::unique_ptr<Block> &block : blocks_)
+    {
+        if (!block)
+        {
+            continue;
+        }
+        ++statistics.blockCount;
+        if (!block->allocator)
+        {
+            statistics.reservedBytes += block->size;
+            statistics.usedBytes += block->size;
+            ++statistics.rangeCount;
+            continue;
+        }
+        const OffsetAllocator::Statistics allocator{
+            block->allocator->statistics()};
+        statistics.reservedBytes += allocator.capacity;
+        statistics.usedBytes += allocator.usedSize;
+        statistics.rangeCount += allocator.allocationCount;
+        statistics.freeRangeCount += allocator.freeRangeCount;
+        statistics.largestFreeRange = std::max<std::size_t>(
+            statistics.largestFreeRange, allocator.largestFreeRange);
+        freeBytes += allocator.freeSize;
+        largestPerBlock += allocator.largestFreeRange;
+    }
+    statistics.fragmentation =
+        freeBytes ? 1.0 - static_cast<double>(largestPerBlock) /
+                              static_cast<double>(freeBytes)
+                  : 0.0;
+    return statistics;
+}
+
+} // namespace Model
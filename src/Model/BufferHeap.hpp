@@ -0,0 +1,107 @@
+#ifndef HOMEWORK01_MODEL_BUFFERHEAP_HPP_
+#define HOMEWORK01_MODEL_BUFFERHEAP_HPP_
+
+#include "OffsetAllocator.hpp"
+
+#include "OpenGL/OpenGLBufferObject.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Model
+{
+
+struct BufferHeapStatistics
+{
+    std::size_t blockCount;
+    std::size_t reservedBytes;
+    std::size_t usedBytes;
+    std::size_t rangeCount;
+    std::size_t freeRangeCount;
+    std::size_t largestFreeRange;
+    // 1 - largest free range / free bytes over every block: 0 while the free
+    // space of each block is in one piece.
+    double fragmentation;
+};
+
+// Large buffer objects of one type shared by many meshes, handed out as
+// ranges by an OffsetAllocator per block, so thousands of small meshes take
+// a few buffer objects instead of a few each. A request larger than the
+// block size gets a block of its own; a block left empty is released. One
+// beyond the 32-bit offsets of the allocator gets a dedicated buffer object
+// with no allocator, which it fills from offset 0.
+//
+// The heap has to outlive its ranges.
+class BufferHeap
+{
+public:
+    using Statistics = BufferHeapStatistics;
+    using BufferObjectType = OpenGL::OpenGLBufferObject;
+
+    // Bytes of one of the buffer objects, returned to the heap when reset or
+    // destroyed.
+    class Range
+    {
+    public:
+        explicit Range() noexcept;
+        Range(Range &&other) noexcept;
+        Range &operator=(Range &&other) noexcept;
+        ~Range();
+
+        Range(const Range &other) = delete;
+        Range &operator=(const Range &other) = delete;
+
+        void reset() noexcept;
+
+        // Null for an empty range.
+        const std::shared_ptr<BufferObjectType> &buffer() const noexcept;
+        std::size_t offset() const noexcept;
+        std::size_t size() const noexcept;
+
+    private:
+        friend class BufferHeap;
+
+        BufferHeap *heap_;
+        std::shared_ptr<BufferObjectType> buffer_;
+        std::size_t offset_;
+        std::size_t size_;
+        std::size_t block_;
+        OffsetAllocator::Allocation allocation_;
+    };
+
+    explicit BufferHeap(BufferObjectType::Type type,
+                        std::size_t blockSize = std::size_t{64} << 20);
+
+    BufferHeap(const BufferHeap &other) = delete;
+    BufferHeap &operator=(const BufferHeap &other) = delete;
+
+    // The offset is a multiple of alignment, which need not be a power of
+    // two, so a range can start on a whole vertex of any stride.
+    Range allocate(std::size_t size, std::size_t alignment);
+
+    // Walks the free ranges of every block.
+    Statistics statistics() const noexcept;
+
+private:
+    struct Block
+    {
+        std::shared_ptr<BufferObjectType> buffer;
+        std::size_t size;
+        // Null for a dedicated block.
+        std::unique_ptr<OffsetAllocator> allocator;
+    };
+
+    std::size_t addBlock(std::size_t size, bool dedicated);
+    void free(Range &range) noexcept;
+
+    BufferObjectType::Type type_;
+    std::size_t blockSize_;
+    // Released blocks leave a null slot, so ranges keep their block index.
+    std::vector<std::unique_ptr<Block>> blocks_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_BUFFERHEAP_HPP_
@@ -0,0 +1,318 @@
+#include "ChunkedMesh.hpp"
+
+#include "ChunkedMeshBuilder.hpp"
+
+#include "Utils/FileIO/FileStatus.hpp"
+#include "Utils/Hash/Hash.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glm/geometric.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+float distanceToChunk(const ChunkRecord &chunk,
+                      const glm::vec3 &point) noexcept;
+bool validChunk(const ChunkRecord &chunk, std::uint32_t attributes,
+                std::uint64_t fileSize) noexcept;
+
+// Distance from point to the chunk's bounding box, 0 inside it.
+inline float distanceToChunk(const ChunkRecord &chunk,
+                             const glm::vec3 &point) noexcept
+{
+    const glm::vec3 minimum{chunk.boundsMinimum[0], chunk.boundsMinimum[1],
+                            chunk.boundsMinimum[2]};
+    const glm::vec3 maximum{chunk.boundsMaximum[0], chunk.boundsMaximum[1],
+                            chunk.boundsMaximum[2]};
+    const glm::vec3 outside{glm::max(minimum - point, point - maximum)};
+    return glm::length(glm::max(outside, 0.0f));
+}
+
+inline bool validChunk(const ChunkRecord &chunk, std::uint32_t attributes,
+                       std::uint64_t fileSize) noexcept
+{
+    return chunk.offset % chunkAlignment == 0 && chunk.offset <= fileSize &&
+           chunk.size <= fileSize - chunk.offset &&
+           chunk.size ==
+               chunkLayout(attributes, chunk.vertexCount, chunk.indexCount)
+                   .size;
+}
+
+} // namespace Detail
+
+ChunkedMesh::ChunkedMesh(ShaderProgramType &shaderProgram,
+                         TextureType *texture, std::size_t budgetBytes,
+                         std::size_t pageInsPerUpdate)
+    : shaderProgram_{&shaderProgram}, texture_{texture},
+      pageInsPerUpdate_{std::max<std::size_t>(pageInsPerUpdate, 1)},
+      file_{}, attributes_{0}, bounds_{glm::vec3{0}, glm::vec3{0}},
+      chunks_{}, resident_{}, order_{}, distances_{}, wanted_{}, staging_{},
+      statistics_{0, 0, 0, budgetBytes, 0, 0, 0, 0.0, 0.0, 0.0},
+      errorMessage_{}
+{
+}
+
+const Bounds &ChunkedMesh::bounds() const noexcept { return bounds_; }
+
+void ChunkedMesh::draw(glm::mat4 &view, glm::mat4 &projection)
+{
+    for (auto &chunk : resident_)
+    {
+        if (chunk)
+        {
+            chunk->draw(view, projection);
+        }
+    }
+}
+
+const std::string &ChunkedMesh::errorMessage() const noexcept
+{
+    return errorMessage_;
+}
+
+void ChunkedMesh::evict(std::size_t chunk) noexcept
+{
+    resident_[chunk].reset(nullptr);
+    statistics_.residentBytes -=
+        static_cast<std::size_t>(chunks_[chunk].size);
+    --statistics_.residentChunks;
+    ++statistics_.evictions;
+}
+
+bool ChunkedMesh::open(const char *sourceFile)
+{
+    const std::size_t budgetBytes{statistics_.budgetBytes};
+    file_.close();
+    chunks_.clear();
+    resident_.clear();
+    staging_.clear();
+    statistics_ = Statistics{0, 0, 0, budgetBytes, 0, 0, 0, 0.0, 0.0, 0.0};
+    errorMessage_.clear();
+
+    const std::string path{ChunkedMeshBuilder::chunkPath(sourceFile)};
+    FileIO::FileStatus status;
+    FileIO::FileStatus chunkStatus;
+    if (!FileIO::GetFileStatus(sourceFile, status) ||
+        !FileIO::GetFileStatus(path.c_str(), chunkStatus))
+    {
+        errorMessage_ = "No chunk file " + path + "\n";
+        return false;
+    }
+
+    file_.open(path, std::ios::in | std::ios::binary);
+
+    Detail::ChunkFileHeader header;
+    if (!file_.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        std::memcmp(header.magic, Detail::chunkMagic, sizeof(header.magic)) ||
+        header.version != Detail::chunkVersion ||
+        header.byteOrder != Detail::chunkByteOrder ||
+        header.sourceSize != status.size ||
+        header.chunksOffset > chunkStatus.size ||
+        header.chunkCount > (chunkStatus.size - header.chunksOffset) /
+                                sizeof(Detail::ChunkRecord))
+    {
+        file_.close();
+        errorMessage_ = path + " is corrupt or stale\n";
+        return false;
+    }
+
+    // A touched but unchanged source keeps its chunks.
+    std::uint64_t sourceHash;
+    if (header.sourceModifiedTime != status.modifiedTime &&
+        (!Hash::HashFile(sourceFile, sourceHash) ||
+         sourceHash != header.sourceHash))
+    {
+        file_.close();
+        errorMessage_ = path + " is stale\n";
+        return false;
+    }
+
+    chunks_.resize(static_cast<std::size_t>(header.chunkCount));
+    file_.seekg(static_cast<std::streamoff>(header.chunksOffset));
+    file_.read(reinterpret_cast<char *>(chunks_.data()),
+               static_cast<std::streamsize>(chunks_.size() *
+                                            sizeof(Detail::ChunkRecord)));
+
+    attributes_ = header.attributes;
+    if (!file_ ||
+        !std::all_of(chunks_.begin(), chunks_.end(),
+                     [&](const Detail::ChunkRecord &chunk) {
+                         return Detail::validChunk(chunk, attributes_,
+                                                   chunkStatus.size);
+                     }))
+    {
+        file_.close();
+        chunks_.clear();
+        errorMessage_ = path + " is corrupt\n";
+        return false;
+    }
+
+    bounds_ = Bounds{glm::vec3{header.boundsMinimum[0], header.boundsMinimum[1],
+                               header.boundsMinimum[2]},
+                     glm::vec3{header.boundsMaximum[0], header.boundsMaximum[1],
+                               header.boundsMaximum[2]}};
+
+    resident_.resize(chunks_.size());
+    order_.resize(chunks_.size());
+    distances_.resize(chunks_.size());
+    wanted_.assign(chunks_.size(), false);
+    statistics_.chunkCount = chunks_.size();
+
+    return true;
+}
+
+bool ChunkedMesh::pageIn(std::size_t chunk)
+{
+    Performance::Stopwatch stopwatch;
+
+    const Detail::ChunkRecord &record{chunks_[chunk]};
+    const Detail::ChunkLayout layout{Detail::chunkLayout(
+        attributes_, record.vertexCount, record.indexCount)};
+
+    const std::size_t words{static_cast<std::size_t>(
+        (layout.size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t))};
+    if (staging_.size() < words)
+    {
+        staging_.resize(words);
+        statistics_.stagingBytes = words * sizeof(std::uint64_t);
+    }
+
+    char *const data{reinterpret_cast<char *>(staging_.data())};
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(record.offset));
+    if (!file_.read(data, static_cast<std::streamsize>(layout.size)))
+    {
+        return false;
+    }
+
+    const MeshView::IndexType *indices{
+        reinterpret_cast<const MeshView::IndexType *>(data + layout.indices)};
+    if (std::any_of(indices, indices + record.indexCount,
+                    [&](MeshView::IndexType index) {
+                        return index >= record.vertexCount;
+                    }))
+    {
+        return false;
+    }
+
+    const MeshView view{
+        reinterpret_cast<const float *>(data + layout.positions),
+        (attributes_ & Detail::chunkNormals)
+            ? reinterpret_cast<const float *>(data + layout.normals)
+            : nullptr,
+        (attributes_ & Detail::chunkTextureCoordinates)
+            ? reinterpret_cast<const float *>(data + layout.textureCoordinates)
+            : nullptr,
+        (attributes_ & Detail::chunkColors)
+            ? reinterpret_cast<const std::uint8_t *>(data + layout.colors)
+            : nullptr,
+        nullptr,
+        record.vertexCount,
+        indices,
+        record.indexCount,
+        Bounds{glm::vec3{record.boundsMinimum[0], record.boundsMinimum[1],
+                         record.boundsMinimum[2]},
+               glm::vec3{record.boundsMaximum[0], record.boundsMaximum[1],
+                         record.boundsMaximum[2]}},
+        nullptr,
+        0,
+        nullptr,
+        0};
+
+    resident_[chunk].reset(new Mesh{view, *shaderProgram_, texture_});
+
+    const double milliseconds{stopwatch.elapsedMilliseconds()};
+    statistics_.residentBytes += static_cast<std::size_t>(record.size);
+    ++statistics_.residentChunks;
+    ++statistics_.pageIns;
+    statistics_.lastPageInMilliseconds = milliseconds;
+    statistics_.averagePageInMilliseconds +=
+        (milliseconds - statistics_.averagePageInMilliseconds) /
+        static_cast<double>(statistics_.pageIns);
+    statistics_.maximumPageInMilliseconds =
+        std::max(statistics_.maximumPageInMilliseconds, milliseconds);
+
+    return true;
+}
+
+const ChunkedMesh::Statistics &ChunkedMesh::statistics() const noexcept
+{
+    return statistics_;
+}
+
+// Nearest chunks first, until the next one would exceed the budget. Chunks
+// leaving that set are evicted before any is paged in, so residency never
+// exceeds the budget.
+void ChunkedMesh::update(const glm::vec3 &cameraPosition)
+{
+    for (std::size_t i{0}; i < chunks_.size(); ++i)
+    {
+        distances_[i] = Detail::distanceToChunk(chunks_[i], cameraPosition);
+    }
+    std::iota(order_.begin(), order_.end(), std::size_t{0});
+    std::sort(order_.begin(), order_.end(),
+              [&](std::size_t lhs, std::size_t rhs) {
+                  return distances_[lhs] < distances_[rhs];
+              });
+
+    std::fill(wanted_.begin(), wanted_.end(), false);
+    std::size_t wantedBytes{0};
+    for (std::size_t chunk : order_)
+    {
+        const std::size_t size{static_cast<std::size_t>(chunks_[chunk].size)};
+        if (wantedBytes + size > statistics_.budgetBytes)
+        {
+            break;
+        }
+        wanted_[chunk] = true;
+        wantedBytes += size;
+    }
+
+    for (std::size_t chunk{0}; chunk < chunks_.size(); ++chunk)
+    {
+        if (resident_[chunk] && !wanted_[chunk])
+        {
+            evict(chunk);
+        }
+    }
+
+    std::size_t pageIns{0};
+    for (std::size_t chunk : order_)
+    {
+        if (!wanted_[chunk] || pageIns == pageInsPerUpdate_)
+        {
+            break;
+        }
+        // A chunk that failed to page in is dropped for good.
+        if (!resident_[chunk] && chunks_[chunk].size)
+        {
+            if (!pageIn(chunk))
+            {
+                errorMessage_ = "Cannot page in chunk " +
+                                std::to_string(chunk) + "\n";
+                chunks_[chunk].size = 0;
+            }
+            ++pageIns;
+        }
+    }
+}
+
+void ChunkedMesh::writeObjects(ObjectUniformBuffer &objects)
+{
+    for (auto &chunk : resident_)
+    {
+        if (chunk)
+        {
+            chunk->writeObjects(objects);
+        }
+    }
+}
+
+} // namespace Model
@@ -0,0 +1,98 @@
+#ifndef HOMEWORK01_MODEL_CHUNKEDMESH_HPP_
+#define HOMEWORK01_MODEL_CHUNKEDMESH_HPP_
+
+#include "Detail/ChunkFormat.hpp"
+#include "Mesh.hpp"
+#include "MeshData.hpp"
+
+#include "OpenGL/OpenGLShaderProgram.hpp"
+#include "OpenGL/OpenGLTexture.hpp"
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec3.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Model
+{
+
+// Out-of-core model over a chunk file written by ChunkedMeshBuilder. Only
+// the chunk table stays on the host. update() keeps the chunks nearest to
+// the camera resident as Meshes within a fixed byte budget. Chunks are read
+// into one reused staging buffer and uploaded from there, so host memory is
+// bounded by the largest chunk.
+class ChunkedMesh
+{
+public:
+    using TextureType = OpenGL::OpenGLTexture;
+    using ShaderProgramType = OpenGL::OpenGLShaderProgram;
+
+    struct Statistics
+    {
+        std::size_t chunkCount;
+        std::size_t residentChunks;
+        std::size_t residentBytes;
+        std::size_t budgetBytes;
+        std::size_t stagingBytes;
+        std::size_t pageIns;
+        std::size_t evictions;
+        // Read plus upload time of a single chunk.
+        double lastPageInMilliseconds;
+        double averagePageInMilliseconds;
+        double maximumPageInMilliseconds;
+    };
+
+    // At most pageInsPerUpdate chunks are paged in per update, which bounds
+    // the stall a camera jump can cause in one frame.
+    explicit ChunkedMesh(ShaderProgramType &shaderProgram,
+                         TextureType *texture, std::size_t budgetBytes,
+                         std::size_t pageInsPerUpdate = 4);
+
+    ChunkedMesh(const ChunkedMesh &other) = delete;
+    ChunkedMesh &operator=(const ChunkedMesh &other) = delete;
+
+    // Opens the chunk file of sourceFile. Returns false when it is missing,
+    // corrupt or stale, in which case it has to be built again.
+    bool open(const char *sourceFile);
+
+    void update(const glm::vec3 &cameraPosition);
+    // Those of the chunks resident after update(), as Mesh::writeObjects().
+    void writeObjects(ObjectUniformBuffer &objects);
+    void draw(glm::mat4 &view, glm::mat4 &projection);
+
+    const Bounds &bounds() const noexcept;
+    const Statistics &statistics() const noexcept;
+    const std::string &errorMessage() const noexcept;
+
+private:
+    bool pageIn(std::size_t chunk);
+    void evict(std::size_t chunk) noexcept;
+
+    ShaderProgramType *shaderProgram_;
+    TextureType *texture_;
+    std::size_t pageInsPerUpdate_;
+
+    std::ifstream file_;
+    std::uint32_t attributes_;
+    Bounds bounds_;
+    std::vector<Detail::ChunkRecord> chunks_;
+
+    std::vector<std::unique_ptr<Mesh>> resident_;
+    std::vector<std::size_t> order_;
+    std::vector<float> distances_;
+    std::vector<bool> wanted_;
+    // 8-byte units keep every stream of a payload aligned.
+    std::vector<std::uint64_t> staging_;
+
+    Statistics statistics_;
+    std::string errorMessage_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_CHUNKEDMESH_HPP_
@@ -0,0 +1,604 @@
+#include "ChunkedMeshBuilder.hpp"
+
+#include "Detail/ChunkFormat.hpp"
+
+#include "Utils/FileIO/FileStatus.hpp"
+#include "Utils/FileIO/MappedFile.hpp"
+#include "Utils/Global.hpp"
+#include "Utils/Hash/Hash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Cells are cubes, so chunks of flat models (terrain, cities) stay square
+// instead of turning into long slabs.
+struct ChunkGrid
+{
+    glm::vec3 origin;
+    float cellSize;
+    std::uint32_t dimensions[3];
+};
+
+constexpr std::size_t maximumCellCount{std::size_t{1} << 22};
+constexpr std::uint32_t noCell{0xFFFFFFFFu};
+
+ChunkGrid makeChunkGrid(const Bounds &bounds, std::size_t targetCellCount);
+double chunkGridCellCount(const glm::vec3 &extent, float cellSize) noexcept;
+std::uint32_t chunkGridCell(const ChunkGrid &grid,
+                            const glm::vec3 &point) noexcept;
+
+inline double chunkGridCellCount(const glm::vec3 &extent,
+                                 float cellSize) noexcept
+{
+    double count{1.0};
+    for (int i{0}; i < 3; ++i)
+    {
+        count *= std::max(1.0, std::ceil(static_cast<double>(extent[i]) /
+                                         static_cast<double>(cellSize)));
+    }
+    return count;
+}
+
+// Bisects for the smallest cell size that yields at most the target count.
+ChunkGrid makeChunkGrid(const Bounds &bounds, std::size_t targetCellCount)
+{
+    const glm::vec3 extent{glm::max(bounds.maximum - bounds.minimum, 0.0f)};
+    const float largest{std::max(extent.x, std::max(extent.y, extent.z))};
+    const double target{static_cast<double>(
+        std::min(std::max<std::size_t>(targetCellCount, 1),
+                 maximumCellCount))};
+
+    ChunkGrid grid{bounds.minimum, 1.0f, {1, 1, 1}};
+    if (!(largest > 0.0f))
+    {
+        return grid;
+    }
+
+    float low{largest / static_cast<float>(target)};
+    float high{largest};
+    for (int i{0}; i < 48; ++i)
+    {
+        const float middle{0.5f * (low + high)};
+        if (chunkGridCellCount(extent, middle) <= target)
+        {
+            high = middle;
+        }
+        else
+        {
+            low = middle;
+        }
+    }
+
+    grid.cellSize = high;
+    for (int i{0}; i < 3; ++i)
+    {
+        grid.dimensions[i] = static_cast<std::uint32_t>(
+            std::max(1.0f, std::ceil(extent[i] / high)));
+    }
+    return grid;
+}
+
+inline std::uint32_t chunkGridCell(const ChunkGrid &grid,
+                                   const glm::vec3 &point) noexcept
+{
+    std::uint32_t cell[3];
+    for (int i{0}; i < 3; ++i)
+    {
+        const float coordinate{(point[i] - grid.origin[i]) / grid.cellSize};
+        // Also catches NaN.
+        cell[i] = coordinate > 0.0f
+                      ? std::min(static_cast<std::uint32_t>(
+                                     std::min(coordinate, 4.0e9f)),
+                                 grid.dimensions[i] - 1)
+                      : 0;
+    }
+    return cell[0] +
+           grid.dimensions[0] * (cell[1] + grid.dimensions[1] * cell[2]);
+}
+
+} // namespace Detail
+
+ChunkedMeshBuilder::ChunkedMeshBuilder(const char *sourceFile,
+                                       std::size_t trianglesPerChunk,
+                                       std::size_t memoryBudget)
+    : sourceFile_{sourceFile},
+      trianglesPerChunk_{std::max<std::size_t>(trianglesPerChunk, 1)},
+      memoryBudget_{memoryBudget}, streams_{false, false, false, false},
+      vertexCount_{0}, recordSize_{0}, vertexSpill_{}, indexSpill_{},
+      records_{}, good_{false}, errorMessage_{}, chunkCount_{0}
+{
+}
+
+ChunkedMeshBuilder::~ChunkedMeshBuilder() { removeSpillFiles(); }
+
+std::string ChunkedMeshBuilder::chunkPath(const char *sourceFile)
+{
+    return std::string{sourceFile} + ".chunks";
+}
+
+std::size_t ChunkedMeshBuilder::chunkCount() const noexcept
+{
+    return chunkCount_;
+}
+
+const std::string &ChunkedMeshBuilder::errorMessage() const noexcept
+{
+    return errorMessage_;
+}
+
+bool ChunkedMeshBuilder::good() const noexcept { return good_; }
+
+void ChunkedMeshBuilder::fail(const std::string &message)
+{
+    if (good_)
+    {
+        errorMessage_ = message;
+    }
+    good_ = false;
+}
+
+void ChunkedMeshBuilder::removeSpillFiles() noexcept
+{
+    vertexSpill_.close();
+    indexSpill_.close();
+
+    const std::string path{chunkPath(sourceFile_.c_str())};
+    std::remove((path + ".vertices.tmp").c_str());
+    std::remove((path + ".indices.tmp").c_str());
+    std::remove((path + ".cells.tmp").c_str());
+}
+
+void ChunkedMeshBuilder::beginMesh(const VertexStreams &streams,
+                                   std::size_t vertexCount,
+                                   std::size_t indexCapacity)
+{
+    PROGRAM_MAYBE_UNUSED(indexCapacity)
+
+    removeSpillFiles();
+
+    streams_ = streams;
+    vertexCount_ = vertexCount;
+    recordSize_ = 3 * sizeof(float) +
+                  (streams.normals ? 3 * sizeof(float) : 0) +
+                  (streams.textureCoordinates ? 2 * sizeof(float) : 0) +
+                  (streams.colors ? 4 : 0);
+    good_ = true;
+    errorMessage_.clear();
+    chunkCount_ = 0;
+
+    const std::string path{chunkPath(sourceFile_.c_str())};
+    vertexSpill_.open(path + ".vertices.tmp",
+                      std::ios::out | std::ios::binary | std::ios::trunc);
+    indexSpill_.open(path + ".indices.tmp",
+                     std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!vertexSpill_.is_open() || !indexSpill_.is_open())
+    {
+        fail("Cannot create spill files next to " + path + "\n");
+    }
+}
+
+// Vertices are spilled interleaved, so that gathering a chunk touches one
+// record per vertex.
+void ChunkedMeshBuilder::writeVertices(std::size_t firstVertex,
+                                       const MeshView &chunk)
+{
+    if (!good_)
+    {
+        return;
+    }
+
+    records_.resize(chunk.vertexCount * recordSize_);
+    for (std::size_t i{0}; i < chunk.vertexCount; ++i)
+    {
+        char *record{records_.data() + i * recordSize_};
+        std::memcpy(record, chunk.positions + 3 * i, 3 * sizeof(float));
+        record += 3 * sizeof(float);
+        if (streams_.normals)
+        {
+            std::memcpy(record, chunk.normals + 3 * i, 3 * sizeof(float));
+            record += 3 * sizeof(float);
+        }
+        if (streams_.textureCoordinates)
+        {
+            std::memcpy(record, chunk.textureCoordinates + 2 * i,
+                        2 * sizeof(float));
+            record += 2 * sizeof(float);
+        }
+        if (streams_.colors)
+        {
+            std::memcpy(record, chunk.colors + 4 * i, 4);
+        }
+    }
+
+    vertexSpill_.seekp(
+        static_cast<std::streamoff>(firstVertex * recordSize_));
+    vertexSpill_.write(records_.data(),
+                       static_cast<std::streamsize>(records_.size()));
+    if (!vertexSpill_.good())
+    {
+        fail("Cannot spill vertices of " + sourceFile_ + "\n");
+    }
+}
+
+void ChunkedMeshBuilder::writeIndices(std::size_t firstIndex,
+                                      const IndexType *indices,
+                                      std::size_t count)
+{
+    if (!good_)
+    {
+        return;
+    }
+
+    indexSpill_.seekp(
+        static_cast<std::streamoff>(firstIndex * sizeof(IndexType)));
+    indexSpill_.write(reinterpret_cast<const char *>(indices),
+                      static_cast<std::streamsize>(count * sizeof(IndexType)));
+    if (!indexSpill_.good())
+    {
+        fail("Cannot spill indices of " + sourceFile_ + "\n");
+    }
+}
+
+void ChunkedMeshBuilder::endMesh(std::size_t indexCount, const Bounds &bounds)
+{
+    vertexSpill_.close();
+    indexSpill_.close();
+
+    if (good_ && !partition(indexCount, bounds))
+    {
+        good_ = false;
+    }
+
+    removeSpillFiles();
+}
+
+void ChunkedMeshBuilder::build(const MeshView &view)
+{
+    beginMesh(VertexStreams{view.normals != nullptr,
+                            view.textureCoordinates != nullptr,
+                            view.colors != nullptr, false},
+              view.vertexCount, view.indexCount);
+    writeVertices(0, view);
+    writeIndices(0, view.indices, view.indexCount);
+    endMesh(view.indexCount, view.bounds);
+}
+
+bool ChunkedMeshBuilder::partition(std::size_t indexCount,
+                                   const Bounds &bounds)
+{
+    const std::string path{chunkPath(sourceFile_.c_str())};
+    const std::size_t triangleCount{indexCount / 3};
+
+    FileIO::FileStatus status;
+    std::uint64_t sourceHash;
+    if (!FileIO::GetFileStatus(sourceFile_.c_str(), status) ||
+        !Hash::HashFile(sourceFile_.c_str(), sourceHash))
+    {
+        fail("Cannot read " + sourceFile_ + "\n");
+        return false;
+    }
+
+    // Empty spill files cannot be mapped; an empty mesh has no chunks.
+    FileIO::MappedFile vertexFile;
+    FileIO::MappedFile indexFile;
+    if (triangleCount &&
+        (!vertexFile.open((path + ".vertices.tmp").c_str()) ||
+         !indexFile.open((path + ".indices.tmp").c_str()) ||
+         vertexFile.size() < vertexCount_ * recordSize_ ||
+         indexFile.size() < 3 * triangleCount * sizeof(IndexType)))
+    {
+        fail("Spilled mesh of " + sourceFile_ + " is incomplete\n");
+        return false;
+    }
+
+    const char *const records{vertexFile.data()};
+    const IndexType *const corners{
+        reinterpret_cast<const IndexType *>(indexFile.data())};
+
+    const Detail::ChunkGrid grid{Detail::makeChunkGrid(
+        bounds, (triangleCount + trianglesPerChunk_ - 1) / trianglesPerChunk_)};
+    const std::size_t cellCount{static_cast<std::size_t>(grid.dimensions[0]) *
+                                grid.dimensions[1] * grid.dimensions[2]};
+
+    // Pass 1: the cell of every triangle, by centroid, spilled so that the
+    // gathering passes below read 4 bytes per triangle.
+    std::vector<std::size_t> cellTriangleCounts(cellCount, 0);
+    {
+        std::ofstream cells(path + ".cells.tmp",
+                            std::ios::out | std::ios::binary |
+                                std::ios::trunc);
+        std::vector<std::uint32_t> block;
+        block.reserve(1u << 16);
+
+        for (std::size_t triangle{0}; triangle < triangleCount; ++triangle)
+        {
+            glm::vec3 centroid{0.0f};
+            bool valid{true};
+            for (std::size_t k{0}; k < 3; ++k)
+            {
+                const IndexType corner{corners[3 * triangle + k]};
+                valid = valid && corner < vertexCount_;
+                if (valid)
+                {
+                    glm::vec3 position;
+                    std::memcpy(&position[0], records + corner * recordSize_,
+                                3 * sizeof(float));
+                    centroid += position;
+                }
+            }
+
+            const std::uint32_t cell{
+                valid ? Detail::chunkGridCell(grid, centroid / 3.0f)
+                      : Detail::noCell};
+            if (valid)
+            {
+                ++cellTriangleCounts[cell];
+            }
+
+            block.push_back(cell);
+            if (block.size() == block.capacity() ||
+                triangle + 1 == triangleCount)
+            {
+                cells.write(reinterpret_cast<const char *>(block.data()),
+                            static_cast<std::streamsize>(
+                                block.size() * sizeof(std::uint32_t)));
+                block.clear();
+            }
+        }
+
+        if (!cells.good())
+        {
+            fail("Cannot spill chunk cells of " + sourceFile_ + "\n");
+            return false;
+        }
+    }
+
+    FileIO::MappedFile cellFile;
+    if (triangleCount && !cellFile.open((path + ".cells.tmp").c_str()))
+    {
+        fail("Cannot map chunk cells of " + sourceFile_ + "\n");
+        return false;
+    }
+    const std::uint32_t *const triangleCells{
+        reinterpret_cast<const std::uint32_t *>(cellFile.data())};
+
+    chunkCount_ = static_cast<std::size_t>(
+        std::count_if(cellTriangleCounts.begin(), cellTriangleCounts.end(),
+                      [](std::size_t count) { return count != 0; }));
+
+    const std::uint32_t attributes{
+        (streams_.normals ? Detail::chunkNormals : 0u) |
+        (streams_.textureCoordinates ? Detail::chunkTextureCoordinates
+                                     : 0u) |
+        (streams_.colors ? Detail::chunkColors : 0u)};
+
+    Detail::ChunkFileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, Detail::chunkMagic, sizeof(header.magic));
+    header.version = Detail::chunkVersion;
+    header.byteOrder = Detail::chunkByteOrder;
+    header.sourceSize = status.size;
+    header.sourceModifiedTime = status.modifiedTime;
+    header.sourceHash = sourceHash;
+    header.vertexCount = vertexCount_;
+    header.indexCount = indexCount;
+    header.chunkCount = chunkCount_;
+    header.attributes = attributes;
+    for (int i{0}; i < 3; ++i)
+    {
+        header.boundsMinimum[i] = bounds.minimum[i];
+        header.boundsMaximum[i] = bounds.maximum[i];
+    }
+    header.chunksOffset = Detail::chunkAlignUp(sizeof(header));
+
+    // Write to a temporary file and move it in place, as MeshCache does.
+    const std::string temporaryPath{path + ".tmp"};
+    std::ofstream out(temporaryPath,
+                      std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        fail("Cannot write " + temporaryPath + "\n");
+        return false;
+    }
+
+    std::vector<Detail::ChunkRecord> chunks;
+    chunks.reserve(chunkCount_);
+    std::uint64_t offset{Detail::chunkAlignUp(
+        header.chunksOffset + chunkCount_ * sizeof(Detail::ChunkRecord))};
+    out.seekp(static_cast<std::streamoff>(offset));
+
+    // A gathered triangle costs its id, three corners, their sorted copy and
+    // up to three payload vertices with their indices.
+    const std::size_t bytesPerTriangle{sizeof(std::uint32_t) +
+                                       6 * sizeof(IndexType) +
+                                       3 * (recordSize_ + sizeof(IndexType))};
+    const std::size_t batchTriangleLimit{
+        std::max<std::size_t>(memoryBudget_ / bytesPerTriangle, 1)};
+
+    std::vector<std::uint32_t> batch;
+    std::vector<std::size_t> batchOffsets;
+    std::vector<IndexType> chunkCorners;
+    std::vector<IndexType> chunkVertices;
+    std::vector<char> payload;
+
+    for (std::size_t firstCell{0}; firstCell < cellCount;)
+    {
+        // Pass 2: gather the triangles of a batch of cells whose total fits
+        // the memory budget; a single oversized cell forms its own batch.
+        std::size_t lastCell{firstCell};
+        std::size_t batchTriangles{0};
+        while (lastCell < cellCount &&
+               (lastCell == firstCell ||
+                batchTriangles + cellTriangleCounts[lastCell] <=
+                    batchTriangleLimit))
+        {
+            batchTriangles += cellTriangleCounts[lastCell++];
+        }
+
+        batchOffsets.assign(lastCell - firstCell + 1, 0);
+        for (std::size_t cell{firstCell}; cell < lastCell; ++cell)
+        {
+            batchOffsets[cell - firstCell + 1] =
+                batchOffsets[cell - firstCell] + cellTriangleCounts[cell];
+        }
+
+        if (batchTriangles)
+        {
+            batch.resize(batchTriangles);
+            std::vector<std::size_t> cursors(batchOffsets.begin(),
+                                             batchOffsets.end() - 1);
+            for (std::size_t triangle{0}; triangle < triangleCount;
+                 ++triangle)
+            {
+                const std::uint32_t cell{triangleCells[triangle]};
+                if (cell >= firstCell && cell < lastCell)
+                {
+                    batch[cursors[cell - firstCell]++] =
+                        static_cast<std::uint32_t>(triangle);
+                }
+            }
+        }
+
+        // Pass 3: each non-empty cell becomes a self-contained chunk with
+        // its own vertices and local indices.
+        for (std::size_t cell{firstCell}; cell < lastCell; ++cell)
+        {
+            const std::size_t begin{batchOffsets[cell - firstCell]};
+            const std::size_t end{batchOffsets[cell - firstCell + 1]};
+            if (begin == end)
+            {
+                continue;
+            }
+
+            chunkCorners.clear();
+            for (std::size_t i{begin}; i < end; ++i)
+            {
+                const IndexType *triangle{corners +
+                                          3 * static_cast<std::size_t>(
+                                                  batch[i])};
+                chunkCorners.insert(chunkCorners.end(), triangle,
+                                    triangle + 3);
+            }
+
+            chunkVertices = chunkCorners;
+            std::sort(chunkVertices.begin(), chunkVertices.end());
+            chunkVertices.erase(
+                std::unique(chunkVertices.begin(), chunkVertices.end()),
+                chunkVertices.end());
+
+            const Detail::ChunkLayout layout{Detail::chunkLayout(
+                attributes, chunkVertices.size(), chunkCorners.size())};
+            payload.assign(static_cast<std::size_t>(layout.size), 0);
+
+            Detail::ChunkRecord chunk;
+            std::memset(&chunk, 0, sizeof(chunk));
+            glm::vec3 minimum{0.0f};
+            glm::vec3 maximum{0.0f};
+
+            for (std::size_t i{0}; i < chunkVertices.size(); ++i)
+            {
+                const char *record{records +
+                                   chunkVertices[i] * recordSize_};
+
+                glm::vec3 position;
+                std::memcpy(&position[0], record, 3 * sizeof(float));
+                minimum = i ? glm::min(minimum, position) : position;
+                maximum = i ? glm::max(maximum, position) : position;
+
+                std::memcpy(payload.data() + layout.positions +
+                                3 * sizeof(float) * i,
+                            record, 3 * sizeof(float));
+                record += 3 * sizeof(float);
+                if (streams_.normals)
+                {
+                    std::memcpy(payload.data() + layout.normals +
+                                    3 * sizeof(float) * i,
+                                record, 3 * sizeof(float));
+                    record += 3 * sizeof(float);
+                }
+                if (streams_.textureCoordinates)
+                {
+                    std::memcpy(payload.data() + layout.textureCoordinates +
+                                    2 * sizeof(float) * i,
+                                record, 2 * sizeof(float));
+                    record += 2 * sizeof(float);
+                }
+                if (streams_.colors)
+                {
+                    std::memcpy(payload.data() + layout.colors + 4 * i,
+                                record, 4);
+                }
+            }
+
+            for (std::size_t i{0}; i < chunkCorners.size(); ++i)
+            {
+                const std::uint32_t local{static_cast<std::uint32_t>(
+                    std::lower_bound(chunkVertices.begin(),
+                                     chunkVertices.end(), chunkCorners[i]) -
+                    chunkVertices.begin())};
+                std::memcpy(payload.data() + layout.indices +
+                                sizeof(std::uint32_t) * i,
+                            &local, sizeof(local));
+            }
+
+            out.write(payload.data(),
+                      static_cast<std::streamsize>(payload.size()));
+
+            chunk.offset = offset;
+            chunk.size = layout.size;
+            chunk.vertexCount =
+                static_cast<std::uint32_t>(chunkVertices.size());
+            chunk.indexCount = static_cast<std::uint32_t>(chunkCorners.size());
+            for (int i{0}; i < 3; ++i)
+            {
+                chunk.boundsMinimum[i] = minimum[i];
+                chunk.boundsMaximum[i] = maximum[i];
+            }
+            chunks.push_back(chunk);
+
+            offset += layout.size;
+        }
+
+        firstCell = lastCell;
+    }
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.seekp(static_cast<std::streamoff>(header.chunksOffset));
+    out.write(reinterpret_cast<const char *>(chunks.data()),
+              static_cast<std::streamsize>(chunks.size() *
+                                           sizeof(Detail::ChunkRecord)));
+
+    if (!out.good())
+    {
+        out.close();
+        std::remove(temporaryPath.c_str());
+        fail("Cannot write " + temporaryPath + "\n");
+        return false;
+    }
+    out.close();
+
+#if defined(_WIN32)
+    // rename() does not replace an existing file on Windows.
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporaryPath.c_str());
+        fail("Cannot move " + temporaryPath + " in place\n");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace Model
@@ -0,0 +1,74 @@
+#ifndef HOMEWORK01_MODEL_CHUNKEDMESHBUILDER_HPP_
+#define HOMEWORK01_MODEL_CHUNKEDMESHBUILDER_HPP_
+
+#include "MeshData.hpp"
+#include "MeshSink.hpp"
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Model
+{
+
+// Preprocessing pass of the out-of-core mode. The streamed mesh is spilled
+// to temporary files as it arrives; endMesh then partitions the triangles
+// into a uniform grid of spatial chunks and writes "<source>.chunks" for
+// ChunkedMesh. Only one batch of grid cells, bounded by memoryBudget, is
+// gathered in memory at a time; the spilled streams are read through
+// mappings, so the host never has to hold the whole model.
+class ChunkedMeshBuilder : public MeshSink
+{
+public:
+    explicit ChunkedMeshBuilder(const char *sourceFile,
+                                std::size_t trianglesPerChunk = 1u << 16,
+                                std::size_t memoryBudget = 256u << 20);
+    ~ChunkedMeshBuilder();
+
+    ChunkedMeshBuilder(const ChunkedMeshBuilder &other) = delete;
+    ChunkedMeshBuilder &operator=(const ChunkedMeshBuilder &other) = delete;
+
+    void beginMesh(const VertexStreams &streams, std::size_t vertexCount,
+                   std::size_t indexCapacity) override;
+    void writeVertices(std::size_t firstVertex, const MeshView &chunk) override;
+    void writeIndices(std::size_t firstIndex, const IndexType *indices,
+                      std::size_t count) override;
+    void endMesh(std::size_t indexCount, const Bounds &bounds) override;
+
+    // Feeds a complete mesh through the sink interface.
+    void build(const MeshView &view);
+
+    // False once any step since beginMesh failed.
+    bool good() const noexcept;
+    const std::string &errorMessage() const noexcept;
+    std::size_t chunkCount() const noexcept;
+
+    static std::string chunkPath(const char *sourceFile);
+
+private:
+    bool partition(std::size_t indexCount, const Bounds &bounds);
+    void fail(const std::string &message);
+    void removeSpillFiles() noexcept;
+
+    std::string sourceFile_;
+    std::size_t trianglesPerChunk_;
+    std::size_t memoryBudget_;
+
+    VertexStreams streams_;
+    std::size_t vertexCount_;
+    // Bytes of one spilled vertex: position, then the present streams.
+    std::size_t recordSize_;
+
+    std::ofstream vertexSpill_;
+    std::ofstream indexSpill_;
+    std::vector<char> records_;
+
+    bool good_;
+    std::string errorMessage_;
+    std::size_t chunkCount_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_CHUNKEDMESHBUILDER_HPP_
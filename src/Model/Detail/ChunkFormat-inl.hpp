@@ -0,0 +1,37 @@
+namespace Model
+{
+
+namespace Detail
+{
+
+inline std::uint64_t chunkAlignUp(std::uint64_t value) noexcept
+{
+    return (value + chunkAlignment - 1) / chunkAlignment * chunkAlignment;
+}
+
+inline ChunkLayout chunkLayout(std::uint32_t attributes,
+                               std::uint64_t vertexCount,
+                               std::uint64_t indexCount) noexcept
+{
+    ChunkLayout layout;
+    layout.positions = 0;
+    layout.normals =
+        chunkAlignUp(layout.positions + 3 * sizeof(float) * vertexCount);
+    layout.textureCoordinates = chunkAlignUp(
+        layout.normals +
+        ((attributes & chunkNormals) ? 3 * sizeof(float) * vertexCount : 0));
+    layout.colors =
+        chunkAlignUp(layout.textureCoordinates +
+                     ((attributes & chunkTextureCoordinates)
+                          ? 2 * sizeof(float) * vertexCount
+                          : 0));
+    layout.indices = chunkAlignUp(
+        layout.colors + ((attributes & chunkColors) ? 4 * vertexCount : 0));
+    layout.size =
+        chunkAlignUp(layout.indices + sizeof(std::uint32_t) * indexCount);
+    return layout;
+}
+
+} // namespace Detail
+
+} // namespace Model
@@ -0,0 +1,87 @@
+#ifndef HOMEWORK01_MODEL_DETAIL_CHUNKFORMAT_HPP_
+#define HOMEWORK01_MODEL_DETAIL_CHUNKFORMAT_HPP_
+
+#include <cstdint>
+#include <type_traits>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// On-disk layout of a chunked model, "<source>.chunks": a header, a table of
+// chunk records and then one payload per chunk. A payload holds the streams
+// of a self-contained mesh (positions, normals, texture coordinates, colors,
+// then 32-bit local indices), each aligned to chunkAlignment, so it can be
+// read with one call and uploaded without conversion.
+
+constexpr char chunkMagic[8]{'H', '0', '1', 'C', 'H', 'U', 'N', 'K'};
+constexpr std::uint32_t chunkVersion{1};
+constexpr std::uint32_t chunkByteOrder{0x01020304};
+constexpr std::uint64_t chunkAlignment{16};
+
+constexpr std::uint32_t chunkNormals{1u << 0};
+constexpr std::uint32_t chunkTextureCoordinates{1u << 1};
+constexpr std::uint32_t chunkColors{1u << 2};
+
+struct ChunkFileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+
+    std::uint64_t sourceSize;
+    std::int64_t sourceModifiedTime;
+    std::uint64_t sourceHash;
+
+    std::uint64_t vertexCount;
+    std::uint64_t indexCount;
+    std::uint64_t chunkCount;
+    std::uint32_t attributes;
+
+    float boundsMinimum[3];
+    float boundsMaximum[3];
+    std::uint32_t reserved;
+
+    std::uint64_t chunksOffset;
+};
+
+struct ChunkRecord
+{
+    std::uint64_t offset;
+    std::uint64_t size;
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+    float boundsMinimum[3];
+    float boundsMaximum[3];
+};
+
+static_assert(std::is_standard_layout<ChunkFileHeader>::value,
+              "ChunkFileHeader is written as raw bytes");
+static_assert(std::is_standard_layout<ChunkRecord>::value,
+              "ChunkRecord is written as raw bytes");
+
+// Offsets of the streams inside one payload; absent streams are empty.
+struct ChunkLayout
+{
+    std::uint64_t positions;
+    std::uint64_t normals;
+    std::uint64_t textureCoordinates;
+    std::uint64_t colors;
+    std::uint64_t indices;
+    std::uint64_t size;
+};
+
+inline std::uint64_t chunkAlignUp(std::uint64_t value) noexcept;
+inline ChunkLayout chunkLayout(std::uint32_t attributes,
+                               std::uint64_t vertexCount,
+                               std::uint64_t indexCount) noexcept;
+
+} // namespace Detail
+
+} // namespace Model
+
+#include "ChunkFormat-inl.hpp"
+
+#endif // HOMEWORK01_MODEL_DETAIL_CHUNKFORMAT_HPP_
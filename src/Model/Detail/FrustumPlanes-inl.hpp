@@ -0,0 +1,41 @@
+#include "glm/geometric.hpp"
+#include "glm/vec3.hpp"
+
+namespace Model
+{
+
+namespace Detail
+{
+
+inline void frustumPlanes(const glm::mat4 &matrix,
+                          glm::vec4 (&planes)[6]) noexcept
+{
+    const glm::vec4 row0{matrix[0][0], matrix[1][0], matrix[2][0],
+                         matrix[3][0]};
+    const glm::vec4 row1{matrix[0][1], matrix[1][1], matrix[2][1],
+                         matrix[3][1]};
+    const glm::vec4 row2{matrix[0][2], matrix[1][2], matrix[2][2],
+                         matrix[3][2]};
+    const glm::vec4 row3{matrix[0][3], matrix[1][3], matrix[2][3],
+                         matrix[3][3]};
+
+    planes[0] = row3 + row0;
+    planes[1] = row3 - row0;
+    planes[2] = row3 + row1;
+    planes[3] = row3 - row1;
+    planes[4] = row3 + row2;
+    planes[5] = row3 - row2;
+
+    for (glm::vec4 &plane : planes)
+    {
+        const float length{glm::length(glm::vec3{plane})};
+        if (length > 0.0f)
+        {
+            plane /= length;
+        }
+    }
+}
+
+} // namespace Detail
+
+} // namespace Model
@@ -0,0 +1,24 @@
+#ifndef HOMEWORK01_MODEL_DETAIL_FRUSTUMPLANES_HPP_
+#define HOMEWORK01_MODEL_DETAIL_FRUSTUMPLANES_HPP_
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Planes of the clip volume of matrix in the space it transforms from, as
+// (normal, distance) with the inside positive and unit normals.
+inline void frustumPlanes(const glm::mat4 &matrix,
+                          glm::vec4 (&planes)[6]) noexcept;
+
+} // namespace Detail
+
+} // namespace Model
+
+#include "FrustumPlanes-inl.hpp"
+
+#endif // HOMEWORK01_MODEL_DETAIL_FRUSTUMPLANES_HPP_
@@ -0,0 +1,46 @@
+#include "glm/geometric.hpp"
+
+#include <cmath>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+inline glm::vec2 octahedralEncode(const glm::vec3 &normal) noexcept
+{
+    const float sum{std::abs(normal.x) + std::abs(normal.y) +
+                    std::abs(normal.z)};
+    if (!(sum > 0.0f))
+    {
+        return glm::vec2{0.0f};
+    }
+
+    glm::vec2 encoded{normal.x / sum, normal.y / sum};
+    if (normal.z < 0.0f)
+    {
+        encoded = glm::vec2{
+            (1.0f - std::abs(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f),
+            (1.0f - std::abs(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f)};
+    }
+    return encoded;
+}
+
+inline glm::vec3 octahedralDecode(const glm::vec2 &encoded) noexcept
+{
+    glm::vec3 normal{encoded.x, encoded.y,
+                     1.0f - std::abs(encoded.x) - std::abs(encoded.y)};
+    if (normal.z < 0.0f)
+    {
+        normal.x = (1.0f - std::abs(encoded.y)) *
+                   (encoded.x >= 0.0f ? 1.0f : -1.0f);
+        normal.y = (1.0f - std::abs(encoded.x)) *
+                   (encoded.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    return glm::normalize(normal);
+}
+
+} // namespace Detail
+
+} // namespace Model
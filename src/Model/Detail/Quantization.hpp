@@ -0,0 +1,26 @@
+#ifndef HOMEWORK01_MODEL_DETAIL_QUANTIZATION_HPP_
+#define HOMEWORK01_MODEL_DETAIL_QUANTIZATION_HPP_
+
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Octahedral mapping of a unit vector onto [-1, 1]^2: the vector is projected
+// onto the octahedron |x| + |y| + |z| = 1 and the lower half is folded over
+// the upper one. Two 16-bit components keep the angular error far below a
+// hundredth of a degree.
+inline glm::vec2 octahedralEncode(const glm::vec3 &normal) noexcept;
+inline glm::vec3 octahedralDecode(const glm::vec2 &encoded) noexcept;
+
+} // namespace Detail
+
+} // namespace Model
+
+#include "Quantization-inl.hpp"
+
+#endif // HOMEWORK01_MODEL_DETAIL_QUANTIZATION_HPP_
@@ -0,0 +1,143 @@
+#include <cmath>
+#include <cstdint>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+inline bool isSpace(char c) noexcept { return c == ' ' || c == '\t'; }
+
+inline bool isLineEnd(char c) noexcept { return c == '\n' || c == '\r'; }
+
+inline bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+inline const char *skipSpaces(const char *p, const char *end) noexcept
+{
+    while (p < end && isSpace(*p))
+    {
+        ++p;
+    }
+    return p;
+}
+
+inline const char *skipWhitespace(const char *p, const char *end) noexcept
+{
+    while (p < end && (isSpace(*p) || isLineEnd(*p)))
+    {
+        ++p;
+    }
+    return p;
+}
+
+inline const char *skipLine(const char *p, const char *end) noexcept
+{
+    while (p < end && *p != '\n')
+    {
+        ++p;
+    }
+    return p < end ? p + 1 : end;
+}
+
+inline bool parseFloat(const char *&p, const char *end, float &value) noexcept
+{
+    static const double powersOfTen[]{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,
+                                      1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                      1e12, 1e13, 1e14, 1e15, 1e16, 1e17,
+                                      1e18, 1e19, 1e20, 1e21, 1e22};
+
+    p = skipSpaces(p, end);
+
+    bool negative{false};
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    std::uint64_t mantissa{0};
+    int exponent{0};
+    int digits{0};
+    bool any{false};
+
+    for (; p < end && isDigit(*p); ++p, any = true)
+    {
+        if (digits < 19)
+        {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+            digits += (mantissa != 0);
+        }
+        else
+        {
+            ++exponent;
+        }
+    }
+
+    if (p < end && *p == '.')
+    {
+        for (++p; p < end && isDigit(*p); ++p, any = true)
+        {
+            if (digits < 19)
+            {
+                mantissa =
+                    mantissa * 10 + static_cast<std::uint64_t>(*p - '0');
+                digits += (mantissa != 0);
+                --exponent;
+            }
+        }
+    }
+
+    if (!any)
+    {
+        return false;
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E'))
+    {
+        const char *mark{p++};
+        bool negativeExponent{false};
+        if (p < end && (*p == '-' || *p == '+'))
+        {
+            negativeExponent = (*p == '-');
+            ++p;
+        }
+
+        if (p < end && isDigit(*p))
+        {
+            int explicitExponent{0};
+            for (; p < end && isDigit(*p); ++p)
+            {
+                if (explicitExponent < 10000)
+                {
+                    explicitExponent = explicitExponent * 10 + (*p - '0');
+                }
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        }
+        else
+        {
+            p = mark;
+        }
+    }
+
+    double result{static_cast<double>(mantissa)};
+    if (exponent < 0)
+    {
+        result = (exponent >= -22) ? result / powersOfTen[-exponent]
+                                   : result * std::pow(10.0, exponent);
+    }
+    else if (exponent > 0)
+    {
+        result = (exponent <= 22) ? result * powersOfTen[exponent]
+                                  : result * std::pow(10.0, exponent);
+    }
+
+    value = static_cast<float>(negative ? -result : result);
+
+    return true;
+}
+
+} // namespace Detail
+
+} // namespace Model
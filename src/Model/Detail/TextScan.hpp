@@ -0,0 +1,30 @@
+#ifndef HOMEWORK01_MODEL_DETAIL_TEXTSCAN_HPP_
+#define HOMEWORK01_MODEL_DETAIL_TEXTSCAN_HPP_
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Scanning helpers shared by the text format loaders. They work on a
+// [p, end) range that need not be null terminated, such as a mapped file.
+
+inline bool isSpace(char c) noexcept;
+inline bool isLineEnd(char c) noexcept;
+inline bool isDigit(char c) noexcept;
+inline const char *skipSpaces(const char *p, const char *end) noexcept;
+inline const char *skipWhitespace(const char *p, const char *end) noexcept;
+inline const char *skipLine(const char *p, const char *end) noexcept;
+
+// Locale independent decimal parser. Skips leading spaces and advances p past
+// the number. Digits past the 19th significant one only scale the exponent.
+inline bool parseFloat(const char *&p, const char *end, float &value) noexcept;
+
+} // namespace Detail
+
+} // namespace Model
+
+#include "TextScan-inl.hpp"
+
+#endif // HOMEWORK01_MODEL_DETAIL_TEXTSCAN_HPP_
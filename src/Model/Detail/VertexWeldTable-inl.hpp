@@ -0,0 +1,122 @@
+#include <algorithm>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+inline VertexWeldTable::VertexWeldTable(std::size_t expectedCount)
+    : slots_{}, mask_{0}, size_{0}, growThreshold_{0}
+{
+    // Keep the load factor at or below one half for the expected size.
+    std::size_t capacity{16};
+    while (capacity < 2 * expectedCount)
+    {
+        capacity <<= 1;
+    }
+    rehash(capacity);
+}
+
+inline std::size_t VertexWeldTable::capacity() const noexcept
+{
+    return slots_.size();
+}
+
+inline std::size_t
+VertexWeldTable::estimateVertexCount(std::size_t positionCount,
+                                     std::size_t triangleCount) noexcept
+{
+    // A closed manifold has about half as many vertices as triangles, and
+    // never fewer unique corners than referenced positions.
+    return std::min(3 * triangleCount,
+                    std::max(positionCount, triangleCount / 2));
+}
+
+inline std::size_t VertexWeldTable::hash(std::uint64_t positionAndTexture,
+                                         std::uint32_t normal) noexcept
+{
+    std::uint64_t value{positionAndTexture ^
+                        (static_cast<std::uint64_t>(normal) << 21)};
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return static_cast<std::size_t>(value);
+}
+
+inline VertexWeldTable::IndexType VertexWeldTable::insert(const VertexKey &key,
+                                                          bool &inserted)
+{
+    const std::uint64_t positionAndTexture{pack(key)};
+    const std::uint32_t normal{static_cast<std::uint32_t>(key.normal)};
+
+    for (std::size_t i{hash(positionAndTexture, normal) & mask_};;
+         i = (i + 1) & mask_)
+    {
+        Slot &slot{slots_[i]};
+
+        if (slot.value == emptyValue)
+        {
+            if (size_ >= growThreshold_)
+            {
+                rehash(2 * slots_.size());
+                return insert(key, inserted);
+            }
+
+            slot.positionAndTexture = positionAndTexture;
+            slot.normal = normal;
+            slot.value = static_cast<IndexType>(size_++);
+            inserted = true;
+            return slot.value;
+        }
+
+        if (slot.positionAndTexture == positionAndTexture &&
+            slot.normal == normal)
+        {
+            inserted = false;
+            return slot.value;
+        }
+    }
+}
+
+inline std::uint64_t VertexWeldTable::pack(const VertexKey &key) noexcept
+{
+    return static_cast<std::uint64_t>(
+               static_cast<std::uint32_t>(key.position)) |
+           static_cast<std::uint64_t>(
+               static_cast<std::uint32_t>(key.textureCoordinate))
+               << 32;
+}
+
+inline void VertexWeldTable::rehash(std::size_t capacity)
+{
+    std::vector<Slot> slots(capacity, Slot{0, 0, emptyValue});
+    const std::size_t mask{capacity - 1};
+
+    for (const Slot &slot : slots_)
+    {
+        if (slot.value == emptyValue)
+        {
+            continue;
+        }
+
+        std::size_t i{hash(slot.positionAndTexture, slot.normal) & mask};
+        while (slots[i].value != emptyValue)
+        {
+            i = (i + 1) & mask;
+        }
+        slots[i] = slot;
+    }
+
+    slots_.swap(slots);
+    mask_ = mask;
+    growThreshold_ = capacity / 4 * 3;
+}
+
+inline std::size_t VertexWeldTable::size() const noexcept { return size_; }
+
+} // namespace Detail
+
+} // namespace Model
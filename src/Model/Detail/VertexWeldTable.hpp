@@ -0,0 +1,72 @@
+#ifndef HOMEWORK01_MODEL_DETAIL_VERTEXWELDTABLE_HPP_
+#define HOMEWORK01_MODEL_DETAIL_VERTEXWELDTABLE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Resolved zero-based attribute indices of one face corner, -1 if absent.
+struct VertexKey
+{
+    std::int32_t position;
+    std::int32_t textureCoordinate;
+    std::int32_t normal;
+};
+
+// Open addressing (linear probing) map from VertexKey to the index of the
+// welded vertex. A slot packs the key and its value into 16 bytes, so four
+// slots share a cache line and a lookup rarely touches more than one.
+class VertexWeldTable
+{
+public:
+    using IndexType = unsigned int;
+
+    explicit VertexWeldTable(std::size_t expectedCount);
+
+    // Returns the index stored for key, or inserts key with the next free
+    // index (the current size) and sets inserted.
+    IndexType insert(const VertexKey &key, bool &inserted);
+
+    std::size_t size() const noexcept;
+    std::size_t capacity() const noexcept;
+
+    // Expected number of unique corners of a triangle soup, used to size the
+    // table before welding.
+    static std::size_t estimateVertexCount(std::size_t positionCount,
+                                           std::size_t triangleCount) noexcept;
+
+private:
+    struct Slot
+    {
+        std::uint64_t positionAndTexture;
+        std::uint32_t normal;
+        IndexType value;
+    };
+
+    static constexpr IndexType emptyValue{~IndexType{0}};
+
+    static std::uint64_t pack(const VertexKey &key) noexcept;
+    static std::size_t hash(std::uint64_t positionAndTexture,
+                            std::uint32_t normal) noexcept;
+
+    void rehash(std::size_t capacity);
+
+    std::vector<Slot> slots_;
+    std::size_t mask_;
+    std::size_t size_;
+    std::size_t growThreshold_;
+};
+
+} // namespace Detail
+
+} // namespace Model
+
+#include "VertexWeldTable-inl.hpp"
+
+#endif // HOMEWORK01_MODEL_DETAIL_VERTEXWELDTABLE_HPP_
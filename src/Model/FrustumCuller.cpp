@@ -0,0 +1,148 @@
+#include "FrustumCuller.hpp"
+
+#include "Detail/FrustumPlanes.hpp"
+
+#include "Utils/Parallel/ParallelFor.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+#include "Utils/Simd/Float4.hpp"
+
+#include "glm/geometric.hpp"
+#include "glm/vec4.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+constexpr std::size_t groupFloats{40};
+
+// Objects per task, a multiple of four; a list shorter than one block is
+// culled on the calling thread.
+constexpr std::size_t cullBlockObjects{1u << 15};
+
+// Bit i is set if object i of the group lies outside a plane. The box is
+// tested at its corner furthest along the plane normal.
+int outsideMask(const float *group, const glm::vec4 (&planes)[6]) noexcept;
+
+inline int outsideMask(const float *group,
+                       const glm::vec4 (&planes)[6]) noexcept
+{
+    const Simd::Float4 zero{Simd::broadcast(0.0f)};
+    const Simd::Float4 centerX{Simd::load(group)};
+    const Simd::Float4 centerY{Simd::load(group + 4)};
+    const Simd::Float4 centerZ{Simd::load(group + 8)};
+    const Simd::Float4 radius{Simd::load(group + 12)};
+    const Simd::Float4 minimumX{Simd::load(group + 16)};
+    const Simd::Float4 minimumY{Simd::load(group + 20)};
+    const Simd::Float4 minimumZ{Simd::load(group + 24)};
+    const Simd::Float4 maximumX{Simd::load(group + 28)};
+    const Simd::Float4 maximumY{Simd::load(group + 32)};
+    const Simd::Float4 maximumZ{Simd::load(group + 36)};
+
+    Simd::Float4 outside{Simd::lessThan(zero, zero)};
+    for (const glm::vec4 &plane : planes)
+    {
+        const Simd::Float4 a{Simd::broadcast(plane.x)};
+        const Simd::Float4 b{Simd::broadcast(plane.y)};
+        const Simd::Float4 c{Simd::broadcast(plane.z)};
+        const Simd::Float4 d{Simd::broadcast(plane.w)};
+
+        const Simd::Float4 sphere{a * centerX + b * centerY + c * centerZ +
+                                  d + radius};
+        const Simd::Float4 box{
+            a * (plane.x >= 0.0f ? maximumX : minimumX) +
+            b * (plane.y >= 0.0f ? maximumY : minimumY) +
+            c * (plane.z >= 0.0f ? maximumZ : minimumZ) + d};
+        outside = Simd::maskOr(
+            outside, Simd::maskOr(Simd::lessThan(sphere, zero),
+                                  Simd::lessThan(box, zero)));
+    }
+    return Simd::moveMask(outside);
+}
+
+} // namespace Detail
+
+FrustumCuller::FrustumCuller(unsigned int threadCount) noexcept
+    : threadCount_{threadCount}, statistics_{}, objectCount_{0}, groups_{}
+{
+}
+
+void FrustumCuller::add(const Bounds &bounds, const BoundingSphere &sphere)
+{
+    const std::size_t lane{objectCount_ % 4};
+    if (!lane)
+    {
+        groups_.resize(groups_.size() + Detail::groupFloats, 0.0f);
+    }
+
+    float *group{groups_.data() + groups_.size() - Detail::groupFloats};
+    const float values[10]{sphere.center.x,  sphere.center.y,
+                           sphere.center.z,  sphere.radius,
+                           bounds.minimum.x, bounds.minimum.y,
+                           bounds.minimum.z, bounds.maximum.x,
+                           bounds.maximum.y, bounds.maximum.z};
+    for (std::size_t i{0}; i < 10; ++i)
+    {
+        group[4 * i + lane] = values[i];
+    }
+    ++objectCount_;
+}
+
+void FrustumCuller::clear() noexcept
+{
+    objectCount_ = 0;
+    groups_.clear();
+}
+
+void FrustumCuller::cull(const glm::mat4 &viewProjection,
+                         std::vector<unsigned char> &visible)
+{
+    Performance::Stopwatch stopwatch;
+
+    glm::vec4 planes[6];
+    Detail::frustumPlanes(viewProjection, planes);
+
+    visible.resize(objectCount_);
+    std::atomic<std::size_t> culled{0};
+
+    const std::size_t blockCount{
+        (objectCount_ + Detail::cullBlockObjects - 1) /
+        Detail::cullBlockObjects};
+    const unsigned int threadCount{blockCount > 1 ? threadCount_ : 1u};
+    Parallel::ParallelFor(blockCount, threadCount, [&](std::size_t block) {
+        const std::size_t first{block * Detail::cullBlockObjects};
+        const std::size_t last{
+            std::min(first + Detail::cullBlockObjects, objectCount_)};
+
+        std::size_t outside{0};
+        for (std::size_t object{first}; object < last; object += 4)
+        {
+            const int mask{Detail::outsideMask(
+                groups_.data() + object / 4 * Detail::groupFloats, planes)};
+            const std::size_t lanes{std::min<std::size_t>(4, last - object)};
+            for (std::size_t lane{0}; lane < lanes; ++lane)
+            {
+                const bool hidden{(mask >> lane & 1) != 0};
+                visible[object + lane] = hidden ? 0 : 1;
+                outside += hidden ? 1 : 0;
+            }
+        }
+        culled += outside;
+    });
+
+    statistics_ = Statistics{objectCount_, objectCount_ - culled.load(),
+                             culled.load(), stopwatch.elapsedMilliseconds()};
+}
+
+std::size_t FrustumCuller::size() const noexcept { return objectCount_; }
+
+const FrustumCuller::Statistics &FrustumCuller::statistics() const noexcept
+{
+    return statistics_;
+}
+
+} // namespace Model
@@ -0,0 +1,62 @@
+#ifndef HOMEWORK01_MODEL_FRUSTUMCULLER_HPP_
+#define HOMEWORK01_MODEL_FRUSTUMCULLER_HPP_
+
+#include "MeshData.hpp"
+
+#include "glm/mat4x4.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace Model
+{
+
+struct FrustumCullStatistics
+{
+    std::size_t objectCount;
+    std::size_t visibleCount;
+    std::size_t culledCount;
+    double cullMilliseconds;
+};
+
+// Tests whole objects against the view frustum before they are drawn. Every
+// object is given as a world space box and sphere, and is culled when
+// either lies outside one of the six planes. The bounds are kept four
+// objects to a group, one array per component, so one SIMD test checks a
+// plane against four objects; long lists are split into blocks tested on
+// up to threadCount threads (0 = every hardware thread).
+class FrustumCuller
+{
+public:
+    using Statistics = FrustumCullStatistics;
+
+    explicit FrustumCuller(unsigned int threadCount = 0) noexcept;
+
+    // Objects are numbered in the order they are added.
+    void add(const Bounds &bounds, const BoundingSphere &sphere);
+    void clear() noexcept;
+    std::size_t size() const noexcept;
+
+    // Sets visible[i] to whether object i may be seen through
+    // viewProjection.
+    void cull(const glm::mat4 &viewProjection,
+              std::vector<unsigned char> &visible);
+
+    // Of the last cull.
+    const Statistics &statistics() const noexcept;
+
+private:
+    unsigned int threadCount_;
+
+    Statistics statistics_;
+
+    std::size_t objectCount_;
+    // groupFloats floats per group of four objects: sphere center x, y, z
+    // and radius, then box minimum x, y, z and maximum x, y, z, each for
+    // the four objects side by side. Lanes past the last object are zero.
+    std::vector<float> groups_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_FRUSTUMCULLER_HPP_
@@ -0,0 +1,525 @@
+#include "GeometryArena.hpp"
+
+#include "Utils/Global.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Smallest buffers allocated, so a scene of small parts does not regrow
+// them part after part.
+constexpr std::size_t minimumArenaVertices{1u << 16};
+constexpr std::size_t minimumArenaIndices{1u << 18};
+
+// Shader location of the first column of the draw model matrix, and of
+// the material color read per slot in its place of the vertex colors.
+constexpr GLuint arenaModelLocation{5};
+constexpr GLuint arenaColorLocation{ColorAttribute::location};
+
+// Commands a frame region holds at first; it grows with the draws.
+constexpr std::size_t minimumStreamCommands{1u << 12};
+
+// Frames the CPU may run ahead of the GPU before a region is waited on.
+constexpr GLuint streamFrameCount{3};
+
+Bounds arenaWorldBounds(const Bounds &bounds,
+                        const glm::mat4 &matrix) noexcept;
+
+inline Bounds arenaWorldBounds(const Bounds &bounds,
+                               const glm::mat4 &matrix) noexcept
+{
+    const glm::vec3 center{
+        matrix * glm::vec4{0.5f * (bounds.minimum + bounds.maximum), 1.0f}};
+    const glm::vec3 extent{0.5f * (bounds.maximum - bounds.minimum)};
+    const glm::vec3 transformedExtent{
+        glm::abs(glm::vec3{matrix[0]}) * extent.x +
+        glm::abs(glm::vec3{matrix[1]}) * extent.y +
+        glm::abs(glm::vec3{matrix[2]}) * extent.z};
+    return Bounds{center - transformedExtent, center + transformedExtent};
+}
+
+} // namespace Detail
+
+GeometryArena::GeometryArena(ShaderProgramType &shaderProgram,
+                             VertexCompression compression)
+    : shaderProgram_{&shaderProgram}, compression_{compression}, stride_{0},
+      vertexSetUp_{nullptr}, vertexWriter_{nullptr},
+      vertexArrayObject_{new VertexArrayObjectType{}}, vertexBuffer_{nullptr},
+      indexBuffer_{nullptr},
+      commandStream_{new OpenGL::OpenGLStreamBuffer{
+          OpenGL::OpenGLBufferObject::Type::DrawIndirectBuffer,
+          static_cast<GLsizeiptr>(sizeof(OpenGL::DrawElementsIndirectCommand) *
+                                  Detail::minimumStreamCommands),
+          Detail::streamFrameCount}},
+      vertexCapacity_{0}, indexCapacity_{0}, materials_{}, parts_{},
+      geometries_{}, draws_{}, freeDraws_{}, instances_{}, instanceParts_{},
+      colorBuffer_{new BufferObjectType{
+          OpenGL::OpenGLBufferObject::Type::ArrayBuffer,
+          OpenGL::OpenGLBufferObject::UsagePattern::DynamicDraw}},
+      colors_{}, commands_{}, runTextures_{}, runOffsets_{},
+      commandsDirty_{false}, culler_{}, visible_{}, cullerDirty_{false},
+      frameCommands_{}, frameRunOffsets_{}, frameOffset_{0}, staging_{},
+      objects_{nullptr}, objectIndex_{0}, statistics_{}
+{
+    PROGRAM_ASSERT(OpenGL::OpenGLDrawIndirect::available());
+
+    if (compression_ == VertexCompression::HalfFloat)
+    {
+        selectLayout<InterleavedLayout<HalfPositionAttribute,
+                                       OctahedralNormalAttribute,
+                                       TextureCoordinateAttribute>>();
+    }
+    else if (compression_ == VertexCompression::Normalized16)
+    {
+        selectLayout<InterleavedLayout<Normalized16PositionAttribute,
+                                       OctahedralNormalAttribute,
+                                       TextureCoordinateAttribute>>();
+    }
+    else
+    {
+        selectLayout<InterleavedLayout<PositionAttribute, NormalAttribute,
+                                       TextureCoordinateAttribute>>();
+    }
+
+    vertexArrayObject_->bind();
+    instances_.setUpAttributes(*shaderProgram_, Detail::arenaModelLocation);
+    colorBuffer_->bind();
+    shaderProgram_->enableAttributeArray(Detail::arenaColorLocation);
+    shaderProgram_->mapAttributePointer(Detail::arenaColorLocation, 4,
+                                        GL_FLOAT, GL_FALSE,
+                                        sizeof(glm::vec4), 0);
+    shaderProgram_->setAttributeDivisor(Detail::arenaColorLocation, 1);
+    vertexArrayObject_->release();
+}
+
+// Every part gets an instance of its own, all with the same matrix.
+GeometryArena::Draw GeometryArena::addDraw(Geometry geometry,
+                                           const glm::mat4 &model)
+{
+    PROGRAM_ASSERT(geometry < geometries_.size());
+
+    Draw draw{static_cast<Draw>(draws_.size())};
+    if (freeDraws_.empty())
+    {
+        draws_.emplace_back();
+    }
+    else
+    {
+        draw = freeDraws_.back();
+        freeDraws_.pop_back();
+    }
+
+    const GeometryRange &range{geometries_[geometry]};
+    DrawRecord &record{draws_[draw]};
+    record.geometry = geometry;
+    record.instances.clear();
+    for (std::uint32_t part{0}; part < range.partCount; ++part)
+    {
+        const InstanceBuffer::Handle instance{
+            instances_.add(model * range.decode)};
+        if (instance >= instanceParts_.size())
+        {
+            instanceParts_.resize(instance + 1);
+        }
+        instanceParts_[instance] = range.firstPart + part;
+        record.instances.push_back(instance);
+    }
+
+    commandsDirty_ = true;
+    cullerDirty_ = true;
+    statistics_.drawCount = draws_.size() - freeDraws_.size();
+    statistics_.partCount = instances_.size();
+    return draw;
+}
+
+GeometryArena::Geometry
+GeometryArena::addGeometry(const MeshView &view,
+                           const std::vector<Material> &materials,
+                           Material fallback)
+{
+    PROGRAM_ASSERT(fallback < materials_.size());
+
+    const std::size_t firstVertex{statistics_.vertexCount};
+    const std::size_t firstIndex{statistics_.indexCount};
+    reserve(firstVertex + view.vertexCount, firstIndex + view.indexCount);
+
+    // Streams of the layout that the view lacks read as zero.
+    std::vector<float> zeros;
+    MeshView chunk{view};
+    if (!chunk.normals || !chunk.textureCoordinates)
+    {
+        zeros.assign(3 * view.vertexCount, 0.0f);
+        chunk.normals = chunk.normals ? chunk.normals : zeros.data();
+        chunk.textureCoordinates =
+            chunk.textureCoordinates ? chunk.textureCoordinates : zeros.data();
+    }
+
+    // Only positions and normals are compressed; the texture coordinates
+    // are left as they are.
+    const VertexQuantization quantization{
+        VertexQuantizer::fit(view, compression_)};
+
+    // The element buffer binding belongs to the vertex array object.
+    vertexArrayObject_->bind();
+    BufferObjectType *buffers[]{vertexBuffer_.get()};
+    vertexWriter_(buffers, firstVertex, chunk, quantization, staging_);
+    indexBuffer_->bind();
+    indexBuffer_->writeBufferSubData(
+        static_cast<GLintptr>(sizeof(MeshView::IndexType) * firstIndex),
+        view.indices,
+        static_cast<GLsizeiptr>(sizeof(MeshView::IndexType) *
+                                view.indexCount));
+    vertexArrayObject_->release();
+
+    const Geometry geometry{static_cast<Geometry>(geometries_.size())};
+    const std::uint32_t firstPart{static_cast<std::uint32_t>(parts_.size())};
+    for (std::size_t i{0}; i < view.subMeshCount; ++i)
+    {
+        const SubMesh &subMesh{view.subMeshes[i]};
+        const std::size_t material{
+            static_cast<std::size_t>(subMesh.materialIndex)};
+        const bool hasMaterial{subMesh.materialIndex >= 0 &&
+                               material < materials.size()};
+        PROGRAM_ASSERT(!hasMaterial || materials[material] < materials_.size());
+        parts_.push_back(PartRange{
+            geometry,
+            static_cast<std::uint32_t>(firstIndex + subMesh.indexOffset),
+            subMesh.indexCount, hasMaterial ? materials[material] : fallback});
+    }
+    if (!view.subMeshCount)
+    {
+        parts_.push_back(PartRange{
+            geometry, static_cast<std::uint32_t>(firstIndex),
+            static_cast<std::uint32_t>(view.indexCount), fallback});
+    }
+
+    geometries_.push_back(GeometryRange{
+        firstPart, static_cast<std::uint32_t>(parts_.size() - firstPart),
+        static_cast<std::int32_t>(firstVertex),
+        Bounds{(view.bounds.minimum - quantization.positionOffset) /
+                   quantization.positionScale,
+               (view.bounds.maximum - quantization.positionOffset) /
+                   quantization.positionScale},
+        glm::scale(glm::translate(glm::mat4{1.0f},
+                                  quantization.positionOffset),
+                   quantization.positionScale)});
+    statistics_.geometryCount = geometries_.size();
+    statistics_.vertexCount += view.vertexCount;
+    statistics_.indexCount += view.indexCount;
+    return geometry;
+}
+
+GeometryArena::Material GeometryArena::addMaterial(TextureType *texture,
+                                                   const glm::vec4 &color)
+{
+    materials_.push_back(MaterialState{texture, color});
+    return static_cast<Material>(materials_.size() - 1);
+}
+
+// One command per part, grouped by the texture of its material so every
+// texture takes one submission. Within a texture parts keep their slot
+// order. The colors of the materials go to the color buffer by slot.
+void GeometryArena::buildCommands()
+{
+    const auto texture = [this](std::uint32_t slot) {
+        return materials_[parts_[instanceParts_[instances_.handle(slot)]]
+                              .material]
+            .texture;
+    };
+    std::vector<std::uint32_t> slots(instances_.size());
+    std::iota(slots.begin(), slots.end(), 0u);
+    std::stable_sort(slots.begin(), slots.end(),
+                     [&texture](std::uint32_t lhs, std::uint32_t rhs) {
+                         return std::less<TextureType *>{}(texture(lhs),
+                                                           texture(rhs));
+                     });
+
+    commands_.clear();
+    runTextures_.clear();
+    runOffsets_.clear();
+    colors_.resize(instances_.size());
+    for (std::uint32_t slot : slots)
+    {
+        const PartRange &part{parts_[instanceParts_[instances_.handle(slot)]]};
+        const MaterialState &material{materials_[part.material]};
+        if (runTextures_.empty() || material.texture != runTextures_.back())
+        {
+            runTextures_.push_back(material.texture);
+            runOffsets_.push_back(commands_.size());
+        }
+        commands_.push_back(OpenGL::DrawElementsIndirectCommand{
+            part.indexCount, 1, part.firstIndex,
+            geometries_[part.geometry].baseVertex, slot});
+        colors_[slot] = material.color;
+    }
+    runOffsets_.push_back(commands_.size());
+
+    colorBuffer_->bind();
+    colorBuffer_->allocateBufferData(
+        colors_.data(),
+        static_cast<GLsizeiptr>(sizeof(glm::vec4) * colors_.size()));
+    commandsDirty_ = false;
+}
+
+// Culled by slot, the base instance of each command.
+void GeometryArena::buildCuller()
+{
+    culler_.clear();
+    for (std::uint32_t slot{0}; slot < instances_.size(); ++slot)
+    {
+        const InstanceBuffer::Handle handle{instances_.handle(slot)};
+        const Bounds bounds{Detail::arenaWorldBounds(
+            geometries_[parts_[instanceParts_[handle]].geometry].bounds,
+            instances_.model(handle))};
+        culler_.add(bounds,
+                    BoundingSphere{0.5f * (bounds.minimum + bounds.maximum),
+                                   0.5f * glm::length(bounds.maximum -
+                                                      bounds.minimum)});
+    }
+    cullerDirty_ = false;
+}
+
+void GeometryArena::draw(const glm::mat4 &view, const glm::mat4 &projection)
+{
+    Performance::Stopwatch stopwatch;
+    statistics_.submissionCount = 0;
+
+    if (!instances_.empty())
+    {
+        if (commandsDirty_)
+        {
+            buildCommands();
+        }
+        if (cullerDirty_)
+        {
+            buildCuller();
+        }
+        culler_.cull(projection * view, visible_);
+        statistics_.visiblePartCount = culler_.statistics().visibleCount;
+        statistics_.culledPartCount = culler_.statistics().culledCount;
+        instances_.upload();
+        writeCommands();
+
+        PROGRAM_ASSERT(objects_ && objectIndex_ < objects_->size());
+        shaderProgram_->use();
+        objects_->bind(objectIndex_);
+
+        vertexArrayObject_->bind();
+        commandStream_->bind();
+        for (std::size_t run{0}; run < runTextures_.size(); ++run)
+        {
+            const std::size_t count{frameRunOffsets_[run + 1] -
+                                    frameRunOffsets_[run]};
+            if (!count)
+            {
+                continue;
+            }
+            if (runTextures_[run])
+            {
+                runTextures_[run]->bind();
+            }
+            OpenGL::OpenGLDrawIndirect::multiDrawElements(
+                GL_UNSIGNED_INT,
+                frameOffset_ +
+                    static_cast<GLintptr>(
+                        sizeof(OpenGL::DrawElementsIndirectCommand) *
+                        frameRunOffsets_[run]),
+                static_cast<GLsizei>(count));
+            ++statistics_.submissionCount;
+        }
+        commandStream_->endFrame();
+    }
+
+    statistics_.submitMilliseconds = stopwatch.elapsedMilliseconds();
+}
+
+void GeometryArena::removeDraw(Draw draw)
+{
+    DrawRecord &record{draws_[draw]};
+    for (InstanceBuffer::Handle instance : record.instances)
+    {
+        instances_.remove(instance);
+    }
+    record.instances.clear();
+    freeDraws_.push_back(draw);
+
+    commandsDirty_ = true;
+    cullerDirty_ = true;
+    statistics_.drawCount = draws_.size() - freeDraws_.size();
+    statistics_.partCount = instances_.size();
+}
+
+// Moves to larger buffers when needed, copying their contents on the GPU.
+void GeometryArena::reserve(std::size_t vertexCount, std::size_t indexCount)
+{
+    bool grown{false};
+    vertexArrayObject_->bind();
+
+    if (vertexCount > vertexCapacity_)
+    {
+        const std::size_t capacity{std::max(
+            {vertexCount, 2 * vertexCapacity_, Detail::minimumArenaVertices})};
+        std::unique_ptr<BufferObjectType> buffer{new BufferObjectType{
+            OpenGL::OpenGLBufferObject::Type::ArrayBuffer,
+            OpenGL::OpenGLBufferObject::UsagePattern::StaticDraw}};
+        buffer->bind();
+        buffer->allocateBufferData(
+            nullptr, static_cast<GLsizeiptr>(stride_ * capacity));
+        if (statistics_.vertexCount)
+        {
+            buffer->copyBufferSubData(
+                *vertexBuffer_, 0, 0,
+                static_cast<GLsizeiptr>(stride_ *
+                                        statistics_.vertexCount));
+        }
+        vertexBuffer_ = std::move(buffer);
+        vertexCapacity_ = capacity;
+        grown = true;
+    }
+
+    if (indexCount > indexCapacity_)
+    {
+        const std::size_t capacity{std::max(
+            {indexCount, 2 * indexCapacity_, Detail::minimumArenaIndices})};
+        std::unique_ptr<BufferObjectType> buffer{new BufferObjectType{
+            OpenGL::OpenGLBufferObject::Type::ElementArrayBuffer,
+            OpenGL::OpenGLBufferObject::UsagePattern::StaticDraw}};
+        buffer->bind();
+        buffer->allocateBufferData(
+            nullptr, static_cast<GLsizeiptr>(sizeof(MeshView::IndexType) *
+                                             capacity));
+        if (statistics_.indexCount)
+        {
+            buffer->copyBufferSubData(
+                *indexBuffer_, 0, 0,
+                static_cast<GLsizeiptr>(sizeof(MeshView::IndexType) *
+                                        statistics_.indexCount));
+        }
+        indexBuffer_ = std::move(buffer);
+        indexCapacity_ = capacity;
+        grown = true;
+    }
+
+    vertexArrayObject_->release();
+    if (grown)
+    {
+        setUpVertexArray();
+    }
+}
+
+template <typename Layout>
+void GeometryArena::selectLayout() noexcept
+{
+    stride_ = Layout::stride;
+    vertexSetUp_ = &Layout::setUp;
+    vertexWriter_ = &Layout::write;
+}
+
+void GeometryArena::setDraw(Draw draw, const glm::mat4 &model)
+{
+    const DrawRecord &record{draws_[draw]};
+    const glm::mat4 matrix{model * geometries_[record.geometry].decode};
+    for (InstanceBuffer::Handle instance : record.instances)
+    {
+        instances_.set(instance, matrix);
+    }
+    cullerDirty_ = true;
+}
+
+// Points the vertex attributes and the element buffer at the current
+// buffers; the slot attributes keep theirs.
+void GeometryArena::setUpVertexArray()
+{
+    vertexArrayObject_->bind();
+    BufferObjectType *buffers[]{vertexBuffer_.get()};
+    vertexSetUp_(*shaderProgram_, buffers, 0);
+    indexBuffer_->bind();
+    vertexArrayObject_->release();
+}
+
+const GeometryArena::Statistics &GeometryArena::statistics() const noexcept
+{
+    return statistics_;
+}
+
+const OpenGL::OpenGLStreamBuffer::Statistics &
+GeometryArena::streamStatistics() const noexcept
+{
+    return commandStream_->statistics();
+}
+
+// Compacts the commands of the visible parts, run by run, and copies them
+// into the region of the frame in one pass. A region too small for every
+// command is replaced by a larger ring.
+void GeometryArena::writeCommands()
+{
+    frameCommands_.clear();
+    frameRunOffsets_.clear();
+    for (std::size_t run{0}; run < runTextures_.size(); ++run)
+    {
+        frameRunOffsets_.push_back(frameCommands_.size());
+        for (std::size_t i{runOffsets_[run]}; i < runOffsets_[run + 1]; ++i)
+        {
+            if (visible_[commands_[i].baseInstance])
+            {
+                frameCommands_.push_back(commands_[i]);
+            }
+        }
+    }
+    frameRunOffsets_.push_back(frameCommands_.size());
+
+    const GLsizeiptr size{static_cast<GLsizeiptr>(
+        sizeof(OpenGL::DrawElementsIndirectCommand) * commands_.size())};
+    const OpenGL::OpenGLStreamBuffer::Statistics &stream{
+        commandStream_->statistics()};
+    if (size > stream.regionSize)
+    {
+        commandStream_.reset(new OpenGL::OpenGLStreamBuffer{
+            OpenGL::OpenGLBufferObject::Type::DrawIndirectBuffer,
+            std::max(size, 2 * stream.regionSize), stream.regionCount});
+    }
+
+    commandStream_->beginFrame();
+    frameOffset_ = 0;
+    if (!frameCommands_.empty())
+    {
+        const GLsizeiptr frameSize{static_cast<GLsizeiptr>(
+            sizeof(OpenGL::DrawElementsIndirectCommand) *
+            frameCommands_.size())};
+        void *data{commandStream_->allocate(
+            frameSize,
+            static_cast<GLsizeiptr>(
+                alignof(OpenGL::DrawElementsIndirectCommand)),
+            frameOffset_)};
+        PROGRAM_ASSERT(data != nullptr);
+        std::memcpy(data, frameCommands_.data(),
+                    static_cast<std::size_t>(frameSize));
+    }
+    commandStream_->flush();
+}
+
+void GeometryArena::writeObjects(ObjectUniformBuffer &objects)
+{
+    // Positions decode through the draw matrices.
+    VertexQuantization quantization{VertexQuantization::identity()};
+    quantization.octahedralNormals = compression_ != VertexCompression::None;
+
+    objects_ = &objects;
+    objectIndex_ = objects.append(
+        ObjectBlock::make(glm::mat4{1.0f}, quantization, true));
+}
+
+} // namespace Model
@@ -0,0 +1,208 @@
+#ifndef HOMEWORK01_MODEL_GEOMETRYARENA_HPP_
+#define HOMEWORK01_MODEL_GEOMETRYARENA_HPP_
+
+#include "FrustumCuller.hpp"
+#include "InstanceBuffer.hpp"
+#include "MeshData.hpp"
+#include "UniformBlocks.hpp"
+#include "VertexLayout.hpp"
+#include "VertexQuantizer.hpp"
+
+#include "OpenGL/OpenGLBufferObject.hpp"
+#include "OpenGL/OpenGLDrawIndirect.hpp"
+#include "OpenGL/OpenGLShaderProgram.hpp"
+#include "OpenGL/OpenGLStreamBuffer.hpp"
+#include "OpenGL/OpenGLTexture.hpp"
+#include "OpenGL/OpenGLVertexArrayObject.hpp"
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Model
+{
+
+struct GeometryArenaStatistics
+{
+    std::size_t geometryCount;
+    std::size_t drawCount;
+    // Sub-meshes of the draws, each drawn by a command of its own.
+    std::size_t partCount;
+    std::size_t vertexCount;
+    std::size_t indexCount;
+    // Of the last draw: glMultiDrawElementsIndirect calls, one per texture,
+    // and the CPU time spent submitting them.
+    std::size_t submissionCount;
+    double submitMilliseconds;
+    // Of the last draw: parts inside and outside the view frustum.
+    std::size_t visiblePartCount;
+    std::size_t culledPartCount;
+};
+
+// Static geometry of many meshes packed into one vertex buffer and one
+// index buffer behind a single vertex array object, drawn with one
+// glMultiDrawElementsIndirect per texture instead of a bind and a draw per
+// sub-mesh. A geometry is added once and drawn any number of times. Every
+// sub-mesh of a draw is a part with a command and a slot of its own: the
+// slot holds the model matrix of the draw and the color of the material of
+// the part, read through instance attributes at base instance = slot, and
+// parts are grouped by the texture of their material.
+//
+// Parts are culled against the view frustum every frame, and the commands
+// of the visible ones are written into a ring of per-frame regions of a
+// stream buffer, so the GPU never reads a region while it is rewritten.
+//
+// Vertices keep positions, normals and texture coordinates, zero where the
+// view has none; the color comes from the material of the part. With
+// compression, positions and normals are stored as a compressed Mesh stores
+// them, each geometry spanning its own bounds, whose decoding goes into the
+// matrices of its draws; texture coordinates stay float, as the draws share
+// one Object block. Needs OpenGLDrawIndirect::available().
+class GeometryArena
+{
+public:
+    using Statistics = GeometryArenaStatistics;
+    using Geometry = std::uint32_t;
+    using Draw = std::uint32_t;
+    using Material = std::uint32_t;
+    using TextureType = OpenGL::OpenGLTexture;
+    using ShaderProgramType = OpenGL::OpenGLShaderProgram;
+    using BufferObjectType = OpenGL::OpenGLBufferObject;
+
+    explicit GeometryArena(
+        ShaderProgramType &shaderProgram,
+        VertexCompression compression = VertexCompression::None);
+
+    // A null texture leaves the bound one.
+    Material addMaterial(TextureType *texture, const glm::vec4 &color);
+    // Buffers grow geometrically, copying what they hold on the GPU. Every
+    // sub-mesh of view becomes a part drawn with materials[materialIndex];
+    // parts without one, or a view without sub-meshes, use fallback.
+    Geometry addGeometry(const MeshView &view,
+                         const std::vector<Material> &materials,
+                         Material fallback);
+    Draw addDraw(Geometry geometry, const glm::mat4 &model);
+    void removeDraw(Draw draw);
+    void setDraw(Draw draw, const glm::mat4 &model);
+
+    // Appends the Object block of every draw, identity with the model
+    // matrices as instances, as Mesh::writeObjects().
+    void writeObjects(ObjectUniformBuffer &objects);
+    void draw(const glm::mat4 &view, const glm::mat4 &projection);
+
+    const Statistics &statistics() const noexcept;
+    const OpenGL::OpenGLStreamBuffer::Statistics &
+    streamStatistics() const noexcept;
+
+private:
+    using VertexArrayObjectType = OpenGL::OpenGLVertexArrayObject;
+    using VertexSetUp = void (*)(ShaderProgramType &program,
+                                 BufferObjectType *const *buffers,
+                                 std::size_t bufferOffset);
+    using VertexWriter = void (*)(BufferObjectType *const *buffers,
+                                  std::size_t firstVertex,
+                                  const MeshView &chunk,
+                                  const VertexQuantization &quantization,
+                                  std::vector<unsigned char> &staging);
+
+    struct MaterialState
+    {
+        TextureType *texture;
+        glm::vec4 color;
+    };
+
+    struct PartRange
+    {
+        Geometry geometry;
+        std::uint32_t firstIndex;
+        std::uint32_t indexCount;
+        Material material;
+    };
+
+    struct GeometryRange
+    {
+        std::uint32_t firstPart;
+        std::uint32_t partCount;
+        std::int32_t baseVertex;
+        // Of the stored positions, which decode maps to model space.
+        Bounds bounds;
+        glm::mat4 decode;
+    };
+
+    // The instances of a draw, one per part of its geometry.
+    struct DrawRecord
+    {
+        Geometry geometry;
+        std::vector<InstanceBuffer::Handle> instances;
+    };
+
+    void buildCommands();
+    void buildCuller();
+    void writeCommands();
+    void reserve(std::size_t vertexCount, std::size_t indexCount);
+    template <typename Layout>
+    void selectLayout() noexcept;
+    void setUpVertexArray();
+
+    ShaderProgramType *shaderProgram_;
+
+    // The interleaved layout of the compression.
+    VertexCompression compression_;
+    std::size_t stride_;
+    VertexSetUp vertexSetUp_;
+    VertexWriter vertexWriter_;
+
+    std::unique_ptr<VertexArrayObjectType> vertexArrayObject_;
+    std::unique_ptr<BufferObjectType> vertexBuffer_;
+    std::unique_ptr<BufferObjectType> indexBuffer_;
+    std::unique_ptr<OpenGL::OpenGLStreamBuffer> commandStream_;
+    std::size_t vertexCapacity_;
+    std::size_t indexCapacity_;
+
+    std::vector<MaterialState> materials_;
+    std::vector<PartRange> parts_;
+    std::vector<GeometryRange> geometries_;
+    // By draw handle, and the handles of removed draws to give out again.
+    std::vector<DrawRecord> draws_;
+    std::vector<Draw> freeDraws_;
+    // The matrices of the parts, and the part of every instance handle.
+    InstanceBuffer instances_;
+    std::vector<std::uint32_t> instanceParts_;
+    // Material colors by slot, rebuilt with the commands.
+    std::unique_ptr<BufferObjectType> colorBuffer_;
+    std::vector<glm::vec4> colors_;
+
+    // Commands sorted by texture, rebuilt when draws are added or removed,
+    // and where each texture's run starts.
+    std::vector<OpenGL::DrawElementsIndirectCommand> commands_;
+    std::vector<TextureType *> runTextures_;
+    std::vector<std::size_t> runOffsets_;
+    bool commandsDirty_;
+
+    // World bounds of the parts by slot, rebuilt when a draw changes, and
+    // which of them the last cull kept.
+    FrustumCuller culler_;
+    std::vector<unsigned char> visible_;
+    bool cullerDirty_;
+    // Commands of the visible parts of the frame and where each run starts
+    // among them; the runs with no visible part stay empty.
+    std::vector<OpenGL::DrawElementsIndirectCommand> frameCommands_;
+    std::vector<std::size_t> frameRunOffsets_;
+    // Where they were written in the command stream.
+    GLintptr frameOffset_;
+
+    std::vector<unsigned char> staging_;
+
+    ObjectUniformBuffer *objects_;
+    std::size_t objectIndex_;
+
+    Statistics statistics_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_GEOMETRYARENA_HPP_
@@ -0,0 +1,777 @@
+#include "GltfLoader.hpp"
+
+#include "Utils/Base64/Base64.hpp"
+#include "Utils/FileIO/FilePath.hpp"
+#include "Utils/FileIO/MappedFile.hpp"
+#include "Utils/Json/Json.hpp"
+#include "Utils/Performance/MemoryUsage.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/quaternion.hpp"
+#include "glm/gtc/type_ptr.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// glTF component types, equal to the GL enums of the same name.
+constexpr std::uint32_t gltfByte{5120};
+constexpr std::uint32_t gltfUnsignedByte{5121};
+constexpr std::uint32_t gltfShort{5122};
+constexpr std::uint32_t gltfUnsignedShort{5123};
+constexpr std::uint32_t gltfUnsignedInt{5125};
+constexpr std::uint32_t gltfFloat{5126};
+
+constexpr std::uint32_t glbMagic{0x46546C67};
+constexpr std::uint32_t glbJsonChunk{0x4E4F534A};
+constexpr std::uint32_t glbBinaryChunk{0x004E4942};
+
+constexpr long long gltfTriangles{4};
+// Deeper node hierarchies are treated as cycles.
+constexpr int gltfMaximumNodeDepth{64};
+
+struct ByteRange
+{
+    const char *data;
+    std::size_t size;
+};
+
+std::uint32_t readUnsigned(const char *p) noexcept;
+std::size_t componentSize(std::uint32_t componentType) noexcept;
+std::uint32_t componentCount(const std::string &type) noexcept;
+int hexDigit(char c) noexcept;
+std::string decodeUri(const std::string &uri);
+bool isDataUri(const std::string &uri) noexcept;
+bool decodeDataUri(const std::string &uri, std::vector<unsigned char> &bytes);
+bool validAttribute(std::size_t slot, const GltfAccessor &accessor) noexcept;
+glm::vec3 vector3(const Json::Value &array, float fallback) noexcept;
+glm::vec4 vector4(const Json::Value &array, float fallback,
+                  float fallbackW) noexcept;
+glm::mat4 nodeTransform(const Json::Value &node);
+bool addNode(const Json::Value &document, long long node,
+             const glm::mat4 &parent, int depth,
+             const std::vector<std::vector<std::size_t>> &meshPrimitives,
+             std::vector<GltfDrawable> &drawables);
+
+inline std::uint32_t readUnsigned(const char *p) noexcept
+{
+    const unsigned char *bytes{reinterpret_cast<const unsigned char *>(p)};
+    return static_cast<std::uint32_t>(bytes[0]) |
+           static_cast<std::uint32_t>(bytes[1]) << 8 |
+           static_cast<std::uint32_t>(bytes[2]) << 16 |
+           static_cast<std::uint32_t>(bytes[3]) << 24;
+}
+
+inline std::size_t componentSize(std::uint32_t componentType) noexcept
+{
+    switch (componentType)
+    {
+    case gltfByte:
+    case gltfUnsignedByte:
+        return 1;
+    case gltfShort:
+    case gltfUnsignedShort:
+        return 2;
+    case gltfUnsignedInt:
+    case gltfFloat:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+inline std::uint32_t componentCount(const std::string &type) noexcept
+{
+    return type == "SCALAR" ? 1
+           : type == "VEC2" ? 2
+           : type == "VEC3" ? 3
+           : type == "VEC4" ? 4
+           : type == "MAT2" ? 4
+           : type == "MAT3" ? 9
+           : type == "MAT4" ? 16
+                            : 0;
+}
+
+inline int hexDigit(char c) noexcept
+{
+    return c >= '0' && c <= '9'   ? c - '0'
+           : c >= 'a' && c <= 'f' ? c - 'a' + 10
+           : c >= 'A' && c <= 'F' ? c - 'A' + 10
+                                  : -1;
+}
+
+// Relative URIs may be percent encoded.
+std::string decodeUri(const std::string &uri)
+{
+    std::string path;
+    for (std::size_t i{0}; i < uri.size(); ++i)
+    {
+        const int high{i + 2 < uri.size() ? hexDigit(uri[i + 1]) : -1};
+        const int low{i + 2 < uri.size() ? hexDigit(uri[i + 2]) : -1};
+        if (uri[i] == '%' && high >= 0 && low >= 0)
+        {
+            path += static_cast<char>(high * 16 + low);
+            i += 2;
+        }
+        else
+        {
+            path += uri[i];
+        }
+    }
+    return path;
+}
+
+inline bool isDataUri(const std::string &uri) noexcept
+{
+    return uri.compare(0, 5, "data:") == 0;
+}
+
+bool decodeDataUri(const std::string &uri, std::vector<unsigned char> &bytes)
+{
+    const std::size_t comma{uri.find(',')};
+    if (comma == std::string::npos ||
+        uri.rfind(";base64", comma) == std::string::npos)
+    {
+        return false;
+    }
+    return Base64::Decode(uri.data() + comma + 1, uri.size() - comma - 1,
+                          bytes);
+}
+
+// The formats the core specification allows for each attribute.
+bool validAttribute(std::size_t slot, const GltfAccessor &accessor) noexcept
+{
+    const std::uint32_t type{accessor.componentType};
+    switch (slot)
+    {
+    case 0:
+    case 1:
+        return type == gltfFloat && accessor.components == 3;
+    case 2:
+        return accessor.components == 2 &&
+               (type == gltfFloat ||
+                ((type == gltfUnsignedByte || type == gltfUnsignedShort) &&
+                 accessor.normalized));
+    case 3:
+        return (accessor.components == 3 || accessor.components == 4) &&
+               (type == gltfFloat ||
+                ((type == gltfUnsignedByte || type == gltfUnsignedShort) &&
+                 accessor.normalized));
+    case 4:
+        return type == gltfFloat && accessor.components == 4;
+    default:
+        return false;
+    }
+}
+
+// Missing elements take the fallback, matching the glTF defaults.
+inline glm::vec3 vector3(const Json::Value &array, float fallback) noexcept
+{
+    glm::vec3 value;
+    for (std::size_t i{0}; i < 3; ++i)
+    {
+        value[static_cast<int>(i)] =
+            static_cast<float>(array[i].number(fallback));
+    }
+    return value;
+}
+
+inline glm::vec4 vector4(const Json::Value &array, float fallback,
+                         float fallbackW) noexcept
+{
+    const std::size_t w{3};
+    return glm::vec4{vector3(array, fallback),
+                     static_cast<float>(array[w].number(fallbackW))};
+}
+
+glm::mat4 nodeTransform(const Json::Value &node)
+{
+    const Json::Value &matrix{node["matrix"]};
+    if (matrix.size() == 16)
+    {
+        float values[16];
+        for (std::size_t i{0}; i < 16; ++i)
+        {
+            values[i] = static_cast<float>(matrix[i].number());
+        }
+        // glTF matrices are column major, as glm stores them.
+        return glm::make_mat4(values);
+    }
+
+    glm::mat4 transform{1.0f};
+    transform = glm::translate(transform,
+                               vector3(node["translation"], 0.0f));
+    // Quaternions are stored as x, y, z, w.
+    const glm::vec4 rotation{vector4(node["rotation"], 0.0f, 1.0f)};
+    transform *= glm::mat4_cast(
+        glm::quat{rotation.w, rotation.x, rotation.y, rotation.z});
+    transform = glm::scale(transform, vector3(node["scale"], 1.0f));
+    return transform;
+}
+
+bool addNode(const Json::Value &document, long long node,
+             const glm::mat4 &parent, int depth,
+             const std::vector<std::vector<std::size_t>> &meshPrimitives,
+             std::vector<GltfDrawable> &drawables)
+{
+    const Json::Value &nodes{document["nodes"]};
+    if (node < 0 || static_cast<std::size_t>(node) >= nodes.size() ||
+        depth > gltfMaximumNodeDepth)
+    {
+        return false;
+    }
+
+    const Json::Value &value{nodes[static_cast<std::size_t>(node)]};
+    const glm::mat4 transform{parent * nodeTransform(value)};
+
+    const long long mesh{value["mesh"].integer(-1)};
+    if (mesh >= static_cast<long long>(meshPrimitives.size()))
+    {
+        return false;
+    }
+    if (mesh >= 0)
+    {
+        for (std::size_t primitive :
+             meshPrimitives[static_cast<std::size_t>(mesh)])
+        {
+            drawables.push_back(GltfDrawable{primitive, transform});
+        }
+    }
+
+    const Json::Value &children{value["children"]};
+    for (std::size_t i{0}; i < children.size(); ++i)
+    {
+        if (!addNode(document, children[i].integer(-1), transform, depth + 1,
+                     meshPrimitives, drawables))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace Detail
+
+GltfLoader::GltfLoader() noexcept
+    : errorMessage_{}, statistics_{0.0, 0, 0, 0, 0, 1}
+{
+}
+
+const std::string &GltfLoader::errorMessage() const noexcept
+{
+    return errorMessage_;
+}
+
+bool GltfLoader::load(const char *fileName, GltfScene &scene)
+{
+    Performance::Stopwatch stopwatch;
+
+    errorMessage_.clear();
+    statistics_ = Statistics{0.0, 0, 0, 0, 0, 1};
+    scene = GltfScene();
+
+    if (!scene.file.open(fileName))
+    {
+        errorMessage_ = std::string{"Cannot open glTF file: "} + fileName;
+        return false;
+    }
+
+    const char *const data{scene.file.data()};
+    const std::size_t size{scene.file.size()};
+
+    Detail::ByteRange json{data, size};
+    Detail::ByteRange binary{nullptr, 0};
+
+    // GLB: a 12 byte header, then a JSON chunk and an optional binary chunk.
+    if (size >= 12 && Detail::readUnsigned(data) == Detail::glbMagic)
+    {
+        if (Detail::readUnsigned(data + 4) != 2 ||
+            Detail::readUnsigned(data + 8) > size || size < 20)
+        {
+            errorMessage_ = "Unsupported or truncated GLB header\n";
+            return false;
+        }
+
+        const std::size_t length{Detail::readUnsigned(data + 8)};
+        std::size_t offset{12};
+        while (offset + 8 <= length)
+        {
+            const std::size_t chunkLength{Detail::readUnsigned(data + offset)};
+            const std::uint32_t chunkType{
+                Detail::readUnsigned(data + offset + 4)};
+            if (chunkLength > length - offset - 8)
+            {
+                errorMessage_ = "Truncated GLB chunk\n";
+                return false;
+            }
+
+            if (offset == 12 && chunkType != Detail::glbJsonChunk)
+            {
+                errorMessage_ = "GLB does not start with a JSON chunk\n";
+                return false;
+            }
+            if (chunkType == Detail::glbJsonChunk)
+            {
+                json = Detail::ByteRange{data + offset + 8, chunkLength};
+            }
+            else if (chunkType == Detail::glbBinaryChunk && !binary.data)
+            {
+                binary = Detail::ByteRange{data + offset + 8, chunkLength};
+            }
+            offset += 8 + chunkLength;
+        }
+    }
+
+    Json::Value document;
+    if (!Json::Parse(json.data, json.data + json.size, document,
+                     errorMessage_))
+    {
+        errorMessage_ += "\n";
+        return false;
+    }
+
+    if (document["asset"]["version"].string().compare(0, 1, "2") != 0)
+    {
+        errorMessage_ = "Only glTF 2.0 is supported\n";
+        return false;
+    }
+
+    const std::string directory{FileIO::DirectoryOf(fileName)};
+
+    // Buffers.
+    const Json::Value &buffers{document["buffers"]};
+    std::vector<Detail::ByteRange> bufferRanges;
+    for (std::size_t i{0}; i < buffers.size(); ++i)
+    {
+        const Json::Value &buffer{buffers[i]};
+        const std::size_t byteLength{
+            static_cast<std::size_t>(buffer["byteLength"].integer())};
+        const std::string &uri{buffer["uri"].string()};
+        Detail::ByteRange range{nullptr, 0};
+
+        if (uri.empty())
+        {
+            if (i != 0 || !binary.data)
+            {
+                errorMessage_ = "glTF buffer " + std::to_string(i) +
+                                " has no uri and no GLB chunk\n";
+                return false;
+            }
+            range = binary;
+        }
+        else if (Detail::isDataUri(uri))
+        {
+            scene.decodedBuffers.emplace_back();
+            if (!Detail::decodeDataUri(uri, scene.decodedBuffers.back()))
+            {
+                errorMessage_ = "Cannot decode data URI of glTF buffer " +
+                                std::to_string(i) + "\n";
+                return false;
+            }
+            range = Detail::ByteRange{
+                reinterpret_cast<const char *>(
+                    scene.decodedBuffers.back().data()),
+                scene.decodedBuffers.back().size()};
+        }
+        else
+        {
+            const std::string path{directory + Detail::decodeUri(uri)};
+            scene.externalBuffers.emplace_back();
+            if (!scene.externalBuffers.back().open(path.c_str()))
+            {
+                errorMessage_ = "Cannot open glTF buffer: " + path + "\n";
+                return false;
+            }
+            range = Detail::ByteRange{scene.externalBuffers.back().data(),
+                                      scene.externalBuffers.back().size()};
+        }
+
+        if (byteLength > range.size)
+        {
+            errorMessage_ =
+                "glTF buffer " + std::to_string(i) + " is truncated\n";
+            return false;
+        }
+        range.size = byteLength;
+        bufferRanges.push_back(range);
+    }
+
+    // Buffer views.
+    const Json::Value &bufferViews{document["bufferViews"]};
+    for (std::size_t i{0}; i < bufferViews.size(); ++i)
+    {
+        const Json::Value &view{bufferViews[i]};
+        const long long buffer{view["buffer"].integer(-1)};
+        const std::size_t offset{
+            static_cast<std::size_t>(view["byteOffset"].integer())};
+        const std::size_t length{
+            static_cast<std::size_t>(view["byteLength"].integer())};
+
+        if (buffer < 0 ||
+            static_cast<std::size_t>(buffer) >= bufferRanges.size() ||
+            offset > bufferRanges[static_cast<std::size_t>(buffer)].size ||
+            length >
+                bufferRanges[static_cast<std::size_t>(buffer)].size - offset)
+        {
+            errorMessage_ =
+                "glTF buffer view " + std::to_string(i) + " is out of range\n";
+            return false;
+        }
+
+        scene.bufferViews.push_back(GltfBufferView{
+            bufferRanges[static_cast<std::size_t>(buffer)].data + offset,
+            length, static_cast<std::size_t>(view["byteStride"].integer())});
+    }
+
+    // Accessors.
+    const Json::Value &accessors{document["accessors"]};
+    for (std::size_t i{0}; i < accessors.size(); ++i)
+    {
+        const Json::Value &value{accessors[i]};
+        GltfAccessor accessor{
+            static_cast<std::int32_t>(value["bufferView"].integer(-1)),
+            static_cast<std::size_t>(value["byteOffset"].integer()),
+            static_cast<std::size_t>(value["count"].integer()),
+            static_cast<std::uint32_t>(value["componentType"].integer()),
+            Detail::componentCount(value["type"].string()),
+            value["normalized"].boolean()};
+
+        const std::size_t elementSize{
+            Detail::componentSize(accessor.componentType) *
+            accessor.components};
+        if (value.contains("sparse") || accessor.bufferView < 0)
+        {
+            errorMessage_ = "glTF accessor " + std::to_string(i) +
+                            " is sparse or has no buffer view, which is not "
+                            "supported\n";
+            return false;
+        }
+        if (elementSize == 0 ||
+            static_cast<std::size_t>(accessor.bufferView) >=
+                scene.bufferViews.size())
+        {
+            errorMessage_ =
+                "glTF accessor " + std::to_string(i) + " is malformed\n";
+            return false;
+        }
+
+        const GltfBufferView &view{
+            scene.bufferViews[static_cast<std::size_t>(accessor.bufferView)]};
+        if (view.stride && view.stride < elementSize)
+        {
+            errorMessage_ =
+                "glTF accessor " + std::to_string(i) + " is malformed\n";
+            return false;
+        }
+
+        // Divided rather than multiplied, so a huge count cannot wrap
+        // around and pass.
+        const std::size_t stride{view.stride ? view.stride : elementSize};
+        if (accessor.count &&
+            (elementSize > view.size ||
+             accessor.offset > view.size - elementSize ||
+             accessor.count - 1 >
+                 (view.size - accessor.offset - elementSize) / stride))
+        {
+            errorMessage_ =
+                "glTF accessor " + std::to_string(i) + " is out of range\n";
+            return false;
+        }
+
+        scene.accessors.push_back(accessor);
+    }
+
+    // Images and the textures that name them.
+    const Json::Value &images{document["images"]};
+    for (std::size_t i{0}; i < images.size(); ++i)
+    {
+        const Json::Value &value{images[i]};
+        const std::string &uri{value["uri"].string()};
+        GltfImage image{nullptr, 0, std::string{}};
+
+        if (value.contains("bufferView"))
+        {
+            const long long view{value["bufferView"].integer(-1)};
+            if (view < 0 ||
+                static_cast<std::size_t>(view) >= scene.bufferViews.size())
+            {
+                errorMessage_ =
+                    "glTF image " + std::to_string(i) + " is malformed\n";
+                return false;
+            }
+            image.data = reinterpret_cast<const unsigned char *>(
+                scene.bufferViews[static_cast<std::size_t>(view)].data);
+            image.size = scene.bufferViews[static_cast<std::size_t>(view)].size;
+        }
+        else if (Detail::isDataUri(uri))
+        {
+            scene.decodedBuffers.emplace_back();
+            if (!Detail::decodeDataUri(uri, scene.decodedBuffers.back()))
+            {
+                errorMessage_ = "Cannot decode data URI of glTF image " +
+                                std::to_string(i) + "\n";
+                return false;
+            }
+            image.data = scene.decodedBuffers.back().data();
+            image.size = scene.decodedBuffers.back().size();
+        }
+        else
+        {
+            image.path = directory + Detail::decodeUri(uri);
+        }
+
+        scene.images.push_back(image);
+    }
+
+    const Json::Value &textures{document["textures"]};
+
+    // Materials. Only the base color is used.
+    const Json::Value &materials{document["materials"]};
+    for (std::size_t i{0}; i < materials.size(); ++i)
+    {
+        const Json::Value &pbr{materials[i]["pbrMetallicRoughness"]};
+        const long long texture{pbr["baseColorTexture"]["index"].integer(-1)};
+        const long long image{
+            texture >= 0 ? textures[static_cast<std::size_t>(texture)]
+                               ["source"]
+                                   .integer(-1)
+                         : -1};
+
+        scene.materials.push_back(GltfMaterial{
+            Detail::vector4(pbr["baseColorFactor"], 1.0f, 1.0f),
+            image < static_cast<long long>(scene.images.size())
+                ? static_cast<std::int32_t>(image)
+                : -1});
+    }
+
+    // Mesh primitives.
+    static const char *const attributeNames[]{"POSITION", "NORMAL",
+                                              "TEXCOORD_0", "COLOR_0",
+                                              "TANGENT"};
+
+    const Json::Value &meshes{document["meshes"]};
+    std::vector<std::vector<std::size_t>> meshPrimitives(meshes.size());
+    std::size_t skippedPrimitives{0};
+
+    for (std::size_t i{0}; i < meshes.size(); ++i)
+    {
+        const Json::Value &primitives{meshes[i]["primitives"]};
+        for (std::size_t j{0}; j < primitives.size(); ++j)
+        {
+            const Json::Value &value{primitives[j]};
+            if (value["mode"].integer(Detail::gltfTriangles) !=
+                Detail::gltfTriangles)
+            {
+                ++skippedPrimitives;
+                continue;
+            }
+
+            GltfPrimitive primitive{
+                {-1, -1, -1, -1, -1},
+                static_cast<std::int32_t>(value["indices"].integer(-1)),
+                static_cast<std::int32_t>(value["material"].integer(-1)),
+                Bounds{glm::vec3{0}, glm::vec3{0}}};
+
+            for (std::size_t slot{0}; slot < 5; ++slot)
+            {
+                const long long accessor{
+                    value["attributes"][attributeNames[slot]].integer(-1)};
+                if (accessor >=
+                        static_cast<long long>(scene.accessors.size()) ||
+                    (accessor >= 0 &&
+                     !Detail::validAttribute(
+                         slot,
+                         scene.accessors[static_cast<std::size_t>(accessor)])))
+                {
+                    errorMessage_ = "glTF mesh " + std::to_string(i) +
+                                    " has an unsupported " +
+                                    attributeNames[slot] + " accessor\n";
+                    return false;
+                }
+                primitive.attributes[slot] =
+                    static_cast<std::int32_t>(accessor);
+            }
+
+            if (primitive.attributes[0] < 0)
+            {
+                ++skippedPrimitives;
+                continue;
+            }
+
+            const GltfAccessor &positions{
+                scene.accessors[static_cast<std::size_t>(
+                    primitive.attributes[0])]};
+            for (std::size_t slot{1}; slot < 5; ++slot)
+            {
+                if (primitive.attributes[slot] >= 0 &&
+                    scene.accessors[static_cast<std::size_t>(
+                                        primitive.attributes[slot])]
+                            .count != positions.count)
+                {
+                    errorMessage_ = "glTF mesh " + std::to_string(i) +
+                                    " has attributes of different lengths\n";
+                    return false;
+                }
+            }
+
+            if (primitive.indices >= 0)
+            {
+                const std::size_t index{
+                    static_cast<std::size_t>(primitive.indices)};
+                const std::uint32_t type{
+                    index < scene.accessors.size()
+                        ? scene.accessors[index].componentType
+                        : 0};
+                if (index >= scene.accessors.size() ||
+                    scene.accessors[index].components != 1 ||
+                    (type != Detail::gltfUnsignedByte &&
+                     type != Detail::gltfUnsignedShort &&
+                     type != Detail::gltfUnsignedInt) ||
+                    scene.bufferViews[static_cast<std::size_t>(
+                                          scene.accessors[index].bufferView)]
+                        .stride)
+                {
+                    errorMessage_ = "glTF mesh " + std::to_string(i) +
+                                    " has an unsupported index accessor\n";
+                    return false;
+                }
+            }
+
+            if (primitive.material >=
+                static_cast<std::int32_t>(scene.materials.size()))
+            {
+                primitive.material = -1;
+            }
+
+            // POSITION must carry min and max; compute them otherwise.
+            const Json::Value &accessor{
+                accessors[static_cast<std::size_t>(primitive.attributes[0])]};
+            if (accessor["min"].size() == 3 && accessor["max"].size() == 3)
+            {
+                for (std::size_t k{0}; k < 3; ++k)
+                {
+                    primitive.bounds.minimum[static_cast<int>(k)] =
+                        static_cast<float>(accessor["min"][k].number());
+                    primitive.bounds.maximum[static_cast<int>(k)] =
+                        static_cast<float>(accessor["max"][k].number());
+                }
+            }
+            else
+            {
+                const GltfBufferView &view{
+                    scene.bufferViews[static_cast<std::size_t>(
+                        positions.bufferView)]};
+                const std::size_t stride{view.stride ? view.stride
+                                                     : 3 * sizeof(float)};
+                for (std::size_t k{0}; k < positions.count; ++k)
+                {
+                    glm::vec3 point;
+                    std::memcpy(&point[0],
+                                view.data + positions.offset + k * stride,
+                                3 * sizeof(float));
+                    primitive.bounds.minimum =
+                        k ? glm::min(primitive.bounds.minimum, point) : point;
+                    primitive.bounds.maximum =
+                        k ? glm::max(primitive.bounds.maximum, point) : point;
+                }
+            }
+
+            meshPrimitives[i].push_back(scene.primitives.size());
+            scene.primitives.push_back(primitive);
+
+            statistics_.vertexCount += positions.count;
+            statistics_.triangleCount +=
+                (primitive.indices >= 0
+                     ? scene.accessors[static_cast<std::size_t>(
+                                           primitive.indices)]
+                           .count
+                     : positions.count) /
+                3;
+        }
+    }
+
+    // Node hierarchy of the default scene, or of every root node when the
+    // asset has no scene.
+    const Json::Value &scenes{document["scenes"]};
+    std::vector<long long> roots;
+    if (scenes.size())
+    {
+        const Json::Value &nodes{
+            scenes[static_cast<std::size_t>(document["scene"].integer(0))]
+                  ["nodes"]};
+        for (std::size_t i{0}; i < nodes.size(); ++i)
+        {
+            roots.push_back(nodes[i].integer(-1));
+        }
+    }
+    else
+    {
+        const Json::Value &nodes{document["nodes"]};
+        std::vector<bool> isChild(nodes.size(), false);
+        for (std::size_t i{0}; i < nodes.size(); ++i)
+        {
+            const Json::Value &children{nodes[i]["children"]};
+            for (std::size_t j{0}; j < children.size(); ++j)
+            {
+                const long long child{children[j].integer(-1)};
+                if (child >= 0 &&
+                    static_cast<std::size_t>(child) < nodes.size())
+                {
+                    isChild[static_cast<std::size_t>(child)] = true;
+                }
+            }
+        }
+        for (std::size_t i{0}; i < nodes.size(); ++i)
+        {
+            if (!isChild[i])
+            {
+                roots.push_back(static_cast<long long>(i));
+            }
+        }
+    }
+
+    for (long long root : roots)
+    {
+        if (!Detail::addNode(document, root, glm::mat4{1.0f}, 0,
+                             meshPrimitives, scene.drawables))
+        {
+            errorMessage_ = "glTF node hierarchy is malformed\n";
+            return false;
+        }
+    }
+
+    // Without nodes, show every primitive once.
+    if (!document.contains("nodes"))
+    {
+        for (std::size_t i{0}; i < scene.primitives.size(); ++i)
+        {
+            scene.drawables.push_back(GltfDrawable{i, glm::mat4{1.0f}});
+        }
+    }
+
+    if (skippedPrimitives)
+    {
+        errorMessage_ = std::to_string(skippedPrimitives) +
+                        " non-triangle or position-less primitives skipped\n";
+    }
+
+    statistics_.loadMilliseconds = stopwatch.elapsedMilliseconds();
+    statistics_.peakResidentSetSize = Performance::PeakResidentSetSize();
+    statistics_.fileSize = size;
+
+    return true;
+}
+
+const GltfLoader::Statistics &GltfLoader::statistics() const noexcept
+{
+    return statistics_;
+}
+
+} // namespace Model
@@ -0,0 +1,112 @@
+#ifndef HOMEWORK01_MODEL_GLTFLOADER_HPP_
+#define HOMEWORK01_MODEL_GLTFLOADER_HPP_
+
+#include "LoadStatistics.hpp"
+#include "MeshData.hpp"
+
+#include "Utils/FileIO/MappedFile.hpp"
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Model
+{
+
+// Byte range of a glTF buffer view, pointing into the mapped file or into a
+// decoded data URI.
+struct GltfBufferView
+{
+    const char *data;
+    std::size_t size;
+    // 0 when the accessors using the view are tightly packed.
+    std::size_t stride;
+};
+
+struct GltfAccessor
+{
+    std::int32_t bufferView;
+    // Offset into the buffer view.
+    std::size_t offset;
+    std::size_t count;
+    // Component types are the GL enums (GL_FLOAT, GL_UNSIGNED_SHORT, ...).
+    std::uint32_t componentType;
+    std::uint32_t components;
+    bool normalized;
+};
+
+// Triangle primitive. Attribute accessors follow the shader locations
+// (POSITION, NORMAL, TEXCOORD_0, COLOR_0, TANGENT); -1 marks an absent one.
+struct GltfPrimitive
+{
+    std::int32_t attributes[5];
+    std::int32_t indices;
+    std::int32_t material;
+    Bounds bounds;
+};
+
+struct GltfMaterial
+{
+    glm::vec4 baseColorFactor;
+    std::int32_t baseColorImage;
+};
+
+// An image is either encoded bytes (GLB chunk or data URI) or a file path.
+struct GltfImage
+{
+    const unsigned char *data;
+    std::size_t size;
+    std::string path;
+};
+
+// One placement of a primitive in the default scene.
+struct GltfDrawable
+{
+    std::size_t primitive;
+    glm::mat4 transform;
+};
+
+// A loaded glTF asset. Buffer views point into storage the scene owns, so
+// the scene must outlive any upload from it.
+struct GltfScene
+{
+    std::vector<GltfBufferView> bufferViews;
+    std::vector<GltfAccessor> accessors;
+    std::vector<GltfPrimitive> primitives;
+    std::vector<GltfMaterial> materials;
+    std::vector<GltfImage> images;
+    std::vector<GltfDrawable> drawables;
+
+    FileIO::MappedFile file;
+    std::vector<FileIO::MappedFile> externalBuffers;
+    std::vector<std::vector<unsigned char>> decodedBuffers;
+};
+
+// Reader for glTF 2.0 in both forms: .glb, whose binary chunk is mapped and
+// referenced in place, and .gltf with external or data URI buffers. Only
+// the layout is validated and described; vertex data is never copied or
+// repacked, so the buffer views can be uploaded as they are.
+class GltfLoader
+{
+public:
+    using Statistics = LoadStatistics;
+
+    explicit GltfLoader() noexcept;
+
+    bool load(const char *fileName, GltfScene &scene);
+
+    const std::string &errorMessage() const noexcept;
+    const Statistics &statistics() const noexcept;
+
+private:
+    std::string errorMessage_;
+    Statistics statistics_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_GLTFLOADER_HPP_
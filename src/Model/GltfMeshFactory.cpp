@@ -0,0 +1,166 @@
+#include "GltfMeshFactory.hpp"
+
+#include "TextureFactory.hpp"
+
+#include "OpenGL/OpenGLStateCache.hpp"
+
+#include <map>
+#include <utility>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+using BufferKey = std::pair<std::int32_t, bool>;
+using BufferMap =
+    std::map<BufferKey, std::shared_ptr<OpenGL::OpenGLBufferObject>>;
+
+std::shared_ptr<OpenGL::OpenGLBufferObject>
+uploadBufferView(const GltfScene &scene, std::int32_t bufferView,
+                 bool indices, BufferMap &buffers);
+std::unique_ptr<OpenGL::OpenGLTexture> loadImage(const GltfImage &image);
+
+// A view is uploaded once per target, however many accessors read from it.
+// Uploads go through the copy target: vertex array objects stay bound after
+// drawing, and binding an index view would replace their element buffer.
+std::shared_ptr<OpenGL::OpenGLBufferObject>
+uploadBufferView(const GltfScene &scene, std::int32_t bufferView,
+                 bool indices, BufferMap &buffers)
+{
+    std::shared_ptr<OpenGL::OpenGLBufferObject> &buffer{
+        buffers[BufferKey{bufferView, indices}]};
+    if (buffer)
+    {
+        return buffer;
+    }
+
+    const GltfBufferView &view{
+        scene.bufferViews[static_cast<std::size_t>(bufferView)]};
+    buffer.reset(new OpenGL::OpenGLBufferObject{
+        indices ? OpenGL::OpenGLBufferObject::Type::ElementArrayBuffer
+                : OpenGL::OpenGLBufferObject::Type::ArrayBuffer,
+        OpenGL::OpenGLBufferObject::UsagePattern::StaticDraw});
+    OpenGL::OpenGLStateCache::bindBuffer(GL_COPY_WRITE_BUFFER, buffer->id());
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(view.size),
+                 view.data, GL_STATIC_DRAW);
+
+    return buffer;
+}
+
+// glTF texture coordinates start at the top row, so images are not flipped.
+std::unique_ptr<OpenGL::OpenGLTexture> loadImage(const GltfImage &image)
+{
+    std::unique_ptr<OpenGL::OpenGLTexture> texture{
+        image.data
+            ? TextureFactory::loadFromMemory(image.data, image.size, false)
+            : TextureFactory::loadFromFile(image.path.c_str(), false)};
+
+    return texture->id() ? std::move(texture) : nullptr;
+}
+
+} // namespace Detail
+
+GltfMeshes GltfMeshFactory::create(const GltfScene &scene,
+                                   OpenGL::OpenGLShaderProgram &shaderProgram)
+{
+    GltfMeshes result;
+    Detail::BufferMap buffers;
+
+    // Images are decoded lazily; untextured materials sample a white one.
+    std::vector<OpenGL::OpenGLTexture *> images(scene.images.size(), nullptr);
+    std::vector<bool> imageLoaded(scene.images.size(), false);
+    OpenGL::OpenGLTexture *white{nullptr};
+
+    for (const GltfDrawable &drawable : scene.drawables)
+    {
+        const GltfPrimitive &primitive{scene.primitives[drawable.primitive]};
+
+        Mesh::BufferLayout layout{};
+        for (std::size_t slot{0}; slot < layout.attributes.size(); ++slot)
+        {
+            if (primitive.attributes[slot] < 0)
+            {
+                continue;
+            }
+
+            const GltfAccessor &accessor{scene.accessors[static_cast<
+                std::size_t>(primitive.attributes[slot])]};
+            layout.attributes[slot] = Mesh::Attribute{
+                Detail::uploadBufferView(scene, accessor.bufferView, false,
+                                         buffers),
+                static_cast<GLint>(accessor.components),
+                static_cast<GLenum>(accessor.componentType),
+                static_cast<GLboolean>(accessor.normalized ? GL_TRUE
+                                                           : GL_FALSE),
+                static_cast<GLsizei>(
+                    scene.bufferViews[static_cast<std::size_t>(
+                                          accessor.bufferView)]
+                        .stride),
+                accessor.offset};
+        }
+
+        const GltfAccessor &positions{scene.accessors[static_cast<
+            std::size_t>(primitive.attributes[0])]};
+        layout.vertexCount = positions.count;
+        layout.bounds = primitive.bounds;
+
+        if (primitive.indices >= 0)
+        {
+            const GltfAccessor &indices{
+                scene.accessors[static_cast<std::size_t>(primitive.indices)]};
+            layout.indexBuffer = Detail::uploadBufferView(
+                scene, indices.bufferView, true, buffers);
+            layout.indexType = static_cast<GLenum>(indices.componentType);
+            layout.indexOffset = indices.offset;
+            layout.indexCount = indices.count;
+        }
+
+        glm::vec4 color{1.0f};
+        std::int32_t image{-1};
+        if (primitive.material >= 0)
+        {
+            const GltfMaterial &material{
+                scene.materials[static_cast<std::size_t>(primitive.material)]};
+            color = material.baseColorFactor;
+            image = material.baseColorImage;
+        }
+
+        OpenGL::OpenGLTexture *texture{nullptr};
+        if (image >= 0)
+        {
+            const std::size_t index{static_cast<std::size_t>(image)};
+            if (!imageLoaded[index])
+            {
+                imageLoaded[index] = true;
+                std::unique_ptr<OpenGL::OpenGLTexture> loaded{
+                    Detail::loadImage(scene.images[index])};
+                if (loaded)
+                {
+                    images[index] = loaded.get();
+                    result.textures.push_back(std::move(loaded));
+                }
+            }
+            texture = images[index];
+        }
+        if (!texture)
+        {
+            if (!white)
+            {
+                result.textures.push_back(TextureFactory::createWhite());
+                white = result.textures.back().get();
+            }
+            texture = white;
+        }
+
+        std::unique_ptr<Mesh> mesh{new Mesh{layout, shaderProgram, texture}};
+        mesh->setModel(drawable.transform);
+        mesh->setColor(color);
+        result.meshes.push_back(std::move(mesh));
+    }
+
+    return result;
+}
+
+} // namespace Model
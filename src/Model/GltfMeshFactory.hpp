@@ -0,0 +1,36 @@
+#ifndef HOMEWORK01_MODEL_GLTFMESHFACTORY_HPP_
+#define HOMEWORK01_MODEL_GLTFMESHFACTORY_HPP_
+
+#include "GltfLoader.hpp"
+#include "Mesh.hpp"
+
+#include "OpenGL/OpenGLShaderProgram.hpp"
+#include "OpenGL/OpenGLTexture.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace Model
+{
+
+// Meshes of a glTF scene, one per placed primitive. The textures are
+// referenced by the meshes and must outlive them.
+struct GltfMeshes
+{
+    std::vector<std::unique_ptr<Mesh>> meshes;
+    std::vector<std::unique_ptr<OpenGL::OpenGLTexture>> textures;
+};
+
+class GltfMeshFactory
+{
+public:
+    // Uploads every referenced buffer view once, byte for byte, and points
+    // the mesh attributes at the accessor ranges inside them. Base color
+    // images are decoded through TextureFactory.
+    static GltfMeshes create(const GltfScene &scene,
+                             OpenGL::OpenGLShaderProgram &shaderProgram);
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_GLTFMESHFACTORY_HPP_
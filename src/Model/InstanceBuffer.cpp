@@ -0,0 +1,167 @@
+#include "InstanceBuffer.hpp"
+
+#include "Utils/Global.hpp"
+
+#include "glm/gtc/type_ptr.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Slot of a removed handle.
+constexpr std::uint32_t noInstanceSlot{
+    std::numeric_limits<std::uint32_t>::max()};
+
+// Smallest buffer allocated, in instances.
+constexpr std::size_t minimumInstanceCapacity{64};
+
+} // namespace Detail
+
+InstanceBuffer::InstanceBuffer()
+    : buffer_{new BufferObjectType{
+          OpenGL::OpenGLBufferObject::Type::ArrayBuffer,
+          OpenGL::OpenGLBufferObject::UsagePattern::DynamicDraw}},
+      capacity_{0}, models_{}, slots_{}, handles_{}, freeHandles_{},
+      dirtyFirst_{0}, dirtyLast_{0}
+{
+}
+
+InstanceBuffer::Handle InstanceBuffer::add(const glm::mat4 &model)
+{
+    Handle instance;
+    if (freeHandles_.empty())
+    {
+        instance = static_cast<Handle>(slots_.size());
+        slots_.push_back(0);
+    }
+    else
+    {
+        instance = freeHandles_.back();
+        freeHandles_.pop_back();
+    }
+
+    slots_[instance] = static_cast<std::uint32_t>(models_.size());
+    handles_.push_back(instance);
+    models_.push_back(model);
+    markDirty(models_.size() - 1);
+    return instance;
+}
+
+bool InstanceBuffer::empty() const noexcept { return models_.empty(); }
+
+void InstanceBuffer::markDirty(std::size_t slot) noexcept
+{
+    if (dirtyFirst_ == dirtyLast_)
+    {
+        dirtyFirst_ = slot;
+        dirtyLast_ = slot + 1;
+        return;
+    }
+    dirtyFirst_ = std::min(dirtyFirst_, slot);
+    dirtyLast_ = std::max(dirtyLast_, slot + 1);
+}
+
+InstanceBuffer::Handle InstanceBuffer::handle(std::size_t slot) const noexcept
+{
+    return handles_[slot];
+}
+
+const glm::mat4 &InstanceBuffer::model(Handle instance) const
+{
+    PROGRAM_ASSERT(instance < slots_.size() &&
+                   slots_[instance] != Detail::noInstanceSlot);
+
+    return models_[slots_[instance]];
+}
+
+const std::vector<glm::mat4> &InstanceBuffer::models() const noexcept
+{
+    return models_;
+}
+
+void InstanceBuffer::remove(Handle instance)
+{
+    PROGRAM_ASSERT(instance < slots_.size() &&
+                   slots_[instance] != Detail::noInstanceSlot);
+
+    const std::size_t slot{slots_[instance]};
+    const std::size_t last{models_.size() - 1};
+    if (slot != last)
+    {
+        models_[slot] = models_[last];
+        handles_[slot] = handles_[last];
+        slots_[handles_[slot]] = static_cast<std::uint32_t>(slot);
+        markDirty(slot);
+    }
+    models_.pop_back();
+    handles_.pop_back();
+
+    slots_[instance] = Detail::noInstanceSlot;
+    freeHandles_.push_back(instance);
+
+    // Nothing past the end needs sending.
+    dirtyLast_ = std::min(dirtyLast_, models_.size());
+    dirtyFirst_ = std::min(dirtyFirst_, dirtyLast_);
+}
+
+void InstanceBuffer::set(Handle instance, const glm::mat4 &model)
+{
+    PROGRAM_ASSERT(instance < slots_.size() &&
+                   slots_[instance] != Detail::noInstanceSlot);
+
+    models_[slots_[instance]] = model;
+    markDirty(slots_[instance]);
+}
+
+void InstanceBuffer::setUpAttributes(ShaderProgramType &program,
+                                     GLuint location)
+{
+    buffer_->bind();
+    for (GLuint column{0}; column < attributeCount; ++column)
+    {
+        program.enableAttributeArray(location + column);
+        program.mapAttributePointer(
+            location + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+            static_cast<int>(column * sizeof(glm::vec4)));
+        program.setAttributeDivisor(location + column, 1);
+    }
+}
+
+std::size_t InstanceBuffer::size() const noexcept { return models_.size(); }
+
+void InstanceBuffer::upload()
+{
+    if (models_.size() > capacity_)
+    {
+        // Grows geometrically, so adding instances one frame at a time
+        // reallocates rarely; the whole buffer is sent with the new storage.
+        capacity_ = std::max({models_.size(), 2 * capacity_,
+                              Detail::minimumInstanceCapacity});
+        buffer_->bind();
+        buffer_->allocateBufferData(
+            nullptr, static_cast<GLsizeiptr>(capacity_ * sizeof(glm::mat4)));
+        dirtyFirst_ = 0;
+        dirtyLast_ = models_.size();
+    }
+
+    if (dirtyFirst_ == dirtyLast_)
+    {
+        return;
+    }
+
+    buffer_->bind();
+    buffer_->writeBufferSubData(
+        static_cast<GLintptr>(dirtyFirst_ * sizeof(glm::mat4)),
+        glm::value_ptr(models_[dirtyFirst_]),
+        static_cast<GLsizeiptr>((dirtyLast_ - dirtyFirst_) *
+                                sizeof(glm::mat4)));
+    dirtyFirst_ = 0;
+    dirtyLast_ = 0;
+}
+
+} // namespace Model
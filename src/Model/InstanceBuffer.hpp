@@ -0,0 +1,71 @@
+#ifndef HOMEWORK01_MODEL_INSTANCEBUFFER_HPP_
+#define HOMEWORK01_MODEL_INSTANCEBUFFER_HPP_
+
+#include "OpenGL/OpenGLBufferObject.hpp"
+#include "OpenGL/OpenGLShaderProgram.hpp"
+
+#include "glm/mat4x4.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Model
+{
+
+// Model matrices of the instances of a mesh, one per instance in a buffer
+// object read through attribute divisors. Instances are packed: removing
+// one moves the last into its slot, so the buffer never has holes, and a
+// handle keeps naming the same instance however it moves. Changes are kept
+// on the host until upload(), which sends only the slots changed since the
+// last one unless the buffer has to grow.
+class InstanceBuffer
+{
+public:
+    using Handle = std::uint32_t;
+    using BufferObjectType = OpenGL::OpenGLBufferObject;
+    using ShaderProgramType = OpenGL::OpenGLShaderProgram;
+
+    // Matrix columns take locations location to location + 3.
+    static constexpr GLuint attributeCount{4};
+
+    explicit InstanceBuffer();
+
+    Handle add(const glm::mat4 &model);
+    // The handle may be given out again by a later add().
+    void remove(Handle instance);
+    void set(Handle instance, const glm::mat4 &model);
+    const glm::mat4 &model(Handle instance) const;
+
+    std::size_t size() const noexcept;
+    bool empty() const noexcept;
+    // Matrices in slot order, as the buffer will hold them.
+    const std::vector<glm::mat4> &models() const noexcept;
+    // Instance whose matrix the buffer holds at slot.
+    Handle handle(std::size_t slot) const noexcept;
+
+    // Points the attributes of the bound vertex array object at the buffer.
+    void setUpAttributes(ShaderProgramType &program, GLuint location);
+    void upload();
+
+private:
+    void markDirty(std::size_t slot) noexcept;
+
+    std::unique_ptr<BufferObjectType> buffer_;
+    std::size_t capacity_;
+
+    std::vector<glm::mat4> models_;
+    // Slot of every handle, and handle of every slot.
+    std::vector<std::uint32_t> slots_;
+    std::vector<Handle> handles_;
+    std::vector<Handle> freeHandles_;
+
+    // Slots changed since the last upload, [dirtyFirst_, dirtyLast_).
+    std::size_t dirtyFirst_;
+    std::size_t dirtyLast_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_INSTANCEBUFFER_HPP_
@@ -0,0 +1,22 @@
+#ifndef HOMEWORK01_MODEL_LOADSTATISTICS_HPP_
+#define HOMEWORK01_MODEL_LOADSTATISTICS_HPP_
+
+#include <cstddef>
+
+namespace Model
+{
+
+// What a model loader reports about its last load.
+struct LoadStatistics
+{
+    double loadMilliseconds;
+    std::size_t peakResidentSetSize;
+    std::size_t fileSize;
+    std::size_t vertexCount;
+    std::size_t triangleCount;
+    unsigned int threadCount;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_LOADSTATISTICS_HPP_
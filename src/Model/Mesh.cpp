@@ -1,119 +1,994 @@
-#include "Mesh.hpp"
-
-#include "Utils/Global.hpp"
-
-namespace Model
-{
-
-Mesh::Mesh() noexcept
-    : shaderProgram_{nullptr}, texture_{nullptr}, vertexArrayObject_{nullptr},
-      vertexBufferObject_{{nullptr, nullptr, nullptr}},
-      elementBufferObject_{nullptr}, indicesCount_{0}, model_{1}
-{
-}
-
-Mesh::Mesh(const std::vector<float> &positions,
-           const std::vector<float> &normals,
-           const std::vector<float> &textureCoordinates,
-           const std::vector<IndexType> &indices,
-           ShaderProgramType &shaderProgram, TextureType *texture)
-    : shaderProgram_{&shaderProgram}, texture_{texture},
-      vertexArrayObject_{nullptr}, vertexBufferObject_{{nullptr, nullptr,
-                                                      nullptr}},
-      elementBufferObject_{nullptr},
-      indicesCount_{static_cast<GLsizei>(indices.size())}, model_{1}
-{
-    create(positions, normals, textureCoordinates, indices);
-}
-
-Mesh::Mesh(Mesh &&other) noexcept = default;
-
-Mesh &Mesh::operator=(Mesh &&other) noexcept = default;
-
-Mesh::~Mesh() noexcept { tidy(); }
-
-void Mesh::vertexBufferObjectSetup(BufferObjectType &object,
-                                   const std::vector<float> &data,
-                                   ShaderProgramType &program, GLuint index,
-                                   GLint size, GLenum type,
-                                   GLboolean normalized, GLsizei stride,
-                                   int offset)
-{
-    object.bind();
-    object.allocateBufferData(data.data(), sizeof(float) * data.size());
-
-    program.enableAttributeArray(index);
-    program.mapAttributePointer(index, size, type, normalized, stride, offset);
-}
-
-void Mesh::create(const std::vector<float> &positions,
-                  const std::vector<float> &normals,
-                  const std::vector<float> &textureCoordinates,
-                  const std::vector<IndexType> &indices)
-{
-    vertexArrayObject_.reset(new VertexArrayObjectType{});
-    for (auto &object : vertexBufferObject_)
-    {
-        object.reset(new BufferObjectType{
-            OpenGL::OpenGLBufferObject::Type::ArrayBuffer,
-            OpenGL::OpenGLBufferObject::UsagePattern::StaticDraw});
-    }
-    elementBufferObject_.reset(new BufferObjectType{
-        OpenGL::OpenGLBufferObject::Type::ElementArrayBuffer,
-        OpenGL::OpenGLBufferObject::UsagePattern::StaticDraw});
-
-    vertexArrayObject_->bind();
-
-    vertexBufferObjectSetup(*(vertexBufferObject_[0]), positions,
-                            *shaderProgram_, 0, 3, GL_FLOAT, GL_FALSE,
-                            3 * sizeof(float), 0);
-
-    vertexBufferObjectSetup(*(vertexBufferObject_[1]), normals, *shaderProgram_,
-                            1, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), 0);
-
-    vertexBufferObjectSetup(*(vertexBufferObject_[2]), textureCoordinates,
-                            *shaderProgram_, 2, 2, GL_FLOAT, GL_FALSE,
-                            2 * sizeof(float), 0);
-
-    elementBufferObject_->bind();
-    elementBufferObject_->allocateBufferData(indices.data(),
-                                            sizeof(IndexType) * indices.size());
-
-    vertexArrayObject_->release();
-}
-
-void Mesh::draw(glm::mat4 &view, glm::mat4 &projection)
-{
-    if (!(texture_))
-    {
-        glActiveTexture(GL_TEXTURE0);
-        texture_->bind();
-    }
-
-    shaderProgram_->use();
-
-    glm::mat4 mvp{projection * view * model_};
-
-    shaderProgram_->setValue<4, 4>("mvp", mvp, false);
-
-    vertexArrayObject_->bind();
-    glDrawElements(GL_TRIANGLES, indicesCount_, GL_UNSIGNED_INT, 0);
-    vertexArrayObject_->release();
-
-    if (!(texture_))
-    {
-        glActiveTexture(GL_TEXTURE0);
-    }
-}
-
-void Mesh::tidy() noexcept
-{
-    elementBufferObject_.reset();
-    for (auto &object : vertexBufferObject_)
-    {
-        object.reset();
-    }
-    vertexArrayObject_.reset();
-}
-
-} // namespace Model
+#include "Mesh.hpp"
+
+#include "Utils/Global.hpp"
+
+#include "glm/geometric.hpp"
+#include "glm/gtc/type_ptr.hpp"
+#include "glm/matrix.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Centered on the box of the view and reaching its furthest vertex, which
+// is usually much tighter than the sphere around the box.
+BoundingSphere enclosingSphere(const MeshView &view) noexcept;
+// Around the box, for meshes whose vertices are not on the host.
+BoundingSphere boxSphere(const Bounds &bounds) noexcept;
+// The box of the eight transformed corners, from the center and the
+// absolute values of the matrix.
+Bounds transformBounds(const Bounds &bounds, const glm::mat4 &matrix) noexcept;
+
+// Shader location of the first column of the instance model matrix.
+constexpr GLuint instanceModelLocation{5};
+
+inline BoundingSphere enclosingSphere(const MeshView &view) noexcept
+{
+    const glm::vec3 center{0.5f * (view.bounds.minimum + view.bounds.maximum)};
+    float squaredRadius{0.0f};
+    for (std::size_t i{0}; i < view.vertexCount; ++i)
+    {
+        const float *position{view.positions + 3 * i};
+        const glm::vec3 offset{glm::vec3{position[0], position[1],
+                                         position[2]} -
+                               center};
+        squaredRadius = std::max(squaredRadius, glm::dot(offset, offset));
+    }
+    return BoundingSphere{center, std::sqrt(squaredRadius)};
+}
+
+inline BoundingSphere boxSphere(const Bounds &bounds) noexcept
+{
+    return BoundingSphere{0.5f * (bounds.minimum + bounds.maximum),
+                          0.5f * glm::length(bounds.maximum - bounds.minimum)};
+}
+
+inline Bounds transformBounds(const Bounds &bounds,
+                              const glm::mat4 &matrix) noexcept
+{
+    const glm::vec3 center{
+        matrix * glm::vec4{0.5f * (bounds.minimum + bounds.maximum), 1.0f}};
+    const glm::vec3 extent{0.5f * (bounds.maximum - bounds.minimum)};
+    const glm::vec3 transformedExtent{
+        glm::abs(glm::vec3{matrix[0]}) * extent.x +
+        glm::abs(glm::vec3{matrix[1]}) * extent.y +
+        glm::abs(glm::vec3{matrix[2]}) * extent.z};
+    return Bounds{center - transformedExtent, center + transformedExtent};
+}
+
+} // namespace Detail
+
+Mesh::Mesh() noexcept
+    : shaderProgram_{nullptr}, texture_{nullptr}, vertexArrayObject_{nullptr},
+      vertexBufferObject_{{nullptr, nullptr, nullptr, nullptr, nullptr}},
+      elementBufferObject_{nullptr}, vertexHeap_{nullptr},
+      indexHeap_{nullptr}, vertexRange_{}, indexRange_{},
+      heapFirstVertex_{0}, layoutMode_{VertexLayoutMode::Split},
+      compression_{VertexCompression::None},
+      quantization_{VertexQuantization::identity()}, quantizationReport_{},
+      vertexWriter_{nullptr}, staging_{}, streams_{false, false, false, false},
+      vertexCount_{0}, indexCapacity_{0}, indicesCount_{0},
+      indexType_{GL_UNSIGNED_INT}, indexOffset_{0}, model_{1}, color_{1},
+      bounds_{glm::vec3{0}, glm::vec3{0}},
+      boundingSphere_{glm::vec3{0}, 0.0f}, subMeshes_{}, materials_{},
+      meshlets_{}, subMeshMeshlets_{}, meshletVisible_{}, meshletCuller_{},
+      meshletStatistics_{}, backfaceCulling_{true}, drawCallCount_{0},
+      drawCounts_{},
+      drawOffsets_{}, levels_{}, levelOfDetail_{0},
+      triangleBvh_{}, instances_{},
+      instanceBounds_{glm::vec3{0}, glm::vec3{0}}, objects_{nullptr},
+      objectIndex_{0}
+{
+}
+
+Mesh::Mesh(const MeshView &view, ShaderProgramType &shaderProgram,
+           TextureType *texture, VertexLayoutMode layoutMode,
+           VertexCompression compression)
+    : shaderProgram_{&shaderProgram}, texture_{texture},
+      vertexArrayObject_{nullptr},
+      vertexBufferObject_{{nullptr, nullptr, nullptr, nullptr, nullptr}},
+      elementBufferObject_{nullptr}, vertexHeap_{nullptr},
+      indexHeap_{nullptr}, vertexRange_{}, indexRange_{},
+      heapFirstVertex_{0}, layoutMode_{layoutMode},
+      compression_{compression},
+      quantization_{VertexQuantization::identity()}, quantizationReport_{},
+      vertexWriter_{nullptr}, staging_{}, streams_{false, false, false, false},
+      vertexCount_{0}, indexCapacity_{0},
+      indicesCount_{static_cast<GLsizei>(view.indexCount)},
+      indexType_{GL_UNSIGNED_INT}, indexOffset_{0}, model_{1}, color_{1},
+      bounds_{view.bounds}, boundingSphere_{Detail::enclosingSphere(view)},
+      subMeshes_{view.subMeshes, view.subMeshes + view.subMeshCount},
+      materials_{},
+      meshlets_{}, subMeshMeshlets_{}, meshletVisible_{}, meshletCuller_{},
+      meshletStatistics_{}, backfaceCulling_{true}, drawCallCount_{0},
+      drawCounts_{},
+      drawOffsets_{}, levels_{}, levelOfDetail_{0},
+      triangleBvh_{}, instances_{},
+      instanceBounds_{glm::vec3{0}, glm::vec3{0}}, objects_{nullptr},
+      objectIndex_{0}
+{
+    create(view, nullptr);
+}
+
+Mesh::Mesh(const BufferLayout &layout, ShaderProgramType &shaderProgram,
+           TextureType *texture)
+    : shaderProgram_{&shaderProgram}, texture_{texture},
+      vertexArrayObject_{nullptr},
+      vertexBufferObject_{{nullptr, nullptr, nullptr, nullptr, nullptr}},
+      elementBufferObject_{nullptr}, vertexHeap_{nullptr},
+      indexHeap_{nullptr}, vertexRange_{}, indexRange_{},
+      heapFirstVertex_{0}, layoutMode_{VertexLayoutMode::Split},
+      compression_{VertexCompression::None},
+      quantization_{VertexQuantization::identity()}, quantizationReport_{},
+      vertexWriter_{nullptr}, staging_{}, streams_{false, false, false, false},
+      vertexCount_{layout.vertexCount}, indexCapacity_{0},
+      indicesCount_{static_cast<GLsizei>(layout.indexCount)},
+      indexType_{layout.indexType}, indexOffset_{layout.indexOffset},
+      model_{1}, color_{1}, bounds_{layout.bounds},
+      boundingSphere_{Detail::boxSphere(layout.bounds)},
+      subMeshes_(1, SubMesh{0,
+                            static_cast<std::uint32_t>(
+                                layout.indexBuffer ? layout.indexCount
+                                                   : layout.vertexCount),
+                            -1}),
+      materials_{},
+      meshlets_{}, subMeshMeshlets_{}, meshletVisible_{}, meshletCuller_{},
+      meshletStatistics_{}, backfaceCulling_{true}, drawCallCount_{0},
+      drawCounts_{},
+      drawOffsets_{}, levels_{}, levelOfDetail_{0},
+      triangleBvh_{}, instances_{},
+      instanceBounds_{glm::vec3{0}, glm::vec3{0}}, objects_{nullptr},
+      objectIndex_{0}
+{
+    streams_ = VertexStreams{layout.attributes[1].buffer != nullptr,
+                             layout.attributes[2].buffer != nullptr,
+                             layout.attributes[3].buffer != nullptr,
+                             layout.attributes[4].buffer != nullptr};
+
+    vertexArrayObject_.reset(new VertexArrayObjectType{});
+    vertexArrayObject_->bind();
+
+    for (std::size_t i{0}; i < layout.attributes.size(); ++i)
+    {
+        const Attribute &attribute{layout.attributes[i]};
+        if (!attribute.buffer)
+        {
+            continue;
+        }
+
+        vertexBufferObject_[i] = attribute.buffer;
+        attribute.buffer->bind();
+        shaderProgram_->enableAttributeArray(static_cast<GLuint>(i));
+        shaderProgram_->mapAttributePointer(
+            static_cast<GLuint>(i), attribute.size, attribute.type,
+            attribute.normalized, attribute.stride,
+            static_cast<int>(attribute.offset));
+    }
+
+    if (layout.indexBuffer)
+    {
+        elementBufferObject_ = layout.indexBuffer;
+        elementBufferObject_->bind();
+    }
+
+    vertexArrayObject_->release();
+}
+
+Mesh::Mesh(const MeshView &view, BufferHeap &vertexHeap, BufferHeap &indexHeap,
+           ShaderProgramType &shaderProgram, TextureType *texture,
+           VertexCompression compression, const VertexImage *image)
+    : Mesh{shaderProgram, texture, VertexLayoutMode::Interleaved}
+{
+    vertexHeap_ = &vertexHeap;
+    indexHeap_ = &indexHeap;
+    compression_ = compression;
+    bounds_ = view.bounds;
+    boundingSphere_ = Detail::enclosingSphere(view);
+    subMeshes_.assign(view.subMeshes, view.subMeshes + view.subMeshCount);
+
+    create(view, image);
+}
+
+Mesh::Mesh(ShaderProgramType &shaderProgram, TextureType *texture,
+           VertexLayoutMode layoutMode)
+    : shaderProgram_{&shaderProgram}, texture_{texture},
+      vertexArrayObject_{nullptr},
+      vertexBufferObject_{{nullptr, nullptr, nullptr, nullptr, nullptr}},
+      elementBufferObject_{nullptr}, vertexHeap_{nullptr},
+      indexHeap_{nullptr}, vertexRange_{}, indexRange_{},
+      heapFirstVertex_{0}, layoutMode_{layoutMode},
+      compression_{VertexCompression::None},
+      quantization_{VertexQuantization::identity()}, quantizationReport_{},
+      vertexWriter_{nullptr}, staging_{}, streams_{false, false, false, false},
+      vertexCount_{0}, indexCapacity_{0}, indicesCount_{0},
+      indexType_{GL_UNSIGNED_INT}, indexOffset_{0}, model_{1}, color_{1},
+      bounds_{glm::vec3{0}, glm::vec3{0}},
+      boundingSphere_{glm::vec3{0}, 0.0f}, subMeshes_{}, materials_{},
+      meshlets_{}, subMeshMeshlets_{}, meshletVisible_{}, meshletCuller_{},
+      meshletStatistics_{}, backfaceCulling_{true}, drawCallCount_{0},
+      drawCounts_{},
+      drawOffsets_{}, levels_{}, levelOfDetail_{0},
+      triangleBvh_{}, instances_{},
+      instanceBounds_{glm::vec3{0}, glm::vec3{0}}, objects_{nullptr},
+      objectIndex_{0}
+{
+}
+
+Mesh::Mesh(Mesh &&other) noexcept = default;
+
+Mesh &Mesh::operator=(Mesh &&other) noexcept = default;
+
+Mesh::~Mesh() noexcept { tidy(); }
+
+InstanceBuffer::Handle Mesh::addInstance(const glm::mat4 &model)
+{
+    if (!instances_)
+    {
+        instances_.reset(new InstanceBuffer{});
+        vertexArrayObject_->bind();
+        instances_->setUpAttributes(*shaderProgram_,
+                                    Detail::instanceModelLocation);
+        vertexArrayObject_->release();
+    }
+
+    growInstanceBounds(model);
+    return instances_->add(model);
+}
+
+const Bounds &Mesh::bounds() const noexcept { return bounds_; }
+
+const BoundingSphere &Mesh::boundingSphere() const noexcept
+{
+    return boundingSphere_;
+}
+
+const std::vector<SubMesh> &Mesh::subMeshes() const noexcept
+{
+    return subMeshes_;
+}
+
+const glm::vec4 &Mesh::color() const noexcept { return color_; }
+
+void Mesh::beginMesh(const VertexStreams &streams, std::size_t vertexCount,
+                     std::size_t indexCapacity)
+{
+    tidy();
+
+    streams_ = streams;
+    vertexCount_ = vertexCount;
+    indexCapacity_ = 0;
+    indicesCount_ = 0;
+    // Every index of a mesh with at most 65536 vertices fits 16 bits, which
+    // halves the index buffer and the index fetch bandwidth.
+    indexType_ = vertexCount <= 65536 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    indexOffset_ = 0;
+
+    vertexArrayObject_.reset(new VertexArrayObjectType{});
+    // A heap range is taken by reserveIndices.
+    if (!indexHeap_)
+    {
+        elementBufferObject_.reset(new BufferObjectType{
+            OpenGL::OpenGLBufferObject::Type::ElementArrayBuffer,
+            OpenGL::OpenGLBufferObject::UsagePattern::StaticDraw});
+    }
+
+    vertexArrayObject_->bind();
+
+    LayoutSetUp setUp{*this};
+    if (compression_ != VertexCompression::None ||
+        layoutMode_ == VertexLayoutMode::Interleaved || vertexHeap_)
+    {
+        selectInterleavedLayout(streams, compression_, setUp);
+    }
+    else
+    {
+        using Optional = VertexAttributes<NormalAttribute,
+                                          TextureCoordinateAttribute,
+                                          ColorAttribute, TangentAttribute>;
+        const bool present[]{streams.normals, streams.textureCoordinates,
+                             streams.colors, streams.tangents};
+        VertexLayoutSelector<SplitLayout, VertexAttributes<PositionAttribute>,
+                             Optional>::select(present, setUp);
+    }
+
+    if (elementBufferObject_)
+    {
+        elementBufferObject_->bind();
+    }
+
+    vertexArrayObject_->release();
+
+    reserveIndices(indexCapacity);
+}
+
+void Mesh::create(const MeshView &view, const VertexImage *image)
+{
+    const bool packed{image && image->compression == compression_};
+    if (packed)
+    {
+        quantization_ = image->quantization;
+        quantizationReport_ = image->report;
+    }
+    else if (compression_ != VertexCompression::None)
+    {
+        quantization_ = VertexQuantizer::fit(view, compression_);
+        quantizationReport_ =
+            VertexQuantizer::measure(view, compression_, quantization_);
+    }
+    else
+    {
+        quantization_ = VertexQuantization::identity();
+        quantizationReport_ = QuantizationReport{};
+    }
+
+    beginMesh(VertexStreams{view.normals != nullptr,
+                            view.textureCoordinates != nullptr,
+                            view.colors != nullptr, view.tangents != nullptr},
+              view.vertexCount, view.indexCount);
+
+    // An image that fills the range exactly has the layout the range was
+    // allocated for.
+    if (packed && vertexHeap_ && image->size == vertexRange_.size())
+    {
+        vertexBufferObject_[0]->bind();
+        vertexBufferObject_[0]->writeBufferSubData(
+            static_cast<GLintptr>(vertexRange_.offset()), image->data,
+            static_cast<GLsizeiptr>(image->size));
+        vertexBufferObject_[0]->release();
+    }
+    else
+    {
+        writeVertices(0, view);
+    }
+    writeIndices(0, view.indices, view.indexCount);
+    indicesCount_ = static_cast<GLsizei>(view.indexCount);
+
+    quantizationReport_.indexBytes = sizeof(IndexType) * view.indexCount;
+    quantizationReport_.compressedIndexBytes = indexSize() * view.indexCount;
+}
+
+void Mesh::draw(glm::mat4 &view, glm::mat4 &projection)
+{
+    drawCallCount_ = 0;
+    if (instances_ && instances_->empty())
+    {
+        return;
+    }
+
+    PROGRAM_ASSERT(objects_ && objectIndex_ < objects_->size());
+
+    shaderProgram_->use();
+    objects_->bind(objectIndex_);
+    if (instances_)
+    {
+        instances_->upload();
+    }
+
+    // Meshlets only cover the full mesh, and one placement of it.
+    meshletStatistics_ = MeshletCullStatistics{};
+    if (!meshlets_.empty() && !levelOfDetail_ && !instances_)
+    {
+        cullMeshlets(view, projection);
+    }
+
+    // The program, vertex array object and textures stay bound after the
+    // draw, so the next draw of this mesh does not reach the driver for them.
+    vertexArrayObject_->bind();
+
+    const std::vector<SubMesh> &subMeshes{
+        levelOfDetail_ ? levels_[levelOfDetail_].subMeshes : subMeshes_};
+    if (subMeshes.empty())
+    {
+        if (texture_)
+        {
+            texture_->bind();
+        }
+        // Without a color stream the attribute reads the current generic
+        // value.
+        if (!streams_.colors)
+        {
+            glVertexAttrib4fv(3, glm::value_ptr(color_));
+        }
+        drawSubMesh(0, 0,
+                    elementBufferObject_
+                        ? static_cast<std::size_t>(indicesCount_)
+                        : vertexCount_);
+    }
+
+    // One draw per sub-mesh; sub-meshes are sorted by material, so state
+    // only changes between materials.
+    TextureType *boundTexture{nullptr};
+    for (std::size_t i{0}; i < subMeshes.size(); ++i)
+    {
+        const SubMesh &subMesh{subMeshes[i]};
+        const std::size_t material{
+            static_cast<std::size_t>(subMesh.materialIndex)};
+        const bool hasMaterial{subMesh.materialIndex >= 0 &&
+                               material < materials_.size()};
+
+        TextureType *texture{hasMaterial && materials_[material].texture
+                                 ? materials_[material].texture
+                                 : texture_};
+        if (texture && texture != boundTexture)
+        {
+            texture->bind();
+            boundTexture = texture;
+        }
+
+        if (!streams_.colors)
+        {
+            glVertexAttrib4fv(3, glm::value_ptr(hasMaterial
+                                                    ? materials_[material].color
+                                                    : color_));
+        }
+
+        drawSubMesh(i, subMesh.indexOffset, subMesh.indexCount);
+    }
+}
+
+std::size_t Mesh::drawCallCount() const noexcept { return drawCallCount_; }
+
+// Culls in model space, where the meshlet bounds are.
+void Mesh::cullMeshlets(const glm::mat4 &view, const glm::mat4 &projection)
+{
+    const glm::vec3 cameraPosition{glm::inverse(view * model_) *
+                                   glm::vec4{0.0f, 0.0f, 0.0f, 1.0f}};
+    meshletStatistics_ =
+        meshletCuller_.cull(meshlets_, projection * view * model_,
+                            cameraPosition, backfaceCulling_, meshletVisible_);
+}
+
+// Draws the visible meshlets of a sub-mesh with one glMultiDrawElements,
+// merging meshlets that follow each other in the index buffer, or the whole
+// range without meshlets.
+void Mesh::drawSubMesh(std::size_t subMesh, std::size_t first,
+                       std::size_t count)
+{
+    if (meshlets_.empty() || levelOfDetail_ || instances_ ||
+        subMesh + 1 >= subMeshMeshlets_.size())
+    {
+        drawRange(first, count);
+        return;
+    }
+
+    drawCounts_.clear();
+    drawOffsets_.clear();
+    std::size_t rangeEnd{0};
+    for (std::size_t i{subMeshMeshlets_[subMesh]};
+         i < subMeshMeshlets_[subMesh + 1]; ++i)
+    {
+        if (!meshletVisible_[i])
+        {
+            continue;
+        }
+
+        const Meshlet &meshlet{meshlets_[i]};
+        if (!drawCounts_.empty() && meshlet.indexOffset == rangeEnd)
+        {
+            drawCounts_.back() += static_cast<GLsizei>(meshlet.indexCount);
+        }
+        else
+        {
+            drawCounts_.push_back(static_cast<GLsizei>(meshlet.indexCount));
+            drawOffsets_.push_back(reinterpret_cast<const GLvoid *>(
+                indexOffset_ + indexSize() * meshlet.indexOffset));
+        }
+        rangeEnd = meshlet.indexOffset + meshlet.indexCount;
+    }
+
+    if (!drawCounts_.empty())
+    {
+        ++drawCallCount_;
+        glMultiDrawElements(GL_TRIANGLES, drawCounts_.data(), indexType_,
+                            drawOffsets_.data(),
+                            static_cast<GLsizei>(drawCounts_.size()));
+    }
+    meshletStatistics_.drawCount += drawCounts_.size();
+}
+
+// Draws count indices, or vertices without an index buffer, from first on,
+// once per instance if the mesh has them.
+void Mesh::drawRange(std::size_t first, std::size_t count)
+{
+    const GLvoid *offset{
+        reinterpret_cast<const GLvoid *>(indexOffset_ + indexSize() * first)};
+    ++drawCallCount_;
+    if (instances_)
+    {
+        const GLsizei instanceCount{static_cast<GLsizei>(instances_->size())};
+        if (elementBufferObject_)
+        {
+            glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(count),
+                                    indexType_, offset, instanceCount);
+        }
+        else
+        {
+            glDrawArraysInstanced(GL_TRIANGLES, static_cast<GLint>(first),
+                                  static_cast<GLsizei>(count),
+                                  instanceCount);
+        }
+    }
+    else if (elementBufferObject_)
+    {
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(count), indexType_,
+                       offset);
+    }
+    else
+    {
+        glDrawArrays(GL_TRIANGLES, static_cast<GLint>(first),
+                     static_cast<GLsizei>(count));
+    }
+}
+
+void Mesh::drawSeparately(glm::mat4 &view, glm::mat4 &projection)
+{
+    if (!instances_)
+    {
+        draw(view, projection);
+        return;
+    }
+
+    // Without the buffer draw() takes the single mesh path; the instance
+    // attributes stay enabled but the shader does not read them.
+    // writeObjects() left a block per instance from objectIndex_ on.
+    std::unique_ptr<InstanceBuffer> instances{std::move(instances_)};
+    const glm::mat4 model{model_};
+    const std::size_t firstObject{objectIndex_};
+    std::size_t drawCallCount{0};
+    for (const glm::mat4 &instance : instances->models())
+    {
+        model_ = model * instance;
+        draw(view, projection);
+        drawCallCount += drawCallCount_;
+        ++objectIndex_;
+    }
+    model_ = model;
+    objectIndex_ = firstObject;
+    instances_ = std::move(instances);
+    drawCallCount_ = drawCallCount;
+}
+
+void Mesh::endMesh(std::size_t indexCount, const Bounds &bounds)
+{
+    indicesCount_ = static_cast<GLsizei>(indexCount);
+    bounds_ = bounds;
+    boundingSphere_ = Detail::boxSphere(bounds);
+    subMeshes_.assign(1,
+                      SubMesh{0, static_cast<std::uint32_t>(indexCount), -1});
+}
+
+void Mesh::growInstanceBounds(const glm::mat4 &model) noexcept
+{
+    const Bounds bounds{Detail::transformBounds(bounds_, model)};
+    if (instances_->empty())
+    {
+        instanceBounds_ = bounds;
+        return;
+    }
+    instanceBounds_.minimum = glm::min(instanceBounds_.minimum, bounds.minimum);
+    instanceBounds_.maximum = glm::max(instanceBounds_.maximum, bounds.maximum);
+}
+
+// Bytes of one index in the element buffer.
+std::size_t Mesh::indexSize() const noexcept
+{
+    return indexType_ == GL_UNSIGNED_BYTE    ? 1u
+           : indexType_ == GL_UNSIGNED_SHORT ? 2u
+                                             : 4u;
+}
+
+const InstanceBuffer *Mesh::instances() const noexcept
+{
+    return instances_.get();
+}
+
+const std::vector<Mesh::MaterialState> &Mesh::materials() const noexcept
+{
+    return materials_;
+}
+
+glm::mat4 Mesh::model() const { return model_; }
+
+std::size_t Mesh::levelOfDetail() const noexcept { return levelOfDetail_; }
+
+const std::vector<LevelOfDetail> &Mesh::levelsOfDetail() const noexcept
+{
+    return levels_;
+}
+
+const std::vector<Meshlet> &Mesh::meshlets() const noexcept
+{
+    return meshlets_;
+}
+
+const MeshletCullStatistics &Mesh::meshletStatistics() const noexcept
+{
+    return meshletStatistics_;
+}
+
+bool Mesh::pick(const Ray &ray, RayHit &hit) const noexcept
+{
+    if (!triangleBvh_)
+    {
+        return false;
+    }
+
+    const glm::mat4 inverse{glm::inverse(model_)};
+    const Ray local{glm::vec3{inverse * glm::vec4{ray.origin, 1.0f}},
+                    glm::vec3{inverse * glm::vec4{ray.direction, 0.0f}},
+                    ray.minimumDistance, ray.maximumDistance};
+    return triangleBvh_->closestHit(local, hit);
+}
+
+VertexImage Mesh::packVertices(const MeshView &view,
+                               VertexCompression compression,
+                               std::vector<unsigned char> &bytes)
+{
+    VertexImage image{compression, VertexQuantization::identity(),
+                      QuantizationReport{}, nullptr, 0};
+    if (compression != VertexCompression::None)
+    {
+        image.quantization = VertexQuantizer::fit(view, compression);
+        image.report =
+            VertexQuantizer::measure(view, compression, image.quantization);
+    }
+
+    LayoutPack pack{view, image.quantization, bytes};
+    selectInterleavedLayout(
+        VertexStreams{view.normals != nullptr,
+                      view.textureCoordinates != nullptr,
+                      view.colors != nullptr, view.tangents != nullptr},
+        compression, pack);
+
+    image.data = bytes.data();
+    image.size = bytes.size();
+    return image;
+}
+
+const QuantizationReport &Mesh::quantizationReport() const noexcept
+{
+    return quantizationReport_;
+}
+
+void Mesh::removeInstance(InstanceBuffer::Handle instance)
+{
+    PROGRAM_ASSERT(instances_);
+
+    instances_->remove(instance);
+}
+
+// Grows the index buffer on the GPU, keeping what was written so far.
+void Mesh::reserveIndices(std::size_t indexCount)
+{
+    if (indexCount <= indexCapacity_)
+    {
+        return;
+    }
+
+    const std::size_t capacity{std::max(indexCount, 2 * indexCapacity_)};
+
+    if (indexHeap_)
+    {
+        BufferHeap::Range range{
+            indexHeap_->allocate(indexSize() * capacity, indexSize())};
+        vertexArrayObject_->bind();
+        range.buffer()->bind();
+        if (indexCapacity_)
+        {
+            range.buffer()->copyBufferSubData(
+                *elementBufferObject_, static_cast<GLintptr>(indexOffset_),
+                static_cast<GLintptr>(range.offset()),
+                static_cast<GLsizeiptr>(indexSize() * indexCapacity_));
+        }
+        vertexArrayObject_->release();
+
+        indexRange_ = std::move(range);
+        elementBufferObject_ = indexRange_.buffer();
+        indexOffset_ = indexRange_.offset();
+        indexCapacity_ = capacity;
+        return;
+    }
+
+    std::unique_ptr<BufferObjectType> buffer{new BufferObjectType{
+        OpenGL::OpenGLBufferObject::Type::ElementArrayBuffer,
+        OpenGL::OpenGLBufferObject::UsagePattern::StaticDraw}};
+
+    vertexArrayObject_->bind();
+    buffer->bind();
+    buffer->allocateBufferData(
+        nullptr, static_cast<GLsizeiptr>(indexSize() * capacity));
+    if (indexCapacity_)
+    {
+        buffer->copyBufferSubData(
+            *elementBufferObject_, 0, 0,
+            static_cast<GLsizeiptr>(indexSize() * indexCapacity_));
+    }
+    vertexArrayObject_->release();
+
+    elementBufferObject_ = std::move(buffer);
+    indexCapacity_ = capacity;
+}
+
+void Mesh::setColor(const glm::vec4 &color) noexcept { color_ = color; }
+
+template <typename Layout>
+void Mesh::LayoutPack::apply()
+{
+    bytes.resize(Layout::stride * view.vertexCount);
+    Layout::pack(view, quantization, bytes.data());
+}
+
+template <typename Layout>
+void Mesh::LayoutSetUp::apply()
+{
+    mesh.setUpLayout<Layout>();
+}
+
+template <typename Function>
+void Mesh::selectInterleavedLayout(const VertexStreams &streams,
+                                   VertexCompression compression,
+                                   Function &function)
+{
+    const bool present[]{streams.normals, streams.textureCoordinates,
+                         streams.colors, streams.tangents};
+    if (compression == VertexCompression::None)
+    {
+        VertexLayoutSelector<
+            InterleavedLayout, VertexAttributes<PositionAttribute>,
+            VertexAttributes<NormalAttribute, TextureCoordinateAttribute,
+                             ColorAttribute, TangentAttribute>>::
+            select(present, function);
+        return;
+    }
+
+    using QuantizedOptional =
+        VertexAttributes<OctahedralNormalAttribute,
+                         Normalized16TextureCoordinateAttribute,
+                         ColorAttribute, Normalized16TangentAttribute>;
+    if (compression == VertexCompression::HalfFloat)
+    {
+        VertexLayoutSelector<InterleavedLayout,
+                             VertexAttributes<HalfPositionAttribute>,
+                             QuantizedOptional>::select(present, function);
+    }
+    else
+    {
+        VertexLayoutSelector<InterleavedLayout,
+                             VertexAttributes<Normalized16PositionAttribute>,
+                             QuantizedOptional>::select(present, function);
+    }
+}
+
+// Allocates the buffers of Layout, or a heap range for its one buffer, and
+// points the attributes at them. The vertex array object has to be bound.
+template <typename Layout>
+void Mesh::setUpLayout()
+{
+    if (vertexHeap_)
+    {
+        PROGRAM_ASSERT(Layout::bufferCount == 1);
+
+        // Starting on a whole vertex lets the writer address the range in
+        // vertices.
+        const std::size_t stride{Layout::vertexSize(0)};
+        vertexRange_ = vertexHeap_->allocate(stride * vertexCount_, stride);
+        vertexBufferObject_[0] = vertexRange_.buffer();
+        heapFirstVertex_ = vertexRange_.offset() / stride;
+
+        Layout::setUp(*shaderProgram_, vertexBuffers().data(),
+                      vertexRange_.offset());
+        vertexWriter_ = &Layout::write;
+        return;
+    }
+
+    for (std::size_t i{0}; i < Layout::bufferCount; ++i)
+    {
+        vertexBufferObject_[i].reset(new BufferObjectType{
+            OpenGL::OpenGLBufferObject::Type::ArrayBuffer,
+            OpenGL::OpenGLBufferObject::UsagePattern::StaticDraw});
+        vertexBufferObject_[i]->bind();
+        vertexBufferObject_[i]->allocateBufferData(
+            nullptr,
+            static_cast<GLsizeiptr>(Layout::vertexSize(i) * vertexCount_));
+    }
+
+    Layout::setUp(*shaderProgram_, vertexBuffers().data());
+    vertexWriter_ = &Layout::write;
+}
+
+void Mesh::setMaterials(std::vector<MaterialState> materials)
+{
+    materials_ = std::move(materials);
+}
+
+void Mesh::setBackfaceCulling(bool backfaceCulling) noexcept
+{
+    backfaceCulling_ = backfaceCulling;
+}
+
+void Mesh::setInstance(InstanceBuffer::Handle instance,
+                       const glm::mat4 &model)
+{
+    PROGRAM_ASSERT(instances_);
+
+    growInstanceBounds(model);
+    instances_->set(instance, model);
+}
+
+void Mesh::setLevelsOfDetail(const LevelOfDetailChain &chain)
+{
+    levels_.clear();
+    levelOfDetail_ = 0;
+    if (chain.levels.empty() || !elementBufferObject_ || !vertexWriter_)
+    {
+        return;
+    }
+
+    const std::size_t base{static_cast<std::size_t>(indicesCount_)};
+    writeIndices(base, chain.indices.data(), chain.indices.size());
+
+    levels_.reserve(chain.levels.size() + 1);
+    levels_.push_back(LevelOfDetail{
+        subMeshes_.empty()
+            ? std::vector<SubMesh>(
+                  1, SubMesh{0, static_cast<std::uint32_t>(base), -1})
+            : subMeshes_,
+        base, 0.0f});
+    for (const LevelOfDetail &level : chain.levels)
+    {
+        levels_.push_back(level);
+        for (SubMesh &subMesh : levels_.back().subMeshes)
+        {
+            subMesh.indexOffset += static_cast<std::uint32_t>(base);
+        }
+    }
+}
+
+void Mesh::setLevelOfDetail(std::size_t level) noexcept
+{
+    levelOfDetail_ = levels_.empty() ? 0 : std::min(level, levels_.size() - 1);
+}
+
+void Mesh::setMeshlets(std::vector<Meshlet> meshlets)
+{
+    meshlets_ = std::move(meshlets);
+    meshletVisible_.assign(meshlets_.size(), 1);
+    meshletStatistics_ = MeshletCullStatistics{};
+
+    subMeshMeshlets_.assign(std::max<std::size_t>(subMeshes_.size(), 1) + 1,
+                            0);
+    for (const Meshlet &meshlet : meshlets_)
+    {
+        if (meshlet.subMesh + 1 < subMeshMeshlets_.size())
+        {
+            ++subMeshMeshlets_[meshlet.subMesh + 1];
+        }
+    }
+    std::partial_sum(subMeshMeshlets_.begin(), subMeshMeshlets_.end(),
+                     subMeshMeshlets_.begin());
+}
+
+void Mesh::setModel(const glm::mat4 &model) { model_ = model; }
+
+void Mesh::setTriangleBvh(std::shared_ptr<const TriangleBvh> bvh)
+{
+    triangleBvh_ = std::move(bvh);
+}
+
+void Mesh::tidy() noexcept
+{
+    vertexRange_.reset();
+    indexRange_.reset();
+    heapFirstVertex_ = 0;
+    elementBufferObject_.reset();
+    for (auto &object : vertexBufferObject_)
+    {
+        object.reset();
+    }
+    vertexArrayObject_.reset();
+    vertexWriter_ = nullptr;
+    staging_.clear();
+    staging_.shrink_to_fit();
+}
+
+Mesh::TextureType *Mesh::texture() const noexcept { return texture_; }
+
+const TriangleBvh *Mesh::triangleBvh() const noexcept
+{
+    return triangleBvh_.get();
+}
+
+std::array<Mesh::BufferObjectType *, 5> Mesh::vertexBuffers() const noexcept
+{
+    std::array<BufferObjectType *, 5> buffers;
+    for (std::size_t i{0}; i < buffers.size(); ++i)
+    {
+        buffers[i] = vertexBufferObject_[i].get();
+    }
+    return buffers;
+}
+
+Bounds Mesh::worldBounds() const noexcept
+{
+    return Detail::transformBounds(instances_ ? instanceBounds_ : bounds_,
+                                   model_);
+}
+
+BoundingSphere Mesh::worldBoundingSphere() const noexcept
+{
+    if (instances_)
+    {
+        return Detail::boxSphere(worldBounds());
+    }
+
+    // The radius grows with the largest scale of the model matrix.
+    const float scale{std::max({glm::length(glm::vec3{model_[0]}),
+                                glm::length(glm::vec3{model_[1]}),
+                                glm::length(glm::vec3{model_[2]})})};
+    return BoundingSphere{
+        glm::vec3{model_ * glm::vec4{boundingSphere_.center, 1.0f}},
+        scale * boundingSphere_.radius};
+}
+
+void Mesh::writeIndices(std::size_t firstIndex, const IndexType *indices,
+                        std::size_t count)
+{
+    reserveIndices(firstIndex + count);
+
+    // Narrowed indices go through the staging buffer.
+    const std::size_t size{indexSize()};
+    const void *data{indices};
+    if (size != sizeof(IndexType))
+    {
+        staging_.resize(size * count);
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            const std::uint16_t index{static_cast<std::uint16_t>(indices[i])};
+            std::memcpy(staging_.data() + size * i, &index, size);
+        }
+        data = staging_.data();
+    }
+
+    vertexArrayObject_->bind();
+    elementBufferObject_->writeBufferSubData(
+        static_cast<GLintptr>(indexOffset_ + size * firstIndex), data,
+        static_cast<GLsizeiptr>(size * count));
+    vertexArrayObject_->release();
+}
+
+// The chunk has to carry every stream announced in beginMesh.
+void Mesh::writeObjects(ObjectUniformBuffer &objects, bool separateInstances)
+{
+    objects_ = &objects;
+    if (!instances_ || !separateInstances)
+    {
+        objectIndex_ = objects.append(
+            ObjectBlock::make(model_, quantization_, instances_ != nullptr));
+        return;
+    }
+
+    objectIndex_ = objects.size();
+    for (const glm::mat4 &instance : instances_->models())
+    {
+        objects.append(
+            ObjectBlock::make(model_ * instance, quantization_, false));
+    }
+}
+
+void Mesh::writeVertices(std::size_t firstVertex, const MeshView &chunk)
+{
+    vertexWriter_(vertexBuffers().data(), heapFirstVertex_ + firstVertex,
+                  chunk, quantization_, staging_);
+    vertexBufferObject_[0]->release();
+}
+
+} // namespace Model
@@ -1,76 +1,324 @@
-#ifndef HOMEWORK01_MODEL_MESH_HPP_
-#define HOMEWORK01_MODEL_MESH_HPP_
-
-#include "OpenGL/OpenGLBufferObject.hpp"
-#include "OpenGL/OpenGLShaderProgram.hpp"
-#include "OpenGL/OpenGLTexture.hpp"
-#include "OpenGL/OpenGLVertexArrayObject.hpp"
-
-#include "glm/mat4x4.hpp"
-
-#include <array>
-#include <memory>
-#include <vector>
-
-namespace Model
-{
-
-class Mesh
-{
-public:
-    using IndexType = unsigned int;
-    using TextureType = OpenGL::OpenGLTexture;
-    using ShaderProgramType = OpenGL::OpenGLShaderProgram;
-
-    explicit Mesh() noexcept;
-    explicit Mesh(const std::vector<float> &positions,
-                  const std::vector<float> &normals,
-                  const std::vector<float> &textureCoordinates,
-                  const std::vector<IndexType> &indices,
-                  ShaderProgramType &shaderProgram,
-                  TextureType *texture = nullptr);
-
-    Mesh(Mesh &&other) noexcept;
-    Mesh &operator=(Mesh &&other) noexcept;
-    ~Mesh();
-
-    Mesh(const Mesh &other) = delete;
-    Mesh &operator=(const Mesh &other) = delete;
-
-    void draw(glm::mat4 &view, glm::mat4 &projection);
-
-    glm::mat4 model();
-    void setModel(glm::mat4 &model);
-
-private:
-    using VertexArrayObjectType = OpenGL::OpenGLVertexArrayObject;
-    using BufferObjectType = OpenGL::OpenGLBufferObject;
-
-    void create(const std::vector<float> &positions,
-                const std::vector<float> &normals,
-                const std::vector<float> &textureCoordinates,
-                const std::vector<IndexType> &indices);
-    void tidy() noexcept;
-
-    static void vertexBufferObjectSetup(BufferObjectType &object,
-                                        const std::vector<float> &data,
-                                        ShaderProgramType &program,
-                                        GLuint index, GLint size, GLenum type,
-                                        GLboolean normalized, GLsizei stride,
-                                        int offset);
-
-    ShaderProgramType *shaderProgram_;
-    TextureType *texture_;
-
-    std::unique_ptr<VertexArrayObjectType> vertexArrayObject_;
-    std::array<std::unique_ptr<BufferObjectType>, 3> vertexBufferObject_;
-    std::unique_ptr<BufferObjectType> elementBufferObject_;
-
-    GLsizei indicesCount_;
-
-    glm::mat4 model_;
-};
-
-} // namespace Model
-
-#endif // HOMEWORK01_MODEL_MESH_HPP_
+#ifndef HOMEWORK01_MODEL_MESH_HPP_
+#define HOMEWORK01_MODEL_MESH_HPP_
+
+#include "BufferHeap.hpp"
+#include "InstanceBuffer.hpp"
+#include "MeshData.hpp"
+#include "MeshSimplifier.hpp"
+#include "MeshSink.hpp"
+#include "MeshletCuller.hpp"
+#include "TriangleBvh.hpp"
+#include "UniformBlocks.hpp"
+#include "VertexLayout.hpp"
+#include "VertexQuantizer.hpp"
+
+#include "OpenGL/OpenGLBufferObject.hpp"
+#include "OpenGL/OpenGLShaderProgram.hpp"
+#include "OpenGL/OpenGLTexture.hpp"
+#include "OpenGL/OpenGLVertexArrayObject.hpp"
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec4.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace Model
+{
+
+// GPU copy of one model. A Mesh is either created from a complete MeshView,
+// filled chunk by chunk through the MeshSink interface (the buffers are
+// sized once and only one chunk is ever held on the host), or set up over
+// ranges of buffer objects that were uploaded as they are, such as glTF
+// buffer views. A mesh created from a view may also live in ranges of
+// shared buffer heaps instead of buffer objects of its own.
+class Mesh : public MeshSink
+{
+public:
+    using IndexType = MeshSink::IndexType;
+    using TextureType = OpenGL::OpenGLTexture;
+    using ShaderProgramType = OpenGL::OpenGLShaderProgram;
+    using BufferObjectType = OpenGL::OpenGLBufferObject;
+
+    // A vertex attribute read in place from a buffer object, which may be
+    // shared with other meshes.
+    struct Attribute
+    {
+        std::shared_ptr<BufferObjectType> buffer;
+        GLint size;
+        GLenum type;
+        GLboolean normalized;
+        GLsizei stride;
+        std::size_t offset;
+    };
+
+    // Vertex and index ranges already resident in buffer objects. Attributes
+    // follow the shader locations (position, normal, texture coordinate,
+    // color, tangent); one without a buffer is absent. Without an index buffer the
+    // vertices are drawn in order.
+    struct BufferLayout
+    {
+        std::array<Attribute, 5> attributes;
+        std::shared_ptr<BufferObjectType> indexBuffer;
+        GLenum indexType;
+        std::size_t indexOffset;
+        std::size_t indexCount;
+        std::size_t vertexCount;
+        Bounds bounds;
+    };
+
+    // How the vertex streams of a mesh created from a view or through the
+    // MeshSink interface are laid out: one buffer per stream, or all
+    // streams interleaved in one buffer.
+    enum class VertexLayoutMode
+    {
+        Split,
+        Interleaved
+    };
+
+    // What a SubMesh is drawn with, indexed by SubMesh::materialIndex. A null
+    // texture falls back to the texture of the mesh.
+    struct MaterialState
+    {
+        TextureType *texture;
+        glm::vec4 color;
+    };
+
+    explicit Mesh() noexcept;
+    // A compressed mesh is always interleaved.
+    explicit Mesh(const MeshView &view, ShaderProgramType &shaderProgram,
+                  TextureType *texture = nullptr,
+                  VertexLayoutMode layoutMode = VertexLayoutMode::Split,
+                  VertexCompression compression = VertexCompression::None);
+    // An empty mesh to be filled through the MeshSink interface.
+    explicit Mesh(ShaderProgramType &shaderProgram,
+                  TextureType *texture = nullptr,
+                  VertexLayoutMode layoutMode = VertexLayoutMode::Split);
+    explicit Mesh(const BufferLayout &layout, ShaderProgramType &shaderProgram,
+                  TextureType *texture = nullptr);
+    // Interleaved, with the vertices in a range of vertexHeap and the
+    // indices, levels of detail included, in a range of indexHeap. The
+    // ranges go back to the heaps with the mesh, so the heaps have to
+    // outlive it. An image packVertices made of view with the same
+    // compression is uploaded as it is instead of packing view again.
+    explicit Mesh(const MeshView &view, BufferHeap &vertexHeap,
+                  BufferHeap &indexHeap, ShaderProgramType &shaderProgram,
+                  TextureType *texture = nullptr,
+                  VertexCompression compression = VertexCompression::None,
+                  const VertexImage *image = nullptr);
+
+    Mesh(Mesh &&other) noexcept;
+    Mesh &operator=(Mesh &&other) noexcept;
+    ~Mesh();
+
+    Mesh(const Mesh &other) = delete;
+    Mesh &operator=(const Mesh &other) = delete;
+
+    // Appends the Object block draw() binds, or with separateInstances one
+    // per instance for drawSeparately(), to objects. Called every frame
+    // before the draw, with objects uploaded in between; objects has to
+    // outlive the draw.
+    void writeObjects(ObjectUniformBuffer &objects,
+                      bool separateInstances = false);
+    // The camera comes from the Camera block; view and projection are for
+    // meshlet culling.
+    void draw(glm::mat4 &view, glm::mat4 &projection);
+    // Draws every instance with draws of its own, the way as many separate
+    // meshes would be, to compare against instancing. Without instances
+    // the same as draw().
+    void drawSeparately(glm::mat4 &view, glm::mat4 &projection);
+
+    glm::mat4 model() const;
+    void setModel(const glm::mat4 &model);
+
+    // Constant vertex color used when the mesh has no color stream.
+    void setColor(const glm::vec4 &color) noexcept;
+    // Sub-meshes without a material state use the texture and color of the
+    // mesh.
+    void setMaterials(std::vector<MaterialState> materials);
+    const glm::vec4 &color() const noexcept;
+    const std::vector<MaterialState> &materials() const noexcept;
+    TextureType *texture() const noexcept;
+    // Draws only the meshlets that pass MeshletCuller, which have to be
+    // built over the index buffer and sub-meshes the mesh was created with,
+    // in sub-mesh order as MeshletBuilder returns them.
+    // An empty list draws every sub-mesh whole.
+    void setMeshlets(std::vector<Meshlet> meshlets);
+    void setBackfaceCulling(bool backfaceCulling) noexcept;
+    // Appends the index buffers of a chain MeshSimplifier built over the
+    // view the mesh was created with. Level 0 stays the full mesh; coarser
+    // levels are drawn without meshlet culling.
+    void setLevelsOfDetail(const LevelOfDetailChain &chain);
+    // Clamped to the levels present.
+    void setLevelOfDetail(std::size_t level) noexcept;
+    // Hierarchy over the view the mesh was created with, for pick().
+    void setTriangleBvh(std::shared_ptr<const TriangleBvh> bvh);
+
+    // The first instance switches the mesh to instanced drawing: every
+    // instance is drawn with its own model matrix, applied before the one
+    // of the mesh, by one glDrawElementsInstanced per sub-mesh. Meshlets
+    // are not culled per instance, so they are drawn whole. Changes reach
+    // the GPU with the next draw.
+    InstanceBuffer::Handle addInstance(const glm::mat4 &model);
+    void removeInstance(InstanceBuffer::Handle instance);
+    void setInstance(InstanceBuffer::Handle instance, const glm::mat4 &model);
+    // Null until the first instance is added.
+    const InstanceBuffer *instances() const noexcept;
+
+    const Bounds &bounds() const noexcept;
+    // Centered on the bounds; reaches the furthest vertex of a mesh created
+    // from a view and the corners of the bounds otherwise.
+    const BoundingSphere &boundingSphere() const noexcept;
+    // Both through the model matrix, for culling. Those of an instanced
+    // mesh cover every place its instances have been, as they only grow.
+    Bounds worldBounds() const noexcept;
+    BoundingSphere worldBoundingSphere() const noexcept;
+    // Bytes used and error introduced by vertex compression and 16-bit
+    // indices.
+    const QuantizationReport &quantizationReport() const noexcept;
+    const std::vector<SubMesh> &subMeshes() const noexcept;
+    const std::vector<Meshlet> &meshlets() const noexcept;
+    std::size_t levelOfDetail() const noexcept;
+    // Every level, the full mesh first, with sub-mesh ranges in the element
+    // buffer. Empty without a chain.
+    const std::vector<LevelOfDetail> &levelsOfDetail() const noexcept;
+    // Of the last draw.
+    const MeshletCullStatistics &meshletStatistics() const noexcept;
+    const TriangleBvh *triangleBvh() const noexcept;
+    // GL draw calls the last draw() or drawSeparately() issued.
+    std::size_t drawCallCount() const noexcept;
+
+    // Closest full-detail triangle along a world space ray, through the
+    // model matrix; distances stay in multiples of the world direction.
+    // False without a hierarchy.
+    bool pick(const Ray &ray, RayHit &hit) const noexcept;
+
+    void beginMesh(const VertexStreams &streams, std::size_t vertexCount,
+                   std::size_t indexCapacity) override;
+    void writeVertices(std::size_t firstVertex, const MeshView &chunk) override;
+    void writeIndices(std::size_t firstIndex, const IndexType *indices,
+                      std::size_t count) override;
+    void endMesh(std::size_t indexCount, const Bounds &bounds) override;
+
+    // Packs the vertices of view into bytes the way a mesh over buffer heaps
+    // created from view with compression stores them. The image points into
+    // bytes.
+    static VertexImage packVertices(const MeshView &view,
+                                    VertexCompression compression,
+                                    std::vector<unsigned char> &bytes);
+
+private:
+    using VertexArrayObjectType = OpenGL::OpenGLVertexArrayObject;
+    using VertexWriter = void (*)(BufferObjectType *const *buffers,
+                                  std::size_t firstVertex,
+                                  const MeshView &chunk,
+                                  const VertexQuantization &quantization,
+                                  std::vector<unsigned char> &staging);
+
+    // Receives the layout chosen for the present streams.
+    struct LayoutSetUp
+    {
+        template <typename Layout>
+        void apply();
+
+        Mesh &mesh;
+    };
+
+    // Receives the layout chosen for the streams of view and packs them.
+    struct LayoutPack
+    {
+        template <typename Layout>
+        void apply();
+
+        const MeshView &view;
+        const VertexQuantization &quantization;
+        std::vector<unsigned char> &bytes;
+    };
+
+    // Picks the interleaved layout of streams under compression.
+    template <typename Function>
+    static void selectInterleavedLayout(const VertexStreams &streams,
+                                        VertexCompression compression,
+                                        Function &function);
+
+    void create(const MeshView &view, const VertexImage *image);
+    void growInstanceBounds(const glm::mat4 &model) noexcept;
+    void cullMeshlets(const glm::mat4 &view, const glm::mat4 &projection);
+    void drawRange(std::size_t first, std::size_t count);
+    void drawSubMesh(std::size_t subMesh, std::size_t first,
+                     std::size_t count);
+    std::size_t indexSize() const noexcept;
+    void reserveIndices(std::size_t indexCount);
+    template <typename Layout>
+    void setUpLayout();
+    void tidy() noexcept;
+    std::array<BufferObjectType *, 5> vertexBuffers() const noexcept;
+
+    ShaderProgramType *shaderProgram_;
+    TextureType *texture_;
+
+    std::unique_ptr<VertexArrayObjectType> vertexArrayObject_;
+    // Indexed by shader location for a BufferLayout, and in the order of
+    // the vertex layout otherwise.
+    std::array<std::shared_ptr<BufferObjectType>, 5> vertexBufferObject_;
+    std::shared_ptr<BufferObjectType> elementBufferObject_;
+    // Null unless the buffers above are ranges of shared heaps; the vertices
+    // then start at vertex heapFirstVertex_ of their buffer.
+    BufferHeap *vertexHeap_;
+    BufferHeap *indexHeap_;
+    BufferHeap::Range vertexRange_;
+    BufferHeap::Range indexRange_;
+    std::size_t heapFirstVertex_;
+
+    VertexLayoutMode layoutMode_;
+    VertexCompression compression_;
+    VertexQuantization quantization_;
+    QuantizationReport quantizationReport_;
+    VertexWriter vertexWriter_;
+    std::vector<unsigned char> staging_;
+
+    VertexStreams streams_;
+    std::size_t vertexCount_;
+    std::size_t indexCapacity_;
+    GLsizei indicesCount_;
+    GLenum indexType_;
+    std::size_t indexOffset_;
+
+    glm::mat4 model_;
+    glm::vec4 color_;
+
+    Bounds bounds_;
+    BoundingSphere boundingSphere_;
+    std::vector<SubMesh> subMeshes_;
+    std::vector<MaterialState> materials_;
+
+    std::vector<Meshlet> meshlets_;
+    // First meshlet of every sub-mesh, and one past the last.
+    std::vector<std::size_t> subMeshMeshlets_;
+    std::vector<unsigned char> meshletVisible_;
+    MeshletCuller meshletCuller_;
+    MeshletCullStatistics meshletStatistics_;
+    bool backfaceCulling_;
+    std::size_t drawCallCount_;
+    // Index ranges of one glMultiDrawElements, kept across frames.
+    std::vector<GLsizei> drawCounts_;
+    std::vector<const GLvoid *> drawOffsets_;
+
+    std::vector<LevelOfDetail> levels_;
+    std::size_t levelOfDetail_;
+
+    std::shared_ptr<const TriangleBvh> triangleBvh_;
+
+    std::unique_ptr<InstanceBuffer> instances_;
+    // Of the instances in the space of the mesh model matrix.
+    Bounds instanceBounds_;
+
+    // Where writeObjects() put the blocks of this frame.
+    ObjectUniformBuffer *objects_;
+    std::size_t objectIndex_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_MESH_HPP_
@@ -0,0 +1,695 @@
+#include "MeshCache.hpp"
+
+#include "Utils/FileIO/FilePath.hpp"
+#include "Utils/FileIO/FileStatus.hpp"
+#include "Utils/Hash/Hash.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+constexpr char cacheMagic[8]{'H', '0', '1', 'M', 'E', 'S', 'H', '\0'};
+// Version 4 caches hold meshes already reordered by MeshOptimizer, version 5
+// ones generated normals for models without any, version 6 generated
+// tangents, version 7 ones the files, such as material libraries, the model
+// depends on, and version 8 ones may hold the vertices packed for upload.
+constexpr std::uint32_t cacheVersion{8};
+constexpr std::uint32_t cacheByteOrder{0x01020304};
+constexpr std::uint64_t cacheAlignment{16};
+// Size recorded for a dependency that did not exist, so creating it later
+// invalidates the cache.
+constexpr std::uint64_t cacheMissingFile{~std::uint64_t{0}};
+
+constexpr std::uint32_t cacheNormals{1u << 0};
+constexpr std::uint32_t cacheTextureCoordinates{1u << 1};
+constexpr std::uint32_t cacheColors{1u << 2};
+constexpr std::uint32_t cacheTangents{1u << 3};
+constexpr std::uint32_t cacheVertexImage{1u << 4};
+
+// Packed vertices are described by the compression and decode parameters
+// they were encoded with and the report measured when encoding them.
+struct CacheVertexImage
+{
+    std::uint32_t compression;
+    std::uint32_t octahedralNormals;
+    float positionOffset[3];
+    float positionScale[3];
+    float textureCoordinateOffset[2];
+    float textureCoordinateScale[2];
+    float maximumPositionError;
+    float maximumNormalError;
+    float maximumTextureCoordinateError;
+    std::uint32_t reserved;
+    std::uint64_t vertexBytes;
+    std::uint64_t compressedVertexBytes;
+};
+
+struct CacheHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+
+    std::uint64_t sourceSize;
+    std::int64_t sourceModifiedTime;
+    std::uint64_t sourceHash;
+
+    std::uint64_t vertexCount;
+    std::uint64_t indexCount;
+    std::uint64_t subMeshCount;
+    std::uint64_t materialCount;
+    std::uint64_t dependencyCount;
+    std::uint32_t attributes;
+
+    float boundsMinimum[3];
+    float boundsMaximum[3];
+    std::uint32_t reserved;
+
+    std::uint64_t positionsOffset;
+    std::uint64_t normalsOffset;
+    std::uint64_t textureCoordinatesOffset;
+    std::uint64_t colorsOffset;
+    std::uint64_t tangentsOffset;
+    std::uint64_t indicesOffset;
+    std::uint64_t subMeshesOffset;
+    std::uint64_t materialsOffset;
+    std::uint64_t materialsSize;
+    std::uint64_t dependenciesOffset;
+    std::uint64_t dependenciesSize;
+
+    CacheVertexImage vertexImage;
+    std::uint64_t vertexImageOffset;
+    std::uint64_t vertexImageSize;
+};
+
+// Each material is stored as its diffuse color, the byte lengths of its name
+// and texture path, then both strings, padded to a 4 byte boundary.
+struct CacheMaterial
+{
+    float diffuseColor[3];
+    std::uint32_t nameLength;
+    std::uint32_t textureLength;
+};
+
+// Each dependency is stored as the size and modification time it had when the
+// cache was written, the byte length of its path relative to the directory of
+// the source, then the path, padded to a 4 byte boundary.
+struct CacheDependency
+{
+    std::uint64_t size;
+    std::int64_t modifiedTime;
+    std::uint32_t pathLength;
+    std::uint32_t reserved;
+};
+
+static_assert(std::is_standard_layout<CacheHeader>::value,
+              "CacheHeader is written as raw bytes");
+static_assert(sizeof(SubMesh) == 3 * sizeof(std::uint32_t),
+              "SubMesh is written as raw bytes");
+static_assert(sizeof(CacheMaterial) == 5 * sizeof(std::uint32_t),
+              "CacheMaterial is written as raw bytes");
+static_assert(sizeof(CacheDependency) == 6 * sizeof(std::uint32_t),
+              "CacheDependency is written as raw bytes");
+static_assert(sizeof(CacheVertexImage) == 20 * sizeof(std::uint32_t),
+              "CacheVertexImage is written as raw bytes");
+
+std::uint64_t alignUp(std::uint64_t value) noexcept;
+FileIO::FileStatus dependencyStatus(const std::string &path);
+bool dependenciesCurrent(const char *data, std::uint64_t size,
+                         std::uint64_t count, const std::string &directory);
+std::vector<char> packDependencies(const std::vector<std::string> &paths,
+                                   const std::string &directory);
+CacheVertexImage packVertexImage(const VertexImage &image) noexcept;
+bool unpackVertexImage(const CacheVertexImage &record, const char *data,
+                       std::uint64_t size, VertexImage &image) noexcept;
+std::vector<char> packMaterials(const Material *materials,
+                                std::size_t count);
+bool unpackMaterials(const char *data, std::uint64_t size,
+                     std::uint64_t count, std::vector<Material> &materials);
+bool validIndices(const MeshView::IndexType *indices, std::uint64_t count,
+                  std::uint64_t vertexCount) noexcept;
+bool validSection(const FileIO::MappedFile &file, std::uint64_t offset,
+                  std::uint64_t count, std::uint64_t itemSize) noexcept;
+bool validSubMeshes(const SubMesh *subMeshes, std::uint64_t count,
+                    std::uint64_t indexCount,
+                    std::uint64_t materialCount) noexcept;
+
+inline std::uint64_t alignUp(std::uint64_t value) noexcept
+{
+    return (value + cacheAlignment - 1) / cacheAlignment * cacheAlignment;
+}
+
+inline FileIO::FileStatus dependencyStatus(const std::string &path)
+{
+    FileIO::FileStatus status;
+    if (!FileIO::GetFileStatus(path.c_str(), status))
+    {
+        status = FileIO::FileStatus{cacheMissingFile, 0};
+    }
+    return status;
+}
+
+inline bool dependenciesCurrent(const char *data, std::uint64_t size,
+                                std::uint64_t count,
+                                const std::string &directory)
+{
+    std::uint64_t offset{0};
+    for (std::uint64_t i{0}; i < count; ++i)
+    {
+        CacheDependency record;
+        if (size - offset < sizeof(record))
+        {
+            return false;
+        }
+        std::memcpy(&record, data + offset, sizeof(record));
+        offset += sizeof(record);
+
+        if (size - offset < record.pathLength)
+        {
+            return false;
+        }
+
+        const FileIO::FileStatus status{dependencyStatus(
+            directory + std::string{data + offset, record.pathLength})};
+        if (status.size != record.size ||
+            status.modifiedTime != record.modifiedTime)
+        {
+            return false;
+        }
+
+        offset = std::min(size, (offset + record.pathLength + 3) / 4 * 4);
+    }
+    return true;
+}
+
+inline std::vector<char>
+packDependencies(const std::vector<std::string> &paths,
+                 const std::string &directory)
+{
+    std::vector<char> bytes;
+    for (const std::string &path : paths)
+    {
+        const FileIO::FileStatus status{dependencyStatus(directory + path)};
+
+        CacheDependency record;
+        record.size = status.size;
+        record.modifiedTime = status.modifiedTime;
+        record.pathLength = static_cast<std::uint32_t>(path.size());
+        record.reserved = 0;
+
+        const char *begin{reinterpret_cast<const char *>(&record)};
+        bytes.insert(bytes.end(), begin, begin + sizeof(record));
+        bytes.insert(bytes.end(), path.begin(), path.end());
+        bytes.resize((bytes.size() + 3) / 4 * 4, '\0');
+    }
+    return bytes;
+}
+
+inline CacheVertexImage packVertexImage(const VertexImage &image) noexcept
+{
+    CacheVertexImage record;
+    std::memset(&record, 0, sizeof(record));
+    record.compression = static_cast<std::uint32_t>(image.compression);
+    record.octahedralNormals = image.quantization.octahedralNormals ? 1 : 0;
+    for (int i{0}; i < 3; ++i)
+    {
+        record.positionOffset[i] = image.quantization.positionOffset[i];
+        record.positionScale[i] = image.quantization.positionScale[i];
+    }
+    for (int i{0}; i < 2; ++i)
+    {
+        record.textureCoordinateOffset[i] =
+            image.quantization.textureCoordinateOffset[i];
+        record.textureCoordinateScale[i] =
+            image.quantization.textureCoordinateScale[i];
+    }
+    record.maximumPositionError = image.report.maximumPositionError;
+    record.maximumNormalError = image.report.maximumNormalError;
+    record.maximumTextureCoordinateError =
+        image.report.maximumTextureCoordinateError;
+    record.vertexBytes = image.report.vertexBytes;
+    record.compressedVertexBytes = image.report.compressedVertexBytes;
+    return record;
+}
+
+inline bool unpackVertexImage(const CacheVertexImage &record,
+                              const char *data, std::uint64_t size,
+                              VertexImage &image) noexcept
+{
+    if (record.compression >
+        static_cast<std::uint32_t>(VertexCompression::HalfFloat))
+    {
+        return false;
+    }
+
+    image.compression = static_cast<VertexCompression>(record.compression);
+    image.quantization.positionOffset =
+        glm::vec3{record.positionOffset[0], record.positionOffset[1],
+                  record.positionOffset[2]};
+    image.quantization.positionScale =
+        glm::vec3{record.positionScale[0], record.positionScale[1],
+                  record.positionScale[2]};
+    image.quantization.textureCoordinateOffset = glm::vec2{
+        record.textureCoordinateOffset[0], record.textureCoordinateOffset[1]};
+    image.quantization.textureCoordinateScale = glm::vec2{
+        record.textureCoordinateScale[0], record.textureCoordinateScale[1]};
+    image.quantization.octahedralNormals = record.octahedralNormals != 0;
+    image.report = QuantizationReport{
+        static_cast<std::size_t>(record.vertexBytes),
+        static_cast<std::size_t>(record.compressedVertexBytes),
+        0,
+        0,
+        record.maximumPositionError,
+        record.maximumNormalError,
+        record.maximumTextureCoordinateError};
+    image.data = reinterpret_cast<const unsigned char *>(data);
+    image.size = static_cast<std::size_t>(size);
+    return true;
+}
+
+inline bool validIndices(const MeshView::IndexType *indices,
+                         std::uint64_t count,
+                         std::uint64_t vertexCount) noexcept
+{
+    return std::none_of(indices, indices + count,
+                        [vertexCount](MeshView::IndexType index) {
+                            return index >= vertexCount;
+                        });
+}
+
+// Divided rather than multiplied, so a corrupt count cannot wrap around.
+inline bool validSection(const FileIO::MappedFile &file, std::uint64_t offset,
+                         std::uint64_t count, std::uint64_t itemSize) noexcept
+{
+    return offset % sizeof(std::uint32_t) == 0 && offset <= file.size() &&
+           count <= (file.size() - offset) / itemSize;
+}
+
+inline bool validSubMeshes(const SubMesh *subMeshes, std::uint64_t count,
+                           std::uint64_t indexCount,
+                           std::uint64_t materialCount) noexcept
+{
+    return std::none_of(
+        subMeshes, subMeshes + count, [&](const SubMesh &subMesh) {
+            return subMesh.indexOffset > indexCount ||
+                   subMesh.indexCount > indexCount - subMesh.indexOffset ||
+                   subMesh.materialIndex < -1 ||
+                   (subMesh.materialIndex >= 0 &&
+                    static_cast<std::uint64_t>(subMesh.materialIndex) >=
+                        materialCount);
+        });
+}
+
+inline std::vector<char> packMaterials(const Material *materials,
+                                       std::size_t count)
+{
+    std::vector<char> bytes;
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        const Material &material{materials[i]};
+
+        CacheMaterial record;
+        for (int j{0}; j < 3; ++j)
+        {
+            record.diffuseColor[j] = material.diffuseColor[j];
+        }
+        record.nameLength = static_cast<std::uint32_t>(material.name.size());
+        record.textureLength =
+            static_cast<std::uint32_t>(material.diffuseTexture.size());
+
+        const char *begin{reinterpret_cast<const char *>(&record)};
+        bytes.insert(bytes.end(), begin, begin + sizeof(record));
+        bytes.insert(bytes.end(), material.name.begin(), material.name.end());
+        bytes.insert(bytes.end(), material.diffuseTexture.begin(),
+                     material.diffuseTexture.end());
+        bytes.resize((bytes.size() + 3) / 4 * 4, '\0');
+    }
+    return bytes;
+}
+
+inline bool unpackMaterials(const char *data, std::uint64_t size,
+                            std::uint64_t count,
+                            std::vector<Material> &materials)
+{
+    materials.clear();
+
+    std::uint64_t offset{0};
+    for (std::uint64_t i{0}; i < count; ++i)
+    {
+        CacheMaterial record;
+        if (size - offset < sizeof(record))
+        {
+            return false;
+        }
+        std::memcpy(&record, data + offset, sizeof(record));
+        offset += sizeof(record);
+
+        const std::uint64_t length{std::uint64_t{record.nameLength} +
+                                   record.textureLength};
+        if (size - offset < length)
+        {
+            return false;
+        }
+
+        Material material;
+        material.diffuseColor =
+            glm::vec3{record.diffuseColor[0], record.diffuseColor[1],
+                      record.diffuseColor[2]};
+        material.name.assign(data + offset, record.nameLength);
+        material.diffuseTexture.assign(data + offset + record.nameLength,
+                                       record.textureLength);
+        materials.push_back(std::move(material));
+
+        offset = std::min(size, (offset + length + 3) / 4 * 4);
+    }
+    return true;
+}
+
+} // namespace Detail
+
+MeshCache::MeshCache() noexcept
+    : file_{}, view_{nullptr, nullptr,  nullptr, nullptr, nullptr,
+                     0,       nullptr,  0,       Bounds{}, nullptr,
+                     0,       nullptr,  0},
+      vertexImage_{VertexCompression::None, VertexQuantization::identity(),
+                   QuantizationReport{}, nullptr, 0},
+      materials_{}
+{
+}
+
+std::string MeshCache::cachePath(const char *sourceFile)
+{
+    return std::string{sourceFile} + ".meshcache";
+}
+
+void MeshCache::close() noexcept
+{
+    file_.close();
+    view_ = MeshView{nullptr, nullptr,  nullptr, nullptr, nullptr,
+                     0,       nullptr,  0,       Bounds{}, nullptr,
+                     0,       nullptr,  0};
+    vertexImage_.data = nullptr;
+    vertexImage_.size = 0;
+    materials_.clear();
+}
+
+bool MeshCache::open(const char *sourceFile)
+{
+    close();
+
+    FileIO::FileStatus status;
+    if (!FileIO::GetFileStatus(sourceFile, status) ||
+        !file_.open(cachePath(sourceFile).c_str()) ||
+        file_.size() < sizeof(Detail::CacheHeader))
+    {
+        close();
+        return false;
+    }
+
+    Detail::CacheHeader header;
+    std::memcpy(&header, file_.data(), sizeof(header));
+
+    if (std::memcmp(header.magic, Detail::cacheMagic, sizeof(header.magic)) ||
+        header.version != Detail::cacheVersion ||
+        header.byteOrder != Detail::cacheByteOrder ||
+        header.sourceSize != status.size)
+    {
+        close();
+        return false;
+    }
+
+    // A touched but unchanged source keeps its cache.
+    std::uint64_t sourceHash;
+    if (header.sourceModifiedTime != status.modifiedTime &&
+        (!Hash::HashFile(sourceFile, sourceHash) ||
+         sourceHash != header.sourceHash))
+    {
+        close();
+        return false;
+    }
+
+    const bool hasNormals{(header.attributes & Detail::cacheNormals) != 0};
+    const bool hasTextureCoordinates{
+        (header.attributes & Detail::cacheTextureCoordinates) != 0};
+    const bool hasColors{(header.attributes & Detail::cacheColors) != 0};
+    const bool hasTangents{(header.attributes & Detail::cacheTangents) != 0};
+    const bool hasVertexImage{
+        (header.attributes & Detail::cacheVertexImage) != 0};
+
+    if (!Detail::validSection(file_, header.positionsOffset,
+                              header.vertexCount, 3 * sizeof(float)) ||
+        (hasNormals &&
+         !Detail::validSection(file_, header.normalsOffset,
+                               header.vertexCount, 3 * sizeof(float))) ||
+        (hasTextureCoordinates &&
+         !Detail::validSection(file_, header.textureCoordinatesOffset,
+                               header.vertexCount, 2 * sizeof(float))) ||
+        (hasColors && !Detail::validSection(file_, header.colorsOffset,
+                                            header.vertexCount, 4)) ||
+        (hasTangents &&
+         !Detail::validSection(file_, header.tangentsOffset,
+                               header.vertexCount, 4 * sizeof(float))) ||
+        !Detail::validSection(file_, header.indicesOffset, header.indexCount,
+                              sizeof(MeshView::IndexType)) ||
+        !Detail::validSection(file_, header.subMeshesOffset,
+                              header.subMeshCount, sizeof(SubMesh)) ||
+        !Detail::validSection(file_, header.materialsOffset,
+                              header.materialsSize, 1) ||
+        !Detail::validSection(file_, header.dependenciesOffset,
+                              header.dependenciesSize, 1) ||
+        (hasVertexImage &&
+         !Detail::validSection(file_, header.vertexImageOffset,
+                               header.vertexImageSize, 1)) ||
+        !Detail::unpackMaterials(file_.data() + header.materialsOffset,
+                                 header.materialsSize, header.materialCount,
+                                 materials_))
+    {
+        close();
+        return false;
+    }
+
+    const char *base{file_.data()};
+
+    // The size of the packed vertices is checked against their layout when
+    // they are uploaded.
+    if (hasVertexImage &&
+        !Detail::unpackVertexImage(header.vertexImage,
+                                   base + header.vertexImageOffset,
+                                   header.vertexImageSize, vertexImage_))
+    {
+        close();
+        return false;
+    }
+
+    // Materials come from other files than the source, which have to be
+    // unchanged as well.
+    if (!Detail::dependenciesCurrent(base + header.dependenciesOffset,
+                                     header.dependenciesSize,
+                                     header.dependencyCount,
+                                     FileIO::DirectoryOf(sourceFile)))
+    {
+        close();
+        return false;
+    }
+
+    // Loaders check what they read, and so does the cache: one pass over the
+    // indices and sub-meshes keeps a corrupt file away from the builders and
+    // the GPU.
+    if (!Detail::validIndices(reinterpret_cast<const MeshView::IndexType *>(
+                                  base + header.indicesOffset),
+                              header.indexCount, header.vertexCount) ||
+        !Detail::validSubMeshes(
+            reinterpret_cast<const SubMesh *>(base + header.subMeshesOffset),
+            header.subMeshCount, header.indexCount, materials_.size()))
+    {
+        close();
+        return false;
+    }
+
+    view_.positions =
+        reinterpret_cast<const float *>(base + header.positionsOffset);
+    view_.normals = hasNormals ? reinterpret_cast<const float *>(
+                                     base + header.normalsOffset)
+                               : nullptr;
+    view_.textureCoordinates =
+        hasTextureCoordinates
+            ? reinterpret_cast<const float *>(base +
+                                              header.textureCoordinatesOffset)
+            : nullptr;
+    view_.colors = hasColors ? reinterpret_cast<const std::uint8_t *>(
+                                   base + header.colorsOffset)
+                             : nullptr;
+    view_.tangents = hasTangents ? reinterpret_cast<const float *>(
+                                       base + header.tangentsOffset)
+                                 : nullptr;
+    view_.vertexCount = static_cast<std::size_t>(header.vertexCount);
+    view_.indices = reinterpret_cast<const MeshView::IndexType *>(
+        base + header.indicesOffset);
+    view_.indexCount = static_cast<std::size_t>(header.indexCount);
+    view_.bounds = Bounds{
+        glm::vec3{header.boundsMinimum[0], header.boundsMinimum[1],
+                  header.boundsMinimum[2]},
+        glm::vec3{header.boundsMaximum[0], header.boundsMaximum[1],
+                  header.boundsMaximum[2]}};
+    view_.subMeshes =
+        reinterpret_cast<const SubMesh *>(base + header.subMeshesOffset);
+    view_.subMeshCount = static_cast<std::size_t>(header.subMeshCount);
+    view_.materials = materials_.data();
+    view_.materialCount = materials_.size();
+
+    return true;
+}
+
+const VertexImage *MeshCache::vertexImage() const noexcept
+{
+    return vertexImage_.data ? &vertexImage_ : nullptr;
+}
+
+const MeshView &MeshCache::view() const noexcept { return view_; }
+
+bool MeshCache::write(const char *sourceFile, const MeshData &meshData,
+                      const VertexImage *vertexImage)
+{
+    FileIO::FileStatus status;
+    std::uint64_t sourceHash;
+    if (!FileIO::GetFileStatus(sourceFile, status) ||
+        !Hash::HashFile(sourceFile, sourceHash))
+    {
+        return false;
+    }
+
+    const MeshView view{meshData.view()};
+
+    Detail::CacheHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, Detail::cacheMagic, sizeof(header.magic));
+    header.version = Detail::cacheVersion;
+    header.byteOrder = Detail::cacheByteOrder;
+    header.sourceSize = status.size;
+    header.sourceModifiedTime = status.modifiedTime;
+    header.sourceHash = sourceHash;
+    header.vertexCount = view.vertexCount;
+    header.indexCount = view.indexCount;
+    header.subMeshCount = view.subMeshCount;
+    header.materialCount = view.materialCount;
+    header.dependencyCount = meshData.dependencies.size();
+    header.attributes =
+        (view.normals ? Detail::cacheNormals : 0u) |
+        (view.textureCoordinates ? Detail::cacheTextureCoordinates : 0u) |
+        (view.colors ? Detail::cacheColors : 0u) |
+        (view.tangents ? Detail::cacheTangents : 0u) |
+        (vertexImage ? Detail::cacheVertexImage : 0u);
+    for (int i{0}; i < 3; ++i)
+    {
+        header.boundsMinimum[i] = view.bounds.minimum[i];
+        header.boundsMaximum[i] = view.bounds.maximum[i];
+    }
+
+    const std::vector<char> materials{
+        Detail::packMaterials(view.materials, view.materialCount)};
+    header.materialsSize = materials.size();
+    const std::vector<char> dependencies{Detail::packDependencies(
+        meshData.dependencies, FileIO::DirectoryOf(sourceFile))};
+    header.dependenciesSize = dependencies.size();
+    if (vertexImage)
+    {
+        header.vertexImage = Detail::packVertexImage(*vertexImage);
+        header.vertexImageSize = vertexImage->size;
+    }
+
+    struct Section
+    {
+        std::uint64_t *offset;
+        const void *data;
+        std::uint64_t size;
+    };
+
+    const Section sections[]{
+        {&header.positionsOffset, view.positions,
+         3 * sizeof(float) * view.vertexCount},
+        {&header.normalsOffset, view.normals,
+         view.normals ? 3 * sizeof(float) * view.vertexCount : 0},
+        {&header.textureCoordinatesOffset, view.textureCoordinates,
+         view.textureCoordinates ? 2 * sizeof(float) * view.vertexCount : 0},
+        {&header.colorsOffset, view.colors,
+         view.colors ? 4 * view.vertexCount : 0},
+        {&header.tangentsOffset, view.tangents,
+         view.tangents ? 4 * sizeof(float) * view.vertexCount : 0},
+        {&header.indicesOffset, view.indices,
+         sizeof(MeshView::IndexType) * view.indexCount},
+        {&header.subMeshesOffset, view.subMeshes,
+         sizeof(SubMesh) * view.subMeshCount},
+        {&header.materialsOffset, materials.data(), materials.size()},
+        {&header.dependenciesOffset, dependencies.data(),
+         dependencies.size()},
+        {&header.vertexImageOffset, vertexImage ? vertexImage->data : nullptr,
+         header.vertexImageSize}};
+
+    std::uint64_t offset{Detail::alignUp(sizeof(header))};
+    for (const Section &section : sections)
+    {
+        *section.offset = offset;
+        offset = Detail::alignUp(offset + section.size);
+    }
+
+    // Write to a temporary file and move it in place, so that a concurrent
+    // reader never maps a half written cache.
+    const std::string path{cachePath(sourceFile)};
+    const std::string temporaryPath{path + ".tmp"};
+    {
+        std::ofstream out(temporaryPath,
+                          std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!out.is_open())
+        {
+            return false;
+        }
+
+        const char padding[Detail::cacheAlignment]{};
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        std::uint64_t written{sizeof(header)};
+
+        for (const Section &section : sections)
+        {
+            out.write(padding,
+                      static_cast<std::streamsize>(*section.offset - written));
+            if (section.size)
+            {
+                out.write(static_cast<const char *>(section.data),
+                          static_cast<std::streamsize>(section.size));
+            }
+            written = *section.offset + section.size;
+        }
+
+        if (!out.good())
+        {
+            out.close();
+            std::remove(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+#if defined(_WIN32)
+    // rename() does not replace an existing file on Windows.
+    std::remove(path.c_str());
+#endif
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace Model
@@ -0,0 +1,59 @@
+#ifndef HOMEWORK01_MODEL_MESHCACHE_HPP_
+#define HOMEWORK01_MODEL_MESHCACHE_HPP_
+
+#include "MeshData.hpp"
+#include "VertexQuantizer.hpp"
+
+#include "Utils/FileIO/MappedFile.hpp"
+
+#include <string>
+#include <vector>
+
+namespace Model
+{
+
+// Versioned binary image of processed mesh data, stored next to its source
+// model as "<source>.meshcache". The cache is keyed by the size, the
+// modification time and the content hash of the source. A valid cache is
+// memory mapped and exposed as a MeshView straight into the mapping, so
+// nothing is parsed or copied before upload. The cache may also hold the
+// vertices packed for one compression, which then go up without packing.
+class MeshCache
+{
+public:
+    explicit MeshCache() noexcept;
+
+    MeshCache(MeshCache &&other) noexcept = default;
+    MeshCache &operator=(MeshCache &&other) noexcept = default;
+    ~MeshCache() = default;
+
+    MeshCache(const MeshCache &other) = delete;
+    MeshCache &operator=(const MeshCache &other) = delete;
+
+    // Maps the cache of sourceFile. Returns false when it is missing,
+    // corrupt or stale, in which case the source has to be loaded again.
+    bool open(const char *sourceFile);
+    void close() noexcept;
+
+    // Valid until close() or destruction.
+    const MeshView &view() const noexcept;
+    // Null when the cache holds no packed vertices. Valid as view() is.
+    const VertexImage *vertexImage() const noexcept;
+
+    static std::string cachePath(const char *sourceFile);
+    // vertexImage, when given, has to be packed from meshData.
+    static bool write(const char *sourceFile, const MeshData &meshData,
+                      const VertexImage *vertexImage = nullptr);
+
+private:
+    FileIO::MappedFile file_;
+    MeshView view_;
+    // Without packed vertices its data is null.
+    VertexImage vertexImage_;
+    // Materials are variable length, so they are parsed out of the mapping.
+    std::vector<Material> materials_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_MESHCACHE_HPP_
@@ -0,0 +1,173 @@
+#ifndef HOMEWORK01_MODEL_MESHDATA_HPP_
+#define HOMEWORK01_MODEL_MESHDATA_HPP_
+
+#include "glm/common.hpp"
+#include "glm/vec3.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Model
+{
+
+struct Bounds
+{
+    glm::vec3 minimum;
+    glm::vec3 maximum;
+};
+
+struct BoundingSphere
+{
+    glm::vec3 center;
+    float radius;
+};
+
+// A contiguous range of the index buffer drawn with one material.
+struct SubMesh
+{
+    std::uint32_t indexOffset;
+    std::uint32_t indexCount;
+    std::int32_t materialIndex;
+};
+
+// Surface description a SubMesh refers to, as read from an OBJ .mtl file.
+struct Material
+{
+    std::string name;
+    glm::vec3 diffuseColor;
+    // Path of the diffuse map, resolved against the model; empty if none.
+    std::string diffuseTexture;
+};
+
+// Non-owning view of mesh geometry. Mesh only reads through a view, so the
+// streams may live in a MeshData or directly in a mapped cache file.
+struct MeshView
+{
+    using IndexType = unsigned int;
+
+    const float *positions;
+    const float *normals;
+    const float *textureCoordinates;
+    // RGBA, one byte per channel.
+    const std::uint8_t *colors;
+    // Tangent in xyz and the sign of the bitangent, cross(normal, tangent),
+    // in w.
+    const float *tangents;
+    std::size_t vertexCount;
+
+    const IndexType *indices;
+    std::size_t indexCount;
+
+    Bounds bounds;
+
+    const SubMesh *subMeshes;
+    std::size_t subMeshCount;
+
+    const Material *materials;
+    std::size_t materialCount;
+};
+
+// CPU side geometry of one model, laid out the way Mesh uploads it: one
+// stream per attribute and a triangle list indexing into them.
+struct MeshData
+{
+    using IndexType = MeshView::IndexType;
+
+    std::size_t vertexCount() const noexcept { return positions.size() / 3; }
+    std::size_t triangleCount() const noexcept { return indices.size() / 3; }
+
+    void clear() noexcept
+    {
+        positions.clear();
+        normals.clear();
+        textureCoordinates.clear();
+        colors.clear();
+        tangents.clear();
+        indices.clear();
+        subMeshes.clear();
+        materials.clear();
+        dependencies.clear();
+        bounds = Bounds{glm::vec3{0}, glm::vec3{0}};
+    }
+
+    void updateBounds() noexcept
+    {
+        bounds = Bounds{glm::vec3{0}, glm::vec3{0}};
+        for (std::size_t i{0}; i + 2 < positions.size(); i += 3)
+        {
+            const glm::vec3 position{positions[i], positions[i + 1],
+                                     positions[i + 2]};
+            bounds.minimum = i ? glm::min(bounds.minimum, position) : position;
+            bounds.maximum = i ? glm::max(bounds.maximum, position) : position;
+        }
+    }
+
+    // Appends a copy of vertex sources[i] to every stream present, for
+    // vertices that have to be split.
+    void duplicateVertices(const std::vector<IndexType> &sources)
+    {
+        duplicate(positions, 3, sources);
+        duplicate(normals, 3, sources);
+        duplicate(textureCoordinates, 2, sources);
+        duplicate(colors, 4, sources);
+        duplicate(tangents, 4, sources);
+    }
+
+    MeshView view() const noexcept
+    {
+        return MeshView{positions.data(),
+                        normals.empty() ? nullptr : normals.data(),
+                        textureCoordinates.empty() ? nullptr
+                                                   : textureCoordinates.data(),
+                        colors.empty() ? nullptr : colors.data(),
+                        tangents.empty() ? nullptr : tangents.data(),
+                        vertexCount(),
+                        indices.data(),
+                        indices.size(),
+                        bounds,
+                        subMeshes.data(),
+                        subMeshes.size(),
+                        materials.data(),
+                        materials.size()};
+    }
+
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> textureCoordinates;
+    std::vector<std::uint8_t> colors;
+    std::vector<float> tangents;
+    std::vector<IndexType> indices;
+
+    Bounds bounds;
+    // Sub-meshes are sorted by material, one range per material.
+    std::vector<SubMesh> subMeshes;
+    std::vector<Material> materials;
+    // Files besides the model the data was read from, such as OBJ material
+    // libraries, relative to the directory of the model.
+    std::vector<std::string> dependencies;
+
+private:
+    template <typename Element>
+    static void duplicate(std::vector<Element> &stream, std::size_t size,
+                          const std::vector<IndexType> &sources)
+    {
+        if (stream.empty())
+        {
+            return;
+        }
+        const std::size_t end{stream.size()};
+        stream.resize(end + size * sources.size());
+        for (std::size_t i{0}; i < sources.size(); ++i)
+        {
+            std::copy_n(stream.begin() + size * sources[i], size,
+                        stream.begin() + end + size * i);
+        }
+    }
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_MESHDATA_HPP_
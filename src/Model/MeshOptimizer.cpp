@@ -0,0 +1,518 @@
+#include "MeshOptimizer.hpp"
+
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glm/geometric.hpp"
+#include "glm/vec3.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Clusters are cut as soon as their ACMR comes within this factor of the
+// ACMR of the whole range, which bounds the cache cost of reordering them.
+constexpr float overdrawThreshold{1.05f};
+// Vertex fetches go through cache lines of this many bytes, of which the
+// simulated cache holds fetchCacheLines.
+constexpr std::size_t fetchLineSize{64};
+constexpr std::size_t fetchCacheLines{64};
+
+constexpr std::uint32_t invalidVertex{
+    std::numeric_limits<std::uint32_t>::max()};
+
+// FIFO cache of vertex ids with timestamps: a vertex is cached while fewer
+// than size vertices have been inserted after it.
+class FifoCache
+{
+public:
+    FifoCache(std::size_t vertexCount, std::size_t size);
+
+    // Returns whether vertex missed, inserting it if so.
+    bool access(std::uint32_t vertex) noexcept;
+    void flush() noexcept;
+
+    std::size_t time() const noexcept;
+    std::size_t stamp(std::uint32_t vertex) const noexcept;
+
+private:
+    std::vector<std::size_t> stamps_;
+    std::size_t size_;
+    std::size_t time_;
+};
+
+std::size_t vertexSize(const MeshData &meshData) noexcept;
+glm::vec3 position(const float *positions, std::uint32_t vertex) noexcept;
+template <typename T>
+void permute(std::vector<T> &stream, std::size_t components,
+             const std::vector<std::uint32_t> &remap);
+
+inline FifoCache::FifoCache(std::size_t vertexCount, std::size_t size)
+    : stamps_(vertexCount, 0), size_{size}, time_{size + 1}
+{
+}
+
+inline bool FifoCache::access(std::uint32_t vertex) noexcept
+{
+    if (time_ - stamps_[vertex] > size_)
+    {
+        stamps_[vertex] = time_++;
+        return true;
+    }
+    return false;
+}
+
+inline void FifoCache::flush() noexcept { time_ += size_ + 1; }
+
+inline std::size_t FifoCache::time() const noexcept { return time_; }
+
+inline std::size_t FifoCache::stamp(std::uint32_t vertex) const noexcept
+{
+    return stamps_[vertex];
+}
+
+inline std::size_t vertexSize(const MeshData &meshData) noexcept
+{
+    return 3 * sizeof(float) +
+           (meshData.normals.empty() ? 0 : 3 * sizeof(float)) +
+           (meshData.textureCoordinates.empty() ? 0 : 2 * sizeof(float)) +
+           (meshData.colors.empty() ? 0 : 4) +
+           (meshData.tangents.empty() ? 0 : 4 * sizeof(float));
+}
+
+inline glm::vec3 position(const float *positions, std::uint32_t vertex) noexcept
+{
+    return glm::vec3{positions[3 * vertex], positions[3 * vertex + 1],
+                     positions[3 * vertex + 2]};
+}
+
+// Moves element v of stream (components wide) to remap[v].
+template <typename T>
+inline void permute(std::vector<T> &stream, std::size_t components,
+                    const std::vector<std::uint32_t> &remap)
+{
+    if (stream.empty())
+    {
+        return;
+    }
+
+    std::vector<T> permuted(stream.size());
+    for (std::size_t v{0}; v < remap.size(); ++v)
+    {
+        std::copy(stream.begin() + components * v,
+                  stream.begin() + components * (v + 1),
+                  permuted.begin() + components * remap[v]);
+    }
+    stream = std::move(permuted);
+}
+
+} // namespace Detail
+
+MeshOptimizer::MeshOptimizer(std::size_t cacheSize,
+                             bool reduceOverdraw) noexcept
+    : statistics_{}, cacheSize_{cacheSize}, reduceOverdraw_{reduceOverdraw}
+{
+}
+
+void MeshOptimizer::optimize(MeshData &meshData)
+{
+    Performance::Stopwatch stopwatch;
+
+    const std::size_t vertexCount{meshData.vertexCount()};
+    const std::size_t vertexSize{Detail::vertexSize(meshData)};
+
+    statistics_ = Statistics{};
+    statistics_.before =
+        analyze(meshData.indices.data(), meshData.indices.size(), vertexCount,
+                vertexSize, cacheSize_);
+
+    std::vector<SubMesh> ranges{meshData.subMeshes};
+    if (ranges.empty())
+    {
+        ranges.push_back(SubMesh{
+            0, static_cast<std::uint32_t>(meshData.indices.size()), -1});
+    }
+
+    std::vector<std::uint32_t> clusters;
+    for (const SubMesh &range : ranges)
+    {
+        clusters.clear();
+        optimizeVertexCache(meshData.indices.data(), range.indexOffset,
+                            range.indexCount, vertexCount, cacheSize_,
+                            reduceOverdraw_ ? &clusters : nullptr);
+        if (reduceOverdraw_)
+        {
+            statistics_.clusterCount += optimizeOverdraw(
+                meshData.indices.data(), range.indexOffset, range.indexCount,
+                meshData.positions.data(), cacheSize_, std::move(clusters));
+        }
+    }
+
+    optimizeVertexFetch(meshData);
+
+    statistics_.after =
+        analyze(meshData.indices.data(), meshData.indices.size(), vertexCount,
+                vertexSize, cacheSize_);
+    statistics_.optimizeMilliseconds = stopwatch.elapsedMilliseconds();
+}
+
+const MeshOptimizer::Statistics &MeshOptimizer::statistics() const noexcept
+{
+    return statistics_;
+}
+
+VertexCacheStatistics MeshOptimizer::analyze(const IndexType *indices,
+                                             std::size_t indexCount,
+                                             std::size_t vertexCount,
+                                             std::size_t vertexSize,
+                                             std::size_t cacheSize)
+{
+    Detail::FifoCache cache{vertexCount, cacheSize};
+    const std::size_t lineCount{
+        (vertexCount * vertexSize + Detail::fetchLineSize - 1) /
+        Detail::fetchLineSize};
+    Detail::FifoCache lines{lineCount, Detail::fetchCacheLines};
+    std::vector<bool> referenced(vertexCount, false);
+
+    std::size_t misses{0};
+    std::size_t fetchedLines{0};
+    std::size_t uniqueVertices{0};
+    for (std::size_t i{0}; i < indexCount; ++i)
+    {
+        const IndexType vertex{indices[i]};
+        if (!referenced[vertex])
+        {
+            referenced[vertex] = true;
+            ++uniqueVertices;
+        }
+
+        if (!cache.access(vertex))
+        {
+            continue;
+        }
+        ++misses;
+
+        // Only vertices the shader runs for are fetched.
+        const std::size_t begin{vertex * vertexSize};
+        for (std::size_t line{begin / Detail::fetchLineSize};
+             line <= (begin + vertexSize - 1) / Detail::fetchLineSize; ++line)
+        {
+            fetchedLines +=
+                lines.access(static_cast<std::uint32_t>(line)) ? 1 : 0;
+        }
+    }
+
+    const std::size_t triangleCount{indexCount / 3};
+    return VertexCacheStatistics{
+        triangleCount ? static_cast<float>(misses) /
+                            static_cast<float>(triangleCount)
+                      : 0.0f,
+        uniqueVertices ? static_cast<float>(misses) /
+                             static_cast<float>(uniqueVertices)
+                       : 0.0f,
+        uniqueVertices ? static_cast<float>(fetchedLines *
+                                            Detail::fetchLineSize) /
+                             static_cast<float>(uniqueVertices * vertexSize)
+                       : 0.0f};
+}
+
+// Tipsify: triangles are emitted fan by fan around a current vertex, and the
+// next vertex is the one of the last fan that stays in the cache longest
+// without running out of triangles. When none qualifies, the most recently
+// used vertex with triangles left, or else the one with the lowest input id,
+// starts a new run.
+void MeshOptimizer::optimizeVertexCache(IndexType *indices, std::size_t first,
+                                        std::size_t count,
+                                        std::size_t vertexCount,
+                                        std::size_t cacheSize,
+                                        std::vector<std::uint32_t> *clusters)
+{
+    const std::size_t triangleCount{count / 3};
+    if (!triangleCount)
+    {
+        return;
+    }
+    IndexType *triangles{indices + first};
+
+    // Range local vertex ids keep every array below proportional to the
+    // range rather than to the whole mesh.
+    std::vector<std::uint32_t> local(vertexCount, Detail::invalidVertex);
+    std::vector<IndexType> global;
+    std::vector<std::uint32_t> corners(3 * triangleCount);
+    for (std::size_t i{0}; i < corners.size(); ++i)
+    {
+        std::uint32_t &id{local[triangles[i]]};
+        if (id == Detail::invalidVertex)
+        {
+            id = static_cast<std::uint32_t>(global.size());
+            global.push_back(triangles[i]);
+        }
+        corners[i] = id;
+    }
+    const std::size_t localCount{global.size()};
+
+    // Triangles around every vertex; live counts those not emitted yet.
+    std::vector<std::uint32_t> live(localCount, 0);
+    for (const std::uint32_t corner : corners)
+    {
+        ++live[corner];
+    }
+    std::vector<std::uint32_t> offsets(localCount + 1, 0);
+    std::partial_sum(live.begin(), live.end(), offsets.begin() + 1);
+    std::vector<std::uint32_t> adjacency(corners.size());
+    {
+        std::vector<std::uint32_t> next(offsets.begin(), offsets.end() - 1);
+        for (std::size_t i{0}; i < corners.size(); ++i)
+        {
+            adjacency[next[corners[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+    }
+
+    Detail::FifoCache cache{localCount, cacheSize};
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<std::uint32_t> deadEnd;
+    std::vector<std::uint32_t> candidates;
+    std::vector<IndexType> output;
+    output.reserve(corners.size());
+    std::size_t cursor{0};
+
+    if (clusters)
+    {
+        clusters->push_back(0);
+    }
+
+    std::uint32_t current{corners[0]};
+    while (current != Detail::invalidVertex)
+    {
+        candidates.clear();
+        for (std::uint32_t i{offsets[current]}; i < offsets[current + 1]; ++i)
+        {
+            const std::uint32_t triangle{adjacency[i]};
+            if (emitted[triangle])
+            {
+                continue;
+            }
+            emitted[triangle] = true;
+            for (std::size_t c{0}; c < 3; ++c)
+            {
+                const std::uint32_t vertex{corners[3 * triangle + c]};
+                output.push_back(global[vertex]);
+                deadEnd.push_back(vertex);
+                candidates.push_back(vertex);
+                --live[vertex];
+                cache.access(vertex);
+            }
+        }
+
+        std::uint32_t next{Detail::invalidVertex};
+        std::size_t bestPriority{0};
+        for (const std::uint32_t vertex : candidates)
+        {
+            if (!live[vertex])
+            {
+                continue;
+            }
+            // Only vertices that stay cached while their remaining
+            // triangles are emitted qualify; the oldest of them wins.
+            const std::size_t age{cache.time() - cache.stamp(vertex)};
+            const std::size_t priority{
+                age + 2 * live[vertex] <= cacheSize ? age : 0};
+            if (priority > bestPriority)
+            {
+                bestPriority = priority;
+                next = vertex;
+            }
+        }
+
+        if (next == Detail::invalidVertex)
+        {
+            while (!deadEnd.empty() && next == Detail::invalidVertex)
+            {
+                if (live[deadEnd.back()])
+                {
+                    next = deadEnd.back();
+                }
+                deadEnd.pop_back();
+            }
+            // Input vertex ids usually follow the surface even when the
+            // triangle order does not.
+            for (; next == Detail::invalidVertex && cursor < vertexCount;
+                 ++cursor)
+            {
+                if (local[cursor] != Detail::invalidVertex &&
+                    live[local[cursor]])
+                {
+                    next = local[cursor];
+                }
+            }
+            if (clusters && next != Detail::invalidVertex)
+            {
+                clusters->push_back(
+                    static_cast<std::uint32_t>(output.size()));
+            }
+        }
+
+        current = next;
+    }
+
+    std::copy(output.begin(), output.end(), triangles);
+}
+
+// Splits the runs of optimizeVertexCache further wherever the ACMR of the
+// cluster so far is close to that of the range, then draws the clusters
+// facing furthest out of the range first.
+std::size_t MeshOptimizer::optimizeOverdraw(IndexType *indices,
+                                            std::size_t first,
+                                            std::size_t count,
+                                            const float *positions,
+                                            std::size_t cacheSize,
+                                            std::vector<std::uint32_t> clusters)
+{
+    const std::size_t triangleCount{count / 3};
+    if (!triangleCount)
+    {
+        return 0;
+    }
+    IndexType *triangles{indices + first};
+
+    const std::size_t vertexCount{
+        static_cast<std::size_t>(
+            *std::max_element(triangles, triangles + 3 * triangleCount)) +
+        1};
+    const float threshold{
+        Detail::overdrawThreshold *
+        analyze(triangles, 3 * triangleCount, vertexCount, 1, cacheSize)
+            .averageCacheMissRatio};
+
+    // Each cluster is costed as if drawn after unrelated geometry.
+    std::vector<std::uint32_t> boundaries;
+    clusters.push_back(static_cast<std::uint32_t>(3 * triangleCount));
+    Detail::FifoCache cache{vertexCount, cacheSize};
+    for (std::size_t run{0}; run + 1 < clusters.size(); ++run)
+    {
+        std::size_t misses{0};
+        std::size_t clusterTriangles{0};
+        cache.flush();
+        boundaries.push_back(clusters[run]);
+        for (std::uint32_t i{clusters[run]}; i < clusters[run + 1]; i += 3)
+        {
+            for (std::uint32_t c{0}; c < 3; ++c)
+            {
+                misses += cache.access(triangles[i + c]) ? 1 : 0;
+            }
+            ++clusterTriangles;
+
+            if (i + 3 < clusters[run + 1] &&
+                static_cast<float>(misses) <=
+                    threshold * static_cast<float>(clusterTriangles))
+            {
+                misses = 0;
+                clusterTriangles = 0;
+                cache.flush();
+                boundaries.push_back(i + 3);
+            }
+        }
+    }
+    boundaries.push_back(static_cast<std::uint32_t>(3 * triangleCount));
+
+    // Area weighted centroid and normal of every cluster and of the range.
+    const std::size_t clusterCount{boundaries.size() - 1};
+    std::vector<glm::vec3> centroids(clusterCount, glm::vec3{0.0f});
+    std::vector<glm::vec3> normals(clusterCount, glm::vec3{0.0f});
+    glm::vec3 rangeCentroid{0.0f};
+    float rangeArea{0.0f};
+    for (std::size_t cluster{0}; cluster < clusterCount; ++cluster)
+    {
+        float area{0.0f};
+        for (std::uint32_t i{boundaries[cluster]};
+             i < boundaries[cluster + 1]; i += 3)
+        {
+            const glm::vec3 a{Detail::position(positions, triangles[i])};
+            const glm::vec3 b{Detail::position(positions, triangles[i + 1])};
+            const glm::vec3 c{Detail::position(positions, triangles[i + 2])};
+            const glm::vec3 normal{glm::cross(b - a, c - a)};
+            const float triangleArea{glm::length(normal)};
+
+            centroids[cluster] += triangleArea * (a + b + c) / 3.0f;
+            normals[cluster] += normal;
+            area += triangleArea;
+        }
+        rangeCentroid += centroids[cluster];
+        rangeArea += area;
+        if (area > 0.0f)
+        {
+            centroids[cluster] /= area;
+        }
+    }
+    if (rangeArea > 0.0f)
+    {
+        rangeCentroid /= rangeArea;
+    }
+
+    std::vector<float> keys(clusterCount, 0.0f);
+    for (std::size_t cluster{0}; cluster < clusterCount; ++cluster)
+    {
+        const float length{glm::length(normals[cluster])};
+        if (length > 0.0f)
+        {
+            keys[cluster] = glm::dot(centroids[cluster] - rangeCentroid,
+                                     normals[cluster] / length);
+        }
+    }
+
+    std::vector<std::uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&keys](std::uint32_t lhs, std::uint32_t rhs) {
+                         return keys[lhs] > keys[rhs];
+                     });
+
+    std::vector<IndexType> sorted;
+    sorted.reserve(3 * triangleCount);
+    for (const std::uint32_t cluster : order)
+    {
+        sorted.insert(sorted.end(), triangles + boundaries[cluster],
+                      triangles + boundaries[cluster + 1]);
+    }
+    std::copy(sorted.begin(), sorted.end(), triangles);
+
+    return clusterCount;
+}
+
+// Vertices nothing references keep their relative order after the rest.
+void MeshOptimizer::optimizeVertexFetch(MeshData &meshData)
+{
+    const std::size_t vertexCount{meshData.vertexCount()};
+    std::vector<std::uint32_t> remap(vertexCount, Detail::invalidVertex);
+
+    std::uint32_t next{0};
+    for (IndexType &index : meshData.indices)
+    {
+        if (remap[index] == Detail::invalidVertex)
+        {
+            remap[index] = next++;
+        }
+        index = remap[index];
+    }
+    for (std::uint32_t &vertex : remap)
+    {
+        if (vertex == Detail::invalidVertex)
+        {
+            vertex = next++;
+        }
+    }
+
+    Detail::permute(meshData.positions, 3, remap);
+    Detail::permute(meshData.normals, 3, remap);
+    Detail::permute(meshData.textureCoordinates, 2, remap);
+    Detail::permute(meshData.colors, 4, remap);
+    Detail::permute(meshData.tangents, 4, remap);
+}
+
+} // namespace Model
@@ -0,0 +1,92 @@
+#ifndef HOMEWORK01_MODEL_MESHOPTIMIZER_HPP_
+#define HOMEWORK01_MODEL_MESHOPTIMIZER_HPP_
+
+#include "MeshData.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Model
+{
+
+// How well an index order uses the post-transform vertex cache, simulated as
+// a FIFO of cacheSize vertices. ACMR is the number of vertex shader runs per
+// triangle (0.5 at best on a regular grid, 3 at worst) and ATVR the number
+// of runs per referenced vertex (1 at best). Overfetch is the number of
+// bytes read from the vertex buffer per byte of referenced vertices, through
+// a small cache of 64-byte lines.
+struct VertexCacheStatistics
+{
+    float averageCacheMissRatio;
+    float averageTransformToVertexRatio;
+    float overfetch;
+};
+
+// What MeshOptimizer reports about its last run.
+struct MeshOptimizerStatistics
+{
+    VertexCacheStatistics before;
+    VertexCacheStatistics after;
+    std::size_t clusterCount;
+    double optimizeMilliseconds;
+};
+
+// Pipeline stage between loading and Mesh::create that reorders a MeshData
+// in place for the GPU, without changing what is drawn:
+//  1. the triangles of every sub-mesh are reordered for post-transform vertex
+//     cache locality (Sander et al., "Fast Triangle Reordering for Vertex
+//     Locality and Reduced Overdraw", 2007);
+//  2. optionally, the resulting runs of triangles are split into clusters
+//     and the clusters sorted so outward facing ones are drawn first, which
+//     lets early depth testing reject more of what they hide;
+//  3. vertices are renumbered in the order the index buffer first uses them,
+//     so vertex fetches walk the streams forwards.
+// Sub-meshes keep their ranges, so materials are unaffected.
+class MeshOptimizer
+{
+public:
+    using IndexType = MeshData::IndexType;
+    using Statistics = MeshOptimizerStatistics;
+
+    explicit MeshOptimizer(std::size_t cacheSize = 16,
+                           bool reduceOverdraw = true) noexcept;
+
+    void optimize(MeshData &meshData);
+
+    const Statistics &statistics() const noexcept;
+
+    // Cache behaviour of drawing indices with a FIFO of cacheSize vertices,
+    // each vertexSize bytes large.
+    static VertexCacheStatistics
+    analyze(const IndexType *indices, std::size_t indexCount,
+            std::size_t vertexCount, std::size_t vertexSize,
+            std::size_t cacheSize);
+
+    // Step 1 over the triangles of [first, first + count) of indices.
+    // Appends the index (relative to first) at which each run of the new
+    // order starts to clusters, if given.
+    static void optimizeVertexCache(IndexType *indices, std::size_t first,
+                                    std::size_t count, std::size_t vertexCount,
+                                    std::size_t cacheSize,
+                                    std::vector<std::uint32_t> *clusters);
+
+    // Step 2 over the same range, given the runs step 1 produced.
+    static std::size_t optimizeOverdraw(IndexType *indices, std::size_t first,
+                                        std::size_t count,
+                                        const float *positions,
+                                        std::size_t cacheSize,
+                                        std::vector<std::uint32_t> clusters);
+
+    // Step 3 over the whole mesh.
+    static void optimizeVertexFetch(MeshData &meshData);
+
+private:
+    Statistics statistics_;
+    std::size_t cacheSize_;
+    bool reduceOverdraw_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_MESHOPTIMIZER_HPP_
@@ -0,0 +1,741 @@
+#include "MeshSimplifier.hpp"
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+constexpr MeshView::IndexType noVertex{
+    std::numeric_limits<MeshView::IndexType>::max()};
+// Weight of the planes that hold border edges in place, relative to the
+// surface planes.
+constexpr float borderWeight{10.0f};
+// Collapses of one pass come from the cheapest part of the candidates, so
+// each pass roughly follows the global cost order.
+constexpr std::size_t passCandidateFraction{3};
+// Smallest cosine between the normals of a triangle before and after a
+// collapse.
+constexpr float minimumNormalTurnDot{0.25f};
+// A level that keeps more than this part of the one before ends the chain.
+constexpr float minimumLevelReduction{0.9f};
+// Vertices at one position whose normals are within about 30 degrees may
+// stand for each other; exporters often write faceted normals of a smooth
+// surface.
+constexpr float wedgeNormalCosine{0.866f};
+
+std::array<std::uint32_t, 3> positionBits(const float *position) noexcept;
+std::uint64_t edgeKey(std::uint32_t from, std::uint32_t to) noexcept;
+bool sameWedge(const MeshView &view, MeshView::IndexType a,
+               MeshView::IndexType b) noexcept;
+
+inline std::array<std::uint32_t, 3> positionBits(const float *position) noexcept
+{
+    std::array<std::uint32_t, 3> bits;
+    std::memcpy(bits.data(), position, sizeof(bits));
+    return bits;
+}
+
+inline std::uint64_t edgeKey(std::uint32_t from, std::uint32_t to) noexcept
+{
+    return static_cast<std::uint64_t>(from) << 32 | to;
+}
+
+// Whether two vertices at one position can take each other's place: close
+// normals, and equal texture coordinates, colors and bitangent signs.
+inline bool sameWedge(const MeshView &view, MeshView::IndexType a,
+                      MeshView::IndexType b) noexcept
+{
+    if (view.normals)
+    {
+        const float *n{view.normals};
+        if (n[3 * a] * n[3 * b] + n[3 * a + 1] * n[3 * b + 1] +
+                n[3 * a + 2] * n[3 * b + 2] <
+            wedgeNormalCosine)
+        {
+            return false;
+        }
+    }
+    if (view.textureCoordinates &&
+        std::memcmp(view.textureCoordinates + 2 * a,
+                    view.textureCoordinates + 2 * b, 2 * sizeof(float)) != 0)
+    {
+        return false;
+    }
+    if (view.colors && std::memcmp(view.colors + 4 * a, view.colors + 4 * b,
+                                   4 * sizeof(std::uint8_t)) != 0)
+    {
+        return false;
+    }
+    return !view.tangents ||
+           (view.tangents[4 * a + 3] < 0.0f) ==
+               (view.tangents[4 * b + 3] < 0.0f);
+}
+
+} // namespace Detail
+
+MeshSimplifier::MeshSimplifier(const MeshView &view)
+    : positions_(view.vertexCount), scale_{1.0f}, wedges_(view.vertexCount),
+      representatives_(view.vertexCount), otherWedges_(view.vertexCount),
+      kinds_(view.vertexCount, VertexKind::Manifold),
+      borderNext_(view.vertexCount, Detail::noVertex),
+      borderPrevious_(view.vertexCount, Detail::noVertex),
+      seamNext_(view.vertexCount, Detail::noVertex),
+      seamPrevious_(view.vertexCount, Detail::noVertex),
+      quadrics_(view.vertexCount, Quadric{}),
+      normals_(view.vertexCount, glm::vec3{0.0f}), error_{0.0f}
+{
+    const glm::vec3 extent{view.bounds.maximum - view.bounds.minimum};
+    scale_ = std::max({extent.x, extent.y, extent.z});
+    if (!(scale_ > 0.0f))
+    {
+        scale_ = 1.0f;
+    }
+    for (std::size_t i{0}; i < view.vertexCount; ++i)
+    {
+        positions_[i] = (glm::vec3{view.positions[3 * i],
+                                   view.positions[3 * i + 1],
+                                   view.positions[3 * i + 2]} -
+                         view.bounds.minimum) /
+                        scale_;
+    }
+
+    // Vertices sharing a position split into wedges by their attributes,
+    // and topology is built over one vertex per wedge. A position with one
+    // wedge points it at itself, the two wedges of a seam point at each
+    // other, and positions with more wedges point them at noVertex.
+    {
+        std::vector<IndexType> order(view.vertexCount);
+        std::iota(order.begin(), order.end(), 0);
+        const auto samePosition = [&view](IndexType lhs, IndexType rhs) {
+            return Detail::positionBits(view.positions + 3 * lhs) ==
+                   Detail::positionBits(view.positions + 3 * rhs);
+        };
+        std::stable_sort(order.begin(), order.end(),
+                         [&view](IndexType lhs, IndexType rhs) {
+                             return Detail::positionBits(view.positions +
+                                                         3 * lhs) <
+                                    Detail::positionBits(view.positions +
+                                                         3 * rhs);
+                         });
+        std::vector<IndexType> positionWedges;
+        for (std::size_t begin{0}, end{0}; begin < order.size(); begin = end)
+        {
+            positionWedges.clear();
+            for (end = begin;
+                 end < order.size() && samePosition(order[end], order[begin]);
+                 ++end)
+            {
+                const IndexType vertex{order[end]};
+                const auto wedge = std::find_if(
+                    positionWedges.begin(), positionWedges.end(),
+                    [&view, vertex](IndexType other) {
+                        return Detail::sameWedge(view, vertex, other);
+                    });
+                wedges_[vertex] =
+                    wedge == positionWedges.end() ? vertex : *wedge;
+                representatives_[vertex] = order[begin];
+                if (wedges_[vertex] == vertex)
+                {
+                    positionWedges.push_back(vertex);
+                }
+            }
+
+            const std::size_t count{positionWedges.size()};
+            for (std::size_t i{0}; i < count; ++i)
+            {
+                otherWedges_[positionWedges[i]] =
+                    count == 1   ? positionWedges[i]
+                    : count == 2 ? positionWedges[1 - i]
+                                 : Detail::noVertex;
+            }
+        }
+    }
+
+    // Wedges used by more than one sub-mesh sit on a material boundary.
+    std::vector<std::int64_t> owner(view.vertexCount, -1);
+    const std::size_t subMeshCount{std::max<std::size_t>(view.subMeshCount, 1)};
+    for (std::size_t subMesh{0}; subMesh < subMeshCount; ++subMesh)
+    {
+        const std::size_t first{view.subMeshCount
+                                    ? view.subMeshes[subMesh].indexOffset
+                                    : 0};
+        const std::size_t count{view.subMeshCount
+                                    ? view.subMeshes[subMesh].indexCount
+                                    : view.indexCount};
+        for (std::size_t i{first}; i < first + count; ++i)
+        {
+            const IndexType wedge{wedges_[view.indices[i]]};
+            if (owner[wedge] < 0)
+            {
+                owner[wedge] = static_cast<std::int64_t>(subMesh);
+            }
+            else if (owner[wedge] != static_cast<std::int64_t>(subMesh))
+            {
+                kinds_[wedge] = VertexKind::Locked;
+            }
+        }
+    }
+
+    // Edges between positions, counted, and edges between wedges.
+    std::unordered_map<std::uint64_t, std::uint32_t> edges;
+    std::unordered_set<std::uint64_t> wedgeEdges;
+    edges.reserve(view.indexCount);
+    wedgeEdges.reserve(view.indexCount);
+    for (std::size_t i{0}; i + 2 < view.indexCount; i += 3)
+    {
+        for (std::size_t c{0}; c < 3; ++c)
+        {
+            const IndexType from{view.indices[i + c]};
+            const IndexType to{view.indices[i + (c + 1) % 3]};
+            ++edges[Detail::edgeKey(representatives_[from],
+                                    representatives_[to])];
+            wedgeEdges.insert(Detail::edgeKey(wedges_[from], wedges_[to]));
+        }
+    }
+
+    // A plane through an edge perpendicular to the surface.
+    const auto holdEdge = [this](IndexType from, IndexType to,
+                                 const glm::vec3 &normal) {
+        const glm::vec3 edge{positions_[to] - positions_[from]};
+        const glm::vec3 side{glm::cross(edge, normal)};
+        const float sideLength{glm::length(side)};
+        if (sideLength > 0.0f)
+        {
+            const glm::vec3 sideNormal{side / sideLength};
+            const float weight{Detail::borderWeight * glm::dot(edge, edge)};
+            addPlane(quadrics_[from], sideNormal,
+                     -glm::dot(sideNormal, positions_[from]), weight);
+            addPlane(quadrics_[to], sideNormal,
+                     -glm::dot(sideNormal, positions_[from]), weight);
+        }
+    };
+
+    for (std::size_t i{0}; i + 2 < view.indexCount; i += 3)
+    {
+        const IndexType triangle[3]{wedges_[view.indices[i]],
+                                    wedges_[view.indices[i + 1]],
+                                    wedges_[view.indices[i + 2]]};
+        const glm::vec3 &a{positions_[triangle[0]]};
+        const glm::vec3 &b{positions_[triangle[1]]};
+        const glm::vec3 &c{positions_[triangle[2]]};
+        const glm::vec3 cross{glm::cross(b - a, c - a)};
+        const float length{glm::length(cross)};
+        if (!(length > 0.0f))
+        {
+            continue;
+        }
+        const glm::vec3 normal{cross / length};
+
+        // Planes weighted by area.
+        for (std::size_t corner{0}; corner < 3; ++corner)
+        {
+            addPlane(quadrics_[triangle[corner]], normal,
+                     -glm::dot(normal, a), 0.5f * length);
+            normals_[triangle[corner]] += cross;
+        }
+
+        for (std::size_t corner{0}; corner < 3; ++corner)
+        {
+            const IndexType from{triangle[corner]};
+            const IndexType to{triangle[(corner + 1) % 3]};
+            const std::uint32_t forward{edges[Detail::edgeKey(
+                representatives_[from], representatives_[to])]};
+            const auto backward =
+                edges.find(Detail::edgeKey(representatives_[to],
+                                           representatives_[from]));
+            const std::uint32_t backwardCount{
+                backward == edges.end() ? 0u : backward->second};
+
+            if (forward > 1 || backwardCount > 1)
+            {
+                kinds_[from] = VertexKind::Locked;
+                kinds_[to] = VertexKind::Locked;
+                continue;
+            }
+            if (backwardCount && wedgeEdges.count(Detail::edgeKey(to, from)))
+            {
+                continue;
+            }
+
+            // Open border edge, or seam edge whose opposite runs between
+            // the other wedges: link its ends and hold it in place.
+            std::vector<IndexType> &next{backwardCount ? seamNext_
+                                                       : borderNext_};
+            std::vector<IndexType> &previous{backwardCount ? seamPrevious_
+                                                           : borderPrevious_};
+            if (next[from] != Detail::noVertex ||
+                previous[to] != Detail::noVertex)
+            {
+                kinds_[from] = VertexKind::Locked;
+                kinds_[to] = VertexKind::Locked;
+            }
+            next[from] = to;
+            previous[to] = from;
+            holdEdge(from, to, normal);
+        }
+    }
+
+    for (std::size_t i{0}; i < view.vertexCount; ++i)
+    {
+        const bool border{borderNext_[i] != Detail::noVertex ||
+                          borderPrevious_[i] != Detail::noVertex};
+        const bool openBorder{borderNext_[i] == Detail::noVertex ||
+                              borderPrevious_[i] == Detail::noVertex};
+        const bool seam{seamNext_[i] != Detail::noVertex ||
+                        seamPrevious_[i] != Detail::noVertex};
+        const bool openSeam{seamNext_[i] == Detail::noVertex ||
+                            seamPrevious_[i] == Detail::noVertex};
+        if (wedges_[i] != i || kinds_[i] == VertexKind::Locked)
+        {
+            continue;
+        }
+        // A seam ends at a position with a single wedge, which stays.
+        if (otherWedges_[i] == i)
+        {
+            kinds_[i] = seam || (border && openBorder) ? VertexKind::Locked
+                        : border                       ? VertexKind::Border
+                                                       : VertexKind::Manifold;
+        }
+        else
+        {
+            kinds_[i] = otherWedges_[i] == Detail::noVertex || border ||
+                                openSeam
+                            ? VertexKind::Locked
+                            : VertexKind::Seam;
+        }
+    }
+    // Both wedges of a seam move together, or neither does.
+    for (std::size_t i{0}; i < view.vertexCount; ++i)
+    {
+        if (wedges_[i] == i && kinds_[i] == VertexKind::Seam &&
+            kinds_[otherWedges_[i]] != VertexKind::Seam)
+        {
+            kinds_[i] = VertexKind::Locked;
+        }
+    }
+}
+
+float MeshSimplifier::simplify(std::vector<IndexType> &indices,
+                               std::vector<SubMesh> &subMeshes,
+                               std::size_t targetIndexCount, float maxError)
+{
+    const std::size_t vertexCount{positions_.size()};
+    const float maxCost{(maxError / scale_) * (maxError / scale_)};
+
+    std::vector<std::uint32_t> triangleSubMesh(indices.size() / 3, 0);
+    for (std::size_t subMesh{0}; subMesh < subMeshes.size(); ++subMesh)
+    {
+        std::fill_n(triangleSubMesh.begin() +
+                        subMeshes[subMesh].indexOffset / 3,
+                    subMeshes[subMesh].indexCount / 3,
+                    static_cast<std::uint32_t>(subMesh));
+    }
+
+    std::vector<std::uint32_t> offsets(vertexCount + 1);
+    std::vector<std::uint32_t> triangles;
+    std::vector<Collapse> candidates;
+    std::vector<bool> locked(vertexCount);
+    std::vector<IndexType> remap(vertexCount);
+
+    while (indices.size() > targetIndexCount)
+    {
+        const std::size_t triangleCount{indices.size() / 3};
+
+        // Triangles around every wedge.
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (const IndexType index : indices)
+        {
+            ++offsets[wedges_[index] + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        triangles.resize(indices.size());
+        {
+            std::vector<std::uint32_t> next(offsets.begin(),
+                                            offsets.end() - 1);
+            for (std::size_t i{0}; i < indices.size(); ++i)
+            {
+                triangles[next[wedges_[indices[i]]]++] =
+                    static_cast<std::uint32_t>(i / 3);
+            }
+        }
+
+        // The cheaper direction of every collapsible edge.
+        candidates.clear();
+        for (std::size_t i{0}; i < indices.size(); i += 3)
+        {
+            for (std::size_t c{0}; c < 3; ++c)
+            {
+                const IndexType a{wedges_[indices[i + c]]};
+                const IndexType b{wedges_[indices[i + (c + 1) % 3]]};
+                const bool forward{canCollapse(a, b)};
+                const bool backward{canCollapse(b, a)};
+                if (!forward && !backward)
+                {
+                    continue;
+                }
+                const float forwardCost{
+                    forward ? collapseCost(a, b)
+                            : std::numeric_limits<float>::max()};
+                const float backwardCost{
+                    backward ? collapseCost(b, a)
+                             : std::numeric_limits<float>::max()};
+                candidates.push_back(forwardCost <= backwardCost
+                                         ? Collapse{a, b, forwardCost}
+                                         : Collapse{b, a, backwardCost});
+            }
+        }
+        if (candidates.empty())
+        {
+            break;
+        }
+        // Only the cheapest part is ordered.
+        const auto cheaper = [](const Collapse &lhs, const Collapse &rhs) {
+            return lhs.cost < rhs.cost;
+        };
+        const std::size_t passCandidates{std::max<std::size_t>(
+            candidates.size() / Detail::passCandidateFraction, 1)};
+        std::nth_element(candidates.begin(),
+                         candidates.begin() + (passCandidates - 1),
+                         candidates.end(), cheaper);
+        std::sort(candidates.begin(), candidates.begin() + passCandidates,
+                  cheaper);
+
+        // Collapses touching the neighbourhood of an earlier one in the same
+        // pass would be checked against stale triangles, so they wait.
+        std::fill(locked.begin(), locked.end(), false);
+        std::iota(remap.begin(), remap.end(), 0);
+        const std::size_t wantedTriangles{
+            triangleCount - targetIndexCount / 3};
+        std::size_t removedTriangles{0};
+        std::size_t collapses{0};
+
+        const auto move = [&](IndexType from, IndexType to) {
+            for (std::uint32_t t{offsets[from]}; t < offsets[from + 1]; ++t)
+            {
+                for (std::size_t c{0}; c < 3; ++c)
+                {
+                    locked[wedges_[indices[3 * triangles[t] + c]]] = true;
+                }
+            }
+            locked[to] = true;
+            remap[from] = to;
+            quadrics_[to] = add(quadrics_[to], quadrics_[from]);
+
+            // A border or seam vertex leaves its chain between its
+            // neighbours.
+            if (kinds_[from] == VertexKind::Border ||
+                kinds_[from] == VertexKind::Seam)
+            {
+                const bool border{kinds_[from] == VertexKind::Border};
+                std::vector<IndexType> &next{border ? borderNext_
+                                                    : seamNext_};
+                std::vector<IndexType> &previous{border ? borderPrevious_
+                                                        : seamPrevious_};
+                previous[next[from]] = previous[from];
+                next[previous[from]] = next[from];
+            }
+            kinds_[from] = VertexKind::Locked;
+        };
+        for (std::size_t i{0};
+             i < passCandidates && removedTriangles < wantedTriangles; ++i)
+        {
+            const Collapse &collapse{candidates[i]};
+            if (collapse.cost > maxCost)
+            {
+                break;
+            }
+            // The other wedge of a seam vertex moves along with it.
+            const bool seam{kinds_[collapse.from] == VertexKind::Seam};
+            const IndexType wedge{seam ? otherWedges_[collapse.from]
+                                       : collapse.from};
+            const IndexType wedgeTarget{
+                seam ? seamTarget(collapse.from, collapse.to) : collapse.to};
+            if (locked[collapse.from] || locked[collapse.to] ||
+                locked[wedge] || locked[wedgeTarget] ||
+                flips(collapse.from, collapse.to, indices, offsets,
+                      triangles) ||
+                (seam && flips(wedge, wedgeTarget, indices, offsets,
+                               triangles)))
+            {
+                continue;
+            }
+
+            // A border vertex takes one triangle with it, every other
+            // vertex two: a seam pair one on either side.
+            removedTriangles +=
+                kinds_[collapse.from] == VertexKind::Border ? 1 : 2;
+            move(collapse.from, collapse.to);
+            if (seam)
+            {
+                move(wedge, wedgeTarget);
+            }
+
+            error_ = std::max(error_, collapse.cost);
+            ++collapses;
+        }
+
+        if (!collapses)
+        {
+            break;
+        }
+
+        // Every vertex of a moved wedge takes the vertex of its target.
+        // Triangles that lost an edge disappear; the rest keep their order,
+        // so sub-meshes stay contiguous.
+        const auto moved = [this, &remap](IndexType vertex) {
+            const IndexType wedge{wedges_[vertex]};
+            return remap[wedge] == wedge ? vertex : remap[wedge];
+        };
+        std::size_t kept{0};
+        for (std::size_t t{0}; t < triangleCount; ++t)
+        {
+            const IndexType a{moved(indices[3 * t])};
+            const IndexType b{moved(indices[3 * t + 1])};
+            const IndexType c{moved(indices[3 * t + 2])};
+            if (representatives_[a] == representatives_[b] ||
+                representatives_[b] == representatives_[c] ||
+                representatives_[c] == representatives_[a])
+            {
+                continue;
+            }
+            indices[3 * kept] = a;
+            indices[3 * kept + 1] = b;
+            indices[3 * kept + 2] = c;
+            triangleSubMesh[kept] = triangleSubMesh[t];
+            ++kept;
+        }
+        indices.resize(3 * kept);
+        triangleSubMesh.resize(kept);
+    }
+
+    std::uint32_t offset{0};
+    for (std::size_t subMesh{0}; subMesh < subMeshes.size(); ++subMesh)
+    {
+        const std::uint32_t first{offset};
+        while (offset < triangleSubMesh.size() &&
+               triangleSubMesh[offset] == subMesh)
+        {
+            ++offset;
+        }
+        subMeshes[subMesh].indexOffset = 3 * first;
+        subMeshes[subMesh].indexCount = 3 * (offset - first);
+    }
+
+    return std::sqrt(error_) * scale_;
+}
+
+LevelOfDetailChain MeshSimplifier::buildChain(const MeshView &view,
+                                              std::size_t levelCount,
+                                              float reduction, float maxError)
+{
+    LevelOfDetailChain chain;
+    if (!view.indexCount)
+    {
+        return chain;
+    }
+
+    MeshSimplifier simplifier{view};
+
+    std::vector<IndexType> indices{view.indices,
+                                   view.indices + view.indexCount};
+    std::vector<SubMesh> subMeshes{view.subMeshes,
+                                   view.subMeshes + view.subMeshCount};
+    if (subMeshes.empty())
+    {
+        subMeshes.push_back(
+            SubMesh{0, static_cast<std::uint32_t>(view.indexCount), -1});
+    }
+
+    const float absoluteError{maxError * simplifier.scale_};
+    for (std::size_t level{0}; level < levelCount; ++level)
+    {
+        const std::size_t previousCount{indices.size()};
+        const std::size_t target{
+            3 * static_cast<std::size_t>(static_cast<float>(previousCount / 3) *
+                                         reduction)};
+        const float error{
+            simplifier.simplify(indices, subMeshes, target, absoluteError)};
+        if (static_cast<float>(indices.size()) >
+            Detail::minimumLevelReduction * static_cast<float>(previousCount))
+        {
+            break;
+        }
+
+        LevelOfDetail lod{subMeshes, indices.size(), error};
+        for (SubMesh &subMesh : lod.subMeshes)
+        {
+            subMesh.indexOffset += static_cast<std::uint32_t>(
+                chain.indices.size());
+        }
+        chain.indices.insert(chain.indices.end(), indices.begin(),
+                             indices.end());
+        chain.levels.push_back(std::move(lod));
+    }
+
+    return chain;
+}
+
+void MeshSimplifier::addPlane(Quadric &quadric, const glm::vec3 &normal,
+                              float distance, float weight) noexcept
+{
+    quadric.a00 += weight * normal.x * normal.x;
+    quadric.a01 += weight * normal.x * normal.y;
+    quadric.a02 += weight * normal.x * normal.z;
+    quadric.a03 += weight * normal.x * distance;
+    quadric.a11 += weight * normal.y * normal.y;
+    quadric.a12 += weight * normal.y * normal.z;
+    quadric.a13 += weight * normal.y * distance;
+    quadric.a22 += weight * normal.z * normal.z;
+    quadric.a23 += weight * normal.z * distance;
+    quadric.a33 += weight * distance * distance;
+    quadric.weight += weight;
+}
+
+MeshSimplifier::Quadric MeshSimplifier::add(const Quadric &a,
+                                            const Quadric &b) noexcept
+{
+    return Quadric{a.a00 + b.a00, a.a01 + b.a01, a.a02 + b.a02,
+                   a.a03 + b.a03, a.a11 + b.a11, a.a12 + b.a12,
+                   a.a13 + b.a13, a.a22 + b.a22, a.a23 + b.a23,
+                   a.a33 + b.a33, a.weight + b.weight};
+}
+
+// Weighted mean of the squared distances from position to the planes.
+float MeshSimplifier::evaluate(const Quadric &quadric,
+                               const glm::vec3 &position) noexcept
+{
+    const float x{position.x};
+    const float y{position.y};
+    const float z{position.z};
+    const float error{quadric.a00 * x * x + 2.0f * quadric.a01 * x * y +
+                      2.0f * quadric.a02 * x * z + 2.0f * quadric.a03 * x +
+                      quadric.a11 * y * y + 2.0f * quadric.a12 * y * z +
+                      2.0f * quadric.a13 * y + quadric.a22 * z * z +
+                      2.0f * quadric.a23 * z + quadric.a33};
+    return quadric.weight > 0.0f ? std::max(error, 0.0f) / quadric.weight
+                                 : 0.0f;
+}
+
+// Only the moving wedge is constrained: the triangles around a manifold or
+// border wedge meet every neighbouring position in one wedge, so any
+// neighbour fits them.
+bool MeshSimplifier::canCollapse(IndexType from, IndexType to) const noexcept
+{
+    switch (kinds_[from])
+    {
+    case VertexKind::Manifold:
+        return true;
+    case VertexKind::Border:
+        return to == borderNext_[from] || to == borderPrevious_[from];
+    case VertexKind::Seam:
+        return seamTarget(from, to) != Detail::noVertex;
+    case VertexKind::Locked:
+        return false;
+    }
+    return false;
+}
+
+// Both wedges of a seam pair move, and each only carries the planes of its
+// own side.
+float MeshSimplifier::collapseCost(IndexType from, IndexType to) const noexcept
+{
+    Quadric quadric{add(quadrics_[from], quadrics_[to])};
+    if (kinds_[from] == VertexKind::Seam)
+    {
+        const IndexType target{seamTarget(from, to)};
+        quadric = add(quadric, quadrics_[otherWedges_[from]]);
+        if (target != to)
+        {
+            quadric = add(quadric, quadrics_[target]);
+        }
+    }
+    return evaluate(quadric, positions_[to]);
+}
+
+// Whether moving wedge from onto to turns any remaining triangle around from
+// over.
+bool MeshSimplifier::flips(IndexType from, IndexType to,
+                           const std::vector<IndexType> &indices,
+                           const std::vector<std::uint32_t> &offsets,
+                           const std::vector<std::uint32_t> &triangles) const
+    noexcept
+{
+    for (std::uint32_t t{offsets[from]}; t < offsets[from + 1]; ++t)
+    {
+        const IndexType *vertices{indices.data() + 3 * triangles[t]};
+        const IndexType triangle[3]{wedges_[vertices[0]], wedges_[vertices[1]],
+                                    wedges_[vertices[2]]};
+        if (representatives_[triangle[0]] == representatives_[to] ||
+            representatives_[triangle[1]] == representatives_[to] ||
+            representatives_[triangle[2]] == representatives_[to])
+        {
+            continue;
+        }
+
+        // Corners in winding order starting at from.
+        std::size_t corner{0};
+        while (triangle[corner] != from)
+        {
+            ++corner;
+        }
+        const glm::vec3 &b{positions_[triangle[(corner + 1) % 3]]};
+        const glm::vec3 &c{positions_[triangle[(corner + 2) % 3]]};
+
+        const glm::vec3 before{
+            glm::cross(b - positions_[from], c - positions_[from])};
+        const glm::vec3 after{glm::cross(b - positions_[to], c - positions_[to])};
+        // Turning by more than about 75 degrees counts as a flip too, which
+        // keeps collapses from leaving slivers standing on edge. Small turns
+        // can add up over many collapses, so the result must also face the
+        // way the source surface did around its corners.
+        const glm::vec3 source{normals_[to] +
+                               normals_[triangle[(corner + 1) % 3]] +
+                               normals_[triangle[(corner + 2) % 3]]};
+        if (!(glm::dot(before, after) >
+              Detail::minimumNormalTurnDot * glm::length(before) *
+                  glm::length(after)) ||
+            !(glm::dot(after, source) > 0.0f))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Where the other wedge of seam vertex from goes when from moves onto to:
+// the seam edge of the other wedge runs the opposite way, so it leads to the
+// wedge at the position of to on its own side. noVertex if to is not along
+// the seam.
+MeshSimplifier::IndexType
+MeshSimplifier::seamTarget(IndexType from, IndexType to) const noexcept
+{
+    const IndexType wedge{otherWedges_[from]};
+    IndexType target{Detail::noVertex};
+    if (to == seamNext_[from])
+    {
+        target = seamPrevious_[wedge];
+    }
+    else if (to == seamPrevious_[from])
+    {
+        target = seamNext_[wedge];
+    }
+    return target != Detail::noVertex &&
+                   representatives_[target] == representatives_[to]
+               ? target
+               : Detail::noVertex;
+}
+
+} // namespace Model
@@ -0,0 +1,134 @@
+#ifndef HOMEWORK01_MODEL_MESHSIMPLIFIER_HPP_
+#define HOMEWORK01_MODEL_MESHSIMPLIFIER_HPP_
+
+#include "MeshData.hpp"
+
+#include "glm/vec3.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Model
+{
+
+// One simplified copy of the index buffer. Sub-mesh ranges index the buffer
+// of the chain it belongs to, and error is the largest geometric error the
+// level introduces, in model units.
+struct LevelOfDetail
+{
+    std::vector<SubMesh> subMeshes;
+    std::size_t indexCount;
+    float error;
+};
+
+// Coarser levels of one mesh, finest first, all over the vertices of the
+// source view. The full resolution mesh is not part of the chain.
+struct LevelOfDetailChain
+{
+    std::vector<MeshView::IndexType> indices;
+    std::vector<LevelOfDetail> levels;
+};
+
+// Quadric error edge-collapse simplification (Garland and Heckbert) that
+// only rewires indices: every collapse moves a vertex onto one of its
+// neighbours, so all levels share the vertex buffer of the source.
+//
+// Vertices at one position whose attributes match, up to a small normal
+// angle as faceted exports have, form one wedge and move together. A UV or
+// normal seam splits a position into two wedges; such a pair only
+// collapses along the seam, both wedges together onto the matching wedges
+// of the next position, so the attributes on either side stay intact.
+// Positions with more than two wedges, wedges on a material boundary and
+// vertices on a non-manifold edge never move; open border vertices only
+// collapse along the border. Border and seam edges add a plane to their
+// quadrics that keeps the outline in place.
+class MeshSimplifier
+{
+public:
+    using IndexType = MeshView::IndexType;
+
+    explicit MeshSimplifier(const MeshView &view);
+
+    // Collapses edges of indices, a triangle list over the vertices of the
+    // view grouped into subMeshes, until at most targetIndexCount indices
+    // remain or the next collapse would exceed maxError model units.
+    // subMeshes are updated to the new ranges. Quadrics accumulate across
+    // calls, so successive calls build successive levels. Returns the error
+    // introduced so far.
+    float simplify(std::vector<IndexType> &indices,
+                   std::vector<SubMesh> &subMeshes,
+                   std::size_t targetIndexCount, float maxError);
+
+    // Up to levelCount levels, each with about reduction times the triangles
+    // of the one before, and an error of at most maxError times the size of
+    // the bounds. Stops early once a level barely shrinks.
+    static LevelOfDetailChain buildChain(const MeshView &view,
+                                         std::size_t levelCount = 4,
+                                         float reduction = 0.5f,
+                                         float maxError = 0.05f);
+
+private:
+    enum class VertexKind : std::uint8_t
+    {
+        Manifold,
+        Border,
+        Seam,
+        Locked
+    };
+
+    // Symmetric 4x4 error matrix of a sum of planes, upper triangle only,
+    // and the total weight of the planes.
+    struct Quadric
+    {
+        float a00, a01, a02, a03, a11, a12, a13, a22, a23, a33;
+        float weight;
+    };
+
+    struct Collapse
+    {
+        IndexType from;
+        IndexType to;
+        float cost;
+    };
+
+    static void addPlane(Quadric &quadric, const glm::vec3 &normal,
+                         float distance, float weight) noexcept;
+    static Quadric add(const Quadric &a, const Quadric &b) noexcept;
+    static float evaluate(const Quadric &quadric,
+                          const glm::vec3 &position) noexcept;
+
+    bool canCollapse(IndexType from, IndexType to) const noexcept;
+    IndexType seamTarget(IndexType from, IndexType to) const noexcept;
+    float collapseCost(IndexType from, IndexType to) const noexcept;
+    bool flips(IndexType from, IndexType to,
+               const std::vector<IndexType> &indices,
+               const std::vector<std::uint32_t> &offsets,
+               const std::vector<std::uint32_t> &triangles) const noexcept;
+
+    // Positions mapped into the unit cube, so costs do not depend on scale.
+    std::vector<glm::vec3> positions_;
+    float scale_;
+    // Vertices at one position with matching attributes form a wedge, and
+    // one of them stands for it; the arrays below are indexed by that
+    // vertex. representatives_ stands for every position in the same way,
+    // and otherWedges_ holds the other wedge of a seam.
+    std::vector<IndexType> wedges_;
+    std::vector<IndexType> representatives_;
+    std::vector<IndexType> otherWedges_;
+    std::vector<VertexKind> kinds_;
+    // Neighbours along the open border, for border wedges, and along the
+    // seam, for seam wedges.
+    std::vector<IndexType> borderNext_;
+    std::vector<IndexType> borderPrevious_;
+    std::vector<IndexType> seamNext_;
+    std::vector<IndexType> seamPrevious_;
+    std::vector<Quadric> quadrics_;
+    // Area weighted normals of the source triangles around every vertex.
+    std::vector<glm::vec3> normals_;
+    float error_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_MESHSIMPLIFIER_HPP_
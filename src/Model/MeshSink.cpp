@@ -0,0 +1,75 @@
+#include "MeshSink.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Model
+{
+
+MeshDataSink::MeshDataSink(MeshData &meshData) noexcept : meshData_(meshData)
+{
+}
+
+void MeshDataSink::beginMesh(const VertexStreams &streams,
+                             std::size_t vertexCount,
+                             std::size_t indexCapacity)
+{
+    meshData_.clear();
+    meshData_.positions.resize(3 * vertexCount);
+    meshData_.normals.resize(streams.normals ? 3 * vertexCount : 0);
+    meshData_.textureCoordinates.resize(
+        streams.textureCoordinates ? 2 * vertexCount : 0);
+    meshData_.colors.resize(streams.colors ? 4 * vertexCount : 0);
+    meshData_.tangents.resize(streams.tangents ? 4 * vertexCount : 0);
+    meshData_.indices.reserve(indexCapacity);
+}
+
+void MeshDataSink::writeVertices(std::size_t firstVertex,
+                                 const MeshView &chunk)
+{
+    const std::size_t count{chunk.vertexCount};
+
+    std::copy(chunk.positions, chunk.positions + 3 * count,
+              meshData_.positions.begin() + 3 * firstVertex);
+    if (!meshData_.normals.empty())
+    {
+        std::copy(chunk.normals, chunk.normals + 3 * count,
+                  meshData_.normals.begin() + 3 * firstVertex);
+    }
+    if (!meshData_.textureCoordinates.empty())
+    {
+        std::copy(chunk.textureCoordinates,
+                  chunk.textureCoordinates + 2 * count,
+                  meshData_.textureCoordinates.begin() + 2 * firstVertex);
+    }
+    if (!meshData_.colors.empty())
+    {
+        std::copy(chunk.colors, chunk.colors + 4 * count,
+                  meshData_.colors.begin() + 4 * firstVertex);
+    }
+    if (!meshData_.tangents.empty())
+    {
+        std::copy(chunk.tangents, chunk.tangents + 4 * count,
+                  meshData_.tangents.begin() + 4 * firstVertex);
+    }
+}
+
+void MeshDataSink::writeIndices(std::size_t firstIndex,
+                                const IndexType *indices, std::size_t count)
+{
+    if (meshData_.indices.size() < firstIndex + count)
+    {
+        meshData_.indices.resize(firstIndex + count);
+    }
+    std::copy(indices, indices + count, meshData_.indices.begin() + firstIndex);
+}
+
+void MeshDataSink::endMesh(std::size_t indexCount, const Bounds &bounds)
+{
+    meshData_.indices.resize(indexCount);
+    meshData_.bounds = bounds;
+    meshData_.subMeshes.assign(
+        1, SubMesh{0, static_cast<std::uint32_t>(indexCount), -1});
+}
+
+} // namespace Model
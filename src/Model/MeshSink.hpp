@@ -0,0 +1,65 @@
+#ifndef HOMEWORK01_MODEL_MESHSINK_HPP_
+#define HOMEWORK01_MODEL_MESHSINK_HPP_
+
+#include "MeshData.hpp"
+
+#include <cstddef>
+
+namespace Model
+{
+
+// Optional vertex streams carried by a mesh, next to the positions.
+struct VertexStreams
+{
+    bool normals;
+    bool textureCoordinates;
+    bool colors;
+    bool tangents;
+};
+
+// Receiver of a mesh that arrives in pieces, such as a loader streaming a
+// file chunk by chunk. Chunks are placed by their first vertex or index, so
+// the sink never has to hold more than one of them.
+class MeshSink
+{
+public:
+    using IndexType = MeshView::IndexType;
+
+    virtual ~MeshSink() = default;
+
+    // Called once before any chunk. indexCapacity is a hint, more indices
+    // may follow.
+    virtual void beginMesh(const VertexStreams &streams,
+                           std::size_t vertexCount,
+                           std::size_t indexCapacity) = 0;
+
+    // chunk.vertexCount vertices starting at firstVertex. The streams named
+    // in beginMesh are set; the index fields of the view are unused.
+    virtual void writeVertices(std::size_t firstVertex,
+                               const MeshView &chunk) = 0;
+    virtual void writeIndices(std::size_t firstIndex, const IndexType *indices,
+                              std::size_t count) = 0;
+
+    virtual void endMesh(std::size_t indexCount, const Bounds &bounds) = 0;
+};
+
+// Collects a streamed mesh in a MeshData, as a single sub-mesh.
+class MeshDataSink : public MeshSink
+{
+public:
+    explicit MeshDataSink(MeshData &meshData) noexcept;
+
+    void beginMesh(const VertexStreams &streams, std::size_t vertexCount,
+                   std::size_t indexCapacity) override;
+    void writeVertices(std::size_t firstVertex, const MeshView &chunk) override;
+    void writeIndices(std::size_t firstIndex, const IndexType *indices,
+                      std::size_t count) override;
+    void endMesh(std::size_t indexCount, const Bounds &bounds) override;
+
+private:
+    MeshData &meshData_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_MESHSINK_HPP_
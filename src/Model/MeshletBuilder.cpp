@@ -0,0 +1,223 @@
+#include "MeshletBuilder.hpp"
+
+#include "Utils/Parallel/ParallelFor.hpp"
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Triangles per block clustered by one task. Meshlets never cross a block,
+// which costs at most one partial meshlet per block.
+constexpr std::size_t meshletBlockTriangles{1u << 14};
+// Clusters whose normals spread wider than this cosine from their average
+// cannot be culled by their cone.
+constexpr float meshletMinimumConeDot{0.1f};
+
+struct MeshletBlock
+{
+    std::size_t firstIndex;
+    std::size_t indexCount;
+    std::uint32_t subMesh;
+};
+
+glm::vec3 meshletPosition(const MeshView &view,
+                          MeshView::IndexType vertex) noexcept;
+void clusterBlock(const MeshView &view, const MeshletBlock &block,
+                  std::size_t maxVertices, std::size_t maxTriangles,
+                  std::vector<Meshlet> &meshlets);
+void computeMeshletBounds(const MeshView &view, Meshlet &meshlet) noexcept;
+
+inline glm::vec3 meshletPosition(const MeshView &view,
+                                 MeshView::IndexType vertex) noexcept
+{
+    return glm::vec3{view.positions[3 * vertex], view.positions[3 * vertex + 1],
+                     view.positions[3 * vertex + 2]};
+}
+
+inline void clusterBlock(const MeshView &view, const MeshletBlock &block,
+                         std::size_t maxVertices, std::size_t maxTriangles,
+                         std::vector<Meshlet> &meshlets)
+{
+    std::vector<MeshView::IndexType> vertices;
+    vertices.reserve(maxVertices);
+
+    Meshlet meshlet{};
+    meshlet.indexOffset = static_cast<std::uint32_t>(block.firstIndex);
+    meshlet.subMesh = block.subMesh;
+
+    const MeshView::IndexType *indices{view.indices};
+    const std::size_t end{block.firstIndex + block.indexCount};
+    for (std::size_t i{block.firstIndex}; i + 2 < end; i += 3)
+    {
+        // Vertices of the triangle not in the meshlet yet, counted once.
+        std::size_t added{0};
+        for (std::size_t c{0}; c < 3; ++c)
+        {
+            const MeshView::IndexType vertex{indices[i + c]};
+            const bool repeated{(c > 0 && vertex == indices[i]) ||
+                                (c > 1 && vertex == indices[i + 1])};
+            if (!repeated && std::find(vertices.begin(), vertices.end(),
+                                       vertex) == vertices.end())
+            {
+                ++added;
+            }
+        }
+
+        if (vertices.size() + added > maxVertices ||
+            meshlet.indexCount / 3 >= maxTriangles)
+        {
+            meshlet.vertexCount = static_cast<std::uint32_t>(vertices.size());
+            meshlets.push_back(meshlet);
+            meshlet.indexOffset = static_cast<std::uint32_t>(i);
+            meshlet.indexCount = 0;
+            vertices.clear();
+        }
+
+        for (std::size_t c{0}; c < 3; ++c)
+        {
+            if (std::find(vertices.begin(), vertices.end(), indices[i + c]) ==
+                vertices.end())
+            {
+                vertices.push_back(indices[i + c]);
+            }
+        }
+        meshlet.indexCount += 3;
+    }
+
+    if (meshlet.indexCount)
+    {
+        meshlet.vertexCount = static_cast<std::uint32_t>(vertices.size());
+        meshlets.push_back(meshlet);
+    }
+
+    for (Meshlet &built : meshlets)
+    {
+        computeMeshletBounds(view, built);
+    }
+}
+
+// Sphere around the box of the triangles, and the cone of their normals
+// with its apex moved to the sphere center.
+inline void computeMeshletBounds(const MeshView &view, Meshlet &meshlet) noexcept
+{
+    const MeshView::IndexType *indices{view.indices + meshlet.indexOffset};
+
+    glm::vec3 minimum{meshletPosition(view, indices[0])};
+    glm::vec3 maximum{minimum};
+    for (std::uint32_t i{1}; i < meshlet.indexCount; ++i)
+    {
+        const glm::vec3 position{meshletPosition(view, indices[i])};
+        minimum = glm::min(minimum, position);
+        maximum = glm::max(maximum, position);
+    }
+    meshlet.center = 0.5f * (minimum + maximum);
+
+    float radius{0.0f};
+    glm::vec3 axis{0.0f};
+    for (std::uint32_t i{0}; i < meshlet.indexCount; i += 3)
+    {
+        const glm::vec3 a{meshletPosition(view, indices[i])};
+        const glm::vec3 b{meshletPosition(view, indices[i + 1])};
+        const glm::vec3 c{meshletPosition(view, indices[i + 2])};
+        radius = std::max({radius, glm::length(a - meshlet.center),
+                           glm::length(b - meshlet.center),
+                           glm::length(c - meshlet.center)});
+
+        const glm::vec3 normal{glm::cross(b - a, c - a)};
+        const float length{glm::length(normal)};
+        if (length > 0.0f)
+        {
+            axis += normal / length;
+        }
+    }
+    meshlet.radius = radius;
+
+    // Without a usable axis the cone is left open.
+    meshlet.coneAxis = glm::vec3{0.0f};
+    meshlet.coneCutoff = 1.0f;
+    const float axisLength{glm::length(axis)};
+    if (!(axisLength > 0.0f))
+    {
+        return;
+    }
+    axis /= axisLength;
+
+    float minimumDot{1.0f};
+    for (std::uint32_t i{0}; i < meshlet.indexCount; i += 3)
+    {
+        const glm::vec3 a{meshletPosition(view, indices[i])};
+        const glm::vec3 normal{
+            glm::cross(meshletPosition(view, indices[i + 1]) - a,
+                       meshletPosition(view, indices[i + 2]) - a)};
+        const float length{glm::length(normal)};
+        if (length > 0.0f)
+        {
+            minimumDot = std::min(minimumDot, glm::dot(axis, normal / length));
+        }
+    }
+
+    if (minimumDot > Detail::meshletMinimumConeDot)
+    {
+        meshlet.coneAxis = axis;
+        meshlet.coneCutoff = std::sqrt(1.0f - minimumDot * minimumDot);
+    }
+}
+
+} // namespace Detail
+
+MeshletBuilder::MeshletBuilder(std::size_t maxVertices,
+                               std::size_t maxTriangles,
+                               unsigned int threadCount) noexcept
+    : maxVertices_{std::max<std::size_t>(maxVertices, 3)},
+      maxTriangles_{std::max<std::size_t>(maxTriangles, 1)},
+      threadCount_{threadCount}
+{
+}
+
+std::vector<Meshlet> MeshletBuilder::build(const MeshView &view) const
+{
+    std::vector<SubMesh> ranges{view.subMeshes,
+                                view.subMeshes + view.subMeshCount};
+    if (ranges.empty())
+    {
+        ranges.push_back(
+            SubMesh{0, static_cast<std::uint32_t>(view.indexCount), -1});
+    }
+
+    std::vector<Detail::MeshletBlock> blocks;
+    for (std::size_t subMesh{0}; subMesh < ranges.size(); ++subMesh)
+    {
+        const std::size_t blockIndices{3 * Detail::meshletBlockTriangles};
+        for (std::size_t first{0}; first < ranges[subMesh].indexCount;
+             first += blockIndices)
+        {
+            blocks.push_back(Detail::MeshletBlock{
+                ranges[subMesh].indexOffset + first,
+                std::min(blockIndices, ranges[subMesh].indexCount - first),
+                static_cast<std::uint32_t>(subMesh)});
+        }
+    }
+
+    std::vector<std::vector<Meshlet>> blockMeshlets(blocks.size());
+    Parallel::ParallelFor(blocks.size(), threadCount_, [&](std::size_t i) {
+        Detail::clusterBlock(view, blocks[i], maxVertices_, maxTriangles_,
+                             blockMeshlets[i]);
+    });
+
+    std::vector<Meshlet> meshlets;
+    for (const std::vector<Meshlet> &block : blockMeshlets)
+    {
+        meshlets.insert(meshlets.end(), block.begin(), block.end());
+    }
+    return meshlets;
+}
+
+} // namespace Model
@@ -0,0 +1,54 @@
+#ifndef HOMEWORK01_MODEL_MESHLETBUILDER_HPP_
+#define HOMEWORK01_MODEL_MESHLETBUILDER_HPP_
+
+#include "MeshData.hpp"
+
+#include "glm/vec3.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Model
+{
+
+// A small cluster of consecutive triangles of one sub-mesh, with the bounds
+// MeshletCuller tests. The triangles face away from every viewpoint p with
+// dot(center - p, coneAxis) >= coneCutoff * |center - p| + radius; a cutoff
+// of 1 or more never culls.
+struct Meshlet
+{
+    std::uint32_t indexOffset;
+    std::uint32_t indexCount;
+    std::uint32_t subMesh;
+    std::uint32_t vertexCount;
+    glm::vec3 center;
+    float radius;
+    glm::vec3 coneAxis;
+    float coneCutoff;
+};
+
+// Splits the index buffer of a view into meshlets of at most maxVertices
+// unique vertices and maxTriangles triangles, in index order. The triangles
+// are not reordered, so the meshlets are ranges of the existing index buffer
+// and are best built over an order optimized for locality (see
+// MeshOptimizer). Sub-meshes are split into blocks that are clustered on up
+// to threadCount threads (0 = every hardware thread).
+class MeshletBuilder
+{
+public:
+    explicit MeshletBuilder(std::size_t maxVertices = 64,
+                            std::size_t maxTriangles = 126,
+                            unsigned int threadCount = 0) noexcept;
+
+    std::vector<Meshlet> build(const MeshView &view) const;
+
+private:
+    std::size_t maxVertices_;
+    std::size_t maxTriangles_;
+    unsigned int threadCount_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_MESHLETBUILDER_HPP_
@@ -0,0 +1,98 @@
+#include "MeshletCuller.hpp"
+
+#include "Detail/FrustumPlanes.hpp"
+
+#include "Utils/Parallel/ParallelFor.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glm/geometric.hpp"
+#include "glm/vec4.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Meshlets per task; a list shorter than one block is culled on the calling
+// thread, so small meshes never start threads.
+constexpr std::size_t cullBlockMeshlets{1u << 13};
+
+} // namespace Detail
+
+MeshletCuller::MeshletCuller(unsigned int threadCount) noexcept
+    : threadCount_{threadCount}
+{
+}
+
+MeshletCullStatistics
+MeshletCuller::cull(const std::vector<Meshlet> &meshlets,
+                    const glm::mat4 &modelViewProjection,
+                    const glm::vec3 &cameraPosition, bool backfaceCulling,
+                    std::vector<unsigned char> &visible) const
+{
+    Performance::Stopwatch stopwatch;
+
+    glm::vec4 planes[6];
+    Detail::frustumPlanes(modelViewProjection, planes);
+
+    visible.resize(meshlets.size());
+    std::atomic<std::size_t> frustumCulled{0};
+    std::atomic<std::size_t> backfaceCulled{0};
+
+    const std::size_t blockCount{
+        (meshlets.size() + Detail::cullBlockMeshlets - 1) /
+        Detail::cullBlockMeshlets};
+    const unsigned int threadCount{
+        blockCount > 1 ? threadCount_ : 1u};
+    Parallel::ParallelFor(blockCount, threadCount, [&](std::size_t block) {
+        const std::size_t first{block * Detail::cullBlockMeshlets};
+        const std::size_t last{
+            std::min(first + Detail::cullBlockMeshlets, meshlets.size())};
+
+        std::size_t outside{0};
+        std::size_t backfacing{0};
+        for (std::size_t i{first}; i < last; ++i)
+        {
+            const Meshlet &meshlet{meshlets[i]};
+
+            bool inside{true};
+            for (const glm::vec4 &plane : planes)
+            {
+                inside = inside && glm::dot(glm::vec3{plane}, meshlet.center) +
+                                           plane.w >=
+                                       -meshlet.radius;
+            }
+            if (!inside)
+            {
+                visible[i] = 0;
+                ++outside;
+                continue;
+            }
+
+            const glm::vec3 offset{meshlet.center - cameraPosition};
+            if (backfaceCulling &&
+                glm::dot(offset, meshlet.coneAxis) >=
+                    meshlet.coneCutoff * glm::length(offset) + meshlet.radius)
+            {
+                visible[i] = 0;
+                ++backfacing;
+                continue;
+            }
+
+            visible[i] = 1;
+        }
+
+        frustumCulled += outside;
+        backfaceCulled += backfacing;
+    });
+
+    return MeshletCullStatistics{meshlets.size(), frustumCulled.load(),
+                                 backfaceCulled.load(), 0,
+                                 stopwatch.elapsedMilliseconds()};
+}
+
+} // namespace Model
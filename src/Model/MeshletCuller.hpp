@@ -0,0 +1,49 @@
+#ifndef HOMEWORK01_MODEL_MESHLETCULLER_HPP_
+#define HOMEWORK01_MODEL_MESHLETCULLER_HPP_
+
+#include "MeshletBuilder.hpp"
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec3.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace Model
+{
+
+// What the last cull of a mesh rejected. drawCount is the number of index
+// ranges left after merging adjacent visible meshlets.
+struct MeshletCullStatistics
+{
+    std::size_t meshletCount;
+    std::size_t frustumCulled;
+    std::size_t backfaceCulled;
+    std::size_t drawCount;
+    double cullMilliseconds;
+};
+
+// Tests meshlets against the view frustum and their normal cones on the CPU.
+// Large meshlet lists are split into blocks tested on up to threadCount
+// threads (0 = every hardware thread).
+class MeshletCuller
+{
+public:
+    explicit MeshletCuller(unsigned int threadCount = 0) noexcept;
+
+    // Sets visible[i] to whether meshlets[i] may be seen through
+    // modelViewProjection from cameraPosition, both in model space.
+    // Statistics are left for the caller to complete with drawCount.
+    MeshletCullStatistics cull(const std::vector<Meshlet> &meshlets,
+                               const glm::mat4 &modelViewProjection,
+                               const glm::vec3 &cameraPosition,
+                               bool backfaceCulling,
+                               std::vector<unsigned char> &visible) const;
+
+private:
+    unsigned int threadCount_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_MESHLETCULLER_HPP_
@@ -0,0 +1,532 @@
+#include "NormalGenerator.hpp"
+
+#include "Detail/VertexWeldTable.hpp"
+
+#include "Utils/Parallel/ParallelFor.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+#include "Utils/Simd/Float4.hpp"
+
+#include "glm/geometric.hpp"
+#include "glm/gtc/type_ptr.hpp"
+#include "glm/trigonometric.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Work items of the parallel passes; inputs of one block run on the calling
+// thread.
+constexpr std::size_t faceBlockTriangles{1u << 14};
+constexpr std::size_t groupBlockGroups{1u << 14};
+constexpr std::size_t vertexBlockVertices{1u << 16};
+// Corners of one vertex whose normals are closer than about one degree keep
+// sharing it.
+constexpr float sameNormalCosine{0.9998f};
+
+float cornerAngle(const glm::vec3 &u, const glm::vec3 &v) noexcept;
+float cornerWeight(NormalWeighting weighting, float area,
+                   float angle) noexcept;
+Simd::Float4 cornerAngle(Simd::Float4 dot, Simd::Float4 lengthSquared0,
+                         Simd::Float4 lengthSquared1) noexcept;
+Simd::Float4 cornerWeight(NormalWeighting weighting, Simd::Float4 area,
+                          Simd::Float4 angle) noexcept;
+VertexKey positionKey(const float *position) noexcept;
+
+inline float cornerAngle(const glm::vec3 &u, const glm::vec3 &v) noexcept
+{
+    const float lengths{std::sqrt(glm::dot(u, u) * glm::dot(v, v))};
+    return lengths > 0.0f
+               ? std::acos(glm::clamp(glm::dot(u, v) / lengths, -1.0f, 1.0f))
+               : 0.0f;
+}
+
+inline float cornerWeight(NormalWeighting weighting, float area,
+                          float angle) noexcept
+{
+    switch (weighting)
+    {
+    case NormalWeighting::Area:
+        return area;
+    case NormalWeighting::Angle:
+        return angle;
+    case NormalWeighting::AreaAngle:
+        return area * angle;
+    }
+    return area * angle;
+}
+
+inline Simd::Float4 cornerAngle(Simd::Float4 dot, Simd::Float4 lengthSquared0,
+                                Simd::Float4 lengthSquared1) noexcept
+{
+    const Simd::Float4 zero{Simd::broadcast(0.0f)};
+    const Simd::Float4 lengths{Simd::sqrt(lengthSquared0 * lengthSquared1)};
+    const Simd::Float4 valid{Simd::lessThan(zero, lengths)};
+    const Simd::Float4 cosine{Simd::min(
+        Simd::max(dot / Simd::select(valid, lengths, Simd::broadcast(1.0f)),
+                  Simd::broadcast(-1.0f)),
+        Simd::broadcast(1.0f))};
+    return Simd::select(valid, Simd::acos(cosine), zero);
+}
+
+inline Simd::Float4 cornerWeight(NormalWeighting weighting, Simd::Float4 area,
+                                 Simd::Float4 angle) noexcept
+{
+    switch (weighting)
+    {
+    case NormalWeighting::Area:
+        return area;
+    case NormalWeighting::Angle:
+        return angle;
+    case NormalWeighting::AreaAngle:
+        return area * angle;
+    }
+    return area * angle;
+}
+
+// Exact position bits, with -0 folded into 0.
+inline VertexKey positionKey(const float *position) noexcept
+{
+    VertexKey key;
+    const float x{position[0] + 0.0f};
+    const float y{position[1] + 0.0f};
+    const float z{position[2] + 0.0f};
+    std::memcpy(&key.position, &x, sizeof(x));
+    std::memcpy(&key.textureCoordinate, &y, sizeof(y));
+    std::memcpy(&key.normal, &z, sizeof(z));
+    return key;
+}
+
+} // namespace Detail
+
+NormalGenerator::NormalGenerator(NormalWeighting weighting, float creaseAngle,
+                                 unsigned int threadCount, bool simd) noexcept
+    : weighting_{weighting},
+      creaseCosine_{creaseAngle >= 180.0f
+                        ? -2.0f
+                        : std::cos(glm::radians(creaseAngle))},
+      threadCount_{threadCount}, simd_{simd}, statistics_{},
+      faceNormals_{}, cornerWeights_{}, vertexGroups_{}, groupOffsets_{},
+      groupCorners_{}
+{
+}
+
+void NormalGenerator::generate(MeshData &meshData, const float *faceNormals)
+{
+    Performance::Stopwatch stopwatch;
+
+    const std::size_t vertexCount{meshData.vertexCount()};
+    const std::size_t triangleCount{meshData.triangleCount()};
+    statistics_ = Statistics{triangleCount, 0, 0.0};
+
+    meshData.normals.assign(3 * vertexCount, 0.0f);
+    if (!triangleCount)
+    {
+        statistics_.generateMilliseconds = stopwatch.elapsedMilliseconds();
+        return;
+    }
+
+    faceNormals_.resize(3 * triangleCount);
+    cornerWeights_.resize(3 * triangleCount);
+    const std::size_t faceBlocks{
+        (triangleCount + Detail::faceBlockTriangles - 1) /
+        Detail::faceBlockTriangles};
+    Parallel::ParallelFor(faceBlocks, threadCount_, [&](std::size_t block) {
+        const std::size_t first{block * Detail::faceBlockTriangles};
+        const std::size_t last{std::min(
+            first + Detail::faceBlockTriangles, triangleCount)};
+        if (simd_)
+        {
+            faceTermsSimd(meshData, first, last);
+        }
+        else
+        {
+            faceTerms(meshData, first, last);
+        }
+
+        // Corner weights still come from the positions.
+        for (std::size_t t{first}; faceNormals && t < last; ++t)
+        {
+            const glm::vec3 normal{glm::make_vec3(faceNormals + 3 * t)};
+            if (glm::dot(normal, normal) > 0.0f)
+            {
+                std::copy_n(faceNormals + 3 * t, 3,
+                            faceNormals_.data() + 3 * t);
+            }
+        }
+    });
+
+    // Groups of vertices at one position, and the corners of each group.
+    vertexGroups_.resize(vertexCount);
+    {
+        Detail::VertexWeldTable table{vertexCount};
+        bool inserted;
+        for (std::size_t i{0}; i < vertexCount; ++i)
+        {
+            vertexGroups_[i] = table.insert(
+                Detail::positionKey(meshData.positions.data() + 3 * i),
+                inserted);
+        }
+        groupOffsets_.assign(table.size() + 1, 0);
+    }
+    for (const MeshData::IndexType index : meshData.indices)
+    {
+        ++groupOffsets_[vertexGroups_[index] + 1];
+    }
+    std::partial_sum(groupOffsets_.begin(), groupOffsets_.end(),
+                     groupOffsets_.begin());
+    groupCorners_.resize(meshData.indices.size());
+    {
+        std::vector<std::uint32_t> next(groupOffsets_.begin(),
+                                        groupOffsets_.end() - 1);
+        for (std::size_t i{0}; i < meshData.indices.size(); ++i)
+        {
+            groupCorners_[next[vertexGroups_[meshData.indices[i]]]++] =
+                static_cast<std::uint32_t>(i);
+        }
+    }
+
+    if (creaseCosine_ < -1.0f)
+    {
+        smooth(meshData);
+    }
+    else
+    {
+        smoothCreased(meshData);
+    }
+
+    statistics_.generateMilliseconds = stopwatch.elapsedMilliseconds();
+}
+
+const NormalGenerator::Statistics &NormalGenerator::statistics() const noexcept
+{
+    return statistics_;
+}
+
+void NormalGenerator::faceTerms(const MeshData &meshData,
+                                std::size_t firstTriangle,
+                                std::size_t lastTriangle) noexcept
+{
+    const float *positions{meshData.positions.data()};
+    for (std::size_t t{firstTriangle}; t < lastTriangle; ++t)
+    {
+        const MeshData::IndexType *triangle{meshData.indices.data() + 3 * t};
+        const glm::vec3 a{positions[3 * triangle[0]],
+                          positions[3 * triangle[0] + 1],
+                          positions[3 * triangle[0] + 2]};
+        const glm::vec3 b{positions[3 * triangle[1]],
+                          positions[3 * triangle[1] + 1],
+                          positions[3 * triangle[1] + 2]};
+        const glm::vec3 c{positions[3 * triangle[2]],
+                          positions[3 * triangle[2] + 1],
+                          positions[3 * triangle[2] + 2]};
+
+        const glm::vec3 cross{glm::cross(b - a, c - a)};
+        const float area{glm::length(cross)};
+        const glm::vec3 normal{area > 0.0f ? cross / area : glm::vec3{0.0f}};
+        faceNormals_[3 * t] = normal.x;
+        faceNormals_[3 * t + 1] = normal.y;
+        faceNormals_[3 * t + 2] = normal.z;
+
+        cornerWeights_[3 * t] = Detail::cornerWeight(
+            weighting_, area, Detail::cornerAngle(b - a, c - a));
+        cornerWeights_[3 * t + 1] = Detail::cornerWeight(
+            weighting_, area, Detail::cornerAngle(a - b, c - b));
+        cornerWeights_[3 * t + 2] = Detail::cornerWeight(
+            weighting_, area, Detail::cornerAngle(a - c, b - c));
+    }
+}
+
+// Four triangles per step, one per lane; the tail goes through faceTerms.
+void NormalGenerator::faceTermsSimd(const MeshData &meshData,
+                                    std::size_t firstTriangle,
+                                    std::size_t lastTriangle) noexcept
+{
+    using Simd::Float4;
+
+    const float *positions{meshData.positions.data()};
+    const MeshData::IndexType *indices{meshData.indices.data()};
+    const auto coordinate = [&](std::size_t t, std::size_t corner,
+                                std::size_t axis) {
+        return Simd::set(positions[3 * indices[3 * t + corner] + axis],
+                         positions[3 * indices[3 * (t + 1) + corner] + axis],
+                         positions[3 * indices[3 * (t + 2) + corner] + axis],
+                         positions[3 * indices[3 * (t + 3) + corner] + axis]);
+    };
+
+    std::size_t t{firstTriangle};
+    for (; t + 4 <= lastTriangle; t += 4)
+    {
+        const Float4 ax{coordinate(t, 0, 0)};
+        const Float4 ay{coordinate(t, 0, 1)};
+        const Float4 az{coordinate(t, 0, 2)};
+        const Float4 bx{coordinate(t, 1, 0)};
+        const Float4 by{coordinate(t, 1, 1)};
+        const Float4 bz{coordinate(t, 1, 2)};
+        const Float4 cx{coordinate(t, 2, 0)};
+        const Float4 cy{coordinate(t, 2, 1)};
+        const Float4 cz{coordinate(t, 2, 2)};
+
+        // Edges a->b, a->c and b->c.
+        const Float4 e0x{bx - ax}, e0y{by - ay}, e0z{bz - az};
+        const Float4 e1x{cx - ax}, e1y{cy - ay}, e1z{cz - az};
+        const Float4 e2x{cx - bx}, e2y{cy - by}, e2z{cz - bz};
+
+        const Float4 nx{e0y * e1z - e0z * e1y};
+        const Float4 ny{e0z * e1x - e0x * e1z};
+        const Float4 nz{e0x * e1y - e0y * e1x};
+        const Float4 area{Simd::sqrt(nx * nx + ny * ny + nz * nz)};
+        const Float4 valid{Simd::lessThan(Simd::broadcast(0.0f), area)};
+        const Float4 inverse{Simd::select(
+            valid, Simd::broadcast(1.0f) / area, Simd::broadcast(0.0f))};
+
+        const Float4 length0{e0x * e0x + e0y * e0y + e0z * e0z};
+        const Float4 length1{e1x * e1x + e1y * e1y + e1z * e1z};
+        const Float4 length2{e2x * e2x + e2y * e2y + e2z * e2z};
+        const Float4 dot01{e0x * e1x + e0y * e1y + e0z * e1z};
+        const Float4 dot02{e0x * e2x + e0y * e2y + e0z * e2z};
+        const Float4 dot12{e1x * e2x + e1y * e2y + e1z * e2z};
+        const Float4 zero{Simd::broadcast(0.0f)};
+
+        float lanes[6][4];
+        Simd::store(lanes[0], nx * inverse);
+        Simd::store(lanes[1], ny * inverse);
+        Simd::store(lanes[2], nz * inverse);
+        Simd::store(lanes[3],
+                    Detail::cornerWeight(
+                        weighting_, area,
+                        Detail::cornerAngle(dot01, length0, length1)));
+        Simd::store(lanes[4],
+                    Detail::cornerWeight(
+                        weighting_, area,
+                        Detail::cornerAngle(zero - dot02, length0, length2)));
+        Simd::store(lanes[5],
+                    Detail::cornerWeight(
+                        weighting_, area,
+                        Detail::cornerAngle(dot12, length1, length2)));
+
+        for (std::size_t lane{0}; lane < 4; ++lane)
+        {
+            for (std::size_t i{0}; i < 3; ++i)
+            {
+                faceNormals_[3 * (t + lane) + i] = lanes[i][lane];
+                cornerWeights_[3 * (t + lane) + i] = lanes[3 + i][lane];
+            }
+        }
+    }
+
+    faceTerms(meshData, t, lastTriangle);
+}
+
+// One normal per group: every vertex at a position gets the same normal.
+void NormalGenerator::smooth(MeshData &meshData)
+{
+    const std::size_t groupCount{groupOffsets_.size() - 1};
+    std::vector<float> groupNormals(3 * groupCount);
+
+    const std::size_t groupBlocks{
+        (groupCount + Detail::groupBlockGroups - 1) /
+        Detail::groupBlockGroups};
+    Parallel::ParallelFor(groupBlocks, threadCount_, [&](std::size_t block) {
+        const std::size_t first{block * Detail::groupBlockGroups};
+        const std::size_t last{
+            std::min(first + Detail::groupBlockGroups, groupCount)};
+        for (std::size_t group{first}; group < last; ++group)
+        {
+            glm::vec3 sum{0.0f};
+            for (std::uint32_t i{groupOffsets_[group]};
+                 i < groupOffsets_[group + 1]; ++i)
+            {
+                const std::uint32_t corner{groupCorners_[i]};
+                const float *normal{faceNormals_.data() +
+                                    3 * (corner / 3)};
+                sum += cornerWeights_[corner] *
+                       glm::vec3{normal[0], normal[1], normal[2]};
+            }
+            const float length{glm::length(sum)};
+            if (length > 0.0f)
+            {
+                sum /= length;
+            }
+            groupNormals[3 * group] = sum.x;
+            groupNormals[3 * group + 1] = sum.y;
+            groupNormals[3 * group + 2] = sum.z;
+        }
+    });
+
+    const std::size_t vertexCount{vertexGroups_.size()};
+    const std::size_t vertexBlocks{
+        (vertexCount + Detail::vertexBlockVertices - 1) /
+        Detail::vertexBlockVertices};
+    Parallel::ParallelFor(vertexBlocks, threadCount_, [&](std::size_t block) {
+        const std::size_t first{block * Detail::vertexBlockVertices};
+        const std::size_t last{
+            std::min(first + Detail::vertexBlockVertices, vertexCount)};
+        for (std::size_t i{first}; i < last; ++i)
+        {
+            std::copy_n(groupNormals.data() + 3 * vertexGroups_[i], 3,
+                        meshData.normals.data() + 3 * i);
+        }
+    });
+}
+
+// Every corner averages the triangles of its group within the crease angle
+// of its own. Corners of one vertex that disagree get new vertices, which
+// are numbered block by block: a first pass counts them, a second one
+// writes them.
+void NormalGenerator::smoothCreased(MeshData &meshData)
+{
+    const std::size_t vertexCount{vertexGroups_.size()};
+    const std::size_t groupCount{groupOffsets_.size() - 1};
+    const std::size_t groupBlocks{
+        (groupCount + Detail::groupBlockGroups - 1) /
+        Detail::groupBlockGroups};
+    std::vector<std::size_t> blockVertices(groupBlocks + 1, 0);
+    std::vector<MeshData::IndexType> sources;
+
+    const auto resolve = [&](std::size_t block, bool write) {
+        const std::size_t first{block * Detail::groupBlockGroups};
+        const std::size_t last{
+            std::min(first + Detail::groupBlockGroups, groupCount)};
+        std::size_t next{vertexCount + blockVertices[block]};
+        std::size_t added{0};
+
+        std::vector<glm::vec3> normals;
+        std::vector<MeshData::IndexType> vertices;
+        std::vector<MeshData::IndexType> outputs;
+        for (std::size_t group{first}; group < last; ++group)
+        {
+            const std::uint32_t *corners{groupCorners_.data() +
+                                         groupOffsets_[group]};
+            const std::size_t count{groupOffsets_[group + 1] -
+                                    groupOffsets_[group]};
+            normals.assign(count, glm::vec3{0.0f});
+            vertices.resize(count);
+            outputs.resize(count);
+
+            for (std::size_t j{0}; j < count; ++j)
+            {
+                const float *face{faceNormals_.data() + 3 * (corners[j] / 3)};
+                const glm::vec3 own{face[0], face[1], face[2]};
+                // A degenerate triangle takes the normal of the whole group.
+                const bool degenerate{!(glm::dot(own, own) > 0.0f)};
+                for (std::size_t k{0}; k < count; ++k)
+                {
+                    const float *other{faceNormals_.data() +
+                                       3 * (corners[k] / 3)};
+                    const glm::vec3 normal{other[0], other[1], other[2]};
+                    if (degenerate || glm::dot(own, normal) >= creaseCosine_)
+                    {
+                        normals[j] += cornerWeights_[corners[k]] * normal;
+                    }
+                }
+                const float length{glm::length(normals[j])};
+                if (length > 0.0f)
+                {
+                    normals[j] /= length;
+                }
+                vertices[j] = meshData.indices[corners[j]];
+            }
+
+            for (std::size_t j{0}; j < count; ++j)
+            {
+                bool claimed{false};
+                bool shared{false};
+                for (std::size_t k{0}; k < j && !shared; ++k)
+                {
+                    if (vertices[k] != vertices[j])
+                    {
+                        continue;
+                    }
+                    claimed = claimed || outputs[k] == vertices[j];
+                    if (glm::dot(normals[k], normals[j]) >=
+                        Detail::sameNormalCosine)
+                    {
+                        outputs[j] = outputs[k];
+                        shared = true;
+                    }
+                }
+                if (shared)
+                {
+                    continue;
+                }
+
+                outputs[j] = claimed ? static_cast<MeshData::IndexType>(next++)
+                                     : vertices[j];
+                added += claimed ? 1 : 0;
+                if (write)
+                {
+                    std::copy_n(glm::value_ptr(normals[j]), 3,
+                                meshData.normals.data() + 3 * outputs[j]);
+                    if (claimed)
+                    {
+                        sources[outputs[j] - vertexCount] = vertices[j];
+                    }
+                }
+            }
+
+            if (write)
+            {
+                for (std::size_t j{0}; j < count; ++j)
+                {
+                    meshData.indices[corners[j]] = outputs[j];
+                }
+            }
+        }
+
+        if (!write)
+        {
+            blockVertices[block + 1] = added;
+        }
+    };
+
+    Parallel::ParallelFor(groupBlocks, threadCount_, [&](std::size_t block) {
+        resolve(block, false);
+    });
+    std::partial_sum(blockVertices.begin(), blockVertices.end(),
+                     blockVertices.begin());
+
+    const std::size_t addedCount{blockVertices.back()};
+    sources.resize(addedCount);
+    meshData.normals.resize(3 * (vertexCount + addedCount));
+    Parallel::ParallelFor(groupBlocks, threadCount_, [&](std::size_t block) {
+        resolve(block, true);
+    });
+
+    // Split vertices copy every other stream of their source.
+    meshData.positions.resize(3 * (vertexCount + addedCount));
+    if (!meshData.textureCoordinates.empty())
+    {
+        meshData.textureCoordinates.resize(2 * (vertexCount + addedCount));
+    }
+    if (!meshData.colors.empty())
+    {
+        meshData.colors.resize(4 * (vertexCount + addedCount));
+    }
+    for (std::size_t i{0}; i < addedCount; ++i)
+    {
+        const std::size_t vertex{vertexCount + i};
+        std::copy_n(meshData.positions.begin() + 3 * sources[i], 3,
+                    meshData.positions.begin() + 3 * vertex);
+        if (!meshData.textureCoordinates.empty())
+        {
+            std::copy_n(meshData.textureCoordinates.begin() + 2 * sources[i],
+                        2, meshData.textureCoordinates.begin() + 2 * vertex);
+        }
+        if (!meshData.colors.empty())
+        {
+            std::copy_n(meshData.colors.begin() + 4 * sources[i], 4,
+                        meshData.colors.begin() + 4 * vertex);
+        }
+    }
+
+    statistics_.splitVertexCount = addedCount;
+}
+
+} // namespace Model
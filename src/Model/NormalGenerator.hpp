@@ -0,0 +1,86 @@
+#ifndef HOMEWORK01_MODEL_NORMALGENERATOR_HPP_
+#define HOMEWORK01_MODEL_NORMALGENERATOR_HPP_
+
+#include "MeshData.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Model
+{
+
+// How much each triangle around a vertex contributes to its normal: by its
+// area, by the angle of its corner at the vertex, or by both.
+enum class NormalWeighting
+{
+    Area,
+    Angle,
+    AreaAngle
+};
+
+struct NormalGeneratorStatistics
+{
+    std::size_t triangleCount;
+    // Vertices added where a crease separates the triangles of one vertex.
+    std::size_t splitVertexCount;
+    double generateMilliseconds;
+};
+
+// Computes vertex normals for a mesh loaded without any. Triangles around
+// one position are averaged even across UV seams. With a crease angle below
+// 180 degrees, a corner only averages the triangles whose face normals are
+// within the crease angle of its own, and vertices whose corners end up
+// with different normals are split.
+//
+// Face normals and corner weights are computed four triangles at a time
+// with SIMD, and both passes run in blocks on up to threadCount threads
+// (0 = every hardware thread). With simd false and one thread it is the
+// plain serial version, which NormalGenerationBenchmark compares against.
+class NormalGenerator
+{
+public:
+    using Statistics = NormalGeneratorStatistics;
+
+    explicit NormalGenerator(
+        NormalWeighting weighting = NormalWeighting::AreaAngle,
+        float creaseAngle = 180.0f, unsigned int threadCount = 0,
+        bool simd = true) noexcept;
+
+    // Replaces meshData.normals; split vertices are appended to every
+    // stream and the indices of their corners rewritten. faceNormals, if
+    // given, holds a unit normal per triangle, such as the facet normals of
+    // an STL file, used instead of the winding; zero entries fall back to
+    // the winding.
+    void generate(MeshData &meshData, const float *faceNormals = nullptr);
+
+    const Statistics &statistics() const noexcept;
+
+private:
+    void faceTerms(const MeshData &meshData, std::size_t firstTriangle,
+                   std::size_t lastTriangle) noexcept;
+    void faceTermsSimd(const MeshData &meshData, std::size_t firstTriangle,
+                       std::size_t lastTriangle) noexcept;
+    void smooth(MeshData &meshData);
+    void smoothCreased(MeshData &meshData);
+
+    NormalWeighting weighting_;
+    // Cosine of the crease angle; -1 or less never splits.
+    float creaseCosine_;
+    unsigned int threadCount_;
+    bool simd_;
+
+    Statistics statistics_;
+
+    // Unit normal of every triangle and the weight of each of its corners.
+    std::vector<float> faceNormals_;
+    std::vector<float> cornerWeights_;
+    // Vertices at one position share a group; corners are listed per group.
+    std::vector<std::uint32_t> vertexGroups_;
+    std::vector<std::uint32_t> groupOffsets_;
+    std::vector<std::uint32_t> groupCorners_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_NORMALGENERATOR_HPP_
@@ -0,0 +1,766 @@
+#include "ObjLoader.hpp"
+
+#include "Detail/TextScan.hpp"
+#include "Detail/VertexWeldTable.hpp"
+
+#include "Utils/FileIO/FilePath.hpp"
+#include "Utils/FileIO/MappedFile.hpp"
+#include "Utils/Parallel/ParallelFor.hpp"
+#include "Utils/Performance/MemoryUsage.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+struct ObjCounts
+{
+    std::size_t lines;
+    std::size_t positions;
+    std::size_t textureCoordinates;
+    std::size_t normals;
+    std::size_t triangles;
+};
+
+// A run of whole lines, with the record counts it holds and the counts of
+// every chunk before it.
+struct ObjChunk
+{
+    const char *begin;
+    const char *end;
+    ObjCounts counts;
+    ObjCounts base;
+
+    // Every usemtl and mtllib name met in the chunk, in file order. Triangles
+    // refer to materialNames by position until they are renumbered.
+    std::vector<std::string> materialNames;
+    std::vector<std::string> libraries;
+};
+
+bool parseIndex(const char *&p, const char *end, long &value) noexcept;
+bool parseCorner(const char *&p, const char *end, long (&corner)[3]) noexcept;
+bool resolveIndex(long index, std::size_t count, std::int32_t &resolved) noexcept;
+bool isKeyword(const char *p, const char *end, const char *keyword) noexcept;
+std::string parseName(const char *p, const char *end);
+std::vector<std::string> parseNames(const char *p, const char *end);
+ObjCounts countRecords(const char *begin, const char *end) noexcept;
+std::vector<ObjChunk> splitChunks(const char *begin, const char *end,
+                                  std::size_t count);
+std::size_t parseChunk(ObjChunk &chunk, float *positions,
+                       float *textureCoordinates, float *normals,
+                       VertexKey *triangles, std::int32_t *triangleMaterials);
+void parseMaterialLibrary(
+    const char *begin, const char *end, const std::string &directory,
+    const std::unordered_map<std::string, std::int32_t> &materialIds,
+    std::vector<Material> &materials);
+std::vector<SubMesh> groupByMaterial(const std::vector<std::int32_t> &materials,
+                                     std::size_t materialCount,
+                                     std::vector<MeshData::IndexType> &indices);
+
+inline bool parseIndex(const char *&p, const char *end, long &value) noexcept
+{
+    bool negative{false};
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        ++p;
+    }
+
+    if (!(p < end && isDigit(*p)))
+    {
+        return false;
+    }
+
+    long result{0};
+    for (; p < end && isDigit(*p); ++p)
+    {
+        result = result * 10 + (*p - '0');
+    }
+    value = negative ? -result : result;
+
+    return true;
+}
+
+// Parses "v", "v/vt", "v//vn" or "v/vt/vn". Absent indices are left as 0,
+// which is never a valid OBJ index.
+inline bool parseCorner(const char *&p, const char *end,
+                        long (&corner)[3]) noexcept
+{
+    corner[0] = corner[1] = corner[2] = 0;
+
+    if (!parseIndex(p, end, corner[0]))
+    {
+        return false;
+    }
+
+    if (p < end && *p == '/')
+    {
+        ++p;
+        if (p < end && *p != '/' && !parseIndex(p, end, corner[1]))
+        {
+            return false;
+        }
+
+        if (p < end && *p == '/')
+        {
+            ++p;
+            if (!parseIndex(p, end, corner[2]))
+            {
+                return false;
+            }
+        }
+    }
+
+    return p == end || isSpace(*p) || isLineEnd(*p);
+}
+
+inline bool resolveIndex(long index, std::size_t count,
+                         std::int32_t &resolved) noexcept
+{
+    const long signedCount{static_cast<long>(count)};
+    const long value{index > 0 ? index - 1 : signedCount + index};
+
+    if (index == 0 || value < 0 || value >= signedCount)
+    {
+        return false;
+    }
+
+    resolved = static_cast<std::int32_t>(value);
+    return true;
+}
+
+// True when the record at p starts with keyword followed by a space.
+inline bool isKeyword(const char *p, const char *end,
+                      const char *keyword) noexcept
+{
+    const std::size_t length{std::strlen(keyword)};
+    return static_cast<std::size_t>(end - p) > length &&
+           std::memcmp(p, keyword, length) == 0 && isSpace(p[length]);
+}
+
+// The rest of the line without surrounding spaces. Names may hold spaces.
+inline std::string parseName(const char *p, const char *end)
+{
+    p = skipSpaces(p, end);
+    const char *last{p};
+    while (last < end && !isLineEnd(*last))
+    {
+        ++last;
+    }
+    while (last > p && isSpace(last[-1]))
+    {
+        --last;
+    }
+    return std::string(p, last);
+}
+
+// The space separated words of the rest of the line.
+inline std::vector<std::string> parseNames(const char *p, const char *end)
+{
+    std::vector<std::string> names;
+    for (p = skipSpaces(p, end); p < end && !isLineEnd(*p);
+         p = skipSpaces(p, end))
+    {
+        const char *first{p};
+        while (p < end && !isSpace(*p) && !isLineEnd(*p))
+        {
+            ++p;
+        }
+        names.emplace_back(first, p);
+    }
+    return names;
+}
+
+ObjCounts countRecords(const char *begin, const char *end) noexcept
+{
+    ObjCounts counts{0, 0, 0, 0, 0};
+
+    for (const char *p{begin}; p < end; p = skipLine(p, end))
+    {
+        ++counts.lines;
+
+        p = skipSpaces(p, end);
+        if (end - p < 2)
+        {
+            continue;
+        }
+
+        if (p[0] == 'v')
+        {
+            if (isSpace(p[1]))
+            {
+                ++counts.positions;
+            }
+            else if (p[1] == 't' && end - p > 2 && isSpace(p[2]))
+            {
+                ++counts.textureCoordinates;
+            }
+            else if (p[1] == 'n' && end - p > 2 && isSpace(p[2]))
+            {
+                ++counts.normals;
+            }
+        }
+        else if (p[0] == 'f' && isSpace(p[1]))
+        {
+            std::size_t corners{0};
+            for (p += 2; p < end && !isLineEnd(*p) && *p != '#';)
+            {
+                p = skipSpaces(p, end);
+                if (p == end || isLineEnd(*p) || *p == '#')
+                {
+                    break;
+                }
+                ++corners;
+                while (p < end && !isSpace(*p) && !isLineEnd(*p))
+                {
+                    ++p;
+                }
+            }
+            counts.triangles += corners > 2 ? corners - 2 : 0;
+        }
+    }
+
+    return counts;
+}
+
+std::vector<ObjChunk> splitChunks(const char *begin, const char *end,
+                                  std::size_t count)
+{
+    std::vector<ObjChunk> chunks;
+    chunks.reserve(count);
+
+    const std::size_t size{static_cast<std::size_t>(end - begin)};
+    const char *chunkBegin{begin};
+
+    for (std::size_t i{1}; i <= count && chunkBegin < end; ++i)
+    {
+        const char *chunkEnd{i == count ? end : begin + size / count * i};
+        if (chunkEnd < chunkBegin)
+        {
+            chunkEnd = chunkBegin;
+        }
+        // Cut after the next line break so that no record is split.
+        chunkEnd = (chunkEnd == end) ? end : skipLine(chunkEnd, end);
+
+        if (chunkEnd > chunkBegin)
+        {
+            ObjChunk chunk{};
+            chunk.begin = chunkBegin;
+            chunk.end = chunkEnd;
+            chunks.push_back(chunk);
+        }
+        chunkBegin = chunkEnd;
+    }
+
+    return chunks;
+}
+
+// Parses one chunk into the global attribute pools and triangle corner list
+// at the offsets given by chunk.base. Each triangle is tagged with the chunk
+// local number of its material, or -1 when it inherits the material active
+// at the start of the chunk. Returns 0 on success or the chunk local line
+// number of the first malformed record.
+std::size_t parseChunk(ObjChunk &chunk, float *positions,
+                       float *textureCoordinates, float *normals,
+                       VertexKey *triangles, std::int32_t *triangleMaterials)
+{
+    std::size_t positionCount{chunk.base.positions};
+    std::size_t textureCoordinateCount{chunk.base.textureCoordinates};
+    std::size_t normalCount{chunk.base.normals};
+    VertexKey *triangle{triangles + 3 * chunk.base.triangles};
+    VertexKey *const triangleEnd{triangle + 3 * chunk.counts.triangles};
+    std::int32_t *triangleMaterial{triangleMaterials + chunk.base.triangles};
+    std::int32_t material{-1};
+
+    std::vector<VertexKey> polygon;
+    std::size_t lineNumber{0};
+
+    for (const char *p{chunk.begin}; p < chunk.end;
+         p = skipLine(p, chunk.end))
+    {
+        ++lineNumber;
+
+        const char *const end{chunk.end};
+        p = skipSpaces(p, end);
+        if (end - p < 2)
+        {
+            continue;
+        }
+
+        bool valid{true};
+
+        if (p[0] == 'v' && isSpace(p[1]))
+        {
+            p += 2;
+            float *position{positions + 3 * positionCount++};
+            valid = parseFloat(p, end, position[0]) &&
+                    parseFloat(p, end, position[1]) &&
+                    parseFloat(p, end, position[2]);
+        }
+        else if (p[0] == 'v' && p[1] == 't' && end - p > 2 && isSpace(p[2]))
+        {
+            p += 3;
+            float *textureCoordinate{textureCoordinates +
+                                     2 * textureCoordinateCount++};
+            textureCoordinate[1] = 0.0f;
+            valid = parseFloat(p, end, textureCoordinate[0]);
+            // The second coordinate is optional in the specification.
+            parseFloat(p, end, textureCoordinate[1]);
+        }
+        else if (p[0] == 'v' && p[1] == 'n' && end - p > 2 && isSpace(p[2]))
+        {
+            p += 3;
+            float *normal{normals + 3 * normalCount++};
+            valid = parseFloat(p, end, normal[0]) &&
+                    parseFloat(p, end, normal[1]) &&
+                    parseFloat(p, end, normal[2]);
+        }
+        else if (p[0] == 'f' && isSpace(p[1]))
+        {
+            polygon.clear();
+
+            for (p += 2;;)
+            {
+                p = skipSpaces(p, end);
+                if (p == end || isLineEnd(*p) || *p == '#')
+                {
+                    break;
+                }
+
+                long corner[3];
+                VertexKey key{-1, -1, -1};
+                if (!parseCorner(p, end, corner) ||
+                    !resolveIndex(corner[0], positionCount, key.position) ||
+                    (corner[1] && !resolveIndex(corner[1],
+                                                textureCoordinateCount,
+                                                key.textureCoordinate)) ||
+                    (corner[2] &&
+                     !resolveIndex(corner[2], normalCount, key.normal)))
+                {
+                    valid = false;
+                    break;
+                }
+
+                polygon.push_back(key);
+            }
+
+            // Triangle fan, the same triangulation tinyobj applies.
+            for (std::size_t i{2}; valid && i < polygon.size(); ++i)
+            {
+                if (triangle == triangleEnd)
+                {
+                    valid = false;
+                    break;
+                }
+                *triangle++ = polygon[0];
+                *triangle++ = polygon[i - 1];
+                *triangle++ = polygon[i];
+                *triangleMaterial++ = material;
+            }
+        }
+        else if (isKeyword(p, end, "usemtl"))
+        {
+            material = static_cast<std::int32_t>(chunk.materialNames.size());
+            chunk.materialNames.push_back(parseName(p + 6, end));
+        }
+        else if (isKeyword(p, end, "mtllib"))
+        {
+            for (std::string &name : parseNames(p + 6, end))
+            {
+                chunk.libraries.push_back(std::move(name));
+            }
+        }
+
+        if (!valid)
+        {
+            return lineNumber;
+        }
+    }
+
+    return 0;
+}
+
+// Reads the diffuse color and map of the materials named in materialIds.
+// Unknown statements and materials the model never uses are skipped.
+void parseMaterialLibrary(
+    const char *begin, const char *end, const std::string &directory,
+    const std::unordered_map<std::string, std::int32_t> &materialIds,
+    std::vector<Material> &materials)
+{
+    Material *material{nullptr};
+
+    for (const char *p{begin}; p < end; p = skipLine(p, end))
+    {
+        p = skipSpaces(p, end);
+
+        if (isKeyword(p, end, "newmtl"))
+        {
+            const auto found = materialIds.find(parseName(p + 6, end));
+            material = found == materialIds.end()
+                           ? nullptr
+                           : &materials[static_cast<std::size_t>(
+                                 found->second)];
+        }
+        else if (!material)
+        {
+            continue;
+        }
+        else if (isKeyword(p, end, "Kd"))
+        {
+            p += 2;
+            glm::vec3 color;
+            if (parseFloat(p, end, color.x) && parseFloat(p, end, color.y) &&
+                parseFloat(p, end, color.z))
+            {
+                material->diffuseColor = color;
+            }
+        }
+        else if (isKeyword(p, end, "map_Kd"))
+        {
+            // Options such as "-s 1 1 1" come first; the file name is last.
+            const std::vector<std::string> names{parseNames(p + 6, end)};
+            if (!names.empty())
+            {
+                material->diffuseTexture = directory + names.back();
+            }
+        }
+    }
+}
+
+// Reorders the triangles so that each material is one contiguous range, in
+// material order with untextured triangles first, and returns the ranges.
+// The order of the triangles within a material is kept.
+std::vector<SubMesh> groupByMaterial(const std::vector<std::int32_t> &materials,
+                                     std::size_t materialCount,
+                                     std::vector<MeshData::IndexType> &indices)
+{
+    std::vector<std::size_t> offsets(materialCount + 2, 0);
+    for (const std::int32_t material : materials)
+    {
+        ++offsets[static_cast<std::size_t>(material + 2)];
+    }
+    for (std::size_t i{1}; i < offsets.size(); ++i)
+    {
+        offsets[i] += offsets[i - 1];
+    }
+
+    std::vector<SubMesh> subMeshes;
+    for (std::size_t i{0}; i + 1 < offsets.size(); ++i)
+    {
+        if (offsets[i + 1] > offsets[i])
+        {
+            subMeshes.push_back(SubMesh{
+                static_cast<std::uint32_t>(3 * offsets[i]),
+                static_cast<std::uint32_t>(3 * (offsets[i + 1] - offsets[i])),
+                static_cast<std::int32_t>(i) - 1});
+        }
+    }
+
+    std::vector<MeshData::IndexType> grouped(indices.size());
+    for (std::size_t i{0}; i < materials.size(); ++i)
+    {
+        std::size_t &offset{
+            offsets[static_cast<std::size_t>(materials[i] + 1)]};
+        std::copy(indices.begin() + 3 * i, indices.begin() + 3 * i + 3,
+                  grouped.begin() + 3 * offset++);
+    }
+    indices.swap(grouped);
+
+    return subMeshes;
+}
+
+class VertexWelder
+{
+public:
+    using IndexType = MeshData::IndexType;
+
+    explicit VertexWelder(MeshData &meshData, const std::vector<float> &positions,
+                          const std::vector<float> &textureCoordinates,
+                          const std::vector<float> &normals,
+                          std::size_t expectedVertices)
+        : meshData_(meshData), positions_(positions),
+          textureCoordinates_(textureCoordinates), normals_(normals),
+          table_{expectedVertices}
+    {
+    }
+
+    IndexType weld(const VertexKey &key)
+    {
+        bool inserted;
+        const IndexType index{table_.insert(key, inserted)};
+
+        if (inserted)
+        {
+            const std::size_t position{static_cast<std::size_t>(key.position)};
+            meshData_.positions.push_back(positions_[3 * position + 0]);
+            meshData_.positions.push_back(positions_[3 * position + 1]);
+            meshData_.positions.push_back(positions_[3 * position + 2]);
+
+            if (!textureCoordinates_.empty())
+            {
+                const std::size_t texture{
+                    static_cast<std::size_t>(key.textureCoordinate)};
+                const bool valid{key.textureCoordinate >= 0};
+                meshData_.textureCoordinates.push_back(
+                    valid ? textureCoordinates_[2 * texture + 0] : 0.0f);
+                meshData_.textureCoordinates.push_back(
+                    valid ? textureCoordinates_[2 * texture + 1] : 0.0f);
+            }
+
+            if (!normals_.empty())
+            {
+                const std::size_t normal{static_cast<std::size_t>(key.normal)};
+                const bool valid{key.normal >= 0};
+                meshData_.normals.push_back(valid ? normals_[3 * normal + 0]
+                                                  : 0.0f);
+                meshData_.normals.push_back(valid ? normals_[3 * normal + 1]
+                                                  : 0.0f);
+                meshData_.normals.push_back(valid ? normals_[3 * normal + 2]
+                                                  : 0.0f);
+            }
+        }
+
+        return index;
+    }
+
+private:
+    MeshData &meshData_;
+    const std::vector<float> &positions_;
+    const std::vector<float> &textureCoordinates_;
+    const std::vector<float> &normals_;
+
+    VertexWeldTable table_;
+};
+
+} // namespace Detail
+
+ObjLoader::ObjLoader(unsigned int threadCount) noexcept
+    : errorMessage_{}, statistics_{0.0, 0, 0, 0, 0, 0}, threadCount_{threadCount}
+{
+}
+
+const std::string &ObjLoader::errorMessage() const noexcept
+{
+    return errorMessage_;
+}
+
+bool ObjLoader::load(const char *fileName, MeshData &meshData)
+{
+    Performance::Stopwatch stopwatch;
+
+    errorMessage_.clear();
+    statistics_ = Statistics{0.0, 0, 0, 0, 0, 0};
+    meshData.clear();
+
+    FileIO::MappedFile file;
+    if (!file.open(fileName))
+    {
+        errorMessage_ = std::string{"Cannot open OBJ file: "} + fileName;
+        return false;
+    }
+
+    const bool success{parse(file.begin(), file.end(),
+                             FileIO::DirectoryOf(fileName), meshData)};
+
+    statistics_.loadMilliseconds = stopwatch.elapsedMilliseconds();
+    statistics_.peakResidentSetSize = Performance::PeakResidentSetSize();
+    statistics_.fileSize = file.size();
+    statistics_.vertexCount = meshData.vertexCount();
+    statistics_.triangleCount = meshData.triangleCount();
+    statistics_.threadCount = Parallel::ResolveThreadCount(threadCount_);
+
+    if (!success)
+    {
+        meshData.clear();
+    }
+
+    return success;
+}
+
+bool ObjLoader::parse(const char *begin, const char *end,
+                      const std::string &directory, MeshData &meshData)
+{
+    const unsigned int threadCount{Parallel::ResolveThreadCount(threadCount_)};
+
+    // A few chunks per thread keeps the workers busy when record density
+    // varies through the file.
+    std::vector<Detail::ObjChunk> chunks{Detail::splitChunks(
+        begin, end, threadCount > 1 ? 4 * threadCount : 1)};
+
+    Parallel::ParallelFor(chunks.size(), threadCount, [&](std::size_t i) {
+        chunks[i].counts = Detail::countRecords(chunks[i].begin, chunks[i].end);
+    });
+
+    Detail::ObjCounts total{0, 0, 0, 0, 0};
+    for (auto &chunk : chunks)
+    {
+        chunk.base = total;
+        total.lines += chunk.counts.lines;
+        total.positions += chunk.counts.positions;
+        total.textureCoordinates += chunk.counts.textureCoordinates;
+        total.normals += chunk.counts.normals;
+        total.triangles += chunk.counts.triangles;
+    }
+
+    std::vector<float> positions(3 * total.positions);
+    std::vector<float> textureCoordinates(2 * total.textureCoordinates);
+    std::vector<float> normals(3 * total.normals);
+    std::vector<Detail::VertexKey> triangles(3 * total.triangles);
+    std::vector<std::int32_t> triangleMaterials(total.triangles, -1);
+    std::vector<std::size_t> errorLines(chunks.size());
+
+    Parallel::ParallelFor(chunks.size(), threadCount, [&](std::size_t i) {
+        errorLines[i] = Detail::parseChunk(
+            chunks[i], positions.data(), textureCoordinates.data(),
+            normals.data(), triangles.data(), triangleMaterials.data());
+    });
+
+    for (std::size_t i{0}; i < chunks.size(); ++i)
+    {
+        if (errorLines[i])
+        {
+            errorMessage_ = "Malformed OBJ record at line " +
+                            std::to_string(chunks[i].base.lines + errorLines[i]) +
+                            "\n";
+            return false;
+        }
+    }
+
+    resolveMaterials(chunks, directory, triangleMaterials, meshData);
+
+    // Welding stays sequential so that vertices are numbered in first-seen
+    // order whatever the thread count.
+    meshData.positions.reserve(3 * total.positions);
+    if (total.textureCoordinates)
+    {
+        meshData.textureCoordinates.reserve(2 * total.positions);
+    }
+    if (total.normals)
+    {
+        meshData.normals.reserve(3 * total.positions);
+    }
+    meshData.indices.resize(triangles.size());
+
+    Detail::VertexWelder welder{
+        meshData, positions, textureCoordinates, normals,
+        Detail::VertexWeldTable::estimateVertexCount(total.positions,
+                                                     total.triangles)};
+
+    for (std::size_t i{0}; i < triangles.size(); ++i)
+    {
+        meshData.indices[i] = welder.weld(triangles[i]);
+    }
+
+    meshData.updateBounds();
+    if (meshData.materials.empty())
+    {
+        meshData.subMeshes.push_back(SubMesh{
+            0, static_cast<std::uint32_t>(meshData.indices.size()), -1});
+    }
+    else
+    {
+        meshData.subMeshes = Detail::groupByMaterial(
+            triangleMaterials, meshData.materials.size(), meshData.indices);
+    }
+
+    return true;
+}
+
+// Numbers the materials in order of first use over the whole file, rewrites
+// the chunk local material of every triangle to that number and reads the
+// referenced material libraries. A library that cannot be opened leaves its
+// materials white and untextured and is reported as a warning only.
+void ObjLoader::resolveMaterials(std::vector<Detail::ObjChunk> &chunks,
+                                 const std::string &directory,
+                                 std::vector<std::int32_t> &triangleMaterials,
+                                 MeshData &meshData)
+{
+    std::unordered_map<std::string, std::int32_t> materialIds;
+    std::vector<std::vector<std::int32_t>> chunkMaterials(chunks.size());
+    // Material in effect at the start of each chunk.
+    std::vector<std::int32_t> inherited(chunks.size());
+    std::vector<std::string> libraries;
+
+    std::int32_t current{-1};
+    for (std::size_t i{0}; i < chunks.size(); ++i)
+    {
+        inherited[i] = current;
+        for (const std::string &name : chunks[i].materialNames)
+        {
+            const auto found = materialIds.emplace(
+                name, static_cast<std::int32_t>(meshData.materials.size()));
+            if (found.second)
+            {
+                meshData.materials.push_back(
+                    Material{name, glm::vec3{1.0f}, std::string{}});
+            }
+            chunkMaterials[i].push_back(found.first->second);
+        }
+        if (!chunkMaterials[i].empty())
+        {
+            current = chunkMaterials[i].back();
+        }
+
+        for (const std::string &library : chunks[i].libraries)
+        {
+            if (std::find(libraries.begin(), libraries.end(), library) ==
+                libraries.end())
+            {
+                libraries.push_back(library);
+            }
+        }
+    }
+
+    if (meshData.materials.empty())
+    {
+        return;
+    }
+    meshData.dependencies = libraries;
+
+    Parallel::ParallelFor(
+        chunks.size(), Parallel::ResolveThreadCount(threadCount_),
+        [&](std::size_t i) {
+            const std::size_t first{chunks[i].base.triangles};
+            const std::size_t last{first + chunks[i].counts.triangles};
+            for (std::size_t j{first}; j < last; ++j)
+            {
+                const std::int32_t local{triangleMaterials[j]};
+                triangleMaterials[j] =
+                    local < 0 ? inherited[i]
+                              : chunkMaterials[i][static_cast<std::size_t>(
+                                    local)];
+            }
+        });
+
+    for (const std::string &library : libraries)
+    {
+        const std::string path{directory + library};
+
+        FileIO::MappedFile file;
+        if (!file.open(path.c_str()))
+        {
+            errorMessage_ += "Cannot open material library: " + path + "\n";
+            continue;
+        }
+
+        Detail::parseMaterialLibrary(file.begin(), file.end(),
+                                     FileIO::DirectoryOf(path), materialIds,
+                                     meshData.materials);
+    }
+}
+
+const ObjLoader::Statistics &ObjLoader::statistics() const noexcept
+{
+    return statistics_;
+}
+
+} // namespace Model
@@ -0,0 +1,60 @@
+#ifndef HOMEWORK01_MODEL_OBJLOADER_HPP_
+#define HOMEWORK01_MODEL_OBJLOADER_HPP_
+
+#include "LoadStatistics.hpp"
+#include "MeshData.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+struct ObjChunk;
+
+} // namespace Detail
+
+// Wavefront OBJ reader working on a memory mapped view of the file. Records
+// are scanned in place and the welded vertex streams and triangle indices are
+// written straight into MeshData.
+//
+// The file is split at line boundaries and parsed on up to threadCount
+// threads (0 = every hardware thread). The result does not depend on the
+// thread count.
+//
+// Faces are grouped into one SubMesh per usemtl material. The diffuse color
+// and map of each material are taken from the mtllib libraries, which are
+// looked up relative to the model.
+class ObjLoader
+{
+public:
+    using Statistics = LoadStatistics;
+
+    explicit ObjLoader(unsigned int threadCount = 0) noexcept;
+
+    bool load(const char *fileName, MeshData &meshData);
+
+    const std::string &errorMessage() const noexcept;
+    const Statistics &statistics() const noexcept;
+
+private:
+    bool parse(const char *begin, const char *end,
+               const std::string &directory, MeshData &meshData);
+    void resolveMaterials(std::vector<Detail::ObjChunk> &chunks,
+                          const std::string &directory,
+                          std::vector<std::int32_t> &triangleMaterials,
+                          MeshData &meshData);
+
+    std::string errorMessage_;
+    Statistics statistics_;
+    unsigned int threadCount_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_OBJLOADER_HPP_
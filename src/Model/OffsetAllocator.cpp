@@ -0,0 +1,286 @@
+#include "OffsetAllocator.hpp"
+
+#include "Utils/Global.hpp"
+
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Sizes below this are binned exactly; above it the bins are
+// (exponent + 1) * 8 + mantissa, with the 3 bits below the leading one as
+// the mantissa.
+constexpr std::uint32_t exactBinLimit{8};
+
+std::uint32_t highestSetBit(std::uint32_t value) noexcept;
+std::uint32_t lowestSetBit(std::uint32_t value) noexcept;
+std::uint32_t binRoundDown(std::uint32_t size) noexcept;
+std::uint32_t binRoundUp(std::uint32_t size) noexcept;
+
+// value must not be zero.
+inline std::uint32_t highestSetBit(std::uint32_t value) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, value);
+    return static_cast<std::uint32_t>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return 31u - static_cast<std::uint32_t>(__builtin_clz(value));
+#else
+    std::uint32_t index{0};
+    while (value >>= 1)
+    {
+        ++index;
+    }
+    return index;
+#endif
+}
+
+// value must not be zero.
+inline std::uint32_t lowestSetBit(std::uint32_t value) noexcept
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<std::uint32_t>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::uint32_t>(__builtin_ctz(value));
+#else
+    std::uint32_t index{0};
+    while (!(value & 1u))
+    {
+        value >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+// Bin whose smallest size is at most size; where a free range is filed.
+inline std::uint32_t binRoundDown(std::uint32_t size) noexcept
+{
+    if (size < exactBinLimit)
+    {
+        return size;
+    }
+    const std::uint32_t exponent{highestSetBit(size) - 3};
+    return ((exponent + 1) << 3) | ((size >> exponent) & 7u);
+}
+
+// Bin whose smallest size is at least size; where a search starts.
+inline std::uint32_t binRoundUp(std::uint32_t size) noexcept
+{
+    const std::uint32_t bin{binRoundDown(size)};
+    if (size < exactBinLimit)
+    {
+        return bin;
+    }
+    const std::uint32_t exponent{highestSetBit(size) - 3};
+    return size & ((1u << exponent) - 1) ? bin + 1 : bin;
+}
+
+} // namespace Detail
+
+constexpr std::uint32_t OffsetAllocator::noNode;
+constexpr std::size_t OffsetAllocator::binCount;
+
+OffsetAllocator::OffsetAllocator(std::uint32_t capacity)
+    : capacity_{capacity}, freeSize_{0}, allocationCount_{0}, nodes_{},
+      unusedNodes_{}, topMask_{0}, binMasks_{}, binHeads_{}
+{
+    binMasks_.fill(0);
+    binHeads_.fill(noNode);
+    if (capacity)
+    {
+        insertFree(0, capacity, noNode, noNode);
+        freeSize_ = capacity;
+    }
+}
+
+OffsetAllocator::Allocation OffsetAllocator::allocate(std::uint32_t size)
+{
+    PROGRAM_ASSERT(size > 0);
+
+    const std::uint32_t bin{findBin(Detail::binRoundUp(size))};
+    if (bin == noNode)
+    {
+        return Allocation{0, noNode};
+    }
+
+    // Indices rather than references: inserting the rest may grow nodes_.
+    const std::uint32_t node{binHeads_[bin]};
+    removeFree(node);
+    nodes_[node].used = true;
+
+    const std::uint32_t rest{nodes_[node].size - size};
+    if (rest)
+    {
+        nodes_[node].size = size;
+        insertFree(nodes_[node].offset + size, rest, node,
+                   nodes_[node].neighbourNext);
+    }
+
+    freeSize_ -= size;
+    ++allocationCount_;
+    return Allocation{nodes_[node].offset, node};
+}
+
+std::uint32_t OffsetAllocator::capacity() const noexcept { return capacity_; }
+
+bool OffsetAllocator::empty() const noexcept { return !allocationCount_; }
+
+// The first non-empty bin from firstBin on, or noNode.
+std::uint32_t OffsetAllocator::findBin(std::uint32_t firstBin) const noexcept
+{
+    const std::uint32_t top{firstBin >> 3};
+    const std::uint32_t low{binMasks_[top] & (0xffu << (firstBin & 7u)) &
+                            0xffu};
+    if (low)
+    {
+        return (top << 3) | Detail::lowestSetBit(low);
+    }
+
+    const std::uint32_t above{top + 1 < 32 ? topMask_ & (~0u << (top + 1))
+                                           : 0u};
+    if (!above)
+    {
+        return noNode;
+    }
+    const std::uint32_t next{Detail::lowestSetBit(above)};
+    return (next << 3) | Detail::lowestSetBit(binMasks_[next]);
+}
+
+// Merges the range with the free ranges on either side.
+void OffsetAllocator::free(const Allocation &allocation)
+{
+    const std::uint32_t node{allocation.node};
+    PROGRAM_ASSERT(node < nodes_.size() && nodes_[node].used);
+
+    std::uint32_t offset{nodes_[node].offset};
+    std::uint32_t size{nodes_[node].size};
+    std::uint32_t previous{nodes_[node].neighbourPrevious};
+    std::uint32_t next{nodes_[node].neighbourNext};
+    freeSize_ += size;
+    --allocationCount_;
+
+    if (previous != noNode && !nodes_[previous].used)
+    {
+        offset = nodes_[previous].offset;
+        size += nodes_[previous].size;
+        removeFree(previous);
+        unusedNodes_.push_back(previous);
+        previous = nodes_[previous].neighbourPrevious;
+    }
+    if (next != noNode && !nodes_[next].used)
+    {
+        size += nodes_[next].size;
+        removeFree(next);
+        unusedNodes_.push_back(next);
+        next = nodes_[next].neighbourNext;
+    }
+
+    nodes_[node].used = false;
+    unusedNodes_.push_back(node);
+    insertFree(offset, size, previous, next);
+}
+
+// Files a free range in its bin and links it between its neighbours.
+std::uint32_t OffsetAllocator::insertFree(std::uint32_t offset,
+                                          std::uint32_t size,
+                                          std::uint32_t neighbourPrevious,
+                                          std::uint32_t neighbourNext)
+{
+    const std::uint32_t node{newNode()};
+    const std::uint32_t bin{Detail::binRoundDown(size)};
+    const std::uint32_t head{binHeads_[bin]};
+
+    nodes_[node] = Node{offset, size, noNode, head, neighbourPrevious,
+                        neighbourNext, false};
+    if (head != noNode)
+    {
+        nodes_[head].binPrevious = node;
+    }
+    binHeads_[bin] = node;
+    binMasks_[bin >> 3] =
+        static_cast<std::uint8_t>(binMasks_[bin >> 3] | (1u << (bin & 7u)));
+    topMask_ |= 1u << (bin >> 3);
+
+    if (neighbourPrevious != noNode)
+    {
+        nodes_[neighbourPrevious].neighbourNext = node;
+    }
+    if (neighbourNext != noNode)
+    {
+        nodes_[neighbourNext].neighbourPrevious = node;
+    }
+    return node;
+}
+
+std::uint32_t OffsetAllocator::newNode()
+{
+    if (unusedNodes_.empty())
+    {
+        nodes_.push_back(Node{});
+        return static_cast<std::uint32_t>(nodes_.size() - 1);
+    }
+    const std::uint32_t node{unusedNodes_.back()};
+    unusedNodes_.pop_back();
+    return node;
+}
+
+// Unlinks a free range from its bin; its neighbour links are left as they
+// are.
+void OffsetAllocator::removeFree(std::uint32_t node) noexcept
+{
+    const Node &removed{nodes_[node]};
+    const std::uint32_t bin{Detail::binRoundDown(removed.size)};
+
+    if (removed.binPrevious != noNode)
+    {
+        nodes_[removed.binPrevious].binNext = removed.binNext;
+    }
+    else
+    {
+        binHeads_[bin] = removed.binNext;
+    }
+    if (removed.binNext != noNode)
+    {
+        nodes_[removed.binNext].binPrevious = removed.binPrevious;
+    }
+
+    if (binHeads_[bin] == noNode)
+    {
+        binMasks_[bin >> 3] = static_cast<std::uint8_t>(
+            binMasks_[bin >> 3] & ~(1u << (bin & 7u)));
+        if (!binMasks_[bin >> 3])
+        {
+            topMask_ &= ~(1u << (bin >> 3));
+        }
+    }
+}
+
+OffsetAllocator::Statistics OffsetAllocator::statistics() const noexcept
+{
+    Statistics statistics{capacity_, capacity_ - freeSize_, freeSize_,
+                          allocationCount_, 0, 0};
+    for (std::uint32_t head : binHeads_)
+    {
+        for (std::uint32_t node{head}; node != noNode;
+             node = nodes_[node].binNext)
+        {
+            ++statistics.freeRangeCount;
+            statistics.largestFreeRange =
+                std::max(statistics.largestFreeRange, nodes_[node].size);
+        }
+    }
+    return statistics;
+}
+
+} // namespace Model
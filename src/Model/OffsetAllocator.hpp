@@ -0,0 +1,95 @@
+#ifndef HOMEWORK01_MODEL_OFFSETALLOCATOR_HPP_
+#define HOMEWORK01_MODEL_OFFSETALLOCATOR_HPP_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Model
+{
+
+struct OffsetAllocatorStatistics
+{
+    std::uint32_t capacity;
+    std::uint32_t usedSize;
+    std::uint32_t freeSize;
+    std::size_t allocationCount;
+    // Free ranges, each between two allocations or an allocation and an end.
+    std::size_t freeRangeCount;
+    std::uint32_t largestFreeRange;
+};
+
+// Hands out ranges of [0, capacity) without touching the memory they stand
+// for, so the same allocator places meshes in a buffer object. Free ranges
+// are kept in a two-level segregated fit (TLSF): sizes are binned like
+// floats with a 3-bit mantissa, and a bitmask per level finds the first
+// non-empty bin large enough in constant time. Freed ranges merge with free
+// neighbours right away, so the free space never splits into more ranges
+// than the allocations around it.
+class OffsetAllocator
+{
+public:
+    using Statistics = OffsetAllocatorStatistics;
+
+    struct Allocation
+    {
+        std::uint32_t offset;
+        // Names the range for free(); noNode if the allocation failed.
+        std::uint32_t node;
+    };
+
+    static constexpr std::uint32_t noNode{0xffffffffu};
+
+    explicit OffsetAllocator(std::uint32_t capacity);
+
+    // Fails, with node == noNode, when no free range is large enough.
+    Allocation allocate(std::uint32_t size);
+    void free(const Allocation &allocation);
+
+    std::uint32_t capacity() const noexcept;
+    bool empty() const noexcept;
+    // Walks the free ranges, so not meant for every allocation.
+    Statistics statistics() const noexcept;
+
+private:
+    // Bins of every size up to 2^32, eight per power of two.
+    static constexpr std::size_t binCount{256};
+
+    struct Node
+    {
+        std::uint32_t offset;
+        std::uint32_t size;
+        // Free ranges of the same bin.
+        std::uint32_t binPrevious;
+        std::uint32_t binNext;
+        // Ranges next to each other in offset order.
+        std::uint32_t neighbourPrevious;
+        std::uint32_t neighbourNext;
+        bool used;
+    };
+
+    std::uint32_t insertFree(std::uint32_t offset, std::uint32_t size,
+                             std::uint32_t neighbourPrevious,
+                             std::uint32_t neighbourNext);
+    void removeFree(std::uint32_t node) noexcept;
+    std::uint32_t newNode();
+    std::uint32_t findBin(std::uint32_t firstBin) const noexcept;
+
+    std::uint32_t capacity_;
+    std::uint32_t freeSize_;
+    std::size_t allocationCount_;
+
+    std::vector<Node> nodes_;
+    std::vector<std::uint32_t> unusedNodes_;
+
+    // Bit b of topMask_ is set if any of bins 8b to 8b + 7 has a range; bit
+    // i of binMasks_[b] if bin 8b + i has one.
+    std::uint32_t topMask_;
+    std::array<std::uint8_t, binCount / 8> binMasks_;
+    std::array<std::uint32_t, binCount> binHeads_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_OFFSETALLOCATOR_HPP_
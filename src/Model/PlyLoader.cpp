@@ -0,0 +1,788 @@
+#include "PlyLoader.hpp"
+
+#include "Utils/FileIO/FileStatus.hpp"
+#include "Utils/Performance/MemoryUsage.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+enum class PlyType
+{
+    Invalid,
+    Int8,
+    UInt8,
+    Int16,
+    UInt16,
+    Int32,
+    UInt32,
+    Float32,
+    Float64
+};
+
+struct PlyProperty
+{
+    std::string name;
+    PlyType type;
+    // Type of the element count for list properties, Invalid otherwise.
+    PlyType countType;
+    // Offset in a fixed size record.
+    std::size_t offset;
+};
+
+struct PlyElement
+{
+    std::string name;
+    std::size_t count;
+    std::vector<PlyProperty> properties;
+    // Record size in bytes, 0 when the element has list properties.
+    std::size_t size;
+};
+
+struct PlyHeader
+{
+    bool bigEndian;
+    std::vector<PlyElement> elements;
+};
+
+// Buffered reader that keeps at most capacity bytes of the file in memory.
+class PlyStream
+{
+public:
+    explicit PlyStream(std::ifstream &in, std::size_t capacity)
+        : in_(in), buffer_(capacity), begin_{0}, end_{0}
+    {
+    }
+
+    // Makes at least size contiguous bytes available at data(). Returns
+    // false at the end of the file or if size exceeds the capacity.
+    bool fill(std::size_t size)
+    {
+        if (end_ - begin_ >= size)
+        {
+            return true;
+        }
+        if (size > buffer_.size())
+        {
+            return false;
+        }
+
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+
+        while (end_ < size && in_)
+        {
+            in_.read(buffer_.data() + end_,
+                     static_cast<std::streamsize>(buffer_.size() - end_));
+            end_ += static_cast<std::size_t>(in_.gcount());
+        }
+
+        return end_ >= size;
+    }
+
+    const char *data() const noexcept { return buffer_.data() + begin_; }
+    std::size_t capacity() const noexcept { return buffer_.size(); }
+    void consume(std::size_t size) noexcept { begin_ += size; }
+
+private:
+    std::ifstream &in_;
+    std::vector<char> buffer_;
+    std::size_t begin_;
+    std::size_t end_;
+};
+
+PlyType parseType(const std::string &name) noexcept;
+std::size_t typeSize(PlyType type) noexcept;
+bool readHeader(std::ifstream &in, PlyHeader &header, std::string &error);
+double readValue(const char *p, PlyType type, bool swap) noexcept;
+std::size_t findProperty(const PlyElement &element,
+                         std::initializer_list<const char *> names) noexcept;
+std::uint8_t colorChannel(double value, PlyType type) noexcept;
+bool skipRecord(PlyStream &stream, const PlyElement &element, bool swap);
+
+PlyType parseType(const std::string &name) noexcept
+{
+    if (name == "char" || name == "int8")
+    {
+        return PlyType::Int8;
+    }
+    if (name == "uchar" || name == "uint8")
+    {
+        return PlyType::UInt8;
+    }
+    if (name == "short" || name == "int16")
+    {
+        return PlyType::Int16;
+    }
+    if (name == "ushort" || name == "uint16")
+    {
+        return PlyType::UInt16;
+    }
+    if (name == "int" || name == "int32")
+    {
+        return PlyType::Int32;
+    }
+    if (name == "uint" || name == "uint32")
+    {
+        return PlyType::UInt32;
+    }
+    if (name == "float" || name == "float32")
+    {
+        return PlyType::Float32;
+    }
+    if (name == "double" || name == "float64")
+    {
+        return PlyType::Float64;
+    }
+    return PlyType::Invalid;
+}
+
+inline std::size_t typeSize(PlyType type) noexcept
+{
+    switch (type)
+    {
+    case PlyType::Int8:
+    case PlyType::UInt8:
+        return 1;
+    case PlyType::Int16:
+    case PlyType::UInt16:
+        return 2;
+    case PlyType::Int32:
+    case PlyType::UInt32:
+    case PlyType::Float32:
+        return 4;
+    case PlyType::Float64:
+        return 8;
+    case PlyType::Invalid:
+        break;
+    }
+    return 0;
+}
+
+bool readHeader(std::ifstream &in, PlyHeader &header, std::string &error)
+{
+    std::string line;
+    if (!std::getline(in, line) || line.compare(0, 3, "ply") != 0)
+    {
+        error = "Not a PLY file\n";
+        return false;
+    }
+
+    bool format{false};
+    header.bigEndian = false;
+    header.elements.clear();
+
+    while (std::getline(in, line))
+    {
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        std::istringstream words{line};
+        std::string keyword;
+        words >> keyword;
+
+        if (keyword == "end_header")
+        {
+            if (!format)
+            {
+                error = "PLY header has no format line\n";
+                return false;
+            }
+            return true;
+        }
+        else if (keyword == "format")
+        {
+            std::string encoding;
+            words >> encoding;
+            if (encoding == "binary_little_endian")
+            {
+                header.bigEndian = false;
+            }
+            else if (encoding == "binary_big_endian")
+            {
+                header.bigEndian = true;
+            }
+            else
+            {
+                error = "Unsupported PLY format: " + encoding + "\n";
+                return false;
+            }
+            format = true;
+        }
+        else if (keyword == "element")
+        {
+            PlyElement element{std::string{}, 0, {}, 0};
+            unsigned long long count{0};
+            if (!(words >> element.name >> count))
+            {
+                error = "Malformed PLY element: " + line + "\n";
+                return false;
+            }
+            element.count = static_cast<std::size_t>(count);
+            header.elements.push_back(element);
+        }
+        else if (keyword == "property")
+        {
+            if (header.elements.empty())
+            {
+                error = "PLY property outside of an element\n";
+                return false;
+            }
+
+            PlyElement &element{header.elements.back()};
+            PlyProperty property{std::string{}, PlyType::Invalid,
+                                 PlyType::Invalid, element.size};
+            std::string type;
+            words >> type;
+
+            if (type == "list")
+            {
+                std::string countType;
+                words >> countType >> type;
+                property.countType = parseType(countType);
+                if (property.countType == PlyType::Invalid ||
+                    property.countType == PlyType::Float32 ||
+                    property.countType == PlyType::Float64)
+                {
+                    error = "Unsupported PLY list count type: " + countType +
+                            "\n";
+                    return false;
+                }
+            }
+
+            property.type = parseType(type);
+            if (property.type == PlyType::Invalid || !(words >> property.name))
+            {
+                error = "Malformed PLY property: " + line + "\n";
+                return false;
+            }
+
+            element.size =
+                (property.countType != PlyType::Invalid ||
+                 (!element.properties.empty() && element.size == 0))
+                    ? 0
+                    : element.size + typeSize(property.type);
+            element.properties.push_back(property);
+        }
+        // comment, obj_info and unknown lines are ignored.
+    }
+
+    error = "PLY header has no end_header line\n";
+    return false;
+}
+
+inline double readValue(const char *p, PlyType type, bool swap) noexcept
+{
+    unsigned char bytes[8];
+    const std::size_t size{typeSize(type)};
+    std::memcpy(bytes, p, size);
+    if (swap)
+    {
+        std::reverse(bytes, bytes + size);
+    }
+
+    switch (type)
+    {
+    case PlyType::Int8:
+    {
+        std::int8_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    case PlyType::UInt8:
+        return bytes[0];
+    case PlyType::Int16:
+    {
+        std::int16_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    case PlyType::UInt16:
+    {
+        std::uint16_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    case PlyType::Int32:
+    {
+        std::int32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    case PlyType::UInt32:
+    {
+        std::uint32_t value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    case PlyType::Float32:
+    {
+        float value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    case PlyType::Float64:
+    {
+        double value;
+        std::memcpy(&value, bytes, sizeof(value));
+        return value;
+    }
+    case PlyType::Invalid:
+        break;
+    }
+    return 0.0;
+}
+
+// Index of the first scalar property called one of names, or the property
+// count if there is none.
+std::size_t findProperty(const PlyElement &element,
+                         std::initializer_list<const char *> names) noexcept
+{
+    for (std::size_t i{0}; i < element.properties.size(); ++i)
+    {
+        for (const char *name : names)
+        {
+            if (element.properties[i].countType == PlyType::Invalid &&
+                element.properties[i].name == name)
+            {
+                return i;
+            }
+        }
+    }
+    return element.properties.size();
+}
+
+// Integer channels use their full range, floating point ones [0, 1].
+inline std::uint8_t colorChannel(double value, PlyType type) noexcept
+{
+    switch (type)
+    {
+    case PlyType::UInt16:
+        value /= 257.0;
+        break;
+    case PlyType::Float32:
+    case PlyType::Float64:
+        value *= 255.0;
+        break;
+    default:
+        break;
+    }
+    return static_cast<std::uint8_t>(
+        std::min(255.0, std::max(0.0, std::floor(value + 0.5))));
+}
+
+// Skips one record of an element with list properties.
+bool skipRecord(PlyStream &stream, const PlyElement &element, bool swap)
+{
+    for (const PlyProperty &property : element.properties)
+    {
+        std::size_t size{typeSize(property.type)};
+        if (property.countType != PlyType::Invalid)
+        {
+            const std::size_t countSize{typeSize(property.countType)};
+            if (!stream.fill(countSize))
+            {
+                return false;
+            }
+            const double count{
+                readValue(stream.data(), property.countType, swap)};
+            stream.consume(countSize);
+            size *= static_cast<std::size_t>(std::max(0.0, count));
+        }
+
+        for (; size; )
+        {
+            const std::size_t step{std::min(size, stream.capacity())};
+            if (!stream.fill(step))
+            {
+                return false;
+            }
+            stream.consume(step);
+            size -= step;
+        }
+    }
+    return true;
+}
+
+} // namespace Detail
+
+PlyLoader::PlyLoader(std::size_t chunkSize) noexcept
+    : errorMessage_{}, statistics_{0.0, 0, 0, 0, 0, 0},
+      chunkSize_{std::max<std::size_t>(chunkSize, 1 << 16)}
+{
+}
+
+const std::string &PlyLoader::errorMessage() const noexcept
+{
+    return errorMessage_;
+}
+
+bool PlyLoader::load(const char *fileName, MeshData &meshData)
+{
+    MeshDataSink sink{meshData};
+    const bool success{load(fileName, sink)};
+    if (!success)
+    {
+        meshData.clear();
+    }
+    return success;
+}
+
+bool PlyLoader::load(const char *fileName, MeshSink &sink)
+{
+    using IndexType = MeshSink::IndexType;
+
+    Performance::Stopwatch stopwatch;
+
+    errorMessage_.clear();
+    statistics_ = Statistics{0.0, 0, 0, 0, 0, 1};
+
+    std::ifstream in(fileName, std::ios::in | std::ios::binary);
+    if (!in.is_open())
+    {
+        errorMessage_ = std::string{"Cannot open PLY file: "} + fileName;
+        return false;
+    }
+
+    Detail::PlyHeader header;
+    if (!Detail::readHeader(in, header, errorMessage_))
+    {
+        return false;
+    }
+
+    const Detail::PlyElement *vertexElement{nullptr};
+    const Detail::PlyElement *faceElement{nullptr};
+    for (const auto &element : header.elements)
+    {
+        vertexElement = element.name == "vertex" ? &element : vertexElement;
+        faceElement = element.name == "face" ? &element : faceElement;
+    }
+
+    if (!vertexElement || vertexElement->size == 0)
+    {
+        errorMessage_ = "PLY file has no fixed size vertex element\n";
+        return false;
+    }
+    if (vertexElement->count > std::numeric_limits<IndexType>::max())
+    {
+        errorMessage_ = "PLY file has too many vertices\n";
+        return false;
+    }
+
+    const auto &properties = vertexElement->properties;
+    const std::size_t position[]{
+        Detail::findProperty(*vertexElement, {"x"}),
+        Detail::findProperty(*vertexElement, {"y"}),
+        Detail::findProperty(*vertexElement, {"z"})};
+    const std::size_t normal[]{
+        Detail::findProperty(*vertexElement, {"nx"}),
+        Detail::findProperty(*vertexElement, {"ny"}),
+        Detail::findProperty(*vertexElement, {"nz"})};
+    const std::size_t textureCoordinate[]{
+        Detail::findProperty(*vertexElement,
+                             {"u", "s", "texture_u", "texture_s"}),
+        Detail::findProperty(*vertexElement,
+                             {"v", "t", "texture_v", "texture_t"})};
+    const std::size_t color[]{
+        Detail::findProperty(*vertexElement, {"red", "diffuse_red"}),
+        Detail::findProperty(*vertexElement, {"green", "diffuse_green"}),
+        Detail::findProperty(*vertexElement, {"blue", "diffuse_blue"}),
+        Detail::findProperty(*vertexElement, {"alpha"})};
+    const std::size_t none{properties.size()};
+
+    if (position[0] == none || position[1] == none || position[2] == none)
+    {
+        errorMessage_ = "PLY vertex element has no x, y, z properties\n";
+        return false;
+    }
+
+    const VertexStreams streams{
+        normal[0] != none && normal[1] != none && normal[2] != none,
+        textureCoordinate[0] != none && textureCoordinate[1] != none,
+        color[0] != none && color[1] != none && color[2] != none, false};
+
+    std::size_t faceList{0};
+    if (faceElement)
+    {
+        faceList = faceElement->properties.size();
+        for (std::size_t i{0}; i < faceElement->properties.size(); ++i)
+        {
+            const auto &property = faceElement->properties[i];
+            if (property.countType != Detail::PlyType::Invalid &&
+                (property.name == "vertex_indices" ||
+                 property.name == "vertex_index"))
+            {
+                faceList = i;
+                break;
+            }
+        }
+        if (faceList == faceElement->properties.size())
+        {
+            errorMessage_ = "PLY face element has no vertex_indices list\n";
+            return false;
+        }
+    }
+
+    const bool swap{header.bigEndian};
+    const std::size_t vertexCount{vertexElement->count};
+    const std::size_t faceCount{faceElement ? faceElement->count : 0};
+
+    sink.beginMesh(streams, vertexCount, 3 * faceCount);
+
+    Detail::PlyStream stream{in, chunkSize_};
+
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> textureCoordinates;
+    std::vector<std::uint8_t> colors;
+    std::vector<IndexType> indices;
+    std::vector<IndexType> polygon;
+
+    Bounds bounds{glm::vec3{0}, glm::vec3{0}};
+    std::size_t indexCount{0};
+
+    for (const auto &element : header.elements)
+    {
+        if (&element == vertexElement)
+        {
+            const std::size_t recordSize{element.size};
+            if (recordSize > stream.capacity())
+            {
+                errorMessage_ = "PLY vertex record is larger than the read "
+                                "buffer\n";
+                return false;
+            }
+            const std::size_t chunkVertices{stream.capacity() / recordSize};
+
+            positions.resize(3 * chunkVertices);
+            normals.resize(streams.normals ? 3 * chunkVertices : 0);
+            textureCoordinates.resize(
+                streams.textureCoordinates ? 2 * chunkVertices : 0);
+            colors.resize(streams.colors ? 4 * chunkVertices : 0);
+
+            for (std::size_t first{0}; first < element.count;)
+            {
+                const std::size_t count{
+                    std::min(chunkVertices, element.count - first)};
+                if (!stream.fill(count * recordSize))
+                {
+                    errorMessage_ = "PLY file ends inside the vertex data\n";
+                    return false;
+                }
+
+                const char *record{stream.data()};
+                for (std::size_t i{0}; i < count; ++i, record += recordSize)
+                {
+                    glm::vec3 point;
+                    for (std::size_t j{0}; j < 3; ++j)
+                    {
+                        const auto &property = properties[position[j]];
+                        point[static_cast<int>(j)] =
+                            static_cast<float>(Detail::readValue(
+                                record + property.offset, property.type,
+                                swap));
+                        positions[3 * i + j] = point[static_cast<int>(j)];
+                    }
+                    const bool firstVertex{first + i == 0};
+                    bounds.minimum = firstVertex
+                                         ? point
+                                         : glm::min(bounds.minimum, point);
+                    bounds.maximum = firstVertex
+                                         ? point
+                                         : glm::max(bounds.maximum, point);
+
+                    for (std::size_t j{0}; streams.normals && j < 3; ++j)
+                    {
+                        const auto &property = properties[normal[j]];
+                        normals[3 * i + j] =
+                            static_cast<float>(Detail::readValue(
+                                record + property.offset, property.type,
+                                swap));
+                    }
+                    for (std::size_t j{0}; streams.textureCoordinates && j < 2;
+                         ++j)
+                    {
+                        const auto &property = properties[textureCoordinate[j]];
+                        textureCoordinates[2 * i + j] =
+                            static_cast<float>(Detail::readValue(
+                                record + property.offset, property.type,
+                                swap));
+                    }
+                    for (std::size_t j{0}; streams.colors && j < 4; ++j)
+                    {
+                        if (color[j] == none)
+                        {
+                            colors[4 * i + j] = 255;
+                            continue;
+                        }
+                        const auto &property = properties[color[j]];
+                        colors[4 * i + j] = Detail::colorChannel(
+                            Detail::readValue(record + property.offset,
+                                              property.type, swap),
+                            property.type);
+                    }
+                }
+                stream.consume(count * recordSize);
+
+                sink.writeVertices(
+                    first, MeshView{positions.data(),
+                                    streams.normals ? normals.data() : nullptr,
+                                    streams.textureCoordinates
+                                        ? textureCoordinates.data()
+                                        : nullptr,
+                                    streams.colors ? colors.data() : nullptr,
+                                    nullptr,
+                                    count,
+                                    nullptr,
+                                    0,
+                                    Bounds{},
+                                    nullptr,
+                                    0,
+                                    nullptr,
+                                    0});
+                first += count;
+            }
+        }
+        else if (&element == faceElement)
+        {
+            indices.reserve(chunkSize_ / sizeof(IndexType));
+
+            const auto flush = [&]() {
+                sink.writeIndices(indexCount, indices.data(), indices.size());
+                indexCount += indices.size();
+                indices.clear();
+            };
+
+            for (std::size_t face{0}; face < element.count; ++face)
+            {
+                for (std::size_t i{0}; i < element.properties.size(); ++i)
+                {
+                    const auto &property = element.properties[i];
+                    const std::size_t countSize{
+                        Detail::typeSize(property.countType)};
+                    const std::size_t itemSize{
+                        Detail::typeSize(property.type)};
+
+                    if (!stream.fill(countSize ? countSize : itemSize))
+                    {
+                        errorMessage_ = "PLY file ends inside the face data\n";
+                        return false;
+                    }
+                    if (!countSize)
+                    {
+                        stream.consume(itemSize);
+                        continue;
+                    }
+
+                    const std::size_t count{static_cast<std::size_t>(
+                        std::max(0.0, Detail::readValue(stream.data(),
+                                                        property.countType,
+                                                        swap)))};
+                    stream.consume(countSize);
+                    if (!stream.fill(count * itemSize))
+                    {
+                        errorMessage_ = "PLY file ends inside the face data\n";
+                        return false;
+                    }
+
+                    if (i == faceList)
+                    {
+                        polygon.resize(count);
+                        for (std::size_t j{0}; j < count; ++j)
+                        {
+                            const double index{Detail::readValue(
+                                stream.data() + j * itemSize, property.type,
+                                swap)};
+                            if (!(index >= 0.0) ||
+                                index >= static_cast<double>(vertexCount))
+                            {
+                                errorMessage_ =
+                                    "PLY face " + std::to_string(face) +
+                                    " has an invalid vertex index\n";
+                                return false;
+                            }
+                            polygon[j] = static_cast<IndexType>(index);
+                        }
+
+                        // Triangle fan, the same as the OBJ loader.
+                        for (std::size_t j{2}; j < count; ++j)
+                        {
+                            if (indices.size() + 3 > indices.capacity())
+                            {
+                                flush();
+                            }
+                            indices.push_back(polygon[0]);
+                            indices.push_back(polygon[j - 1]);
+                            indices.push_back(polygon[j]);
+                        }
+                    }
+                    stream.consume(count * itemSize);
+                }
+            }
+            flush();
+        }
+        else if (element.size)
+        {
+            std::size_t remaining{element.size * element.count};
+            for (; remaining;)
+            {
+                const std::size_t step{std::min(remaining, stream.capacity())};
+                if (!stream.fill(step))
+                {
+                    errorMessage_ = "PLY file ends inside element " +
+                                    element.name + "\n";
+                    return false;
+                }
+                stream.consume(step);
+                remaining -= step;
+            }
+        }
+        else
+        {
+            for (std::size_t i{0}; i < element.count; ++i)
+            {
+                if (!Detail::skipRecord(stream, element, swap))
+                {
+                    errorMessage_ = "PLY file ends inside element " +
+                                    element.name + "\n";
+                    return false;
+                }
+            }
+        }
+    }
+
+    sink.endMesh(indexCount, bounds);
+
+    statistics_.loadMilliseconds = stopwatch.elapsedMilliseconds();
+    statistics_.peakResidentSetSize = Performance::PeakResidentSetSize();
+    FileIO::FileStatus status;
+    statistics_.fileSize =
+        FileIO::GetFileStatus(fileName, status) ? status.size : 0;
+    statistics_.vertexCount = vertexCount;
+    statistics_.triangleCount = indexCount / 3;
+
+    return true;
+}
+
+const PlyLoader::Statistics &PlyLoader::statistics() const noexcept
+{
+    return statistics_;
+}
+
+} // namespace Model
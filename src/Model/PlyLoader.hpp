@@ -0,0 +1,43 @@
+#ifndef HOMEWORK01_MODEL_PLYLOADER_HPP_
+#define HOMEWORK01_MODEL_PLYLOADER_HPP_
+
+#include "LoadStatistics.hpp"
+#include "MeshData.hpp"
+#include "MeshSink.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace Model
+{
+
+// Binary PLY reader (little or big endian). After the header, element blocks
+// are read in chunks of about chunkSize bytes and handed to a MeshSink, so
+// host memory stays bounded by the chunk size rather than the file size.
+//
+// The vertex element may carry positions, normals, texture coordinates
+// (u/v, s/t or texture_u/texture_v) and colors (red/green/blue[/alpha]).
+// Faces are read from their vertex_indices (or vertex_index) list and
+// triangulated as fans. Other elements and properties are skipped.
+class PlyLoader
+{
+public:
+    using Statistics = LoadStatistics;
+
+    explicit PlyLoader(std::size_t chunkSize = 4 << 20) noexcept;
+
+    bool load(const char *fileName, MeshData &meshData);
+    bool load(const char *fileName, MeshSink &sink);
+
+    const std::string &errorMessage() const noexcept;
+    const Statistics &statistics() const noexcept;
+
+private:
+    std::string errorMessage_;
+    Statistics statistics_;
+    std::size_t chunkSize_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_PLYLOADER_HPP_
@@ -0,0 +1,502 @@
+#include "StlLoader.hpp"
+
+#include "Detail/TextScan.hpp"
+#include "NormalGenerator.hpp"
+
+#include "Utils/FileIO/MappedFile.hpp"
+#include "Utils/Parallel/ParallelFor.hpp"
+#include "Utils/Performance/MemoryUsage.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Binary STL: an 80 byte header, a little endian triangle count, then one 50
+// byte record per triangle (normal, three vertices, attribute byte count).
+constexpr std::size_t stlHeaderSize{84};
+constexpr std::size_t stlBinaryStride{50};
+// ASCII facets are parsed into the first 48 bytes of the binary layout.
+constexpr std::size_t stlAsciiStride{48};
+
+// Position of one corner, with -0 folded into +0 so that equal values also
+// have equal bits.
+struct StlCorner
+{
+    float position[3];
+};
+
+std::uint32_t readUnsigned(const char *p) noexcept;
+float readFloat(const char *p) noexcept;
+bool isBinaryStl(const char *begin, std::size_t size) noexcept;
+bool matchWord(const char *&p, const char *end, const char *word) noexcept;
+std::size_t parseAsciiStl(const char *begin, const char *end,
+                          std::vector<float> &records);
+void facetNormal(const char *record, float (&normal)[3]) noexcept;
+std::uint32_t hashCorner(const StlCorner &corner) noexcept;
+bool equalCorners(const StlCorner &a, const StlCorner &b) noexcept;
+
+inline std::uint32_t readUnsigned(const char *p) noexcept
+{
+    const unsigned char *bytes{reinterpret_cast<const unsigned char *>(p)};
+    return static_cast<std::uint32_t>(bytes[0]) |
+           static_cast<std::uint32_t>(bytes[1]) << 8 |
+           static_cast<std::uint32_t>(bytes[2]) << 16 |
+           static_cast<std::uint32_t>(bytes[3]) << 24;
+}
+
+inline float readFloat(const char *p) noexcept
+{
+    // Binary records are not aligned and the file is little endian.
+    const std::uint32_t bits{readUnsigned(p)};
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value + 0.0f;
+}
+
+// Many binary files start their header with "solid" as well, so the size is
+// the reliable test.
+inline bool isBinaryStl(const char *begin, std::size_t size) noexcept
+{
+    return size >= stlHeaderSize &&
+           (size - stlHeaderSize) / stlBinaryStride ==
+               readUnsigned(begin + 80) &&
+           (size - stlHeaderSize) % stlBinaryStride == 0;
+}
+
+inline bool matchWord(const char *&p, const char *end, const char *word) noexcept
+{
+    const std::size_t length{std::strlen(word)};
+    if (static_cast<std::size_t>(end - p) < length ||
+        std::memcmp(p, word, length) != 0 ||
+        (p + length < end && !isSpace(p[length]) && !isLineEnd(p[length])))
+    {
+        return false;
+    }
+
+    p += length;
+    return true;
+}
+
+// Parses "facet normal n n n outer loop vertex v v v (x3) endloop endfacet"
+// blocks into records of twelve floats. Returns 0 on success or the line of
+// the first malformed facet.
+std::size_t parseAsciiStl(const char *begin, const char *end,
+                          std::vector<float> &records)
+{
+    const char *p{skipLine(skipWhitespace(begin, end), end)};
+
+    while ((p = skipWhitespace(p, end)) < end)
+    {
+        if (matchWord(p, end, "endsolid"))
+        {
+            // Files that concatenate several solids continue after this.
+            p = skipLine(p, end);
+            p = skipWhitespace(p, end);
+            if (!matchWord(p, end, "solid"))
+            {
+                break;
+            }
+            p = skipLine(p, end);
+            continue;
+        }
+
+        const char *facet{p};
+        float record[12];
+        bool valid{matchWord(p, end, "facet") &&
+                   (p = skipWhitespace(p, end), matchWord(p, end, "normal")) &&
+                   parseFloat(p, end, record[0]) &&
+                   parseFloat(p, end, record[1]) &&
+                   parseFloat(p, end, record[2]) &&
+                   (p = skipWhitespace(p, end), matchWord(p, end, "outer")) &&
+                   (p = skipWhitespace(p, end), matchWord(p, end, "loop"))};
+
+        for (std::size_t i{3}; valid && i < 12; i += 3)
+        {
+            p = skipWhitespace(p, end);
+            valid = matchWord(p, end, "vertex") &&
+                    parseFloat(p, end, record[i]) &&
+                    parseFloat(p, end, record[i + 1]) &&
+                    parseFloat(p, end, record[i + 2]);
+        }
+
+        valid = valid &&
+                (p = skipWhitespace(p, end), matchWord(p, end, "endloop")) &&
+                (p = skipWhitespace(p, end), matchWord(p, end, "endfacet"));
+
+        if (!valid)
+        {
+            return static_cast<std::size_t>(
+                       std::count(begin, facet, '\n')) +
+                   1;
+        }
+
+        records.insert(records.end(), record, record + 12);
+    }
+
+    return 0;
+}
+
+// Exporters often leave the stored normal zero or stale, so it is only used
+// when it has unit length and faces the side the winding does; it is then
+// exact where the cross product of a sliver is not. Otherwise the winding
+// decides.
+inline void facetNormal(const char *record, float (&normal)[3]) noexcept
+{
+    float vertex[3][3];
+    for (std::size_t i{0}; i < 3; ++i)
+    {
+        for (std::size_t j{0}; j < 3; ++j)
+        {
+            vertex[i][j] = readFloat(record + 12 * (i + 1) + 4 * j);
+        }
+    }
+
+    const float e1[3]{vertex[1][0] - vertex[0][0], vertex[1][1] - vertex[0][1],
+                      vertex[1][2] - vertex[0][2]};
+    const float e2[3]{vertex[2][0] - vertex[0][0], vertex[2][1] - vertex[0][1],
+                      vertex[2][2] - vertex[0][2]};
+    const float n[3]{e1[1] * e2[2] - e1[2] * e2[1],
+                     e1[2] * e2[0] - e1[0] * e2[2],
+                     e1[0] * e2[1] - e1[1] * e2[0]};
+    const float length{std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2])};
+    const bool wound{length > 0.0f && std::isfinite(length)};
+
+    const float stored[3]{readFloat(record), readFloat(record + 4),
+                          readFloat(record + 8)};
+    const float storedLength{std::sqrt(stored[0] * stored[0] +
+                                       stored[1] * stored[1] +
+                                       stored[2] * stored[2])};
+    const float facing{stored[0] * n[0] + stored[1] * n[1] +
+                       stored[2] * n[2]};
+    const bool useStored{std::fabs(storedLength - 1.0f) < 1e-3f &&
+                         (!wound || facing > 0.0f)};
+
+    const float *source{useStored ? stored : n};
+    const float scale{useStored ? 1.0f / storedLength
+                      : wound   ? 1.0f / length
+                                : 0.0f};
+    for (std::size_t j{0}; j < 3; ++j)
+    {
+        normal[j] = source[j] * scale + 0.0f;
+    }
+}
+
+inline std::uint32_t hashCorner(const StlCorner &corner) noexcept
+{
+    std::uint32_t words[3];
+    std::memcpy(words, &corner, sizeof(words));
+
+    std::uint64_t value{0x9E3779B97F4A7C15ull};
+    for (std::uint32_t word : words)
+    {
+        value = (value ^ word) * 0xFF51AFD7ED558CCDull;
+        value ^= value >> 32;
+    }
+    value *= 0xC4CEB9FE1A85EC53ull;
+    return static_cast<std::uint32_t>(value >> 32);
+}
+
+inline bool equalCorners(const StlCorner &a, const StlCorner &b) noexcept
+{
+    return std::memcmp(&a, &b, sizeof(StlCorner)) == 0;
+}
+
+} // namespace Detail
+
+StlLoader::StlLoader(unsigned int threadCount, float creaseAngle) noexcept
+    : errorMessage_{}, statistics_{0.0, 0, 0, 0, 0, 0},
+      threadCount_{threadCount}, creaseAngle_{creaseAngle}
+{
+}
+
+const std::string &StlLoader::errorMessage() const noexcept
+{
+    return errorMessage_;
+}
+
+bool StlLoader::load(const char *fileName, MeshData &meshData)
+{
+    Performance::Stopwatch stopwatch;
+
+    errorMessage_.clear();
+    statistics_ = Statistics{0.0, 0, 0, 0, 0, 0};
+    meshData.clear();
+
+    FileIO::MappedFile file;
+    if (!file.open(fileName))
+    {
+        errorMessage_ = std::string{"Cannot open STL file: "} + fileName;
+        return false;
+    }
+
+    bool success{false};
+
+    if (Detail::isBinaryStl(file.data(), file.size()))
+    {
+        success = weld(file.data() + Detail::stlHeaderSize,
+                       Detail::stlBinaryStride,
+                       Detail::readUnsigned(file.data() + 80), meshData);
+    }
+    else
+    {
+        const char *p{Detail::skipWhitespace(file.begin(), file.end())};
+        if (!Detail::matchWord(p, file.end(), "solid"))
+        {
+            errorMessage_ =
+                std::string{"Not a binary or ASCII STL file: "} + fileName;
+            return false;
+        }
+
+        std::vector<float> records;
+        const std::size_t errorLine{
+            Detail::parseAsciiStl(file.begin(), file.end(), records)};
+        if (errorLine)
+        {
+            errorMessage_ = "Malformed STL facet at line " +
+                            std::to_string(errorLine) + "\n";
+            return false;
+        }
+
+        success = weld(reinterpret_cast<const char *>(records.data()),
+                       Detail::stlAsciiStride, records.size() / 12, meshData);
+    }
+
+    statistics_.loadMilliseconds = stopwatch.elapsedMilliseconds();
+    statistics_.peakResidentSetSize = Performance::PeakResidentSetSize();
+    statistics_.fileSize = file.size();
+    statistics_.vertexCount = meshData.vertexCount();
+    statistics_.triangleCount = meshData.triangleCount();
+    statistics_.threadCount = Parallel::ResolveThreadCount(threadCount_);
+
+    if (!success)
+    {
+        meshData.clear();
+    }
+
+    return success;
+}
+
+const StlLoader::Statistics &StlLoader::statistics() const noexcept
+{
+    return statistics_;
+}
+
+bool StlLoader::weld(const char *records, std::size_t stride,
+                     std::size_t triangleCount, MeshData &meshData)
+{
+    using IndexType = MeshData::IndexType;
+
+    const std::size_t cornerCount{3 * triangleCount};
+    if (cornerCount > std::numeric_limits<IndexType>::max())
+    {
+        errorMessage_ = "STL file has too many triangles\n";
+        return false;
+    }
+
+    const unsigned int threadCount{Parallel::ResolveThreadCount(threadCount_)};
+
+    // Fixed size blocks keep the block layout, and with it the result,
+    // independent of the thread count.
+    const std::size_t blockSize{1 << 16};
+    const std::size_t blockCount{(cornerCount + blockSize - 1) / blockSize};
+
+    // Facet normals and corner hashes. Corner positions are read back from
+    // the records when needed rather than copied; facet normals only enter
+    // the vertex normals generated after the weld.
+    std::vector<float> facetNormals(3 * triangleCount);
+    std::vector<std::uint32_t> hashes(cornerCount);
+
+    const auto cornerAt = [&](std::size_t i) {
+        const char *record{records + i / 3 * stride + 12 * (i % 3 + 1)};
+        Detail::StlCorner corner;
+        for (std::size_t j{0}; j < 3; ++j)
+        {
+            corner.position[j] = Detail::readFloat(record + 4 * j);
+        }
+        return corner;
+    };
+
+    Parallel::ParallelFor(blockCount, threadCount, [&](std::size_t block) {
+        const std::size_t first{block * blockSize / 3};
+        const std::size_t last{
+            std::min(triangleCount, (block + 1) * blockSize / 3)};
+
+        for (std::size_t triangle{first}; triangle < last; ++triangle)
+        {
+            float normal[3];
+            Detail::facetNormal(records + triangle * stride, normal);
+            std::memcpy(&facetNormals[3 * triangle], normal, sizeof(normal));
+
+            for (std::size_t i{3 * triangle}; i < 3 * triangle + 3; ++i)
+            {
+                hashes[i] = Detail::hashCorner(cornerAt(i));
+            }
+        }
+    });
+
+    // Spatial hash partitions: the top bits of the hash pick the partition,
+    // so equal corners always meet in the same one. Partitions of a few ten
+    // thousand corners keep each weld table in cache, and the partition count
+    // again only depends on the input.
+    unsigned int partitionBits{0};
+    while (partitionBits < 12 &&
+           (std::size_t{1} << partitionBits) * (1 << 15) < cornerCount)
+    {
+        ++partitionBits;
+    }
+    const std::size_t partitionCount{std::size_t{1} << partitionBits};
+    const auto partitionOf = [partitionBits](std::uint32_t hash) {
+        return partitionBits ? static_cast<std::size_t>(hash >>
+                                                        (32 - partitionBits))
+                             : std::size_t{0};
+    };
+
+    // Counting sort of corner ids by partition, stable in corner order.
+    std::vector<IndexType> offsets(blockCount * partitionCount);
+    Parallel::ParallelFor(blockCount, threadCount, [&](std::size_t block) {
+        IndexType *counts{offsets.data() + block * partitionCount};
+        const std::size_t last{std::min(cornerCount, (block + 1) * blockSize)};
+        for (std::size_t i{block * blockSize}; i < last; ++i)
+        {
+            ++counts[partitionOf(hashes[i])];
+        }
+    });
+
+    std::vector<std::size_t> partitionBegin(partitionCount + 1);
+    std::size_t offset{0};
+    for (std::size_t partition{0}; partition < partitionCount; ++partition)
+    {
+        partitionBegin[partition] = offset;
+        for (std::size_t block{0}; block < blockCount; ++block)
+        {
+            IndexType &count{offsets[block * partitionCount + partition]};
+            const std::size_t blockOffset{offset};
+            offset += count;
+            count = static_cast<IndexType>(blockOffset);
+        }
+    }
+    partitionBegin[partitionCount] = offset;
+
+    std::vector<IndexType> order(cornerCount);
+    Parallel::ParallelFor(blockCount, threadCount, [&](std::size_t block) {
+        IndexType *next{offsets.data() + block * partitionCount};
+        const std::size_t last{std::min(cornerCount, (block + 1) * blockSize)};
+        for (std::size_t i{block * blockSize}; i < last; ++i)
+        {
+            order[next[partitionOf(hashes[i])]++] = static_cast<IndexType>(i);
+        }
+    });
+
+    // Weld every partition on its own. Each corner records the first corner
+    // with the same key, which owns the welded vertex.
+    std::vector<IndexType> owners(cornerCount);
+    Parallel::ParallelFor(partitionCount, threadCount,
+                          [&](std::size_t partition) {
+        const std::size_t begin{partitionBegin[partition]};
+        const std::size_t end{partitionBegin[partition + 1]};
+
+        std::size_t capacity{16};
+        while (capacity < 2 * (end - begin))
+        {
+            capacity <<= 1;
+        }
+        const std::size_t mask{capacity - 1};
+        const IndexType empty{std::numeric_limits<IndexType>::max()};
+        std::vector<IndexType> table(capacity, empty);
+
+        for (std::size_t i{begin}; i < end; ++i)
+        {
+            const IndexType corner{order[i]};
+            const Detail::StlCorner key{cornerAt(corner)};
+            for (std::size_t slot{hashes[corner] & mask};;
+                 slot = (slot + 1) & mask)
+            {
+                if (table[slot] == empty)
+                {
+                    table[slot] = corner;
+                    owners[corner] = corner;
+                    break;
+                }
+                if (hashes[table[slot]] == hashes[corner] &&
+                    Detail::equalCorners(cornerAt(table[slot]), key))
+                {
+                    owners[corner] = table[slot];
+                    break;
+                }
+            }
+        }
+    });
+
+    // Number the owners in corner order, then point every corner at the
+    // number of its owner. An owner never comes after its corners.
+    std::vector<std::size_t> blockVertices(blockCount + 1);
+    Parallel::ParallelFor(blockCount, threadCount, [&](std::size_t block) {
+        const std::size_t last{std::min(cornerCount, (block + 1) * blockSize)};
+        std::size_t count{0};
+        for (std::size_t i{block * blockSize}; i < last; ++i)
+        {
+            count += (owners[i] == i);
+        }
+        blockVertices[block + 1] = count;
+    });
+    for (std::size_t block{0}; block < blockCount; ++block)
+    {
+        blockVertices[block + 1] += blockVertices[block];
+    }
+
+    const std::size_t vertexCount{blockVertices[blockCount]};
+    meshData.positions.resize(3 * vertexCount);
+    meshData.indices.resize(cornerCount);
+
+    Parallel::ParallelFor(blockCount, threadCount, [&](std::size_t block) {
+        const std::size_t last{std::min(cornerCount, (block + 1) * blockSize)};
+        std::size_t vertex{blockVertices[block]};
+        for (std::size_t i{block * blockSize}; i < last; ++i)
+        {
+            if (owners[i] == i)
+            {
+                const Detail::StlCorner corner{cornerAt(i)};
+                std::memcpy(&meshData.positions[3 * vertex], corner.position,
+                            sizeof(corner.position));
+                meshData.indices[i] = static_cast<IndexType>(vertex++);
+            }
+        }
+    });
+
+    // Owner entries are read by other blocks, so only the corners they own
+    // are written.
+    Parallel::ParallelFor(blockCount, threadCount, [&](std::size_t block) {
+        const std::size_t last{std::min(cornerCount, (block + 1) * blockSize)};
+        for (std::size_t i{block * blockSize}; i < last; ++i)
+        {
+            if (owners[i] != i)
+            {
+                meshData.indices[i] = meshData.indices[owners[i]];
+            }
+        }
+    });
+
+    // Splits the vertices at creases, where the facets around one position
+    // do not share a normal.
+    NormalGenerator generator{NormalWeighting::AreaAngle, creaseAngle_,
+                              threadCount_};
+    generator.generate(meshData, facetNormals.data());
+
+    meshData.updateBounds();
+    meshData.subMeshes.push_back(
+        SubMesh{0, static_cast<std::uint32_t>(cornerCount), -1});
+
+    return true;
+}
+
+} // namespace Model
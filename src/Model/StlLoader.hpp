@@ -0,0 +1,49 @@
+#ifndef HOMEWORK01_MODEL_STLLOADER_HPP_
+#define HOMEWORK01_MODEL_STLLOADER_HPP_
+
+#include "LoadStatistics.hpp"
+#include "MeshData.hpp"
+
+#include <cstddef>
+#include <string>
+
+namespace Model
+{
+
+// Binary and ASCII STL reader. Binary files are read through a mapped view;
+// ASCII files are first parsed into the same record layout. The triangle
+// soup is then welded into an indexed mesh on up to threadCount threads
+// (0 = every hardware thread): corners are partitioned by the hash of their
+// position, every partition is welded independently, and vertices are
+// numbered by first occurrence so the result does not depend on the thread
+// count.
+//
+// Corners merge when their positions match bit for bit. Vertex normals
+// average the facet normals around a vertex, and vertices where facets meet
+// at more than creaseAngle degrees are split so that edges stay sharp.
+class StlLoader
+{
+public:
+    using Statistics = LoadStatistics;
+
+    explicit StlLoader(unsigned int threadCount = 0,
+                       float creaseAngle = 60.0f) noexcept;
+
+    bool load(const char *fileName, MeshData &meshData);
+
+    const std::string &errorMessage() const noexcept;
+    const Statistics &statistics() const noexcept;
+
+private:
+    bool weld(const char *records, std::size_t stride,
+              std::size_t triangleCount, MeshData &meshData);
+
+    std::string errorMessage_;
+    Statistics statistics_;
+    unsigned int threadCount_;
+    float creaseAngle_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_STLLOADER_HPP_
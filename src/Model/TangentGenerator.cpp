@@ -0,0 +1,331 @@
+#include "TangentGenerator.hpp"
+
+#include "Utils/Parallel/ParallelFor.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+#include "glm/geometric.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Work items of the parallel passes; inputs of one block run on the calling
+// thread.
+constexpr std::size_t tangentBlockTriangles{1u << 14};
+constexpr std::size_t tangentBlockVertices{1u << 14};
+
+// Vertices split by one block of the resolve pass and the tangents of the
+// corners they take over.
+struct TangentSplits
+{
+    std::vector<MeshData::IndexType> vertices;
+    std::vector<float> tangents;
+};
+
+glm::vec3 streamVector3(const std::vector<float> &stream,
+                        std::size_t vertex) noexcept;
+glm::vec3 tangentPlaneProjection(const glm::vec3 &normal,
+                                 const glm::vec3 &vector) noexcept;
+glm::vec3 anyTangent(const glm::vec3 &normal) noexcept;
+float projectedCornerAngle(const glm::vec3 &normal, const glm::vec3 &u,
+                           const glm::vec3 &v) noexcept;
+
+inline glm::vec3 streamVector3(const std::vector<float> &stream,
+                               std::size_t vertex) noexcept
+{
+    return glm::vec3{stream[3 * vertex], stream[3 * vertex + 1],
+                     stream[3 * vertex + 2]};
+}
+
+// vector with its component along the unit normal removed.
+inline glm::vec3 tangentPlaneProjection(const glm::vec3 &normal,
+                                        const glm::vec3 &vector) noexcept
+{
+    return vector - normal * glm::dot(normal, vector);
+}
+
+// Unit vector perpendicular to normal, for vertices no triangle votes for.
+inline glm::vec3 anyTangent(const glm::vec3 &normal) noexcept
+{
+    const glm::vec3 axis{std::abs(normal.x) < 0.9f ? glm::vec3{1, 0, 0}
+                                                   : glm::vec3{0, 1, 0}};
+    return glm::normalize(tangentPlaneProjection(normal, axis));
+}
+
+// Angle between the edges u and v once both are projected into the tangent
+// plane, the corner weight MikkTSpace uses.
+inline float projectedCornerAngle(const glm::vec3 &normal, const glm::vec3 &u,
+                                  const glm::vec3 &v) noexcept
+{
+    const glm::vec3 a{tangentPlaneProjection(normal, u)};
+    const glm::vec3 b{tangentPlaneProjection(normal, v)};
+    const float lengths{std::sqrt(glm::dot(a, a) * glm::dot(b, b))};
+    return lengths > 0.0f
+               ? std::acos(glm::clamp(glm::dot(a, b) / lengths, -1.0f, 1.0f))
+               : 0.0f;
+}
+
+} // namespace Detail
+
+TangentGenerator::TangentGenerator(unsigned int threadCount) noexcept
+    : threadCount_{threadCount}, statistics_{}, faceTangents_{},
+      faceSigns_{}, vertexOffsets_{}, vertexCorners_{}, vertexSigns_{}
+{
+}
+
+bool TangentGenerator::generate(MeshData &meshData)
+{
+    Performance::Stopwatch stopwatch;
+
+    const std::size_t vertexCount{meshData.vertexCount()};
+    const std::size_t triangleCount{meshData.triangleCount()};
+    statistics_ = Statistics{triangleCount, 0, 0, 0.0};
+
+    if (meshData.normals.size() != 3 * vertexCount ||
+        meshData.textureCoordinates.size() != 2 * vertexCount)
+    {
+        statistics_.triangleCount = 0;
+        return false;
+    }
+
+    meshData.tangents.assign(4 * vertexCount, 0.0f);
+
+    faceTangents_.resize(3 * triangleCount);
+    faceSigns_.resize(triangleCount);
+    const std::size_t faceBlocks{
+        (triangleCount + Detail::tangentBlockTriangles - 1) /
+        Detail::tangentBlockTriangles};
+    Parallel::ParallelFor(faceBlocks, threadCount_, [&](std::size_t block) {
+        const std::size_t first{block * Detail::tangentBlockTriangles};
+        const std::size_t last{std::min(
+            first + Detail::tangentBlockTriangles, triangleCount)};
+        faceTangents(meshData, first, last);
+    });
+    statistics_.degenerateTriangleCount = static_cast<std::size_t>(
+        std::count(faceSigns_.begin(), faceSigns_.end(), 0));
+
+    // Corners of every vertex, in index order.
+    vertexOffsets_.assign(vertexCount + 1, 0);
+    for (const MeshData::IndexType index : meshData.indices)
+    {
+        ++vertexOffsets_[index + 1];
+    }
+    std::partial_sum(vertexOffsets_.begin(), vertexOffsets_.end(),
+                     vertexOffsets_.begin());
+    vertexCorners_.resize(meshData.indices.size());
+    {
+        std::vector<std::uint32_t> next(vertexOffsets_.begin(),
+                                        vertexOffsets_.end() - 1);
+        for (std::size_t i{0}; i < meshData.indices.size(); ++i)
+        {
+            vertexCorners_[next[meshData.indices[i]]++] =
+                static_cast<std::uint32_t>(i);
+        }
+    }
+
+    // Tangents of the existing vertices; each block lists the vertices it
+    // splits, which are numbered in block order afterwards.
+    vertexSigns_.resize(vertexCount);
+    const std::size_t vertexBlocks{
+        (vertexCount + Detail::tangentBlockVertices - 1) /
+        Detail::tangentBlockVertices};
+    std::vector<Detail::TangentSplits> splits(vertexBlocks);
+    Parallel::ParallelFor(vertexBlocks, threadCount_, [&](std::size_t block) {
+        const std::size_t first{block * Detail::tangentBlockVertices};
+        const std::size_t last{
+            std::min(first + Detail::tangentBlockVertices, vertexCount)};
+        resolve(meshData, first, last, splits[block].vertices,
+                splits[block].tangents);
+    });
+
+    std::vector<std::size_t> blockVertices(vertexBlocks + 1, 0);
+    for (std::size_t block{0}; block < vertexBlocks; ++block)
+    {
+        blockVertices[block + 1] =
+            blockVertices[block] + splits[block].vertices.size();
+    }
+    const std::size_t addedCount{blockVertices.back()};
+    if (addedCount)
+    {
+        // Corners of the orientation a vertex does not keep move to its
+        // split copy.
+        Parallel::ParallelFor(
+            vertexBlocks, threadCount_, [&](std::size_t block) {
+            const std::vector<MeshData::IndexType> &vertices{
+                splits[block].vertices};
+            for (std::size_t i{0}; i < vertices.size(); ++i)
+            {
+                const MeshData::IndexType vertex{vertices[i]};
+                const MeshData::IndexType split{static_cast<
+                    MeshData::IndexType>(vertexCount + blockVertices[block] +
+                                         i)};
+                for (std::uint32_t j{vertexOffsets_[vertex]};
+                     j < vertexOffsets_[vertex + 1]; ++j)
+                {
+                    const std::uint32_t corner{vertexCorners_[j]};
+                    const std::int8_t sign{faceSigns_[corner / 3]};
+                    if (sign && sign != vertexSigns_[vertex])
+                    {
+                        meshData.indices[corner] = split;
+                    }
+                }
+            }
+        });
+
+        std::vector<MeshData::IndexType> sources;
+        sources.reserve(addedCount);
+        for (const Detail::TangentSplits &block : splits)
+        {
+            sources.insert(sources.end(), block.vertices.begin(),
+                           block.vertices.end());
+        }
+        meshData.duplicateVertices(sources);
+        float *tangents{meshData.tangents.data() + 4 * vertexCount};
+        for (const Detail::TangentSplits &block : splits)
+        {
+            tangents = std::copy(block.tangents.begin(), block.tangents.end(),
+                                 tangents);
+        }
+    }
+
+    statistics_.splitVertexCount = addedCount;
+    statistics_.generateMilliseconds = stopwatch.elapsedMilliseconds();
+    return true;
+}
+
+const TangentGenerator::Statistics &
+TangentGenerator::statistics() const noexcept
+{
+    return statistics_;
+}
+
+void TangentGenerator::faceTangents(const MeshData &meshData,
+                                    std::size_t firstTriangle,
+                                    std::size_t lastTriangle) noexcept
+{
+    const std::vector<float> &positions{meshData.positions};
+    const std::vector<float> &coordinates{meshData.textureCoordinates};
+    for (std::size_t t{firstTriangle}; t < lastTriangle; ++t)
+    {
+        const MeshData::IndexType *triangle{meshData.indices.data() + 3 * t};
+        const glm::vec3 p0{Detail::streamVector3(positions, triangle[0])};
+        const glm::vec2 t0{coordinates[2 * triangle[0]],
+                           coordinates[2 * triangle[0] + 1]};
+        const glm::vec3 d1{Detail::streamVector3(positions, triangle[1]) -
+                           p0};
+        const glm::vec3 d2{Detail::streamVector3(positions, triangle[2]) -
+                           p0};
+        const glm::vec2 t1{glm::vec2{coordinates[2 * triangle[1]],
+                                     coordinates[2 * triangle[1] + 1]} -
+                           t0};
+        const glm::vec2 t2{glm::vec2{coordinates[2 * triangle[2]],
+                                     coordinates[2 * triangle[2] + 1]} -
+                           t0};
+
+        // d1 = s * t1.x + b * t1.y and d2 = s * t2.x + b * t2.y solved for
+        // s, up to the twice signed texture space area it is divided by.
+        const float signedArea{t1.x * t2.y - t1.y * t2.x};
+        const glm::vec3 s{t2.y * d1 - t1.y * d2};
+        const float length{glm::length(s)};
+
+        float *out{faceTangents_.data() + 3 * t};
+        if (!(std::abs(signedArea) > 0.0f) || !(length > 0.0f))
+        {
+            out[0] = out[1] = out[2] = 0.0f;
+            faceSigns_[t] = 0;
+            continue;
+        }
+        const float sign{signedArea > 0.0f ? 1.0f : -1.0f};
+        out[0] = sign * s.x / length;
+        out[1] = sign * s.y / length;
+        out[2] = sign * s.z / length;
+        faceSigns_[t] = signedArea > 0.0f ? 1 : -1;
+    }
+}
+
+void TangentGenerator::resolve(MeshData &meshData, std::size_t firstVertex,
+                               std::size_t lastVertex,
+                               std::vector<MeshData::IndexType> &splitVertices,
+                               std::vector<float> &splitTangents) noexcept
+{
+    const std::vector<float> &positions{meshData.positions};
+    const MeshData::IndexType *indices{meshData.indices.data()};
+    for (std::size_t vertex{firstVertex}; vertex < lastVertex; ++vertex)
+    {
+        glm::vec3 normal{Detail::streamVector3(meshData.normals, vertex)};
+        const float normalLength{glm::length(normal)};
+        normal = normalLength > 0.0f ? normal / normalLength
+                                     : glm::vec3{0, 0, 1};
+        const glm::vec3 position{Detail::streamVector3(positions, vertex)};
+
+        // Sums of the unmirrored [0] and mirrored [1] corners.
+        glm::vec3 sums[2]{glm::vec3{0.0f}, glm::vec3{0.0f}};
+        float angles[2]{0.0f, 0.0f};
+        bool voted[2]{false, false};
+        for (std::uint32_t j{vertexOffsets_[vertex]};
+             j < vertexOffsets_[vertex + 1]; ++j)
+        {
+            const std::uint32_t corner{vertexCorners_[j]};
+            const std::int8_t sign{faceSigns_[corner / 3]};
+            if (!sign)
+            {
+                continue;
+            }
+            const std::size_t side{sign > 0 ? 0u : 1u};
+            voted[side] = true;
+
+            const glm::vec3 projected{Detail::tangentPlaneProjection(
+                normal,
+                Detail::streamVector3(faceTangents_, corner / 3))};
+            const float length{glm::length(projected)};
+            if (!(length > 0.0f))
+            {
+                continue;
+            }
+            const std::uint32_t base{corner - corner % 3};
+            const float angle{Detail::projectedCornerAngle(
+                normal,
+                Detail::streamVector3(positions,
+                                      indices[base + (corner + 1) % 3]) -
+                    position,
+                Detail::streamVector3(positions,
+                                      indices[base + (corner + 2) % 3]) -
+                    position)};
+            sums[side] += (angle / length) * projected;
+            angles[side] += angle;
+        }
+
+        // The orientation covering the larger angle keeps the vertex.
+        const std::size_t kept{
+            voted[1] && (!voted[0] || angles[1] > angles[0]) ? 1u : 0u};
+        vertexSigns_[vertex] = kept ? -1 : 1;
+
+        const auto frame = [&](std::size_t side, float *out) {
+            const float length{glm::length(sums[side])};
+            const glm::vec3 tangent{length > 0.0f
+                                        ? sums[side] / length
+                                        : Detail::anyTangent(normal)};
+            out[0] = tangent.x;
+            out[1] = tangent.y;
+            out[2] = tangent.z;
+            out[3] = side ? -1.0f : 1.0f;
+        };
+        frame(kept, meshData.tangents.data() + 4 * vertex);
+        if (voted[0] && voted[1])
+        {
+            splitVertices.push_back(static_cast<MeshData::IndexType>(vertex));
+            splitTangents.resize(splitTangents.size() + 4);
+            frame(1 - kept, splitTangents.data() + splitTangents.size() - 4);
+        }
+    }
+}
+
+} // namespace Model
@@ -0,0 +1,77 @@
+#ifndef HOMEWORK01_MODEL_TANGENTGENERATOR_HPP_
+#define HOMEWORK01_MODEL_TANGENTGENERATOR_HPP_
+
+#include "MeshData.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Model
+{
+
+struct TangentGeneratorStatistics
+{
+    std::size_t triangleCount;
+    // Triangles whose texture coordinates span no area and so do not vote.
+    std::size_t degenerateTriangleCount;
+    // Vertices added where triangles of mirrored and unmirrored texture
+    // space meet.
+    std::size_t splitVertexCount;
+    double generateMilliseconds;
+};
+
+// Computes tangent frames for normal mapping, following the MikkTSpace
+// formulation so baked normal maps line up: every triangle contributes its
+// texture space s direction, projected into the tangent plane of the vertex
+// normal and weighted by the corner angle, and the bitangent sign comes from
+// the winding of the triangle in texture space. Vertices shared by mirrored
+// and unmirrored triangles are split. Vertices are the welded ones of the
+// mesh rather than MikkTSpace's own position and normal groups.
+//
+// Both passes run in blocks on up to threadCount threads (0 = every
+// hardware thread). Each vertex sums its corners in index order and split
+// vertices are numbered by block, so the result does not depend on the
+// thread count.
+class TangentGenerator
+{
+public:
+    using Statistics = TangentGeneratorStatistics;
+
+    explicit TangentGenerator(unsigned int threadCount = 0) noexcept;
+
+    // Replaces meshData.tangents. Needs normals and texture coordinates;
+    // without them the mesh is left as it is and false is returned. Split
+    // vertices are appended to every stream and the indices of their
+    // corners rewritten.
+    bool generate(MeshData &meshData);
+
+    const Statistics &statistics() const noexcept;
+
+private:
+    void faceTangents(const MeshData &meshData, std::size_t firstTriangle,
+                      std::size_t lastTriangle) noexcept;
+    void resolve(MeshData &meshData, std::size_t firstVertex,
+                 std::size_t lastVertex,
+                 std::vector<MeshData::IndexType> &splitVertices,
+                 std::vector<float> &splitTangents) noexcept;
+
+    unsigned int threadCount_;
+
+    Statistics statistics_;
+
+    // Unit texture space s direction of every triangle and its orientation:
+    // 1 or -1, or 0 where the texture coordinates are degenerate.
+    std::vector<float> faceTangents_;
+    std::vector<std::int8_t> faceSigns_;
+    // Corners of every vertex, in index order.
+    std::vector<std::uint32_t> vertexOffsets_;
+    std::vector<std::uint32_t> vertexCorners_;
+    // Orientation each vertex keeps; the corners of the other one move to a
+    // split vertex.
+    std::vector<std::int8_t> vertexSigns_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_TANGENTGENERATOR_HPP_
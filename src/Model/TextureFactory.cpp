@@ -1,60 +1,129 @@
-#include "TextureFactory.hpp"
-
-#include "Utils/Compilers.hpp"
-
-PRAGMA_WARNING_PUSH
-PRAGMA_WARNING_DISABLE_DOUBLEPROMOTION
-
-#include "stb_image.h"
-
-PRAGMA_WARNING_POP
-
-namespace Model
-{
-
-namespace Detail
-{
-
-GLenum rgbFormat(int channels) noexcept;
-
-GLenum rgbFormat(int channels) noexcept
-{
-    switch (channels)
-    {
-    case 1:
-        return GL_RED;
-    case 2:
-        return GL_RG;
-    case 4:
-        return GL_RGBA;
-    case 3:
-    default:
-        return GL_RGB;
-    }
-}
-
-} // namespace Detail
-
-std::unique_ptr<OpenGL::OpenGLTexture>
-TextureFactory::loadFromFile(const char *fileName)
-{
-    int width, height, channels;
-    stbi_set_flip_vertically_on_load(true);
-    unsigned char *data{stbi_load(fileName, &width, &height, &channels, 0)};
-
-    if (!data)
-    {
-        return std::unique_ptr<OpenGL::OpenGLTexture>{
-            new OpenGL::OpenGLTexture()};
-    }
-
-    const size_t size{static_cast<size_t>(width * height * channels)};
-
-    std::vector<unsigned char> buffer{data, data + size};
-    stbi_image_free(data);
-
-    return std::unique_ptr<OpenGL::OpenGLTexture>{new OpenGL::OpenGLTexture{
-        width, height, Detail::rgbFormat(channels), buffer}};
-}
-
-} // namespace Model
+#include "TextureFactory.hpp"
+
+#include "Utils/Compilers.hpp"
+#include "Utils/Parallel/ParallelFor.hpp"
+
+PRAGMA_WARNING_PUSH
+PRAGMA_WARNING_DISABLE_DOUBLEPROMOTION
+
+#include "stb_image.h"
+
+PRAGMA_WARNING_POP
+
+#include <vector>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+GLenum rgbFormat(int channels) noexcept;
+std::unique_ptr<OpenGL::OpenGLTexture> createTexture(unsigned char *data,
+                                                     int width, int height,
+                                                     int channels);
+
+GLenum rgbFormat(int channels) noexcept
+{
+    switch (channels)
+    {
+    case 1:
+        return GL_RED;
+    case 2:
+        return GL_RG;
+    case 4:
+        return GL_RGBA;
+    case 3:
+    default:
+        return GL_RGB;
+    }
+}
+
+// Takes ownership of stb image data.
+std::unique_ptr<OpenGL::OpenGLTexture> createTexture(unsigned char *data,
+                                                     int width, int height,
+                                                     int channels)
+{
+    if (!data)
+    {
+        return std::unique_ptr<OpenGL::OpenGLTexture>{
+            new OpenGL::OpenGLTexture()};
+    }
+
+    const size_t size{static_cast<size_t>(width * height * channels)};
+
+    std::vector<unsigned char> buffer{data, data + size};
+    stbi_image_free(data);
+
+    return std::unique_ptr<OpenGL::OpenGLTexture>{new OpenGL::OpenGLTexture{
+        width, height, rgbFormat(channels), buffer}};
+}
+
+} // namespace Detail
+
+std::unique_ptr<OpenGL::OpenGLTexture> TextureFactory::createWhite()
+{
+    const std::vector<unsigned char> buffer(4, 255);
+
+    return std::unique_ptr<OpenGL::OpenGLTexture>{
+        new OpenGL::OpenGLTexture{1, 1, GL_RGBA, buffer}};
+}
+
+std::unique_ptr<OpenGL::OpenGLTexture>
+TextureFactory::loadFromFile(const char *fileName, bool flipVertically)
+{
+    int width, height, channels;
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
+    unsigned char *data{stbi_load(fileName, &width, &height, &channels, 0)};
+
+    return Detail::createTexture(data, width, height, channels);
+}
+
+std::vector<std::unique_ptr<OpenGL::OpenGLTexture>>
+TextureFactory::loadFromFiles(const std::vector<std::string> &fileNames,
+                              bool flipVertically, unsigned int threadCount)
+{
+    struct Image
+    {
+        unsigned char *data;
+        int width;
+        int height;
+        int channels;
+    };
+
+    // Decoding dominates; only the upload needs the GL context.
+    std::vector<Image> images(fileNames.size(), Image{nullptr, 0, 0, 0});
+    Parallel::ParallelFor(
+        fileNames.size(), threadCount, [&](std::size_t i) {
+            Image &image{images[i]};
+            stbi_set_flip_vertically_on_load_thread(flipVertically);
+            image.data = stbi_load(fileNames[i].c_str(), &image.width,
+                                   &image.height, &image.channels, 0);
+        });
+
+    std::vector<std::unique_ptr<OpenGL::OpenGLTexture>> textures;
+    textures.reserve(images.size());
+    for (const Image &image : images)
+    {
+        textures.push_back(image.data ? Detail::createTexture(
+                                            image.data, image.width,
+                                            image.height, image.channels)
+                                      : nullptr);
+    }
+
+    return textures;
+}
+
+std::unique_ptr<OpenGL::OpenGLTexture>
+TextureFactory::loadFromMemory(const unsigned char *data, std::size_t size,
+                               bool flipVertically)
+{
+    int width, height, channels;
+    stbi_set_flip_vertically_on_load_thread(flipVertically);
+    unsigned char *image{stbi_load_from_memory(
+        data, static_cast<int>(size), &width, &height, &channels, 0)};
+
+    return Detail::createTexture(image, width, height, channels);
+}
+
+} // namespace Model
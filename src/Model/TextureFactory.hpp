@@ -1,20 +1,38 @@
-#ifndef HOMEWORK01_MODEL_TEXTUREFACTORY_HPP_
-#define HOMEWORK01_MODEL_TEXTUREFACTORY_HPP_
-
-#include "OpenGL/OpenGLTexture.hpp"
-
-#include <memory>
-
-namespace Model
-{
-
-class TextureFactory
-{
-public:
-    static std::unique_ptr<OpenGL::OpenGLTexture>
-    loadFromFile(const char *fileName);
-};
-
-} // namespace Model
-
-#endif // HOMEWORK01_MODEL_TEXTUREFACTORY_HPP_
+#ifndef HOMEWORK01_MODEL_TEXTUREFACTORY_HPP_
+#define HOMEWORK01_MODEL_TEXTUREFACTORY_HPP_
+
+#include "OpenGL/OpenGLTexture.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Model
+{
+
+class TextureFactory
+{
+public:
+    // Images are flipped by default so that their first row ends up at
+    // t = 1, which is what OBJ texture coordinates expect. glTF coordinates
+    // start at the top row and need no flip.
+    static std::unique_ptr<OpenGL::OpenGLTexture>
+    loadFromFile(const char *fileName, bool flipVertically = true);
+    // Decodes an encoded image (PNG, JPEG, ...) held in memory.
+    static std::unique_ptr<OpenGL::OpenGLTexture>
+    loadFromMemory(const unsigned char *data, std::size_t size,
+                   bool flipVertically = true);
+    // Decodes the images on up to threadCount threads (0 = every hardware
+    // thread) and uploads them on the calling thread, which must own the GL
+    // context. Images that cannot be read give a null texture.
+    static std::vector<std::unique_ptr<OpenGL::OpenGLTexture>>
+    loadFromFiles(const std::vector<std::string> &fileNames,
+                  bool flipVertically = true, unsigned int threadCount = 0);
+    // 1x1 opaque white texture, for meshes sampled without an image.
+    static std::unique_ptr<OpenGL::OpenGLTexture> createWhite();
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_TEXTUREFACTORY_HPP_
@@ -0,0 +1,753 @@
+#include "TriangleBvh.hpp"
+
+#include "Utils/Parallel/ParallelFor.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+#include "Utils/Simd/Float4.hpp"
+
+#include "glm/common.hpp"
+#include "glm/geometric.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+// Bins per axis; ranges with fewer triangles use one bin per triangle.
+constexpr std::size_t bvhBinCount{16};
+// Cost of a traversal step in triangle tests: one SIMD test of four boxes
+// costs about two scalar triangle tests.
+constexpr float bvhTraversalCost{2.0f};
+// Largest leaf; the count of a BvhNode child has to hold it.
+constexpr std::size_t bvhLeafTriangles{4};
+// Ranges this small are built as one task, each on one thread.
+constexpr std::size_t bvhTaskTriangles{1u << 15};
+// Ranges larger than this bin and bound their triangles in parallel.
+constexpr std::size_t bvhBlockTriangles{1u << 16};
+// Below this depth splits follow the surface area heuristic, then halve the
+// range, which bounds the depth and so the traversal stack.
+constexpr std::size_t bvhSahDepth{48};
+constexpr std::size_t bvhStackSize{512};
+constexpr std::uint32_t bvhTaskNode{0xffffffffu};
+
+// Node of the binary tree. Leaves have a count and interior nodes none; a
+// node with left bvhTaskNode stands for the root of task right.
+struct BvhBuildNode
+{
+    Bounds bounds;
+    std::uint32_t left;
+    std::uint32_t right;
+    std::uint32_t first;
+    std::uint32_t count;
+};
+
+// A range of the triangle order built into a tree of its own.
+struct BvhTask
+{
+    std::uint32_t node;
+    std::size_t first;
+    std::size_t last;
+    std::size_t depth;
+};
+
+struct BvhBin
+{
+    Bounds bounds;
+    std::size_t count;
+};
+
+using BvhBins = std::array<BvhBin, 3 * bvhBinCount>;
+
+// Box of a triangle. The references themselves are partitioned, so the
+// build streams through them instead of gathering boxes by index.
+struct BvhReference
+{
+    Bounds box;
+    std::uint32_t triangle;
+};
+
+// The references being sorted into leaves.
+struct BvhBuildInput
+{
+    BvhReference *references;
+    unsigned int threadCount;
+};
+
+Bounds emptyBounds() noexcept;
+void grow(Bounds &bounds, const Bounds &other) noexcept;
+void grow(Bounds &bounds, const glm::vec3 &point) noexcept;
+float surfaceArea(const Bounds &bounds) noexcept;
+glm::vec3 centroid(const BvhReference &reference) noexcept;
+void boundBlock(const BvhBuildInput &input, std::size_t first,
+                std::size_t last, Bounds &bounds, Bounds &centroids) noexcept;
+void rangeBounds(const BvhBuildInput &input, std::size_t first,
+                 std::size_t last, Bounds &bounds, Bounds &centroids);
+void binBlock(const BvhBuildInput &input, std::size_t first, std::size_t last,
+              const Bounds &centroids, const glm::vec3 &scale,
+              BvhBins &bins) noexcept;
+BvhBins binRange(const BvhBuildInput &input, std::size_t first,
+                 std::size_t last, const Bounds &centroids,
+                 std::size_t binCount);
+std::uint32_t buildNode(const BvhBuildInput &input, std::size_t first,
+                        std::size_t last, std::size_t depth,
+                        std::vector<BvhBuildNode> &nodes,
+                        std::vector<BvhTask> *tasks);
+std::uint32_t collapse(const std::vector<BvhBuildNode> &nodes,
+                       std::uint32_t node, std::size_t depth,
+                       std::vector<BvhNode> &out,
+                       TriangleBvhStatistics &statistics);
+bool intersectTriangle(const Ray &ray, const float *positions,
+                       const std::uint32_t *triangle, float farthest,
+                       RayHit &hit) noexcept;
+
+inline Bounds emptyBounds() noexcept
+{
+    const float largest{std::numeric_limits<float>::max()};
+    return Bounds{glm::vec3{largest}, glm::vec3{-largest}};
+}
+
+inline void grow(Bounds &bounds, const Bounds &other) noexcept
+{
+    bounds.minimum = glm::min(bounds.minimum, other.minimum);
+    bounds.maximum = glm::max(bounds.maximum, other.maximum);
+}
+
+inline void grow(Bounds &bounds, const glm::vec3 &point) noexcept
+{
+    bounds.minimum = glm::min(bounds.minimum, point);
+    bounds.maximum = glm::max(bounds.maximum, point);
+}
+
+// Half the surface area, which is all the heuristic compares. Empty bounds
+// have none.
+inline float surfaceArea(const Bounds &bounds) noexcept
+{
+    const glm::vec3 extent{
+        glm::max(bounds.maximum - bounds.minimum, glm::vec3{0.0f})};
+    return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+}
+
+// Center of the triangle's box, which stands in for the triangle when
+// binning.
+inline glm::vec3 centroid(const BvhReference &reference) noexcept
+{
+    return 0.5f * (reference.box.minimum + reference.box.maximum);
+}
+
+// Grows bounds and centroids by references[first, last).
+inline void boundBlock(const BvhBuildInput &input, std::size_t first,
+                       std::size_t last, Bounds &bounds,
+                       Bounds &centroids) noexcept
+{
+    for (std::size_t i{first}; i < last; ++i)
+    {
+        grow(bounds, input.references[i].box);
+        grow(centroids, centroid(input.references[i]));
+    }
+}
+
+// Bounds of the triangles of a range and of their centroids. Large ranges
+// are split into blocks whose results are merged in order.
+inline void rangeBounds(const BvhBuildInput &input, std::size_t first,
+                        std::size_t last, Bounds &bounds, Bounds &centroids)
+{
+    bounds = emptyBounds();
+    centroids = emptyBounds();
+    if (last - first <= bvhBlockTriangles)
+    {
+        boundBlock(input, first, last, bounds, centroids);
+        return;
+    }
+
+    const std::size_t blocks{
+        (last - first + bvhBlockTriangles - 1) / bvhBlockTriangles};
+    std::vector<Bounds> blockBounds(2 * blocks, emptyBounds());
+    Parallel::ParallelFor(blocks, input.threadCount, [&](std::size_t block) {
+        const std::size_t begin{first + block * bvhBlockTriangles};
+        boundBlock(input, begin, std::min(begin + bvhBlockTriangles, last),
+                   blockBounds[2 * block], blockBounds[2 * block + 1]);
+    });
+    for (std::size_t block{0}; block < blocks; ++block)
+    {
+        grow(bounds, blockBounds[2 * block]);
+        grow(centroids, blockBounds[2 * block + 1]);
+    }
+}
+
+// Adds references[first, last) to bins, along all three axes.
+inline void binBlock(const BvhBuildInput &input, std::size_t first,
+                     std::size_t last, const Bounds &centroids,
+                     const glm::vec3 &scale, BvhBins &bins) noexcept
+{
+    for (std::size_t i{first}; i < last; ++i)
+    {
+        const BvhReference &reference{input.references[i]};
+        const glm::vec3 bin{(centroid(reference) - centroids.minimum) *
+                            scale};
+        for (std::size_t axis{0}; axis < 3; ++axis)
+        {
+            BvhBin &target{bins[axis * bvhBinCount +
+                                static_cast<std::size_t>(
+                                    bin[static_cast<int>(axis)])]};
+            grow(target.bounds, reference.box);
+            ++target.count;
+        }
+    }
+}
+
+// Bins the centroids of a range along all three axes at once, in blocks
+// merged in order for large ranges.
+inline BvhBins binRange(const BvhBuildInput &input, std::size_t first,
+                        std::size_t last, const Bounds &centroids,
+                        std::size_t binCount)
+{
+    const glm::vec3 extent{centroids.maximum - centroids.minimum};
+    glm::vec3 scale;
+    for (int axis{0}; axis < 3; ++axis)
+    {
+        scale[axis] = extent[axis] > 0.0f
+                          ? static_cast<float>(binCount) * 0.9999f /
+                                extent[axis]
+                          : 0.0f;
+    }
+
+    BvhBins bins;
+    bins.fill(BvhBin{emptyBounds(), 0});
+    if (last - first <= bvhBlockTriangles)
+    {
+        binBlock(input, first, last, centroids, scale, bins);
+        return bins;
+    }
+
+    const std::size_t blocks{
+        (last - first + bvhBlockTriangles - 1) / bvhBlockTriangles};
+    std::vector<BvhBins> blockBins(blocks, bins);
+    Parallel::ParallelFor(blocks, input.threadCount, [&](std::size_t block) {
+        const std::size_t begin{first + block * bvhBlockTriangles};
+        binBlock(input, begin, std::min(begin + bvhBlockTriangles, last),
+                 centroids, scale, blockBins[block]);
+    });
+    for (const BvhBins &block : blockBins)
+    {
+        for (std::size_t i{0}; i < bins.size(); ++i)
+        {
+            grow(bins[i].bounds, block[i].bounds);
+            bins[i].count += block[i].count;
+        }
+    }
+    return bins;
+}
+
+// Builds the subtree of references[first, last) and returns its root. With
+// tasks, ranges of at most bvhTaskTriangles become placeholders built
+// later.
+inline std::uint32_t buildNode(const BvhBuildInput &input, std::size_t first,
+                               std::size_t last, std::size_t depth,
+                               std::vector<BvhBuildNode> &nodes,
+                               std::vector<BvhTask> *tasks)
+{
+    const std::uint32_t index{static_cast<std::uint32_t>(nodes.size())};
+    const std::size_t count{last - first};
+    if (tasks && count <= bvhTaskTriangles)
+    {
+        nodes.push_back(BvhBuildNode{
+            emptyBounds(), bvhTaskNode,
+            static_cast<std::uint32_t>(tasks->size()), 0, 0});
+        tasks->push_back(BvhTask{index, first, last, depth});
+        return index;
+    }
+
+    Bounds bounds;
+    Bounds centroids;
+    rangeBounds(input, first, last, bounds, centroids);
+    nodes.push_back(BvhBuildNode{bounds, 0, 0,
+                                 static_cast<std::uint32_t>(first),
+                                 static_cast<std::uint32_t>(count)});
+    if (count <= 1)
+    {
+        return index;
+    }
+
+    // Best split by the surface area heuristic.
+    const glm::vec3 extent{centroids.maximum - centroids.minimum};
+    std::size_t middle{first};
+    if (depth < bvhSahDepth &&
+        (extent.x > 0.0f || extent.y > 0.0f || extent.z > 0.0f))
+    {
+        const std::size_t binCount{std::min(bvhBinCount, count)};
+        const BvhBins bins{
+            binRange(input, first, last, centroids, binCount)};
+        const float area{std::max(surfaceArea(bounds),
+                                  std::numeric_limits<float>::min())};
+        float bestCost{std::numeric_limits<float>::max()};
+        int bestAxis{-1};
+        std::size_t bestBin{0};
+        for (int axis{0}; axis < 3; ++axis)
+        {
+            if (!(extent[axis] > 0.0f))
+            {
+                continue;
+            }
+            const BvhBin *axisBins{bins.data() + axis * bvhBinCount};
+
+            // Right side areas and counts of every split, swept from the
+            // end.
+            float rightArea[bvhBinCount];
+            std::size_t rightCount[bvhBinCount];
+            Bounds right{emptyBounds()};
+            std::size_t rightTriangles{0};
+            for (std::size_t i{binCount - 1}; i > 0; --i)
+            {
+                grow(right, axisBins[i].bounds);
+                rightTriangles += axisBins[i].count;
+                rightArea[i] = surfaceArea(right);
+                rightCount[i] = rightTriangles;
+            }
+
+            Bounds left{emptyBounds()};
+            std::size_t leftTriangles{0};
+            for (std::size_t i{1}; i < binCount; ++i)
+            {
+                grow(left, axisBins[i - 1].bounds);
+                leftTriangles += axisBins[i - 1].count;
+                if (!leftTriangles || !rightCount[i])
+                {
+                    continue;
+                }
+                const float cost{
+                    bvhTraversalCost +
+                    (surfaceArea(left) * static_cast<float>(leftTriangles) +
+                     rightArea[i] * static_cast<float>(rightCount[i])) /
+                        area};
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestBin = i;
+                }
+            }
+        }
+
+        if (count <= bvhLeafTriangles &&
+            static_cast<float>(count) <= bestCost)
+        {
+            return index;
+        }
+        if (bestAxis >= 0)
+        {
+            const float minimum{centroids.minimum[bestAxis]};
+            const float scale{static_cast<float>(binCount) * 0.9999f /
+                              extent[bestAxis]};
+            middle = static_cast<std::size_t>(
+                std::partition(input.references + first,
+                               input.references + last,
+                               [&](const BvhReference &reference) {
+                                   return static_cast<std::size_t>(
+                                              (centroid(reference)[bestAxis] -
+                                               minimum) *
+                                              scale) < bestBin;
+                               }) -
+                input.references);
+        }
+    }
+    else if (count <= bvhLeafTriangles)
+    {
+        return index;
+    }
+
+    // Past the heuristic's depth, or with nothing to tell the centroids
+    // apart: halve the range along the widest axis.
+    if (middle == first || middle == last)
+    {
+        const int axis{extent.x >= extent.y && extent.x >= extent.z ? 0
+                       : extent.y >= extent.z                       ? 1
+                                                                    : 2};
+        middle = first + count / 2;
+        std::nth_element(input.references + first,
+                         input.references + middle, input.references + last,
+                         [&](const BvhReference &a, const BvhReference &b) {
+                             const float ca{centroid(a)[axis]};
+                             const float cb{centroid(b)[axis]};
+                             return ca < cb ||
+                                    (!(cb < ca) && a.triangle < b.triangle);
+                         });
+    }
+
+    const std::uint32_t left{
+        buildNode(input, first, middle, depth + 1, nodes, tasks)};
+    const std::uint32_t right{
+        buildNode(input, middle, last, depth + 1, nodes, tasks)};
+    nodes[index].left = left;
+    nodes[index].right = right;
+    nodes[index].count = 0;
+    return index;
+}
+
+// Emits the four-wide node for a binary node: its children are expanded,
+// largest first, until four are gathered or only leaves remain. Returns the
+// index of the emitted node, which precedes its subtrees.
+inline std::uint32_t collapse(const std::vector<BvhBuildNode> &nodes,
+                              std::uint32_t node, std::size_t depth,
+                              std::vector<BvhNode> &out,
+                              TriangleBvhStatistics &statistics)
+{
+    std::uint32_t children[4]{node, 0, 0, 0};
+    std::uint32_t childCount{1};
+    if (nodes[node].count == 0)
+    {
+        children[0] = nodes[node].left;
+        children[1] = nodes[node].right;
+        childCount = 2;
+    }
+    while (childCount < 4)
+    {
+        std::uint32_t largest{4};
+        float largestArea{-1.0f};
+        for (std::uint32_t i{0}; i < childCount; ++i)
+        {
+            const BvhBuildNode &child{nodes[children[i]]};
+            if (child.count == 0 && surfaceArea(child.bounds) > largestArea)
+            {
+                largest = i;
+                largestArea = surfaceArea(child.bounds);
+            }
+        }
+        if (largest == 4)
+        {
+            break;
+        }
+        const BvhBuildNode &expanded{nodes[children[largest]]};
+        children[largest] = expanded.left;
+        children[childCount++] = expanded.right;
+    }
+
+    const std::uint32_t index{static_cast<std::uint32_t>(out.size())};
+    out.push_back(BvhNode{});
+    out[index].childCount = childCount;
+    statistics.depth = std::max(statistics.depth, depth + 1);
+    for (std::uint32_t i{0}; i < childCount; ++i)
+    {
+        const BvhBuildNode &child{nodes[children[i]]};
+        for (int axis{0}; axis < 3; ++axis)
+        {
+            out[index].minimum[axis][i] = child.bounds.minimum[axis];
+            out[index].maximum[axis][i] = child.bounds.maximum[axis];
+        }
+        if (child.count)
+        {
+            out[index].child[i] = child.first;
+            out[index].count[i] = static_cast<std::uint8_t>(child.count);
+            ++statistics.leafCount;
+        }
+        else
+        {
+            const std::uint32_t childIndex{
+                collapse(nodes, children[i], depth + 1, out, statistics)};
+            out[index].child[i] = childIndex;
+        }
+    }
+    return index;
+}
+
+// Moller-Trumbore, hitting both faces.
+inline bool intersectTriangle(const Ray &ray, const float *positions,
+                              const std::uint32_t *triangle, float farthest,
+                              RayHit &hit) noexcept
+{
+    const glm::vec3 p0{positions[3 * triangle[0]],
+                       positions[3 * triangle[0] + 1],
+                       positions[3 * triangle[0] + 2]};
+    const glm::vec3 e1{glm::vec3{positions[3 * triangle[1]],
+                                 positions[3 * triangle[1] + 1],
+                                 positions[3 * triangle[1] + 2]} -
+                       p0};
+    const glm::vec3 e2{glm::vec3{positions[3 * triangle[2]],
+                                 positions[3 * triangle[2] + 1],
+                                 positions[3 * triangle[2] + 2]} -
+                       p0};
+
+    const glm::vec3 p{glm::cross(ray.direction, e2)};
+    const float determinant{glm::dot(e1, p)};
+    if (!(std::abs(determinant) > 0.0f))
+    {
+        return false;
+    }
+    const float inverse{1.0f / determinant};
+    const glm::vec3 s{ray.origin - p0};
+    const float u{glm::dot(s, p) * inverse};
+    if (u < 0.0f || u > 1.0f)
+    {
+        return false;
+    }
+    const glm::vec3 q{glm::cross(s, e1)};
+    const float v{glm::dot(ray.direction, q) * inverse};
+    if (v < 0.0f || u + v > 1.0f)
+    {
+        return false;
+    }
+    const float distance{glm::dot(e2, q) * inverse};
+    if (distance < ray.minimumDistance || distance > farthest)
+    {
+        return false;
+    }
+
+    hit.distance = distance;
+    hit.u = u;
+    hit.v = v;
+    return true;
+}
+
+} // namespace Detail
+
+TriangleBvh::TriangleBvh(unsigned int threadCount) noexcept
+    : threadCount_{threadCount}, statistics_{}, nodes_{}, triangles_{},
+      triangleIds_{}, positions_{}, textureCoordinates_{}
+{
+}
+
+void TriangleBvh::build(const MeshView &view)
+{
+    Performance::Stopwatch stopwatch;
+
+    const std::size_t triangleCount{view.indexCount / 3};
+    statistics_ = Statistics{triangleCount, 0, 0, 0, 0.0};
+    nodes_.clear();
+    triangles_.clear();
+    triangleIds_.clear();
+    positions_.assign(view.positions, view.positions + 3 * view.vertexCount);
+    if (view.textureCoordinates)
+    {
+        textureCoordinates_.assign(view.textureCoordinates,
+                                   view.textureCoordinates +
+                                       2 * view.vertexCount);
+    }
+    else
+    {
+        textureCoordinates_.clear();
+    }
+    if (!triangleCount)
+    {
+        statistics_.buildMilliseconds = stopwatch.elapsedMilliseconds();
+        return;
+    }
+
+    // Box of every triangle.
+    std::vector<Detail::BvhReference> references(triangleCount);
+    const std::size_t blocks{
+        (triangleCount + Detail::bvhBlockTriangles - 1) /
+        Detail::bvhBlockTriangles};
+    Parallel::ParallelFor(blocks, threadCount_, [&](std::size_t block) {
+        const std::size_t first{block * Detail::bvhBlockTriangles};
+        const std::size_t last{
+            std::min(first + Detail::bvhBlockTriangles, triangleCount)};
+        for (std::size_t t{first}; t < last; ++t)
+        {
+            Bounds box{Detail::emptyBounds()};
+            for (std::size_t corner{0}; corner < 3; ++corner)
+            {
+                const float *position{view.positions +
+                                      3 * view.indices[3 * t + corner]};
+                Detail::grow(box,
+                             glm::vec3{position[0], position[1], position[2]});
+            }
+            references[t] =
+                Detail::BvhReference{box, static_cast<std::uint32_t>(t)};
+        }
+    });
+
+    const Detail::BvhBuildInput input{
+        references.data(), Parallel::ResolveThreadCount(threadCount_)};
+
+    // The top of the tree is split on this thread, binning large ranges in
+    // parallel; the ranges it leaves are built as independent subtrees.
+    std::vector<Detail::BvhBuildNode> nodes;
+    std::vector<Detail::BvhTask> tasks;
+    Detail::buildNode(input, 0, triangleCount, 0, nodes, &tasks);
+
+    std::vector<std::vector<Detail::BvhBuildNode>> taskNodes(tasks.size());
+    Parallel::ParallelFor(tasks.size(), threadCount_, [&](std::size_t task) {
+        Detail::buildNode(input, tasks[task].first, tasks[task].last,
+                          tasks[task].depth, taskNodes[task], nullptr);
+    });
+    for (std::size_t task{0}; task < tasks.size(); ++task)
+    {
+        const std::uint32_t offset{static_cast<std::uint32_t>(nodes.size())};
+        for (Detail::BvhBuildNode node : taskNodes[task])
+        {
+            if (!node.count)
+            {
+                node.left += offset;
+                node.right += offset;
+            }
+            nodes.push_back(node);
+        }
+        nodes[tasks[task].node] = nodes[offset];
+    }
+
+    Detail::collapse(nodes, 0, 0, nodes_, statistics_);
+    statistics_.nodeCount = nodes_.size();
+
+    // Triangles in leaf order, so a leaf reads consecutive indices.
+    triangleIds_.resize(triangleCount);
+    triangles_.resize(3 * triangleCount);
+    for (std::size_t i{0}; i < triangleCount; ++i)
+    {
+        triangleIds_[i] = references[i].triangle;
+        std::copy_n(view.indices + 3 * triangleIds_[i], 3,
+                    triangles_.begin() + 3 * i);
+    }
+
+    statistics_.buildMilliseconds = stopwatch.elapsedMilliseconds();
+}
+
+bool TriangleBvh::closestHit(const Ray &ray, RayHit &hit) const noexcept
+{
+    if (!traverse<false>(ray, hit))
+    {
+        return false;
+    }
+
+    const std::uint32_t slot{hit.triangle};
+    hit.triangle = triangleIds_[slot];
+    hit.textureCoordinate = glm::vec2{0.0f};
+    if (!textureCoordinates_.empty())
+    {
+        const std::uint32_t *triangle{triangles_.data() + 3 * slot};
+        const float weights[3]{1.0f - hit.u - hit.v, hit.u, hit.v};
+        for (std::size_t corner{0}; corner < 3; ++corner)
+        {
+            hit.textureCoordinate +=
+                weights[corner] *
+                glm::vec2{textureCoordinates_[2 * triangle[corner]],
+                          textureCoordinates_[2 * triangle[corner] + 1]};
+        }
+    }
+    return true;
+}
+
+bool TriangleBvh::anyHit(const Ray &ray) const noexcept
+{
+    RayHit hit;
+    return traverse<true>(ray, hit);
+}
+
+bool TriangleBvh::empty() const noexcept { return nodes_.empty(); }
+
+const TriangleBvh::Statistics &TriangleBvh::statistics() const noexcept
+{
+    return statistics_;
+}
+
+template <bool AnyHit>
+bool TriangleBvh::traverse(const Ray &ray, RayHit &hit) const noexcept
+{
+    using Simd::Float4;
+
+    if (nodes_.empty())
+    {
+        return false;
+    }
+
+    // Axis-parallel rays take a huge but finite inverse, so slabs never
+    // compute 0 * infinity.
+    Float4 origin[3];
+    Float4 inverse[3];
+    for (int axis{0}; axis < 3; ++axis)
+    {
+        const float direction{ray.direction[axis]};
+        origin[axis] = Simd::broadcast(ray.origin[axis]);
+        inverse[axis] = Simd::broadcast(
+            1.0f / (std::abs(direction) > 1e-20f
+                        ? direction
+                        : (direction < 0.0f ? -1e-20f : 1e-20f)));
+    }
+    const Float4 nearest{Simd::broadcast(ray.minimumDistance)};
+
+    float farthest{ray.maximumDistance};
+    bool found{false};
+    std::uint32_t stack[Detail::bvhStackSize];
+    std::size_t stackSize{0};
+    stack[stackSize++] = 0;
+    while (stackSize)
+    {
+        const BvhNode &node{nodes_[stack[--stackSize]]};
+
+        // Slab test of the ray against the four child boxes.
+        Float4 entry{nearest};
+        Float4 exit{Simd::broadcast(farthest)};
+        for (int axis{0}; axis < 3; ++axis)
+        {
+            const Float4 t0{(Simd::load(node.minimum[axis]) - origin[axis]) *
+                            inverse[axis]};
+            const Float4 t1{(Simd::load(node.maximum[axis]) - origin[axis]) *
+                            inverse[axis]};
+            entry = Simd::max(entry, Simd::min(t0, t1));
+            exit = Simd::min(exit, Simd::max(t0, t1));
+        }
+        const int mask{Simd::moveMask(Simd::lessEqual(entry, exit)) &
+                       ((1 << node.childCount) - 1)};
+        if (!mask)
+        {
+            continue;
+        }
+        float entries[4];
+        Simd::store(entries, entry);
+
+        // Leaves are tested right away; nodes are pushed far to near, so
+        // the nearest is visited next.
+        std::uint32_t pending[4];
+        float pendingEntries[4];
+        std::size_t pendingCount{0};
+        for (int i{0}; i < 4; ++i)
+        {
+            if (!(mask & (1 << i)))
+            {
+                continue;
+            }
+            if (node.count[i])
+            {
+                for (std::uint32_t t{node.child[i]};
+                     t < node.child[i] + node.count[i]; ++t)
+                {
+                    if (Detail::intersectTriangle(ray, positions_.data(),
+                                                  triangles_.data() + 3 * t,
+                                                  farthest, hit))
+                    {
+                        if (AnyHit)
+                        {
+                            return true;
+                        }
+                        found = true;
+                        farthest = hit.distance;
+                        hit.triangle = t;
+                    }
+                }
+                continue;
+            }
+
+            std::size_t j{pendingCount++};
+            for (; j > 0 && pendingEntries[j - 1] < entries[i]; --j)
+            {
+                pending[j] = pending[j - 1];
+                pendingEntries[j] = pendingEntries[j - 1];
+            }
+            pending[j] = node.child[i];
+            pendingEntries[j] = entries[i];
+        }
+        for (std::size_t i{0}; i < pendingCount; ++i)
+        {
+            if (pendingEntries[i] <= farthest)
+            {
+                stack[stackSize++] = pending[i];
+            }
+        }
+    }
+    return found;
+}
+
+} // namespace Model
@@ -0,0 +1,108 @@
+#ifndef HOMEWORK01_MODEL_TRIANGLEBVH_HPP_
+#define HOMEWORK01_MODEL_TRIANGLEBVH_HPP_
+
+#include "MeshData.hpp"
+
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Model
+{
+
+// Points origin + t * direction for t in [minimumDistance,
+// maximumDistance]. direction need not be unit length; distances are
+// measured in multiples of it, so a ray transformed by an affine matrix
+// keeps them.
+struct Ray
+{
+    glm::vec3 origin;
+    glm::vec3 direction;
+    float minimumDistance;
+    float maximumDistance;
+};
+
+// A ray meeting a triangle at corner0 + u * (corner1 - corner0) +
+// v * (corner2 - corner0). triangle indexes the triangles of the source
+// view.
+struct RayHit
+{
+    float distance;
+    float u;
+    float v;
+    std::uint32_t triangle;
+    // Interpolated at the hit; zero if the mesh has none.
+    glm::vec2 textureCoordinate;
+};
+
+// Four children of a node side by side, so one SIMD test checks the ray
+// against all of their boxes. A child with a count is a leaf holding count
+// triangles from index child on; otherwise child is a node index.
+struct BvhNode
+{
+    float minimum[3][4];
+    float maximum[3][4];
+    std::uint32_t child[4];
+    std::uint8_t count[4];
+    std::uint32_t childCount;
+    std::uint32_t padding;
+};
+
+struct TriangleBvhStatistics
+{
+    std::size_t triangleCount;
+    std::size_t nodeCount;
+    std::size_t leafCount;
+    std::size_t depth;
+    double buildMilliseconds;
+};
+
+// Bounding volume hierarchy over the triangles of a mesh for ray queries
+// on the CPU, such as picking. A binary tree is built top-down with a
+// binned surface area heuristic, subtrees in parallel on up to threadCount
+// threads (0 = every hardware thread), then collapsed into four-wide nodes
+// laid out depth first. The tree keeps its own copy of positions and
+// texture coordinates, so the view need not outlive build().
+class TriangleBvh
+{
+public:
+    using Statistics = TriangleBvhStatistics;
+
+    explicit TriangleBvh(unsigned int threadCount = 0) noexcept;
+
+    void build(const MeshView &view);
+
+    // Nearest hit within the ray's range.
+    bool closestHit(const Ray &ray, RayHit &hit) const noexcept;
+    // Whether anything lies within the ray's range, stopping at the first
+    // hit found; meant for occlusion tests.
+    bool anyHit(const Ray &ray) const noexcept;
+
+    bool empty() const noexcept;
+    const Statistics &statistics() const noexcept;
+
+private:
+    // Leaves hit.triangle as the position of the hit triangle in leaf
+    // order.
+    template <bool AnyHit>
+    bool traverse(const Ray &ray, RayHit &hit) const noexcept;
+
+    unsigned int threadCount_;
+
+    Statistics statistics_;
+
+    std::vector<BvhNode> nodes_;
+    // Vertex indices of the triangles in leaf order, and the index each had
+    // in the source view.
+    std::vector<std::uint32_t> triangles_;
+    std::vector<std::uint32_t> triangleIds_;
+    std::vector<float> positions_;
+    std::vector<float> textureCoordinates_;
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_TRIANGLEBVH_HPP_
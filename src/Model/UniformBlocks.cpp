@@ -0,0 +1,19 @@
+#include "UniformBlocks.hpp"
+
+namespace Model
+{
+
+ObjectBlock ObjectBlock::make(const glm::mat4 &model,
+                              const VertexQuantization &quantization,
+                              bool instanced) noexcept
+{
+    return ObjectBlock{model,
+                       quantization.positionOffset,
+                       quantization.octahedralNormals ? 1u : 0u,
+                       quantization.positionScale,
+                       instanced ? 1u : 0u,
+                       quantization.textureCoordinateOffset,
+                       quantization.textureCoordinateScale};
+}
+
+} // namespace Model
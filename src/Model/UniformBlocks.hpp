@@ -0,0 +1,87 @@
+#ifndef HOMEWORK01_MODEL_UNIFORMBLOCKS_HPP_
+#define HOMEWORK01_MODEL_UNIFORMBLOCKS_HPP_
+
+#include "VertexLayout.hpp"
+
+#include "OpenGL/OpenGLStd140Layout.hpp"
+#include "OpenGL/OpenGLUniformBuffer.hpp"
+
+#include "glad/glad.h"
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Model
+{
+
+// Binding points of the blocks the mesh shader declares; every program is
+// mapped to them once linked.
+constexpr GLuint cameraBlockBinding{0};
+constexpr GLuint objectBlockBinding{1};
+
+// The Camera block, written once a frame and read by every program.
+struct CameraBlock
+{
+    using Layout = OpenGL::OpenGLStd140Layout<glm::mat4, glm::mat4, glm::mat4,
+                                              glm::vec4>;
+
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 viewProjection;
+    // World space, w = 1.
+    glm::vec4 eyePosition;
+};
+
+static_assert(CameraBlock::Layout::matches(
+                  sizeof(CameraBlock), offsetof(CameraBlock, view),
+                  offsetof(CameraBlock, projection),
+                  offsetof(CameraBlock, viewProjection),
+                  offsetof(CameraBlock, eyePosition)),
+              "CameraBlock does not follow the std140 layout of Camera");
+
+// The Object block: what a draw of one mesh needs beyond the camera. The
+// flags are GLSL bools, 4 bytes in a block, and fill the vec3 before them
+// up to 16 bytes.
+struct ObjectBlock
+{
+    using Layout =
+        OpenGL::OpenGLStd140Layout<glm::mat4, glm::vec3, std::uint32_t,
+                                   glm::vec3, std::uint32_t, glm::vec2,
+                                   glm::vec2>;
+
+    glm::mat4 model;
+    glm::vec3 positionOffset;
+    std::uint32_t octahedralNormals;
+    glm::vec3 positionScale;
+    std::uint32_t instanced;
+    glm::vec2 textureCoordinateOffset;
+    glm::vec2 textureCoordinateScale;
+
+    static ObjectBlock make(const glm::mat4 &model,
+                            const VertexQuantization &quantization,
+                            bool instanced) noexcept;
+};
+
+static_assert(ObjectBlock::Layout::matches(
+                  sizeof(ObjectBlock), offsetof(ObjectBlock, model),
+                  offsetof(ObjectBlock, positionOffset),
+                  offsetof(ObjectBlock, octahedralNormals),
+                  offsetof(ObjectBlock, positionScale),
+                  offsetof(ObjectBlock, instanced),
+                  offsetof(ObjectBlock, textureCoordinateOffset),
+                  offsetof(ObjectBlock, textureCoordinateScale)),
+              "ObjectBlock does not follow the std140 layout of Object");
+
+using CameraUniformBuffer = OpenGL::OpenGLUniformBuffer<CameraBlock>;
+// The blocks of everything drawn in a frame, uploaded together before the
+// first draw.
+using ObjectUniformBuffer = OpenGL::OpenGLUniformBuffer<ObjectBlock>;
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_UNIFORMBLOCKS_HPP_
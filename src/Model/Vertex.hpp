@@ -1,19 +1,34 @@
-#ifndef HOMEWORK01_MODEL_VERTEX_HPP_
-#define HOMEWORK01_MODEL_VERTEX_HPP_
-
-#include "glm/vec2.hpp"
-#include "glm/vec3.hpp"
-
-namespace Model
-{
-
-struct Vertex
-{
-    glm::vec3 position;
-    glm::vec3 normal;
-    glm::vec2 textureCoordinate;
-};
-
-} // namespace Model
-
-#endif // HOMEWORK01_MODEL_VERTEX_HPP_
+#ifndef HOMEWORK01_MODEL_VERTEX_HPP_
+#define HOMEWORK01_MODEL_VERTEX_HPP_
+
+#include "VertexLayout.hpp"
+
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+#include <cstddef>
+
+namespace Model
+{
+
+struct Vertex
+{
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 textureCoordinate;
+};
+
+// The interleaved layout a buffer of Vertex records is read with.
+using VertexLayout = InterleavedLayout<PositionAttribute, NormalAttribute,
+                                       TextureCoordinateAttribute>;
+
+static_assert(sizeof(Vertex) == VertexLayout::stride &&
+                  offsetof(Vertex, normal) ==
+                      VertexLayout::offset<NormalAttribute>() &&
+                  offsetof(Vertex, textureCoordinate) ==
+                      VertexLayout::offset<TextureCoordinateAttribute>(),
+              "Vertex has to match VertexLayout");
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_VERTEX_HPP_
@@ -0,0 +1,425 @@
+#include "Detail/Quantization.hpp"
+
+#include "Utils/Compilers.hpp"
+
+PRAGMA_WARNING_PUSH
+PRAGMA_WARNING_DISABLE_FLOATEQUAL
+
+#include "glm/gtc/packing.hpp"
+
+PRAGMA_WARNING_POP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+template <>
+struct AttributeSizeSum<> : std::integral_constant<std::size_t, 0>
+{
+};
+
+template <typename First, typename... Rest>
+struct AttributeSizeSum<First, Rest...>
+    : std::integral_constant<std::size_t, First::byteSize +
+                                              AttributeSizeSum<Rest...>::value>
+{
+};
+
+// Byte offset of Attribute within a vertex of the interleaved Attributes.
+template <typename Attribute, typename... Attributes>
+struct AttributeOffset;
+
+template <typename Attribute, typename... Rest>
+struct AttributeOffset<Attribute, Attribute, Rest...>
+    : std::integral_constant<std::size_t, 0>
+{
+};
+
+template <typename Attribute, typename First, typename... Rest>
+struct AttributeOffset<Attribute, First, Rest...>
+    : std::integral_constant<std::size_t,
+                             First::byteSize +
+                                 AttributeOffset<Attribute, Rest...>::value>
+{
+};
+
+// Calls function.template apply<Attribute, Index, Offset>() for every
+// attribute, where Index is its position in the list and Offset the sum of
+// the sizes of the attributes before it.
+template <std::size_t Index, std::size_t Offset, typename... Attributes>
+struct AttributeVisitor;
+
+template <std::size_t Index, std::size_t Offset>
+struct AttributeVisitor<Index, Offset>
+{
+    template <typename Function>
+    static void visit(Function &) noexcept
+    {
+    }
+};
+
+template <std::size_t Index, std::size_t Offset, typename First,
+          typename... Rest>
+struct AttributeVisitor<Index, Offset, First, Rest...>
+{
+    template <typename Function>
+    static void visit(Function &function)
+    {
+        function.template apply<First, Index, Offset>();
+        AttributeVisitor<Index + 1, Offset + First::byteSize,
+                         Rest...>::visit(function);
+    }
+};
+
+struct AttributeSetUp
+{
+    template <typename Attribute, std::size_t Index, std::size_t Offset>
+    void apply()
+    {
+        OpenGL::OpenGLBufferObject &buffer{*buffers[split ? Index : 0]};
+        buffer.bind();
+        program.enableAttributeArray(Attribute::location);
+        program.mapAttributePointer(
+            Attribute::location, Attribute::size, Attribute::type,
+            Attribute::normalized,
+            static_cast<GLsizei>(split ? Attribute::byteSize : stride),
+            static_cast<int>(bufferOffset + (split ? 0 : Offset)));
+    }
+
+    OpenGL::OpenGLShaderProgram &program;
+    OpenGL::OpenGLBufferObject *const *buffers;
+    bool split;
+    std::size_t stride;
+    std::size_t bufferOffset;
+};
+
+// Fills one attribute of every vertex: a strided copy of the stream, where
+// the constant vertex size lets the copy be inlined, or a call to encode for
+// quantized attributes.
+template <std::size_t Stride>
+struct AttributePack
+{
+    template <typename Attribute, std::size_t Index, std::size_t Offset>
+    void apply() noexcept
+    {
+        pack<Attribute>(out + Offset,
+                        std::is_base_of<QuantizedVertexAttribute, Attribute>{});
+    }
+
+    template <typename Attribute>
+    void pack(unsigned char *destination, std::false_type) noexcept
+    {
+        const unsigned char *source{
+            static_cast<const unsigned char *>(Attribute::stream(chunk))};
+        for (std::size_t i{0}; i < chunk.vertexCount; ++i)
+        {
+            std::memcpy(destination, source, Attribute::byteSize);
+            source += Attribute::byteSize;
+            destination += Stride;
+        }
+    }
+
+    template <typename Attribute>
+    void pack(unsigned char *destination, std::true_type) noexcept
+    {
+        for (std::size_t i{0}; i < chunk.vertexCount; ++i)
+        {
+            Attribute::encode(chunk, i, quantization, destination);
+            destination += Stride;
+        }
+    }
+
+    const MeshView &chunk;
+    const VertexQuantization &quantization;
+    unsigned char *out;
+};
+
+struct AttributeWrite
+{
+    template <typename Attribute, std::size_t Index, std::size_t Offset>
+    void apply()
+    {
+        static_assert(
+            !std::is_base_of<QuantizedVertexAttribute, Attribute>::value,
+            "Split layouts upload streams as they are");
+
+        OpenGL::OpenGLBufferObject &buffer{*buffers[Index]};
+        buffer.bind();
+        buffer.writeBufferSubData(
+            static_cast<GLintptr>(Attribute::byteSize * firstVertex),
+            Attribute::stream(chunk),
+            static_cast<GLsizeiptr>(Attribute::byteSize * chunk.vertexCount));
+    }
+
+    OpenGL::OpenGLBufferObject *const *buffers;
+    std::size_t firstVertex;
+    const MeshView &chunk;
+};
+
+struct AttributeSize
+{
+    template <typename Attribute, std::size_t Index, std::size_t Offset>
+    void apply() noexcept
+    {
+        if (Index == buffer)
+        {
+            size = Attribute::byteSize;
+        }
+    }
+
+    std::size_t buffer;
+    std::size_t size;
+};
+
+} // namespace Detail
+
+template <GLuint Location, GLint Size, GLenum Type, GLboolean Normalized>
+constexpr GLuint VertexAttribute<Location, Size, Type, Normalized>::location;
+template <GLuint Location, GLint Size, GLenum Type, GLboolean Normalized>
+constexpr GLint VertexAttribute<Location, Size, Type, Normalized>::size;
+template <GLuint Location, GLint Size, GLenum Type, GLboolean Normalized>
+constexpr GLenum VertexAttribute<Location, Size, Type, Normalized>::type;
+template <GLuint Location, GLint Size, GLenum Type, GLboolean Normalized>
+constexpr GLboolean
+    VertexAttribute<Location, Size, Type, Normalized>::normalized;
+template <GLuint Location, GLint Size, GLenum Type, GLboolean Normalized>
+constexpr std::size_t
+    VertexAttribute<Location, Size, Type, Normalized>::byteSize;
+
+inline const void *PositionAttribute::stream(const MeshView &view) noexcept
+{
+    return view.positions;
+}
+
+inline const void *NormalAttribute::stream(const MeshView &view) noexcept
+{
+    return view.normals;
+}
+
+inline const void *
+TextureCoordinateAttribute::stream(const MeshView &view) noexcept
+{
+    return view.textureCoordinates;
+}
+
+inline const void *ColorAttribute::stream(const MeshView &view) noexcept
+{
+    return view.colors;
+}
+
+inline const void *TangentAttribute::stream(const MeshView &view) noexcept
+{
+    return view.tangents;
+}
+
+inline VertexQuantization VertexQuantization::identity() noexcept
+{
+    return VertexQuantization{glm::vec3{0.0f}, glm::vec3{1.0f},
+                              glm::vec2{0.0f}, glm::vec2{1.0f}, false};
+}
+
+inline void
+Normalized16PositionAttribute::encode(const MeshView &chunk,
+                                      std::size_t vertex,
+                                      const VertexQuantization &quantization,
+                                      unsigned char *out) noexcept
+{
+    std::uint16_t value[4]{0, 0, 0, 0};
+    for (int i{0}; i < 3; ++i)
+    {
+        value[i] = glm::packUnorm1x16(
+            (chunk.positions[3 * vertex + i] - quantization.positionOffset[i]) /
+            quantization.positionScale[i]);
+    }
+    std::memcpy(out, value, sizeof(value));
+}
+
+inline void
+HalfPositionAttribute::encode(const MeshView &chunk, std::size_t vertex,
+                              const VertexQuantization &quantization,
+                              unsigned char *out) noexcept
+{
+    std::uint16_t value[4]{0, 0, 0, 0};
+    for (int i{0}; i < 3; ++i)
+    {
+        value[i] = glm::packHalf1x16(std::min(
+            std::max((chunk.positions[3 * vertex + i] -
+                      quantization.positionOffset[i]) /
+                         quantization.positionScale[i],
+                     -1.0f),
+            1.0f));
+    }
+    std::memcpy(out, value, sizeof(value));
+}
+
+inline void
+OctahedralNormalAttribute::encode(const MeshView &chunk, std::size_t vertex,
+                                  const VertexQuantization &,
+                                  unsigned char *out) noexcept
+{
+    const float *normal{chunk.normals + 3 * vertex};
+    const glm::vec2 encoded{Detail::octahedralEncode(
+        glm::vec3{normal[0], normal[1], normal[2]})};
+    const std::uint16_t value[2]{glm::packSnorm1x16(encoded.x),
+                                 glm::packSnorm1x16(encoded.y)};
+    std::memcpy(out, value, sizeof(value));
+}
+
+inline void Normalized16TextureCoordinateAttribute::encode(
+    const MeshView &chunk, std::size_t vertex,
+    const VertexQuantization &quantization, unsigned char *out) noexcept
+{
+    std::uint16_t value[2];
+    for (int i{0}; i < 2; ++i)
+    {
+        value[i] = glm::packUnorm1x16(
+            (chunk.textureCoordinates[2 * vertex + i] -
+             quantization.textureCoordinateOffset[i]) /
+            quantization.textureCoordinateScale[i]);
+    }
+    std::memcpy(out, value, sizeof(value));
+}
+
+inline void
+Normalized16TangentAttribute::encode(const MeshView &chunk, std::size_t vertex,
+                                     const VertexQuantization &,
+                                     unsigned char *out) noexcept
+{
+    const float *tangent{chunk.tangents + 4 * vertex};
+    const std::uint16_t value[4]{
+        glm::packSnorm1x16(tangent[0]), glm::packSnorm1x16(tangent[1]),
+        glm::packSnorm1x16(tangent[2]),
+        glm::packSnorm1x16(tangent[3] < 0.0f ? -1.0f : 1.0f)};
+    std::memcpy(out, value, sizeof(value));
+}
+
+template <typename... Attributes>
+constexpr std::size_t InterleavedLayout<Attributes...>::bufferCount;
+template <typename... Attributes>
+constexpr std::size_t InterleavedLayout<Attributes...>::stride;
+
+template <typename... Attributes>
+template <typename Attribute>
+inline constexpr std::size_t
+InterleavedLayout<Attributes...>::offset() noexcept
+{
+    return Detail::AttributeOffset<Attribute, Attributes...>::value;
+}
+
+template <typename... Attributes>
+inline constexpr std::size_t
+InterleavedLayout<Attributes...>::vertexSize(std::size_t) noexcept
+{
+    return stride;
+}
+
+template <typename... Attributes>
+inline void
+InterleavedLayout<Attributes...>::setUp(ShaderProgramType &program,
+                                        BufferObjectType *const *buffers,
+                                        std::size_t bufferOffset)
+{
+    Detail::AttributeSetUp setUp{program, buffers, false, stride,
+                                 bufferOffset};
+    Detail::AttributeVisitor<0, 0, Attributes...>::visit(setUp);
+}
+
+template <typename... Attributes>
+inline void
+InterleavedLayout<Attributes...>::pack(const MeshView &chunk,
+                                       const VertexQuantization &quantization,
+                                       unsigned char *out)
+{
+    Detail::AttributePack<stride> pack{chunk, quantization, out};
+    Detail::AttributeVisitor<0, 0, Attributes...>::visit(pack);
+}
+
+template <typename... Attributes>
+inline void InterleavedLayout<Attributes...>::write(
+    BufferObjectType *const *buffers, std::size_t firstVertex,
+    const MeshView &chunk, const VertexQuantization &quantization,
+    std::vector<unsigned char> &staging)
+{
+    staging.resize(stride * chunk.vertexCount);
+    pack(chunk, quantization, staging.data());
+
+    buffers[0]->bind();
+    buffers[0]->writeBufferSubData(static_cast<GLintptr>(stride * firstVertex),
+                                   staging.data(),
+                                   static_cast<GLsizeiptr>(staging.size()));
+}
+
+template <typename... Attributes>
+constexpr std::size_t SplitLayout<Attributes...>::bufferCount;
+
+template <typename... Attributes>
+inline std::size_t
+SplitLayout<Attributes...>::vertexSize(std::size_t buffer) noexcept
+{
+    Detail::AttributeSize size{buffer, 0};
+    Detail::AttributeVisitor<0, 0, Attributes...>::visit(size);
+    return size.size;
+}
+
+template <typename... Attributes>
+inline void SplitLayout<Attributes...>::setUp(ShaderProgramType &program,
+                                              BufferObjectType *const *buffers,
+                                              std::size_t bufferOffset)
+{
+    Detail::AttributeSetUp setUp{program, buffers, true, 0, bufferOffset};
+    Detail::AttributeVisitor<0, 0, Attributes...>::visit(setUp);
+}
+
+template <typename... Attributes>
+inline void SplitLayout<Attributes...>::write(BufferObjectType *const *buffers,
+                                              std::size_t firstVertex,
+                                              const MeshView &chunk,
+                                              const VertexQuantization &,
+                                              std::vector<unsigned char> &)
+{
+    Detail::AttributeWrite write{buffers, firstVertex, chunk};
+    Detail::AttributeVisitor<0, 0, Attributes...>::visit(write);
+}
+
+template <template <typename...> class Layout, typename... Required>
+struct VertexLayoutSelector<Layout, VertexAttributes<Required...>,
+                            VertexAttributes<>>
+{
+    template <typename Function>
+    static void select(const bool *, Function &function)
+    {
+        function.template apply<Layout<Required...>>();
+    }
+};
+
+template <template <typename...> class Layout, typename... Required,
+          typename Next, typename... Rest>
+struct VertexLayoutSelector<Layout, VertexAttributes<Required...>,
+                            VertexAttributes<Next, Rest...>>
+{
+    template <typename Function>
+    static void select(const bool *present, Function &function)
+    {
+        if (*present)
+        {
+            VertexLayoutSelector<Layout, VertexAttributes<Required..., Next>,
+                                 VertexAttributes<Rest...>>::select(present + 1,
+                                                                    function);
+        }
+        else
+        {
+            VertexLayoutSelector<Layout, VertexAttributes<Required...>,
+                                 VertexAttributes<Rest...>>::select(present + 1,
+                                                                    function);
+        }
+    }
+};
+
+} // namespace Model
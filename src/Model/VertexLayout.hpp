@@ -0,0 +1,270 @@
+#ifndef HOMEWORK01_MODEL_VERTEXLAYOUT_HPP_
+#define HOMEWORK01_MODEL_VERTEXLAYOUT_HPP_
+
+#include "MeshData.hpp"
+
+#include "OpenGL/OpenGLBufferObject.hpp"
+#include "OpenGL/OpenGLShaderProgram.hpp"
+
+#include "glad/glad.h"
+
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+namespace Model
+{
+
+// Compile-time description of how vertex streams are stored in buffer
+// objects. A layout lists its attributes as types, so strides, offsets and
+// the enableAttributeArray/mapAttributePointer calls are all resolved when
+// the layout is instantiated rather than looked up at run time.
+
+namespace Detail
+{
+
+// Bytes of one component of a GL data type. Defined here, ahead of the
+// attributes below that are instantiated with it.
+template <GLenum Type>
+struct GLTypeSize;
+
+template <>
+struct GLTypeSize<GL_BYTE> : std::integral_constant<std::size_t, 1>
+{
+};
+
+template <>
+struct GLTypeSize<GL_UNSIGNED_BYTE> : std::integral_constant<std::size_t, 1>
+{
+};
+
+template <>
+struct GLTypeSize<GL_SHORT> : std::integral_constant<std::size_t, 2>
+{
+};
+
+template <>
+struct GLTypeSize<GL_UNSIGNED_SHORT> : std::integral_constant<std::size_t, 2>
+{
+};
+
+template <>
+struct GLTypeSize<GL_HALF_FLOAT> : std::integral_constant<std::size_t, 2>
+{
+};
+
+template <>
+struct GLTypeSize<GL_INT> : std::integral_constant<std::size_t, 4>
+{
+};
+
+template <>
+struct GLTypeSize<GL_UNSIGNED_INT> : std::integral_constant<std::size_t, 4>
+{
+};
+
+template <>
+struct GLTypeSize<GL_FLOAT> : std::integral_constant<std::size_t, 4>
+{
+};
+
+template <typename... Attributes>
+struct AttributeSizeSum;
+
+} // namespace Detail
+
+// One vertex attribute: the shader location it feeds, its component count
+// and type, and the MeshView stream its data comes from.
+template <GLuint Location, GLint Size, GLenum Type, GLboolean Normalized>
+struct VertexAttribute
+{
+    static constexpr GLuint location{Location};
+    static constexpr GLint size{Size};
+    static constexpr GLenum type{Type};
+    static constexpr GLboolean normalized{Normalized};
+    static constexpr std::size_t byteSize{
+        static_cast<std::size_t>(Size) * Detail::GLTypeSize<Type>::value};
+};
+
+struct PositionAttribute : VertexAttribute<0, 3, GL_FLOAT, GL_FALSE>
+{
+    static const void *stream(const MeshView &view) noexcept;
+};
+
+struct NormalAttribute : VertexAttribute<1, 3, GL_FLOAT, GL_FALSE>
+{
+    static const void *stream(const MeshView &view) noexcept;
+};
+
+struct TextureCoordinateAttribute : VertexAttribute<2, 2, GL_FLOAT, GL_FALSE>
+{
+    static const void *stream(const MeshView &view) noexcept;
+};
+
+struct ColorAttribute : VertexAttribute<3, 4, GL_UNSIGNED_BYTE, GL_TRUE>
+{
+    static const void *stream(const MeshView &view) noexcept;
+};
+
+struct TangentAttribute : VertexAttribute<4, 4, GL_FLOAT, GL_FALSE>
+{
+    static const void *stream(const MeshView &view) noexcept;
+};
+
+// Maps quantized attributes back to model space: a stored position p decodes
+// to positionOffset + positionScale * p, where p is read as a normalized
+// value, and likewise for texture coordinates. The identity leaves float
+// attributes as they are.
+struct VertexQuantization
+{
+    glm::vec3 positionOffset;
+    glm::vec3 positionScale;
+    glm::vec2 textureCoordinateOffset;
+    glm::vec2 textureCoordinateScale;
+    // Normals are stored octahedral encoded.
+    bool octahedralNormals;
+
+    static VertexQuantization identity() noexcept;
+};
+
+// Base of attributes that are not a copy of their MeshView stream but are
+// encoded vertex by vertex through encode().
+struct QuantizedVertexAttribute
+{
+};
+
+// Positions as 16-bit unsigned normalized integers spanning the bounds. The
+// fourth component pads a vertex to a 4-byte boundary.
+struct Normalized16PositionAttribute
+    : VertexAttribute<0, 4, GL_UNSIGNED_SHORT, GL_TRUE>,
+      QuantizedVertexAttribute
+{
+    static void encode(const MeshView &chunk, std::size_t vertex,
+                       const VertexQuantization &quantization,
+                       unsigned char *out) noexcept;
+};
+
+// Positions as half floats in [-1, 1] around the center of the bounds.
+struct HalfPositionAttribute : VertexAttribute<0, 4, GL_HALF_FLOAT, GL_FALSE>,
+                               QuantizedVertexAttribute
+{
+    static void encode(const MeshView &chunk, std::size_t vertex,
+                       const VertexQuantization &quantization,
+                       unsigned char *out) noexcept;
+};
+
+// Unit normals as two 16-bit signed normalized octahedral coordinates.
+struct OctahedralNormalAttribute : VertexAttribute<1, 2, GL_SHORT, GL_TRUE>,
+                                   QuantizedVertexAttribute
+{
+    static void encode(const MeshView &chunk, std::size_t vertex,
+                       const VertexQuantization &quantization,
+                       unsigned char *out) noexcept;
+};
+
+// Texture coordinates as 16-bit unsigned normalized integers spanning their
+// range, which may reach outside [0, 1] for tiled textures.
+struct Normalized16TextureCoordinateAttribute
+    : VertexAttribute<2, 2, GL_UNSIGNED_SHORT, GL_TRUE>,
+      QuantizedVertexAttribute
+{
+    static void encode(const MeshView &chunk, std::size_t vertex,
+                       const VertexQuantization &quantization,
+                       unsigned char *out) noexcept;
+};
+
+// Tangents as four 16-bit signed normalized integers, the bitangent sign
+// exactly -1 or 1 in the last.
+struct Normalized16TangentAttribute
+    : VertexAttribute<4, 4, GL_SHORT, GL_TRUE>,
+      QuantizedVertexAttribute
+{
+    static void encode(const MeshView &chunk, std::size_t vertex,
+                       const VertexQuantization &quantization,
+                       unsigned char *out) noexcept;
+};
+
+// Type list of attributes.
+template <typename... Attributes>
+struct VertexAttributes
+{
+};
+
+// Every attribute in one buffer, one vertex after the other.
+template <typename... Attributes>
+struct InterleavedLayout
+{
+    using BufferObjectType = OpenGL::OpenGLBufferObject;
+    using ShaderProgramType = OpenGL::OpenGLShaderProgram;
+
+    static constexpr std::size_t bufferCount{1};
+    static constexpr std::size_t stride{
+        Detail::AttributeSizeSum<Attributes...>::value};
+
+    // Byte offset of Attribute within a vertex.
+    template <typename Attribute>
+    static constexpr std::size_t offset() noexcept;
+
+    // Bytes taken by one vertex in the given buffer.
+    static constexpr std::size_t vertexSize(std::size_t buffer) noexcept;
+
+    // Points the attributes at buffers, which must hold bufferCount buffer
+    // objects, with the first vertex bufferOffset bytes in. The vertex array
+    // object to set up has to be bound.
+    static void setUp(ShaderProgramType &program,
+                      BufferObjectType *const *buffers,
+                      std::size_t bufferOffset = 0);
+
+    // Interleaves the streams of chunk into out, which must hold
+    // stride * chunk.vertexCount bytes, encoding quantized attributes with
+    // quantization. Every stream of the layout has to be present in chunk.
+    static void pack(const MeshView &chunk,
+                     const VertexQuantization &quantization,
+                     unsigned char *out);
+
+    // Uploads the vertices of chunk from firstVertex on, packing them in
+    // staging first.
+    static void write(BufferObjectType *const *buffers, std::size_t firstVertex,
+                      const MeshView &chunk,
+                      const VertexQuantization &quantization,
+                      std::vector<unsigned char> &staging);
+};
+
+// Each attribute in a buffer of its own, in the order listed. The streams are
+// uploaded as they are, so quantized attributes are not supported.
+template <typename... Attributes>
+struct SplitLayout
+{
+    using BufferObjectType = OpenGL::OpenGLBufferObject;
+    using ShaderProgramType = OpenGL::OpenGLShaderProgram;
+
+    static constexpr std::size_t bufferCount{sizeof...(Attributes)};
+
+    static std::size_t vertexSize(std::size_t buffer) noexcept;
+
+    static void setUp(ShaderProgramType &program,
+                      BufferObjectType *const *buffers,
+                      std::size_t bufferOffset = 0);
+
+    // quantization and staging are not used.
+    static void write(BufferObjectType *const *buffers, std::size_t firstVertex,
+                      const MeshView &chunk,
+                      const VertexQuantization &quantization,
+                      std::vector<unsigned char> &staging);
+};
+
+// Picks the Layout instantiation for the streams present at run time: the
+// Required attributes followed by those of Optional whose flag in present is
+// set. Calls function.template apply<Layout<...>>().
+template <template <typename...> class Layout, typename Required,
+          typename Optional>
+struct VertexLayoutSelector;
+
+} // namespace Model
+
+#include "VertexLayout-inl.hpp"
+
+#endif // HOMEWORK01_MODEL_VERTEXLAYOUT_HPP_
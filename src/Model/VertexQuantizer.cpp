@@ -0,0 +1,197 @@
+#include "VertexQuantizer.hpp"
+
+#include "Detail/Quantization.hpp"
+
+#include "glm/common.hpp"
+#include "glm/trigonometric.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace Model
+{
+
+namespace Detail
+{
+
+glm::vec3 decodePosition(const unsigned char *encoded,
+                         VertexCompression compression,
+                         const VertexQuantization &quantization) noexcept;
+
+inline glm::vec3 decodePosition(const unsigned char *encoded,
+                                VertexCompression compression,
+                                const VertexQuantization &quantization) noexcept
+{
+    std::uint16_t value[3];
+    std::memcpy(value, encoded, sizeof(value));
+
+    glm::vec3 position;
+    for (int i{0}; i < 3; ++i)
+    {
+        position[i] = compression == VertexCompression::HalfFloat
+                          ? glm::unpackHalf1x16(value[i])
+                          : glm::unpackUnorm1x16(value[i]);
+    }
+    return quantization.positionOffset + quantization.positionScale * position;
+}
+
+} // namespace Detail
+
+VertexQuantization VertexQuantizer::fit(const MeshView &view,
+                                        VertexCompression compression)
+{
+    VertexQuantization quantization{VertexQuantization::identity()};
+    if (compression == VertexCompression::None)
+    {
+        return quantization;
+    }
+
+    const glm::vec3 extent{view.bounds.maximum - view.bounds.minimum};
+    if (compression == VertexCompression::HalfFloat)
+    {
+        quantization.positionOffset =
+            0.5f * (view.bounds.minimum + view.bounds.maximum);
+        quantization.positionScale = 0.5f * extent;
+    }
+    else
+    {
+        quantization.positionOffset = view.bounds.minimum;
+        quantization.positionScale = extent;
+    }
+
+    if (view.textureCoordinates && view.vertexCount)
+    {
+        glm::vec2 minimum{view.textureCoordinates[0],
+                          view.textureCoordinates[1]};
+        glm::vec2 maximum{minimum};
+        for (std::size_t i{1}; i < view.vertexCount; ++i)
+        {
+            const glm::vec2 coordinate{view.textureCoordinates[2 * i],
+                                       view.textureCoordinates[2 * i + 1]};
+            minimum = glm::min(minimum, coordinate);
+            maximum = glm::max(maximum, coordinate);
+        }
+        quantization.textureCoordinateOffset = minimum;
+        quantization.textureCoordinateScale = maximum - minimum;
+    }
+
+    // A flat axis would divide by zero; any scale decodes it exactly.
+    for (int i{0}; i < 3; ++i)
+    {
+        if (!(quantization.positionScale[i] > 0.0f))
+        {
+            quantization.positionScale[i] = 1.0f;
+        }
+    }
+    for (int i{0}; i < 2; ++i)
+    {
+        if (!(quantization.textureCoordinateScale[i] > 0.0f))
+        {
+            quantization.textureCoordinateScale[i] = 1.0f;
+        }
+    }
+    quantization.octahedralNormals = true;
+
+    return quantization;
+}
+
+QuantizationReport
+VertexQuantizer::measure(const MeshView &view, VertexCompression compression,
+                         const VertexQuantization &quantization)
+{
+    const std::size_t floatSize{
+        3 * sizeof(float) + (view.normals ? 3 * sizeof(float) : 0) +
+        (view.textureCoordinates ? 2 * sizeof(float) : 0) +
+        (view.colors ? 4 : 0) + (view.tangents ? 4 * sizeof(float) : 0)};
+
+    QuantizationReport report{floatSize * view.vertexCount,
+                               floatSize * view.vertexCount,
+                               0,
+                               0,
+                               0.0f,
+                               0.0f,
+                               0.0f};
+    if (compression == VertexCompression::None)
+    {
+        return report;
+    }
+
+    const std::size_t compressedSize{
+        Normalized16PositionAttribute::byteSize +
+        (view.normals ? OctahedralNormalAttribute::byteSize : 0) +
+        (view.textureCoordinates
+             ? Normalized16TextureCoordinateAttribute::byteSize
+             : 0) +
+        (view.colors ? ColorAttribute::byteSize : 0) +
+        (view.tangents ? Normalized16TangentAttribute::byteSize : 0)};
+    report.compressedVertexBytes = compressedSize * view.vertexCount;
+
+    unsigned char encoded[8];
+    for (std::size_t i{0}; i < view.vertexCount; ++i)
+    {
+        if (compression == VertexCompression::HalfFloat)
+        {
+            HalfPositionAttribute::encode(view, i, quantization, encoded);
+        }
+        else
+        {
+            Normalized16PositionAttribute::encode(view, i, quantization,
+                                                  encoded);
+        }
+        const glm::vec3 position{
+            Detail::decodePosition(encoded, compression, quantization)};
+        for (int j{0}; j < 3; ++j)
+        {
+            report.maximumPositionError =
+                std::max(report.maximumPositionError,
+                         std::abs(position[j] - view.positions[3 * i + j]));
+        }
+
+        if (view.normals)
+        {
+            OctahedralNormalAttribute::encode(view, i, quantization, encoded);
+            std::uint16_t value[2];
+            std::memcpy(value, encoded, sizeof(value));
+            const glm::vec3 normal{Detail::octahedralDecode(
+                glm::vec2{glm::unpackSnorm1x16(value[0]),
+                          glm::unpackSnorm1x16(value[1])})};
+
+            const glm::vec3 source{view.normals[3 * i], view.normals[3 * i + 1],
+                                   view.normals[3 * i + 2]};
+            const float length{glm::length(source)};
+            if (length > 0.0f)
+            {
+                const float cosine{glm::clamp(
+                    glm::dot(normal, source / length), -1.0f, 1.0f)};
+                report.maximumNormalError =
+                    std::max(report.maximumNormalError,
+                             glm::degrees(std::acos(cosine)));
+            }
+        }
+
+        if (view.textureCoordinates)
+        {
+            Normalized16TextureCoordinateAttribute::encode(view, i,
+                                                           quantization,
+                                                           encoded);
+            std::uint16_t value[2];
+            std::memcpy(value, encoded, sizeof(value));
+            for (int j{0}; j < 2; ++j)
+            {
+                const float coordinate{
+                    quantization.textureCoordinateOffset[j] +
+                    quantization.textureCoordinateScale[j] *
+                        glm::unpackUnorm1x16(value[j])};
+                report.maximumTextureCoordinateError = std::max(
+                    report.maximumTextureCoordinateError,
+                    std::abs(coordinate - view.textureCoordinates[2 * i + j]));
+            }
+        }
+    }
+
+    return report;
+}
+
+} // namespace Model
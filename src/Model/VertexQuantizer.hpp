@@ -0,0 +1,67 @@
+#ifndef HOMEWORK01_MODEL_VERTEXQUANTIZER_HPP_
+#define HOMEWORK01_MODEL_VERTEXQUANTIZER_HPP_
+
+#include "MeshData.hpp"
+#include "VertexLayout.hpp"
+
+#include <cstddef>
+
+namespace Model
+{
+
+// Compressed vertex formats. Both store octahedral normals and 16-bit
+// normalized texture coordinates; they differ in how positions are stored.
+enum class VertexCompression
+{
+    None,
+    // 16-bit unsigned normalized positions across the bounds (8 bytes).
+    Normalized16,
+    // Half float positions around the center of the bounds (8 bytes).
+    HalfFloat
+};
+
+// Memory and precision cost of compressing one mesh. Errors are the largest
+// difference between a source attribute and its decoded value: in model
+// units for positions, in degrees for normals.
+struct QuantizationReport
+{
+    std::size_t vertexBytes;
+    std::size_t compressedVertexBytes;
+    std::size_t indexBytes;
+    std::size_t compressedIndexBytes;
+    float maximumPositionError;
+    float maximumNormalError;
+    float maximumTextureCoordinateError;
+};
+
+// Vertices of a mesh already interleaved, and encoded when compressed, as a
+// Mesh over buffer heaps stores them, with what it took to encode them. The
+// bytes are not owned.
+struct VertexImage
+{
+    VertexCompression compression;
+    VertexQuantization quantization;
+    QuantizationReport report;
+    const unsigned char *data;
+    std::size_t size;
+};
+
+class VertexQuantizer
+{
+public:
+    // Decode parameters that fit the streams of view into the compressed
+    // ranges.
+    static VertexQuantization fit(const MeshView &view,
+                                  VertexCompression compression);
+
+    // Encodes and decodes every vertex to measure the error. The index
+    // fields of the report are left for the caller, which picks the index
+    // type.
+    static QuantizationReport measure(const MeshView &view,
+                                      VertexCompression compression,
+                                      const VertexQuantization &quantization);
+};
+
+} // namespace Model
+
+#endif // HOMEWORK01_MODEL_VERTEXQUANTIZER_HPP_
@@ -1,25 +1,31 @@
-#ifndef HOMEWORK01_OPENGL_OPENGL_HPP_
-#define HOMEWORK01_OPENGL_OPENGL_HPP_
-
-#include "OpenGLBufferObject.hpp"
-#include "OpenGLException.hpp"
-#include "OpenGLModelObject.hpp"
-#include "OpenGLShader.hpp"
-#include "OpenGLShaderProgram.hpp"
-#include "OpenGLTexture.hpp"
-#include "OpenGLVertexArrayObject.hpp"
-
-/**
- * \brief This namespace represents OpenGL function and class.
- *
- * This  namespace contains multiple OpenGL function and class.
- *
- * \par Warning:
- * OpenGL is not thread safe.  Please use it under the same thread which
- * creates OpenGL content.
- */
-namespace OpenGL
-{
-} // namespace OpenGL
-
-#endif // HOMEWORK01_OPENGL_OPENGL_HPP_
+#ifndef HOMEWORK01_OPENGL_OPENGL_HPP_
+#define HOMEWORK01_OPENGL_OPENGL_HPP_
+
+#include "OpenGLBufferObject.hpp"
+#include "OpenGLDrawIndirect.hpp"
+#include "OpenGLException.hpp"
+#include "OpenGLModelObject.hpp"
+#include "OpenGLShader.hpp"
+#include "OpenGLShaderProgram.hpp"
+#include "OpenGLStateCache.hpp"
+#include "OpenGLStd140Layout.hpp"
+#include "OpenGLStreamBuffer.hpp"
+#include "OpenGLTexture.hpp"
+#include "OpenGLUniformBuffer.hpp"
+#include "OpenGLUniformName.hpp"
+#include "OpenGLVertexArrayObject.hpp"
+
+/**
+ * \brief This namespace represents OpenGL function and class.
+ *
+ * This  namespace contains multiple OpenGL function and class.
+ *
+ * \par Warning:
+ * OpenGL is not thread safe.  Please use it under the same thread which
+ * creates OpenGL content.
+ */
+namespace OpenGL
+{
+} // namespace OpenGL
+
+#endif // HOMEWORK01_OPENGL_OPENGL_HPP_
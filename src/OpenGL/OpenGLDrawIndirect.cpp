@@ -0,0 +1,54 @@
+#include "OpenGLDrawIndirect.hpp"
+
+#include "Utils/Global.hpp"
+
+namespace OpenGL
+{
+
+namespace Detail
+{
+
+using MultiDrawElementsIndirect = void(APIENTRYP)(GLenum mode, GLenum type,
+                                                  const void *indirect,
+                                                  GLsizei drawCount,
+                                                  GLsizei stride);
+
+MultiDrawElementsIndirect multiDrawElementsIndirect{nullptr};
+
+} // namespace Detail
+
+bool OpenGLDrawIndirect::available() noexcept
+{
+    return Detail::multiDrawElementsIndirect != nullptr;
+}
+
+bool OpenGLDrawIndirect::load(GLADloadproc loader) noexcept
+{
+    Detail::multiDrawElementsIndirect = nullptr;
+
+    GLint major{0};
+    GLint minor{0};
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major < 4 || (major == 4 && minor < 3))
+    {
+        return false;
+    }
+
+    Detail::multiDrawElementsIndirect =
+        reinterpret_cast<Detail::MultiDrawElementsIndirect>(
+            loader("glMultiDrawElementsIndirect"));
+    return available();
+}
+
+void OpenGLDrawIndirect::multiDrawElements(GLenum type, GLintptr offset,
+                                           GLsizei drawCount) noexcept
+{
+    PROGRAM_ASSERT(available());
+
+    Detail::multiDrawElementsIndirect(
+        GL_TRIANGLES, type, PROGRAM_BUFFER_OFFSET(offset), drawCount,
+        static_cast<GLsizei>(sizeof(DrawElementsIndirectCommand)));
+}
+
+} // namespace OpenGL
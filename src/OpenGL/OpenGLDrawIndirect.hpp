@@ -0,0 +1,83 @@
+#ifndef HOMEWORK01_OPENGL_OPENGLDRAWINDIRECT_HPP_
+#define HOMEWORK01_OPENGL_OPENGLDRAWINDIRECT_HPP_
+
+#include "glad/glad.h"
+
+namespace OpenGL
+{
+
+/**
+ * \brief One command of an indirect draw, laid out as OpenGL reads it from
+ * a draw indirect buffer.
+ */
+struct DrawElementsIndirectCommand
+{
+    /**
+     * \brief Number of indices drawn.
+     */
+    GLuint count;
+    /**
+     * \brief Number of instances drawn.
+     */
+    GLuint instanceCount;
+    /**
+     * \brief First index, in indices rather than bytes.
+     */
+    GLuint firstIndex;
+    /**
+     * \brief Added to every index before the vertices are fetched.
+     */
+    GLint baseVertex;
+    /**
+     * \brief First instance; attributes with a divisor start reading here.
+     */
+    GLuint baseInstance;
+};
+
+/**
+ * \brief Multi-draw indirect submission of OpenGL 4.3.
+ *
+ * \par Note:
+ * The loader of this program is generated for OpenGL 3.3 core, so the entry
+ * point is looked up here when the context turns out to be recent enough.
+ * Drivers usually create the newest core context compatible with the one
+ * requested, so a 3.3 request still gets it on most systems, Mesa's
+ * llvmpipe included.
+ *
+ * \par Warning:
+ * This class is not thread safe. Please use it under the same thread which
+ * creates OpenGL content.
+ */
+class OpenGLDrawIndirect
+{
+public:
+    /**
+     * \brief Look up the entry point through \a loader for the current
+     * context.
+     *
+     * \param loader The function the OpenGL loader was initialized with.
+     * \return Return \c true If the context is OpenGL 4.3 or later and the
+     * entry point was found. Otherwise return \c false.
+     */
+    static bool load(GLADloadproc loader) noexcept;
+    /**
+     * \brief Whether load succeeded.
+     */
+    static bool available() noexcept;
+
+    /**
+     * \brief Draw \a drawCount commands read from the bound draw indirect
+     * buffer, starting \a offset bytes in, with the bound vertex array
+     * object.
+     *
+     * \param type The type of the indices.
+     * \param offset Byte offset of the first command.
+     * \param drawCount Number of commands.
+     */
+    static void multiDrawElements(GLenum type, GLintptr offset,
+                                  GLsizei drawCount) noexcept;
+};
+
+} // namespace OpenGL
+
+#endif // HOMEWORK01_OPENGL_OPENGLDRAWINDIRECT_HPP_
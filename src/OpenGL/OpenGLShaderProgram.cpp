@@ -1,206 +1,398 @@
-#include "OpenGLShaderProgram.hpp"
-
-#include "OpenGLException.hpp"
-
-#include "Utils/Global.hpp"
-
-#include <iostream>
-
-namespace OpenGL
-{
-
-namespace Detail
-{
-
-constexpr GLuint noId{0};
-
-bool isCreated(GLuint id) noexcept;
-std::unique_ptr<OpenGLShader> makeShader(OpenGLShader::Type type);
-
-inline bool isCreated(GLuint id) noexcept { return static_cast<bool>(id); }
-
-std::unique_ptr<OpenGLShader> makeShader(OpenGLShader::Type type)
-{
-    std::unique_ptr<OpenGLShader> shader{nullptr};
-
-    try
-    {
-        shader.reset(new OpenGLShader{type});
-    }
-    catch (OpenGLException &e)
-    {
-
-        std::cerr << "[Error]" << e.what();
-
-        return std::unique_ptr<OpenGLShader>{nullptr};
-    }
-
-    return shader;
-}
-
-} // namespace Detail
-
-OpenGLShaderProgram::OpenGLShaderProgram() : id_{Detail::noId} { create(); }
-
-OpenGLShaderProgram::OpenGLShaderProgram(OpenGLShaderProgram &&other) noexcept
-    : id_{std::move(other.id_)}
-{
-    other.id_ = 0; // Avoid double deletion
-}
-
-OpenGLShaderProgram &
-OpenGLShaderProgram::operator=(OpenGLShaderProgram &&other) noexcept
-{
-    if (this != &other)
-    {
-        if (Detail::isCreated(id_))
-        {
-            tidy();
-        }
-
-        id_ = std::move(other.id_);
-        shaders_ = std::move(other.shaders_);
-
-        other.id_ = Detail::noId; // Avoid double deletion
-    }
-
-    return *this;
-}
-
-OpenGLShaderProgram::~OpenGLShaderProgram()
-{
-    if (Detail::isCreated(id_))
-    {
-        tidy();
-    }
-}
-
-bool OpenGLShaderProgram::addShaderFromFile(OpenGLShader::Type type,
-                                            const char *fileName) noexcept
-{
-    PROGRAM_ASSERT(Detail::isCreated(id_));
-
-    auto shader = Detail::makeShader(type);
-
-    if (!(shader.get()))
-    {
-        return false;
-    }
-
-    if (!shader->compileFromFile(fileName))
-    {
-        return false;
-    }
-
-    attachShader(std::move(shader));
-
-    return true;
-}
-
-bool OpenGLShaderProgram::addShaderFromSource(OpenGLShader::Type type,
-                                              const char *source) noexcept
-{
-    PROGRAM_ASSERT(Detail::isCreated(id_));
-
-    auto shader = Detail::makeShader(type);
-
-    if (!(shader.get()))
-    {
-        return false;
-    }
-
-    if (!shader->compileFromSource(source))
-    {
-        return false;
-    }
-
-    attachShader(std::move(shader));
-
-    return true;
-}
-
-void OpenGLShaderProgram::attachShader(
-    std::unique_ptr<OpenGLShader> &&shader) noexcept
-{
-    PROGRAM_ASSERT(Detail::isCreated(id_));
-    glAttachShader(id_, shader->id());
-    shaders_.push_back(std::move(shader));
-}
-
-void OpenGLShaderProgram::create()
-{
-    PROGRAM_ASSERT(!Detail::isCreated(id_));
-    id_ = glCreateProgram();
-
-    if (!Detail::isCreated(id_))
-    {
-        throw OpenGLException("OpenGLShaderProgram failed to instantiate.");
-    }
-}
-
-void OpenGLShaderProgram::destroyProgram() noexcept
-{
-    PROGRAM_ASSERT(Detail::isCreated(id_));
-    glDeleteProgram(id_);
-
-    id_ = Detail::noId;
-}
-
-void OpenGLShaderProgram::destroyShaders() noexcept
-{
-    PROGRAM_ASSERT(Detail::isCreated(id_));
-
-    for (auto &shader : shaders_)
-    {
-        glDeleteShader(shader->id());
-        shader.reset(nullptr);
-    }
-
-    shaders_.clear();
-}
-
-void OpenGLShaderProgram::disableAttributeArray(GLuint index) noexcept
-{
-    glDisableVertexAttribArray(index);
-}
-
-void OpenGLShaderProgram::enableAttributeArray(GLuint index) noexcept
-{
-    glEnableVertexAttribArray(index);
-}
-
-GLuint OpenGLShaderProgram::id() const noexcept { return id_; }
-
-void OpenGLShaderProgram::link() noexcept 
-{ 
-    glLinkProgram(id_);
-}
-
-bool OpenGLShaderProgram::linkStatus() const noexcept
-{
-    GLint status;
-    glGetProgramiv(id_, GL_LINK_STATUS, &status);
-    return (status == GL_TRUE);
-}
-
-void OpenGLShaderProgram::mapAttributePointer(GLuint index, GLint size,
-                                              GLenum type, GLboolean normalized,
-                                              GLsizei stride,
-                                              int offset) noexcept
-{
-    glVertexAttribPointer(index, size, type, normalized, stride,(GLvoid *)offset);
-}
-
-void OpenGLShaderProgram::tidy() noexcept
-{
-    PROGRAM_ASSERT(Detail::isCreated(id_));
-    destroyShaders();
-    destroyProgram();
-}
-
-void OpenGLShaderProgram::use() noexcept 
-{
-    glUseProgram(id_);
-}
-
-} // namespace OpenGL
+#include "OpenGLShaderProgram.hpp"
+
+#include "OpenGLException.hpp"
+#include "OpenGLStateCache.hpp"
+
+#include "Utils/Global.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+namespace OpenGL
+{
+
+namespace Detail
+{
+
+constexpr GLuint noId{0};
+constexpr std::int32_t emptySlot{-1};
+
+bool isCreated(GLuint id) noexcept;
+std::unique_ptr<OpenGLShader> makeShader(OpenGLShader::Type type);
+std::size_t uniformSlotCount(std::size_t uniformCount) noexcept;
+
+inline bool isCreated(GLuint id) noexcept { return static_cast<bool>(id); }
+
+std::unique_ptr<OpenGLShader> makeShader(OpenGLShader::Type type)
+{
+    std::unique_ptr<OpenGLShader> shader{nullptr};
+
+    try
+    {
+        shader.reset(new OpenGLShader{type});
+    }
+    catch (OpenGLException &e)
+    {
+
+        std::cerr << "[Error]" << e.what();
+
+        return std::unique_ptr<OpenGLShader>{nullptr};
+    }
+
+    return shader;
+}
+
+// A power of two at least twice the number of uniforms, so a probe meets an
+// empty slot soon.
+inline std::size_t uniformSlotCount(std::size_t uniformCount) noexcept
+{
+    std::size_t count{8};
+    while (count < 2 * uniformCount)
+    {
+        count *= 2;
+    }
+    return count;
+}
+
+} // namespace Detail
+
+OpenGLShaderProgram::OpenGLShaderProgram()
+    : id_{Detail::noId}, shaders_{}, uniforms_{}, keys_{}, slots_{},
+      statistics_{}
+{
+    create();
+}
+
+OpenGLShaderProgram::OpenGLShaderProgram(OpenGLShaderProgram &&other) noexcept
+    : id_{std::move(other.id_)}, shaders_{std::move(other.shaders_)},
+      uniforms_{std::move(other.uniforms_)}, keys_{std::move(other.keys_)},
+      slots_{std::move(other.slots_)},
+      statistics_{other.statistics_}
+{
+    other.id_ = 0; // Avoid double deletion
+}
+
+OpenGLShaderProgram &
+OpenGLShaderProgram::operator=(OpenGLShaderProgram &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (Detail::isCreated(id_))
+        {
+            tidy();
+        }
+
+        id_ = std::move(other.id_);
+        shaders_ = std::move(other.shaders_);
+        uniforms_ = std::move(other.uniforms_);
+        keys_ = std::move(other.keys_);
+        slots_ = std::move(other.slots_);
+        statistics_ = other.statistics_;
+
+        other.id_ = Detail::noId; // Avoid double deletion
+    }
+
+    return *this;
+}
+
+OpenGLShaderProgram::~OpenGLShaderProgram()
+{
+    if (Detail::isCreated(id_))
+    {
+        tidy();
+    }
+}
+
+std::size_t OpenGLShaderProgram::addUniform(std::string name, GLint location)
+{
+    const std::uint32_t hash{Detail::hashUniformName(name.c_str())};
+    uniforms_.push_back(Uniform{location, 0, {}});
+    keys_.push_back(UniformKey{hash, std::move(name), uniforms_.size() - 1});
+    return uniforms_.size() - 1;
+}
+
+bool OpenGLShaderProgram::addShaderFromFile(OpenGLShader::Type type,
+                                            const char *fileName) noexcept
+{
+    PROGRAM_ASSERT(Detail::isCreated(id_));
+
+    auto shader = Detail::makeShader(type);
+
+    if (!(shader.get()))
+    {
+        return false;
+    }
+
+    if (!shader->compileFromFile(fileName))
+    {
+        return false;
+    }
+
+    attachShader(std::move(shader));
+
+    return true;
+}
+
+bool OpenGLShaderProgram::addShaderFromSource(OpenGLShader::Type type,
+                                              const char *source) noexcept
+{
+    PROGRAM_ASSERT(Detail::isCreated(id_));
+
+    auto shader = Detail::makeShader(type);
+
+    if (!(shader.get()))
+    {
+        return false;
+    }
+
+    if (!shader->compileFromSource(source))
+    {
+        return false;
+    }
+
+    attachShader(std::move(shader));
+
+    return true;
+}
+
+void OpenGLShaderProgram::attachShader(
+    std::unique_ptr<OpenGLShader> &&shader) noexcept
+{
+    PROGRAM_ASSERT(Detail::isCreated(id_));
+    glAttachShader(id_, shader->id());
+    shaders_.push_back(std::move(shader));
+}
+
+bool OpenGLShaderProgram::bindUniformBlock(const char *name,
+                                           GLuint binding) noexcept
+{
+    PROGRAM_ASSERT(Detail::isCreated(id_));
+
+    const GLuint index{glGetUniformBlockIndex(id_, name)};
+    if (index == GL_INVALID_INDEX)
+    {
+        return false;
+    }
+    glUniformBlockBinding(id_, index, binding);
+    return true;
+}
+
+void OpenGLShaderProgram::create()
+{
+    PROGRAM_ASSERT(!Detail::isCreated(id_));
+    id_ = glCreateProgram();
+
+    if (!Detail::isCreated(id_))
+    {
+        throw OpenGLException("OpenGLShaderProgram failed to instantiate.");
+    }
+}
+
+void OpenGLShaderProgram::destroyProgram() noexcept
+{
+    PROGRAM_ASSERT(Detail::isCreated(id_));
+    OpenGLStateCache::forgetProgram(id_);
+    glDeleteProgram(id_);
+
+    id_ = Detail::noId;
+}
+
+void OpenGLShaderProgram::destroyShaders() noexcept
+{
+    PROGRAM_ASSERT(Detail::isCreated(id_));
+
+    for (auto &shader : shaders_)
+    {
+        glDeleteShader(shader->id());
+        shader.reset(nullptr);
+    }
+
+    shaders_.clear();
+}
+
+void OpenGLShaderProgram::disableAttributeArray(GLuint index) noexcept
+{
+    glDisableVertexAttribArray(index);
+}
+
+void OpenGLShaderProgram::enableAttributeArray(GLuint index) noexcept
+{
+    glEnableVertexAttribArray(index);
+}
+
+GLuint OpenGLShaderProgram::id() const noexcept { return id_; }
+
+void OpenGLShaderProgram::link() noexcept
+{
+    glLinkProgram(id_);
+    loadUniforms();
+}
+
+bool OpenGLShaderProgram::linkStatus() const noexcept
+{
+    GLint status;
+    glGetProgramiv(id_, GL_LINK_STATUS, &status);
+    return (status == GL_TRUE);
+}
+
+// Uniforms in blocks have no location and are left out. An array is listed
+// once, as its first element "name[0]", so every element is added by name
+// and "name" is added as the first element too.
+void OpenGLShaderProgram::loadUniforms()
+{
+    uniforms_.clear();
+    keys_.clear();
+    slots_.clear();
+    statistics_ = Statistics{};
+    if (!linkStatus())
+    {
+        return;
+    }
+
+    GLint count{0};
+    GLint maxLength{0};
+    glGetProgramiv(id_, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(id_, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+    std::vector<GLchar> buffer(static_cast<std::size_t>(maxLength) + 1);
+    for (GLint i{0}; i < count; ++i)
+    {
+        GLsizei length{0};
+        GLint size{0};
+        GLenum type{0};
+        glGetActiveUniform(id_, static_cast<GLuint>(i),
+                           static_cast<GLsizei>(buffer.size()), &length, &size,
+                           &type, buffer.data());
+        const GLint location{glGetUniformLocation(id_, buffer.data())};
+        if (location == -1)
+        {
+            continue;
+        }
+
+        std::string name{buffer.data(), static_cast<std::size_t>(length)};
+        const bool listedAsArray{name.size() > 3 &&
+                                 name.compare(name.size() - 3, 3, "[0]") == 0};
+        if (!listedAsArray && size <= 1)
+        {
+            addUniform(std::move(name), location);
+            continue;
+        }
+
+        if (listedAsArray)
+        {
+            name.resize(name.size() - 3);
+        }
+        const std::size_t first{addUniform(name + "[0]", location)};
+        keys_.push_back(UniformKey{Detail::hashUniformName(name.c_str()),
+                                   name, first});
+        for (GLint element{1}; element < size; ++element)
+        {
+            std::string elementName{name + "[" + std::to_string(element) +
+                                    "]"};
+            const GLint elementLocation{
+                glGetUniformLocation(id_, elementName.c_str())};
+            if (elementLocation != -1)
+            {
+                addUniform(std::move(elementName), elementLocation);
+            }
+        }
+    }
+
+    slots_.assign(Detail::uniformSlotCount(keys_.size()), Detail::emptySlot);
+    const std::size_t mask{slots_.size() - 1};
+    for (std::size_t i{0}; i < keys_.size(); ++i)
+    {
+        std::size_t slot{keys_[i].hash & mask};
+        while (slots_[slot] != Detail::emptySlot)
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = static_cast<std::int32_t>(i);
+    }
+    statistics_.uniformCount = uniforms_.size();
+}
+
+// Probes the slots from the hash of the name; the hash is compared before
+// the name, so a miss rarely reaches strcmp.
+GLint OpenGLShaderProgram::locationToSet(OpenGLUniformName name,
+                                         const void *value, std::size_t size,
+                                         bool transpose) const noexcept
+{
+    PROGRAM_ASSERT(size < sizeof(Uniform::shadow));
+
+    Uniform *uniform{nullptr};
+    if (!slots_.empty())
+    {
+        const std::size_t mask{slots_.size() - 1};
+        for (std::size_t slot{name.hash() & mask};
+             slots_[slot] != Detail::emptySlot; slot = (slot + 1) & mask)
+        {
+            const UniformKey &candidate{
+                keys_[static_cast<std::size_t>(slots_[slot])]};
+            if (candidate.hash == name.hash() &&
+                std::strcmp(candidate.name.c_str(), name.name()) == 0)
+            {
+                uniform = &uniforms_[candidate.uniform];
+                break;
+            }
+        }
+    }
+    if (!uniform)
+    {
+        ++statistics_.unknownCount;
+        return -1;
+    }
+
+    const unsigned char transposed{static_cast<unsigned char>(transpose)};
+    if (uniform->shadowSize == size + 1 &&
+        std::memcmp(uniform->shadow.data(), value, size) == 0 &&
+        uniform->shadow[size] == transposed)
+    {
+        ++statistics_.skippedCount;
+        return -1;
+    }
+
+    std::memcpy(uniform->shadow.data(), value, size);
+    uniform->shadow[size] = transposed;
+    uniform->shadowSize = size + 1;
+    ++statistics_.updateCount;
+    return uniform->location;
+}
+
+void OpenGLShaderProgram::mapAttributePointer(GLuint index, GLint size,
+                                              GLenum type, GLboolean normalized,
+                                              GLsizei stride,
+                                              int offset) noexcept
+{
+    glVertexAttribPointer(index, size, type, normalized, stride,
+                          reinterpret_cast<GLvoid *>(
+                              static_cast<std::intptr_t>(offset)));
+}
+
+void OpenGLShaderProgram::setAttributeDivisor(GLuint index,
+                                              GLuint divisor) noexcept
+{
+    glVertexAttribDivisor(index, divisor);
+}
+
+OpenGLShaderProgram::Statistics
+OpenGLShaderProgram::statistics() const noexcept
+{
+    return statistics_;
+}
+
+void OpenGLShaderProgram::tidy() noexcept
+{
+    PROGRAM_ASSERT(Detail::isCreated(id_));
+    destroyShaders();
+    destroyProgram();
+}
+
+void OpenGLShaderProgram::use() noexcept
+{
+    PROGRAM_ASSERT(Detail::isCreated(id_));
+    OpenGLStateCache::useProgram(id_);
+}
+
+} // namespace OpenGL
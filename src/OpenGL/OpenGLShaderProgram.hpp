@@ -1,286 +1,435 @@
-#ifndef HOMEWORK01_OPENGL_SHADERPROGRAM_HPP_
-#define HOMEWORK01_OPENGL_SHADERPROGRAM_HPP_
-
-#include "OpenGLShader.hpp"
-
-#include "glad/glad.h"
-
-#include "glm/detail/qualifier.hpp"
-
-#include <memory>
-#include <vector>
-
-namespace OpenGL
-{
-
-/**
- * \brief This class represents the OpenGL shader program.
- *
- * \details OpenGLShaderProgram allow the compiled shader to be linked and use.
- *
- * \par Warning:
- * This class is not thread safe. Please use it under the same thread which
- * creates OpenGL content.
- *
- * \sa OpenGLShader
- */
-class OpenGLShaderProgram
-{
-public:
-    /**
-     * \brief Initializes a new instance of the OpenGLShaderProgram class.
-     *
-     */
-    explicit OpenGLShaderProgram();
-
-    /**
-     * \brief Initializes a new instance of the OpenGLShaderProgram class with
-     * the content of \a other.
-     *
-     * \param other Another object to assign with.
-     */
-    OpenGLShaderProgram(OpenGLShaderProgram &&other) noexcept;
-    /**
-     * \brief Initializes a new instance of the OpenGLShaderProgram class with
-     * the content of \a other.
-     *
-     * \param other Another object to assign with.
-     */
-    OpenGLShaderProgram &operator=(OpenGLShaderProgram &&other) noexcept;
-    /**
-     * \brief Destroy the instance of the OpenGLShaderProgram class.
-     */
-    ~OpenGLShaderProgram();
-
-    OpenGLShaderProgram(const OpenGLShaderProgram &other) = delete;
-    OpenGLShaderProgram &operator=(const OpenGLShaderProgram &other) = delete;
-
-    /**
-     * \brief Link the shaders in the OpenGLShaderProgram together.
-     */
-    void link() noexcept;
-
-    /**
-     * \brief Compile the source code of the \a fileName to the specified \a
-     * type OpenGL::OpenGLShader and add it to the OpenGLShaderProgram.
-     *
-     * \param type Shader type.
-     * \param fileName File name of the source code.
-     * \return Return \c true If the shader is compile and add successfully.
-     * Otherwise return \c false.
-     *
-     * \sa OpenGLShaderProgram::addShaderFromSource
-     */
-    bool addShaderFromFile(OpenGLShader::Type type,
-                           const char *fileName) noexcept;
-    /**
-     * \brief Compile the \a source content to the specified \a type
-     * OpenGL::OpenGLShader and add it to the OpenGLShaderProgram.
-     *
-     * \param type Shader type.
-     * \param source Source code content.
-     * \return Return \c true If the shader is compile and add successfully.
-     * Otherwise return \c false.
-     *
-     * \sa OpenGLShaderProgram::addShaderFromFile
-     */
-    bool addShaderFromSource(OpenGLShader::Type type,
-                             const char *source) noexcept;
-
-    /**
-     * \brief Disable the vertex attribute at \a index in the
-     * OpenGLShaderProgram.
-     *
-     * \param index Given index.
-     *
-     * \sa OpenGLShaderProgram::enableAttributeArray
-     */
-    void disableAttributeArray(GLuint index) noexcept;
-    /**
-     * \brief Enable the vertex attribute at \a index in the
-     * OpenGLShaderProgram.
-     *
-     * \param index Given index.
-     *
-     * \sa OpenGLShaderProgram::disableAttributeArray
-     */
-    void enableAttributeArray(GLuint index) noexcept;
-
-    /**
-     * \brief Set the location and format of the array of attributes at \a index
-     * in OpenGLShaderProgram.
-     *
-     * \param index The index location of the shader.
-     * \param size The number of components per attribute. Must be 1, 2, 3, 4.
-     * \param type The data type of the array of the attribute. Normally will be
-     * \c GL_BYTE, \c GL_UNSIGNED_BYTE, \c GL_SHORT, \c GL_UNSIGNED_SHORT, \c
-     * GL_INT, and \c GL_UNSIGNED_INT.
-     * \param normalized \c GL_TRUE if the fixed-point data values should be
-     * normalized. Or \c GL_FALSE if the data values is convert directly.
-     * \param stride The number of bytes between each attributes.
-     * \param offset The number of bytes offset of the first attributes.
-     */
-    void mapAttributePointer(GLuint index, GLint size, GLenum type,
-                             GLboolean normalized, GLsizei stride,
-                             int offset) noexcept;
-
-    /**
-     * \brief Use the OpenGLShaderProgram to the current rendering state.
-     */
-    void use() noexcept;
-
-    /**
-     * @brief Set the uniform value with the given \a name to \a value.
-     *
-     * \tparam T Must be \c bool, \c int, \c unsigned int, and \c float type.
-     * \param name The name of the specified value.
-     * \param value Specified value.
-     */
-    template <typename T>
-    void setValue(const char *name, T value) const noexcept;
-    /**
-     * \overload
-     *
-     * \brief Set the uniform value with the given \a name to vector( \a x, \a y
-     * ).
-     *
-     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
-     * \param name The name of the specified value.
-     * \param x Specified value of the x component.
-     * \param y Specified value of the y component.
-     */
-    template <typename T>
-    void setValue(const char *name, T x, T y) const noexcept;
-    /**
-     * \overload
-     *
-     * \brief Set the uniform value with the given \a name to \a vector.
-     *
-     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
-     * \param name The name of the specified value.
-     * \param vector Specified value.
-     */
-    template <typename T>
-    void setValue(const char *name, glm::vec<2, T> vector) const noexcept;
-    /**
-     * \overload
-     *
-     * \brief Set the uniform value with the given \a name to vector( \a x, \a y
-     * \a z).
-     *
-     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
-     * \param name The name of the specified value.
-     * \param x Specified value of the x component.
-     * \param y Specified value of the y component.
-     * \param z Specified value of the z component.
-     */
-    template <typename T>
-    void setValue(const char *name, T x, T y, T z) const noexcept;
-    /**
-     * \overload
-     *
-     * \brief Set the uniform value with the given \a name to \a vector.
-     *
-     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
-     * \param name The name of the specified value.
-     * \param vector Specified value.
-     */
-    template <typename T>
-    void setValue(const char *name, glm::vec<3, T> vector) const noexcept;
-    /**
-     * \overload
-     *
-     * \brief Set the uniform value with the given \a name to vector( \a x, \a y
-     * \a z).
-     *
-     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
-     * \param name The name of the specified value.
-     * \param x Specified value of the x component.
-     * \param y Specified value of the y component.
-     * \param z Specified value of the z component.
-     */
-    template <typename T>
-    void setValue(const char *name, T x, T y, T z, T w) const noexcept;
-    /**
-     * \overload
-     *
-     * \brief Set the uniform value with the given \a name to \a vector.
-     *
-     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
-     * \param name The name of the specified value.
-     * \param vector Specified value.
-     */
-    template <typename T>
-    void setValue(const char *name, glm::vec<4, T> vector) const noexcept;
-    /**
-     * \overload
-     *
-     * \brief Set the uniform value with the given \a name to \a matrix with or
-     * without \a transpose.
-     *
-     * @tparam row Must be 2, 3, 4.
-     * @tparam column Must be 2, 3, 4.
-     * @param name The name of the specified value.
-     * @param matrix Specified matrix.
-     * @param transpose The matrix should be transpose or not.
-     */
-    template <int row, int column>
-    void setValue(const char *name, glm::mat<row, column, float> matrix,
-                  bool transpose) const noexcept;
-
-    /**
-     * \brief Gets the link status of the OpenGLShader
-     *
-     * \return Specified link status.
-     */
-    bool linkStatus() const noexcept;
-    /**
-     * \brief Gets the id of the OpenGLShader
-     *
-     * \return Specified id.
-     */
-    GLuint id() const noexcept;
-
-private:
-    /**
-     * \brief Attach the shader to the OpenGLShaderProgram
-     *
-     * \param shader Specified shader.
-     */
-    void attachShader(std::unique_ptr<OpenGLShader> &&shader) noexcept;
-
-    /**
-     * \brief Create the buffer.
-     *
-     * \exception OpenGLException Buffer failed to instantiate.
-     */
-    void create();
-    /**
-     * \brief Clean up and delete the buffer.
-     */
-    void tidy() noexcept;
-    /**
-     * \brief Destroy the shader program.
-     */
-    void destroyProgram() noexcept;
-    /**
-     * \brief Destroy the shader which attached to the program.
-     */
-    void destroyShaders() noexcept;
-
-    /**
-     * \brief The id of the OpenGLShaderProgram.
-     */
-    GLuint id_;
-
-    /**
-     * \brief  The shader of the OpenGLShaderProgram.
-     */
-    std::vector<std::unique_ptr<OpenGLShader>> shaders_;
-};
-
-} // namespace OpenGL
-
-#include "OpenGLShaderProgram-inl.hpp"
-
-#endif // HOMEWORK01_OPENGL_SHADERPROGRAM_HPP_
+#ifndef HOMEWORK01_OPENGL_SHADERPROGRAM_HPP_
+#define HOMEWORK01_OPENGL_SHADERPROGRAM_HPP_
+
+#include "OpenGLShader.hpp"
+#include "OpenGLUniformName.hpp"
+
+#include "glad/glad.h"
+
+#include "glm/detail/qualifier.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace OpenGL
+{
+
+/**
+ * \brief This structure represents the uniform counters of an
+ * OpenGLShaderProgram.
+ */
+struct OpenGLShaderProgramStatistics
+{
+    /**
+     * \brief The number of active uniforms found at the last link.
+     */
+    std::size_t uniformCount;
+    /**
+     * \brief The number of values sent to OpenGL.
+     */
+    std::size_t updateCount;
+    /**
+     * \brief The number of values equal to the last one sent, and so skipped.
+     */
+    std::size_t skippedCount;
+    /**
+     * \brief The number of values set by a name which is not an active
+     * uniform.
+     */
+    std::size_t unknownCount;
+};
+
+/**
+ * \brief This class represents the OpenGL shader program.
+ *
+ * \details OpenGLShaderProgram allow the compiled shader to be linked and use.
+ * Linking enumerates the active uniforms into a table hashed by name, so
+ * setting a uniform does not query its location. The last value set to each
+ * uniform is kept, and setting the same value again makes no OpenGL call.
+ * Data that changes per draw belongs in uniform blocks, see
+ * OpenGLUniformBuffer; the table serves the uniforms outside blocks, such
+ * as samplers, and programs without blocks.
+ *
+ * \par Warning:
+ * This class is not thread safe. Please use it under the same thread which
+ * creates OpenGL content.
+ *
+ * \sa OpenGLShader
+ */
+class OpenGLShaderProgram
+{
+public:
+    using Statistics = OpenGLShaderProgramStatistics;
+
+    /**
+     * \brief Initializes a new instance of the OpenGLShaderProgram class.
+     *
+     */
+    explicit OpenGLShaderProgram();
+
+    /**
+     * \brief Initializes a new instance of the OpenGLShaderProgram class with
+     * the content of \a other.
+     *
+     * \param other Another object to assign with.
+     */
+    OpenGLShaderProgram(OpenGLShaderProgram &&other) noexcept;
+    /**
+     * \brief Initializes a new instance of the OpenGLShaderProgram class with
+     * the content of \a other.
+     *
+     * \param other Another object to assign with.
+     */
+    OpenGLShaderProgram &operator=(OpenGLShaderProgram &&other) noexcept;
+    /**
+     * \brief Destroy the instance of the OpenGLShaderProgram class.
+     */
+    ~OpenGLShaderProgram();
+
+    OpenGLShaderProgram(const OpenGLShaderProgram &other) = delete;
+    OpenGLShaderProgram &operator=(const OpenGLShaderProgram &other) = delete;
+
+    /**
+     * \brief Link the shaders in the OpenGLShaderProgram together and
+     * enumerate the active uniforms.
+     */
+    void link() noexcept;
+
+    /**
+     * \brief Compile the source code of the \a fileName to the specified \a
+     * type OpenGL::OpenGLShader and add it to the OpenGLShaderProgram.
+     *
+     * \param type Shader type.
+     * \param fileName File name of the source code.
+     * \return Return \c true If the shader is compile and add successfully.
+     * Otherwise return \c false.
+     *
+     * \sa OpenGLShaderProgram::addShaderFromSource
+     */
+    bool addShaderFromFile(OpenGLShader::Type type,
+                           const char *fileName) noexcept;
+    /**
+     * \brief Compile the \a source content to the specified \a type
+     * OpenGL::OpenGLShader and add it to the OpenGLShaderProgram.
+     *
+     * \param type Shader type.
+     * \param source Source code content.
+     * \return Return \c true If the shader is compile and add successfully.
+     * Otherwise return \c false.
+     *
+     * \sa OpenGLShaderProgram::addShaderFromFile
+     */
+    bool addShaderFromSource(OpenGLShader::Type type,
+                             const char *source) noexcept;
+
+    /**
+     * \brief Disable the vertex attribute at \a index in the
+     * OpenGLShaderProgram.
+     *
+     * \param index Given index.
+     *
+     * \sa OpenGLShaderProgram::enableAttributeArray
+     */
+    void disableAttributeArray(GLuint index) noexcept;
+    /**
+     * \brief Enable the vertex attribute at \a index in the
+     * OpenGLShaderProgram.
+     *
+     * \param index Given index.
+     *
+     * \sa OpenGLShaderProgram::disableAttributeArray
+     */
+    void enableAttributeArray(GLuint index) noexcept;
+
+    /**
+     * \brief Set the location and format of the array of attributes at \a index
+     * in OpenGLShaderProgram.
+     *
+     * \param index The index location of the shader.
+     * \param size The number of components per attribute. Must be 1, 2, 3, 4.
+     * \param type The data type of the array of the attribute. Normally will be
+     * \c GL_BYTE, \c GL_UNSIGNED_BYTE, \c GL_SHORT, \c GL_UNSIGNED_SHORT, \c
+     * GL_INT, and \c GL_UNSIGNED_INT.
+     * \param normalized \c GL_TRUE if the fixed-point data values should be
+     * normalized. Or \c GL_FALSE if the data values is convert directly.
+     * \param stride The number of bytes between each attributes.
+     * \param offset The number of bytes offset of the first attributes.
+     */
+    void mapAttributePointer(GLuint index, GLint size, GLenum type,
+                             GLboolean normalized, GLsizei stride,
+                             int offset) noexcept;
+    /**
+     * \brief Set how often the attribute at \a index advances during an
+     * instanced draw.
+     *
+     * \param index The index location of the shader.
+     * \param divisor \c 0 to advance once per vertex, otherwise once every
+     * \a divisor instances.
+     */
+    void setAttributeDivisor(GLuint index, GLuint divisor) noexcept;
+    /**
+     * \brief Read the uniform block \a name from the buffer range bound to
+     * \a binding.
+     *
+     * \param name The name of the uniform block.
+     * \param binding The uniform buffer binding point.
+     * \return Return \c true If the program has an active block \a name.
+     * Otherwise return \c false.
+     *
+     * \sa OpenGLUniformBuffer
+     */
+    bool bindUniformBlock(const char *name, GLuint binding) noexcept;
+
+    /**
+     * \brief Use the OpenGLShaderProgram to the current rendering state.
+     *
+     * \par Note:
+     * Nothing reaches OpenGL if the program is already in use, see
+     * OpenGLStateCache.
+     */
+    void use() noexcept;
+
+    /**
+     * @brief Set the uniform value with the given \a name to \a value.
+     *
+     * \par Note:
+     * An element of an array is named with its index, as \c lights[2] or
+     * \c lights[2].color; the name of the array alone sets element \c 0.
+     *
+     * \tparam T Must be \c bool, \c int, \c unsigned int, and \c float type.
+     * \param name The name of the specified value.
+     * \param value Specified value.
+     */
+    template <typename T>
+    void setValue(OpenGLUniformName name, T value) const noexcept;
+    /**
+     * \overload
+     *
+     * \brief Set the uniform value with the given \a name to vector( \a x, \a y
+     * ).
+     *
+     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
+     * \param name The name of the specified value.
+     * \param x Specified value of the x component.
+     * \param y Specified value of the y component.
+     */
+    template <typename T>
+    void setValue(OpenGLUniformName name, T x, T y) const noexcept;
+    /**
+     * \overload
+     *
+     * \brief Set the uniform value with the given \a name to \a vector.
+     *
+     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
+     * \param name The name of the specified value.
+     * \param vector Specified value.
+     */
+    template <typename T>
+    void setValue(OpenGLUniformName name, glm::vec<2, T> vector) const noexcept;
+    /**
+     * \overload
+     *
+     * \brief Set the uniform value with the given \a name to vector( \a x, \a y
+     * \a z).
+     *
+     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
+     * \param name The name of the specified value.
+     * \param x Specified value of the x component.
+     * \param y Specified value of the y component.
+     * \param z Specified value of the z component.
+     */
+    template <typename T>
+    void setValue(OpenGLUniformName name, T x, T y, T z) const noexcept;
+    /**
+     * \overload
+     *
+     * \brief Set the uniform value with the given \a name to \a vector.
+     *
+     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
+     * \param name The name of the specified value.
+     * \param vector Specified value.
+     */
+    template <typename T>
+    void setValue(OpenGLUniformName name, glm::vec<3, T> vector) const noexcept;
+    /**
+     * \overload
+     *
+     * \brief Set the uniform value with the given \a name to vector( \a x, \a y
+     * \a z).
+     *
+     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
+     * \param name The name of the specified value.
+     * \param x Specified value of the x component.
+     * \param y Specified value of the y component.
+     * \param z Specified value of the z component.
+     */
+    template <typename T>
+    void setValue(OpenGLUniformName name, T x, T y, T z, T w) const noexcept;
+    /**
+     * \overload
+     *
+     * \brief Set the uniform value with the given \a name to \a vector.
+     *
+     * \tparam T T Must be \c int, \c unsigned int, and \c float type.
+     * \param name The name of the specified value.
+     * \param vector Specified value.
+     */
+    template <typename T>
+    void setValue(OpenGLUniformName name, glm::vec<4, T> vector) const noexcept;
+    /**
+     * \overload
+     *
+     * \brief Set the uniform value with the given \a name to \a matrix with or
+     * without \a transpose.
+     *
+     * @tparam row Must be 2, 3, 4.
+     * @tparam column Must be 2, 3, 4.
+     * @param name The name of the specified value.
+     * @param matrix Specified matrix.
+     * @param transpose The matrix should be transpose or not.
+     */
+    template <int row, int column>
+    void setValue(OpenGLUniformName name, glm::mat<row, column, float> matrix,
+                  bool transpose) const noexcept;
+
+    /**
+     * \brief Gets the link status of the OpenGLShader
+     *
+     * \return Specified link status.
+     */
+    bool linkStatus() const noexcept;
+    /**
+     * \brief Gets the id of the OpenGLShader
+     *
+     * \return Specified id.
+     */
+    GLuint id() const noexcept;
+    /**
+     * \brief Gets the uniform counters of the OpenGLShaderProgram.
+     *
+     * \return Specified statistics.
+     */
+    Statistics statistics() const noexcept;
+
+private:
+    /**
+     * \brief This structure represents an active uniform, or one element of
+     * an active array, and the last value set to it.
+     */
+    struct Uniform
+    {
+        GLint location;
+        /**
+         * \brief The size of the last value in bytes, \c 0 if none was set.
+         */
+        std::size_t shadowSize;
+        /**
+         * \brief The bytes of the last value; a 4x4 matrix and its transpose
+         * flag at most.
+         */
+        std::array<unsigned char, 68> shadow;
+    };
+
+    /**
+     * \brief This structure represents a name a uniform is set by. The first
+     * element of an array has two, \c name and \c name[0].
+     */
+    struct UniformKey
+    {
+        std::uint32_t hash;
+        std::string name;
+        /**
+         * \brief The index of the uniform in uniforms_.
+         */
+        std::size_t uniform;
+    };
+
+    /**
+     * \brief Find the uniform with \a name and remember \a value as its last
+     * value.
+     *
+     * \param name The name of the specified value.
+     * \param value The bytes of the value.
+     * \param size The number of bytes of the value.
+     * \param transpose The matrix should be transpose or not.
+     * \return The location to set, or \c -1 if the uniform is not active or
+     * already has the value.
+     */
+    GLint locationToSet(OpenGLUniformName name, const void *value,
+                        std::size_t size,
+                        bool transpose = false) const noexcept;
+    /**
+     * \brief Enumerate the active uniforms into the uniform table.
+     */
+    void loadUniforms();
+    /**
+     * \brief Add the uniform at \a location to the uniform table under
+     * \a name.
+     *
+     * \return The index of the uniform in uniforms_.
+     */
+    std::size_t addUniform(std::string name, GLint location);
+    /**
+     * \brief Attach the shader to the OpenGLShaderProgram
+     *
+     * \param shader Specified shader.
+     */
+    void attachShader(std::unique_ptr<OpenGLShader> &&shader) noexcept;
+
+    /**
+     * \brief Create the buffer.
+     *
+     * \exception OpenGLException Buffer failed to instantiate.
+     */
+    void create();
+    /**
+     * \brief Clean up and delete the buffer.
+     */
+    void tidy() noexcept;
+    /**
+     * \brief Destroy the shader program.
+     */
+    void destroyProgram() noexcept;
+    /**
+     * \brief Destroy the shader which attached to the program.
+     */
+    void destroyShaders() noexcept;
+
+    /**
+     * \brief The id of the OpenGLShaderProgram.
+     */
+    GLuint id_;
+
+    /**
+     * \brief  The shader of the OpenGLShaderProgram.
+     */
+    std::vector<std::unique_ptr<OpenGLShader>> shaders_;
+
+    /**
+     * \brief The active uniforms of the OpenGLShaderProgram.
+     */
+    mutable std::vector<Uniform> uniforms_;
+    /**
+     * \brief The names the uniforms are set by.
+     */
+    std::vector<UniformKey> keys_;
+    /**
+     * \brief Open addressing table of indices into keys_, \c -1 for an
+     * empty slot. Its size is a power of two.
+     */
+    std::vector<std::int32_t> slots_;
+    /**
+     * \brief The uniform counters of the OpenGLShaderProgram.
+     */
+    mutable Statistics statistics_;
+};
+
+} // namespace OpenGL
+
+#include "OpenGLShaderProgram-inl.hpp"
+
+#endif // HOMEWORK01_OPENGL_SHADERPROGRAM_HPP_
@@ -0,0 +1,291 @@
+#include "OpenGLStateCache.hpp"
+
+#include "OpenGLBufferObject.hpp"
+
+#include "Utils/Global.hpp"
+
+#include <array>
+
+namespace OpenGL
+{
+
+namespace Detail
+{
+
+// No object or enum has this value, so a cached value never matches it.
+constexpr GLuint unknown{~0u};
+
+enum BufferTarget : std::size_t
+{
+    ArrayTarget,
+    ElementArrayTarget,
+    CopyReadTarget,
+    CopyWriteTarget,
+    DrawIndirectTarget,
+    UniformTarget,
+    BufferTargetCount
+};
+
+struct BufferRange
+{
+    GLuint buffer;
+    GLintptr offset;
+    GLsizeiptr size;
+};
+
+struct State
+{
+    GLuint program;
+    GLuint vertexArray;
+    GLuint activeUnit;
+    std::array<GLuint, OpenGLStateCache::textureUnitCount> textures;
+    std::array<GLuint, BufferTargetCount> buffers;
+    std::array<BufferRange, OpenGLStateCache::uniformBindingCount>
+        uniformRanges;
+    GLuint polygonMode;
+    GLuint depthTest;
+    GLuint depthMask;
+    GLuint depthFunction;
+};
+
+State unknownState() noexcept;
+std::size_t bufferTarget(GLenum target) noexcept;
+bool update(GLuint &cached, GLuint value) noexcept;
+
+State state{unknownState()};
+OpenGLStateStatistics frame{};
+OpenGLStateStatistics lastFrame{};
+
+inline State unknownState() noexcept
+{
+    State unknownState;
+    unknownState.program = unknown;
+    unknownState.vertexArray = unknown;
+    unknownState.activeUnit = unknown;
+    unknownState.textures.fill(unknown);
+    unknownState.buffers.fill(unknown);
+    unknownState.uniformRanges.fill(BufferRange{unknown, 0, 0});
+    unknownState.polygonMode = unknown;
+    unknownState.depthTest = unknown;
+    unknownState.depthMask = unknown;
+    unknownState.depthFunction = unknown;
+    return unknownState;
+}
+
+inline std::size_t bufferTarget(GLenum target) noexcept
+{
+    switch (target)
+    {
+    case OpenGLBufferObject::ArrayBuffer:
+        return ArrayTarget;
+    case OpenGLBufferObject::ElementArrayBuffer:
+        return ElementArrayTarget;
+    case GL_COPY_READ_BUFFER:
+        return CopyReadTarget;
+    case GL_COPY_WRITE_BUFFER:
+        return CopyWriteTarget;
+    case OpenGLBufferObject::DrawIndirectBuffer:
+        return DrawIndirectTarget;
+    case OpenGLBufferObject::UniformBuffer:
+        return UniformTarget;
+    default:
+        return BufferTargetCount;
+    }
+}
+
+// Record \a value in \a cached and count the change as issued, or as
+// filtered when \a cached already holds it.
+inline bool update(GLuint &cached, GLuint value) noexcept
+{
+    if (cached == value)
+    {
+        ++frame.filteredCount;
+        return false;
+    }
+
+    cached = value;
+    ++frame.issuedCount;
+    return true;
+}
+
+} // namespace Detail
+
+constexpr GLuint OpenGLStateCache::textureUnitCount;
+constexpr GLuint OpenGLStateCache::uniformBindingCount;
+
+void OpenGLStateCache::bindBuffer(GLenum target, GLuint buffer) noexcept
+{
+    const std::size_t slot{Detail::bufferTarget(target)};
+    if (slot == Detail::BufferTargetCount)
+    {
+        ++Detail::frame.issuedCount;
+        glBindBuffer(target, buffer);
+        return;
+    }
+
+    if (Detail::update(Detail::state.buffers[slot], buffer))
+    {
+        glBindBuffer(target, buffer);
+    }
+}
+
+void OpenGLStateCache::bindBufferRange(GLenum target, GLuint index,
+                                       GLuint buffer, GLintptr offset,
+                                       GLsizeiptr size) noexcept
+{
+    const std::size_t slot{Detail::bufferTarget(target)};
+    if (slot == Detail::UniformTarget && index < uniformBindingCount)
+    {
+        Detail::BufferRange &range{Detail::state.uniformRanges[index]};
+        if (range.buffer == buffer && range.offset == offset &&
+            range.size == size)
+        {
+            ++Detail::frame.filteredCount;
+            return;
+        }
+        range = Detail::BufferRange{buffer, offset, size};
+    }
+
+    ++Detail::frame.issuedCount;
+    glBindBufferRange(target, index, buffer, offset, size);
+    if (slot != Detail::BufferTargetCount)
+    {
+        Detail::state.buffers[slot] = buffer;
+    }
+}
+
+void OpenGLStateCache::bindTexture(GLuint unit, GLuint texture) noexcept
+{
+    PROGRAM_ASSERT(unit < textureUnitCount);
+
+    if (Detail::update(Detail::state.activeUnit, unit))
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+    }
+    if (Detail::update(Detail::state.textures[unit], texture))
+    {
+        glBindTexture(GL_TEXTURE_2D, texture);
+    }
+}
+
+// Binding another vertex array object also switches the element array
+// buffer to the one it recorded.
+void OpenGLStateCache::bindVertexArray(GLuint vertexArray) noexcept
+{
+    if (Detail::update(Detail::state.vertexArray, vertexArray))
+    {
+        glBindVertexArray(vertexArray);
+        Detail::state.buffers[Detail::ElementArrayTarget] = Detail::unknown;
+    }
+}
+
+void OpenGLStateCache::endFrame() noexcept
+{
+    Detail::lastFrame = Detail::frame;
+    Detail::frame = Statistics{};
+}
+
+void OpenGLStateCache::forgetBuffer(GLuint buffer) noexcept
+{
+    for (GLuint &cached : Detail::state.buffers)
+    {
+        if (cached == buffer)
+        {
+            cached = Detail::unknown;
+        }
+    }
+    for (Detail::BufferRange &range : Detail::state.uniformRanges)
+    {
+        if (range.buffer == buffer)
+        {
+            range.buffer = Detail::unknown;
+        }
+    }
+}
+
+void OpenGLStateCache::forgetProgram(GLuint program) noexcept
+{
+    if (Detail::state.program == program)
+    {
+        Detail::state.program = Detail::unknown;
+    }
+}
+
+void OpenGLStateCache::forgetTexture(GLuint texture) noexcept
+{
+    for (GLuint &cached : Detail::state.textures)
+    {
+        if (cached == texture)
+        {
+            cached = Detail::unknown;
+        }
+    }
+}
+
+void OpenGLStateCache::forgetVertexArray(GLuint vertexArray) noexcept
+{
+    if (Detail::state.vertexArray == vertexArray)
+    {
+        Detail::state.vertexArray = Detail::unknown;
+        Detail::state.buffers[Detail::ElementArrayTarget] = Detail::unknown;
+    }
+}
+
+void OpenGLStateCache::invalidate() noexcept
+{
+    Detail::state = Detail::unknownState();
+}
+
+void OpenGLStateCache::setDepthFunction(GLenum function) noexcept
+{
+    if (Detail::update(Detail::state.depthFunction, function))
+    {
+        glDepthFunc(function);
+    }
+}
+
+void OpenGLStateCache::setDepthMask(bool enabled) noexcept
+{
+    if (Detail::update(Detail::state.depthMask, enabled ? GL_TRUE : GL_FALSE))
+    {
+        glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    }
+}
+
+void OpenGLStateCache::setDepthTest(bool enabled) noexcept
+{
+    if (Detail::update(Detail::state.depthTest, enabled ? GL_TRUE : GL_FALSE))
+    {
+        if (enabled)
+        {
+            glEnable(GL_DEPTH_TEST);
+        }
+        else
+        {
+            glDisable(GL_DEPTH_TEST);
+        }
+    }
+}
+
+void OpenGLStateCache::setPolygonMode(GLenum mode) noexcept
+{
+    if (Detail::update(Detail::state.polygonMode, mode))
+    {
+        glPolygonMode(GL_FRONT_AND_BACK, mode);
+    }
+}
+
+const OpenGLStateCache::Statistics &OpenGLStateCache::statistics() noexcept
+{
+    return Detail::lastFrame;
+}
+
+void OpenGLStateCache::useProgram(GLuint program) noexcept
+{
+    if (Detail::update(Detail::state.program, program))
+    {
+        glUseProgram(program);
+    }
+}
+
+} // namespace OpenGL
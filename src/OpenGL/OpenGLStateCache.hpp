@@ -0,0 +1,167 @@
+#ifndef HOMEWORK01_OPENGL_OPENGLSTATECACHE_HPP_
+#define HOMEWORK01_OPENGL_OPENGLSTATECACHE_HPP_
+
+#include "glad/glad.h"
+
+#include <cstddef>
+
+namespace OpenGL
+{
+
+/**
+ * \brief Counters of the OpenGLStateCache over one frame.
+ */
+struct OpenGLStateStatistics
+{
+    /**
+     * \brief State changes passed on to OpenGL.
+     */
+    std::size_t issuedCount;
+    /**
+     * \brief State changes dropped because the state was already set.
+     */
+    std::size_t filteredCount;
+};
+
+/**
+ * \brief The binding and render state last set on the OpenGL context.
+ *
+ * \details The wrapper classes set state through this class, which drops a
+ * change when the cache already holds the value, so binding the same program,
+ * vertex array object or texture for every draw reaches the driver once.
+ * Objects are left bound after use; releasing one only costs a call when
+ * something else is bound next.
+ *
+ * The element array buffer binding belongs to the bound vertex array object,
+ * so it is cached only until another vertex array object is bound.
+ *
+ * State starts unknown, so the first change of each kind is always issued.
+ * Code setting state directly has to call invalidate afterwards. The ImGui
+ * backend restores whatever it changes, so it does not.
+ *
+ * \par Warning:
+ * This class is not thread safe. Please use it under the same thread which
+ * creates OpenGL content. There is one cache for the one context of the
+ * program.
+ */
+class OpenGLStateCache
+{
+public:
+    using Statistics = OpenGLStateStatistics;
+
+    /**
+     * \brief Number of texture units whose bindings are cached.
+     */
+    static constexpr GLuint textureUnitCount{16};
+    /**
+     * \brief Number of uniform buffer binding points whose ranges are cached.
+     */
+    static constexpr GLuint uniformBindingCount{16};
+
+    /**
+     * \brief Make \a program the current program.
+     *
+     * \param program Specified program id.
+     */
+    static void useProgram(GLuint program) noexcept;
+    /**
+     * \brief Bind the vertex array object \a vertexArray, or none with \c 0.
+     *
+     * \param vertexArray Specified vertex array object id.
+     */
+    static void bindVertexArray(GLuint vertexArray) noexcept;
+    /**
+     * \brief Make \a unit the active texture unit and bind the 2D texture
+     * \a texture to it, so texture parameters set next apply to \a texture.
+     *
+     * \param unit Specified texture unit, below textureUnitCount.
+     * \param texture Specified texture id, or \c 0 for none.
+     */
+    static void bindTexture(GLuint unit, GLuint texture) noexcept;
+    /**
+     * \brief Bind the buffer object \a buffer to \a target.
+     *
+     * \par Note:
+     * Only the targets of OpenGLBufferObject and the copy targets are cached;
+     * other targets are always issued.
+     *
+     * \param target Specified target.
+     * \param buffer Specified buffer object id, or \c 0 for none.
+     */
+    static void bindBuffer(GLenum target, GLuint buffer) noexcept;
+    /**
+     * \brief Bind \a size bytes of \a buffer from \a offset to the binding
+     * point \a index of \a target, which also binds \a buffer to \a target.
+     *
+     * \param target Specified indexed target.
+     * \param index Specified binding point.
+     * \param buffer Specified buffer object id.
+     * \param offset Specified offset in bytes.
+     * \param size Specified size in bytes.
+     */
+    static void bindBufferRange(GLenum target, GLuint index, GLuint buffer,
+                                GLintptr offset, GLsizeiptr size) noexcept;
+    /**
+     * \brief Set how both faces of polygons are rasterized.
+     *
+     * \param mode \c GL_POINT, \c GL_LINE or \c GL_FILL.
+     */
+    static void setPolygonMode(GLenum mode) noexcept;
+    /**
+     * \brief Enable or disable the depth test.
+     *
+     * \param enabled Whether fragments are tested against the depth buffer.
+     */
+    static void setDepthTest(bool enabled) noexcept;
+    /**
+     * \brief Enable or disable writing to the depth buffer.
+     *
+     * \param enabled Whether fragments write their depth.
+     */
+    static void setDepthMask(bool enabled) noexcept;
+    /**
+     * \brief Set the comparison of the depth test.
+     *
+     * \param function Specified comparison, such as \c GL_LESS.
+     */
+    static void setDepthFunction(GLenum function) noexcept;
+
+    /**
+     * \brief Drop \a program from the cache before it is deleted, since
+     * OpenGL may hand out its id again.
+     */
+    static void forgetProgram(GLuint program) noexcept;
+    /**
+     * \brief Drop \a vertexArray from the cache before it is deleted.
+     */
+    static void forgetVertexArray(GLuint vertexArray) noexcept;
+    /**
+     * \brief Drop \a texture from every unit of the cache before it is
+     * deleted.
+     */
+    static void forgetTexture(GLuint texture) noexcept;
+    /**
+     * \brief Drop \a buffer from every target of the cache before it is
+     * deleted.
+     */
+    static void forgetBuffer(GLuint buffer) noexcept;
+    /**
+     * \brief Forget all cached state, after it was changed behind the cache.
+     */
+    static void invalidate() noexcept;
+
+    /**
+     * \brief Close the counters of the frame that was just rendered.
+     */
+    static void endFrame() noexcept;
+    /**
+     * \brief Gets the counters of the last frame closed by endFrame.
+     *
+     * \return Specified statistics.
+     */
+    static const Statistics &statistics() noexcept;
+};
+
+} // namespace OpenGL
+
+#endif // HOMEWORK01_OPENGL_OPENGLSTATECACHE_HPP_
@@ -0,0 +1,242 @@
+#ifndef HOMEWORK01_OPENGL_OPENGLSTD140LAYOUT_HPP_
+#define HOMEWORK01_OPENGL_OPENGLSTD140LAYOUT_HPP_
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+
+#include <cstddef>
+
+namespace OpenGL
+{
+
+namespace Detail
+{
+
+/**
+ * \brief Round \a offset up to a multiple of \a alignment.
+ */
+constexpr std::size_t std140Align(std::size_t offset, std::size_t alignment)
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+/**
+ * \brief Base alignment and size of a std140 block member.
+ */
+template <std::size_t alignment, std::size_t size>
+struct Std140MemberBase
+{
+    static constexpr std::size_t baseAlignment() noexcept { return alignment; }
+    static constexpr std::size_t byteSize() noexcept { return size; }
+};
+
+/**
+ * \brief The std140 rules for the C++ type of a block member.
+ *
+ * \details Only types stored the same way in C++ and in a std140 block have
+ * one: \c bool is one byte in C++ but four in a block, so it is written as an
+ * \c unsigned \c int, and the columns of a \c glm::mat3 are 12 bytes apart
+ * rather than 16.
+ */
+template <typename T>
+struct Std140Member;
+
+template <>
+struct Std140Member<float> : Std140MemberBase<4, 4>
+{
+};
+
+template <>
+struct Std140Member<int> : Std140MemberBase<4, 4>
+{
+};
+
+template <>
+struct Std140Member<unsigned int> : Std140MemberBase<4, 4>
+{
+};
+
+template <>
+struct Std140Member<glm::vec2> : Std140MemberBase<8, 8>
+{
+};
+
+template <>
+struct Std140Member<glm::ivec2> : Std140MemberBase<8, 8>
+{
+};
+
+template <>
+struct Std140Member<glm::uvec2> : Std140MemberBase<8, 8>
+{
+};
+
+template <>
+struct Std140Member<glm::vec3> : Std140MemberBase<16, 12>
+{
+};
+
+template <>
+struct Std140Member<glm::ivec3> : Std140MemberBase<16, 12>
+{
+};
+
+template <>
+struct Std140Member<glm::uvec3> : Std140MemberBase<16, 12>
+{
+};
+
+template <>
+struct Std140Member<glm::vec4> : Std140MemberBase<16, 16>
+{
+};
+
+template <>
+struct Std140Member<glm::ivec4> : Std140MemberBase<16, 16>
+{
+};
+
+template <>
+struct Std140Member<glm::uvec4> : Std140MemberBase<16, 16>
+{
+};
+
+template <>
+struct Std140Member<glm::mat4> : Std140MemberBase<16, 64>
+{
+};
+
+} // namespace Detail
+
+/**
+ * \brief This class represents the std140 layout of a uniform block whose
+ * members have the types \a Members, in order.
+ *
+ * \details The offsets follow the std140 rules, so a \c float right after a
+ * \c vec3 fills the last 4 bytes of the \c vec3, as in C++. A C++ struct
+ * mirroring a block checks itself against its layout at compile time:
+ *
+ * \code{.cpp}
+ * struct Light
+ * {
+ *     using Layout = OpenGL::OpenGLStd140Layout<glm::vec3, float, glm::vec4>;
+ *
+ *     glm::vec3 position;
+ *     float range;
+ *     glm::vec4 color;
+ * };
+ * static_assert(Light::Layout::matches(sizeof(Light),
+ *                                      offsetof(Light, position),
+ *                                      offsetof(Light, range),
+ *                                      offsetof(Light, color)),
+ *               "Light does not follow std140");
+ * \endcode
+ *
+ * \sa OpenGLUniformBuffer
+ */
+template <typename... Members>
+class OpenGLStd140Layout;
+
+/**
+ * \brief The layout of no members, which ends where it starts.
+ */
+template <>
+class OpenGLStd140Layout<>
+{
+public:
+    static constexpr std::size_t offset(std::size_t,
+                                        std::size_t start = 0) noexcept
+    {
+        return start;
+    }
+
+    static constexpr std::size_t end(std::size_t start = 0) noexcept
+    {
+        return start;
+    }
+};
+
+template <typename First, typename... Rest>
+class OpenGLStd140Layout<First, Rest...>
+{
+public:
+    /**
+     * \brief Gets the offset of the member at \a index.
+     *
+     * \param index The index of the member.
+     * \param start The offset of the first member before alignment.
+     * \return Specified offset in bytes.
+     */
+    static constexpr std::size_t offset(std::size_t index,
+                                        std::size_t start = 0) noexcept
+    {
+        return index == 0
+                   ? Detail::std140Align(
+                         start, Detail::Std140Member<First>::baseAlignment())
+                   : OpenGLStd140Layout<Rest...>::offset(index - 1,
+                                                         firstEnd(start));
+    }
+
+    /**
+     * \brief Gets the offset one past the last member.
+     *
+     * \param start The offset of the first member before alignment.
+     * \return Specified offset in bytes.
+     */
+    static constexpr std::size_t end(std::size_t start = 0) noexcept
+    {
+        return OpenGLStd140Layout<Rest...>::end(firstEnd(start));
+    }
+
+    /**
+     * \brief Gets the size of the block, the end rounded up to the 16 bytes
+     * of a \c vec4.
+     *
+     * \return Specified size in bytes.
+     */
+    static constexpr std::size_t size() noexcept
+    {
+        return Detail::std140Align(end(), 16);
+    }
+
+    /**
+     * \brief Check the size and member offsets of a C++ struct against the
+     * layout.
+     *
+     * \param blockSize The \c sizeof of the struct.
+     * \param offsets The \c offsetof of every member, in order.
+     * \return Return \c true If there is an offset per member and each
+     * matches, and the size matches. Otherwise return \c false.
+     */
+    template <typename... Offsets>
+    static constexpr bool matches(std::size_t blockSize,
+                                  Offsets... offsets) noexcept
+    {
+        return sizeof...(Offsets) == 1 + sizeof...(Rest) &&
+               blockSize == size() &&
+               matchesFrom(0, static_cast<std::size_t>(offsets)...);
+    }
+
+private:
+    static constexpr std::size_t firstEnd(std::size_t start) noexcept
+    {
+        return Detail::std140Align(
+                   start, Detail::Std140Member<First>::baseAlignment()) +
+               Detail::Std140Member<First>::byteSize();
+    }
+
+    static constexpr bool matchesFrom(std::size_t) noexcept { return true; }
+
+    template <typename... Offsets>
+    static constexpr bool matchesFrom(std::size_t index, std::size_t first,
+                                      Offsets... rest) noexcept
+    {
+        return offset(index) == first && matchesFrom(index + 1, rest...);
+    }
+};
+
+} // namespace OpenGL
+
+#endif // HOMEWORK01_OPENGL_OPENGLSTD140LAYOUT_HPP_
@@ -0,0 +1,193 @@
+#include "OpenGLStreamBuffer.hpp"
+
+#include "Utils/Global.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+
+namespace OpenGL
+{
+
+namespace Detail
+{
+
+using BufferStorage = void(APIENTRYP)(GLenum target, GLsizeiptr size,
+                                      const void *data, GLbitfield flags);
+
+BufferStorage bufferStorage{nullptr};
+
+// Flags of OpenGL 4.4, absent from the 3.3 loader.
+constexpr GLbitfield mapPersistentBit{0x0040};
+constexpr GLbitfield mapCoherentBit{0x0080};
+
+// How long one wait for a fence lasts before it is retried, in nanoseconds.
+constexpr GLuint64 streamFenceTimeout{1000000};
+
+} // namespace Detail
+
+OpenGLStreamBuffer::OpenGLStreamBuffer(OpenGLBufferObject::Type type,
+                                       GLsizeiptr regionSize,
+                                       GLuint regionCount)
+    : buffer_{type, OpenGLBufferObject::UsagePattern::StreamDraw},
+      mapping_{nullptr}, region_{regionCount - 1}, used_{0},
+      fences_(regionCount, nullptr), statistics_{}
+{
+    PROGRAM_ASSERT(regionSize > 0 && regionCount > 0);
+
+    statistics_.regionSize = regionSize;
+    statistics_.regionCount = regionCount;
+
+    const GLsizeiptr size{regionSize * static_cast<GLsizeiptr>(regionCount)};
+    buffer_.bind();
+    if (Detail::bufferStorage)
+    {
+        const GLbitfield flags{GL_MAP_WRITE_BIT | Detail::mapPersistentBit |
+                               Detail::mapCoherentBit};
+        Detail::bufferStorage(type, size, nullptr, flags);
+        mapping_ = static_cast<unsigned char *>(
+            glMapBufferRange(type, 0, size, flags));
+        PROGRAM_ASSERT(mapping_ != nullptr);
+        statistics_.persistent = true;
+    }
+    else
+    {
+        buffer_.allocateBufferData(nullptr, size);
+    }
+}
+
+OpenGLStreamBuffer::~OpenGLStreamBuffer()
+{
+    for (GLsync fence : fences_)
+    {
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+    }
+    // Deleting the buffer unmaps it.
+}
+
+bool OpenGLStreamBuffer::available() noexcept
+{
+    return Detail::bufferStorage != nullptr;
+}
+
+void *OpenGLStreamBuffer::allocate(GLsizeiptr size, GLsizeiptr alignment,
+                                   GLintptr &offset) noexcept
+{
+    PROGRAM_ASSERT(alignment > 0);
+
+    const GLsizeiptr start{(used_ + alignment - 1) / alignment * alignment};
+    if (!mapping_ || start + size > statistics_.regionSize)
+    {
+        ++statistics_.overflowCount;
+        return nullptr;
+    }
+    used_ = start + size;
+
+    const GLintptr regionOffset{
+        static_cast<GLintptr>(statistics_.regionSize) * region_};
+    offset = regionOffset + start;
+    return mapping_ + (statistics_.persistent ? offset : start);
+}
+
+void OpenGLStreamBuffer::beginFrame() noexcept
+{
+    region_ = (region_ + 1) % statistics_.regionCount;
+    used_ = 0;
+    ++statistics_.frameCount;
+
+    GLsync &fence{fences_[region_]};
+    if (fence)
+    {
+        // Flushing lets the fence signal even if nothing else would submit
+        // the commands before it.
+        GLenum status{glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0)};
+        if (status == GL_TIMEOUT_EXPIRED)
+        {
+            Performance::Stopwatch stopwatch;
+            do
+            {
+                status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                          Detail::streamFenceTimeout);
+            } while (status == GL_TIMEOUT_EXPIRED);
+            ++statistics_.stallCount;
+            statistics_.stallMilliseconds += stopwatch.elapsedMilliseconds();
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    mapRegion();
+}
+
+void OpenGLStreamBuffer::bind() noexcept { buffer_.bind(); }
+
+OpenGLBufferObject &OpenGLStreamBuffer::buffer() noexcept { return buffer_; }
+
+void OpenGLStreamBuffer::endFrame() noexcept
+{
+    flush();
+
+    GLsync &fence{fences_[region_]};
+    if (fence)
+    {
+        glDeleteSync(fence);
+    }
+    fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    statistics_.frameBytes = used_;
+    statistics_.totalBytes += static_cast<unsigned long long>(used_);
+}
+
+void OpenGLStreamBuffer::flush() noexcept
+{
+    if (!statistics_.persistent && mapping_)
+    {
+        buffer_.bind();
+        glUnmapBuffer(buffer_.type());
+        mapping_ = nullptr;
+    }
+}
+
+bool OpenGLStreamBuffer::load(GLADloadproc loader) noexcept
+{
+    Detail::bufferStorage = nullptr;
+
+    GLint major{0};
+    GLint minor{0};
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+    if (major < 4 || (major == 4 && minor < 4))
+    {
+        return false;
+    }
+
+    Detail::bufferStorage =
+        reinterpret_cast<Detail::BufferStorage>(loader("glBufferStorage"));
+    return Detail::bufferStorage != nullptr;
+}
+
+// The fence already guarantees the GPU is done with the region, so the map
+// neither waits nor keeps the old contents.
+void OpenGLStreamBuffer::mapRegion() noexcept
+{
+    if (statistics_.persistent)
+    {
+        return;
+    }
+
+    buffer_.bind();
+    mapping_ = static_cast<unsigned char *>(glMapBufferRange(
+        buffer_.type(),
+        static_cast<GLintptr>(statistics_.regionSize) * region_,
+        statistics_.regionSize,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+            GL_MAP_UNSYNCHRONIZED_BIT));
+}
+
+const OpenGLStreamBuffer::Statistics &
+OpenGLStreamBuffer::statistics() const noexcept
+{
+    return statistics_;
+}
+
+} // namespace OpenGL
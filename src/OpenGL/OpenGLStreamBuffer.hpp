@@ -0,0 +1,204 @@
+#ifndef HOMEWORK01_OPENGL_OPENGLSTREAMBUFFER_HPP_
+#define HOMEWORK01_OPENGL_OPENGLSTREAMBUFFER_HPP_
+
+#include "OpenGLBufferObject.hpp"
+
+#include "glad/glad.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace OpenGL
+{
+
+/**
+ * \brief Counters of an OpenGLStreamBuffer.
+ */
+struct OpenGLStreamBufferStatistics
+{
+    /**
+     * \brief Bytes of one region.
+     */
+    GLsizeiptr regionSize;
+    /**
+     * \brief Number of regions, the frames that may be in flight.
+     */
+    GLuint regionCount;
+    /**
+     * \brief Whether the buffer is mapped once for its lifetime.
+     */
+    bool persistent;
+    /**
+     * \brief Frames begun so far.
+     */
+    std::size_t frameCount;
+    /**
+     * \brief Frames whose region was still read by the GPU and had to wait.
+     */
+    std::size_t stallCount;
+    /**
+     * \brief Time spent waiting in those frames, in milliseconds.
+     */
+    double stallMilliseconds;
+    /**
+     * \brief Bytes allocated in the last frame.
+     */
+    GLsizeiptr frameBytes;
+    /**
+     * \brief Bytes allocated in every frame so far.
+     */
+    unsigned long long totalBytes;
+    /**
+     * \brief Allocations refused because the region was full.
+     */
+    std::size_t overflowCount;
+};
+
+/**
+ * \brief This class represents a buffer written by the CPU every frame and
+ * read by the GPU, split into one region per frame in flight.
+ *
+ * \details
+ *     A frame writes only its own region, through a pointer, and a fence
+ *     placed at the end of the frame tells when the GPU is done with it, so
+ *     a region is reused without orphaning the buffer and without any call
+ *     into the driver per write. With OpenGL 4.4 buffer storage the buffer
+ *     is mapped persistent and coherent once; otherwise each frame maps its
+ *     region unsynchronized, the fence doing the synchronization.
+ *
+ * \code{.cpp}
+ * stream.beginFrame();
+ * GLintptr offset;
+ * void *data{stream.allocate(size, 16, offset)};
+ * std::memcpy(data, source, size);
+ * stream.flush();
+ * // Draws reading the range at offset.
+ * stream.endFrame();
+ * \endcode
+ *
+ * \par Warning:
+ * This class is not thread safe. Please use it under the same thread which
+ * creates OpenGL content.
+ */
+class OpenGLStreamBuffer
+{
+public:
+    using Statistics = OpenGLStreamBufferStatistics;
+
+    /**
+     * \brief Initializes a new instance of the OpenGLStreamBuffer class of
+     * \a regionCount regions of \a regionSize bytes, bound to \a type.
+     *
+     * \exception OpenGLException Buffer failed to instantiate.
+     */
+    explicit OpenGLStreamBuffer(OpenGLBufferObject::Type type,
+                                GLsizeiptr regionSize,
+                                GLuint regionCount = 3);
+    /**
+     * \brief Destroy the instance of the OpenGLStreamBuffer class, with its
+     * fences and mapping.
+     */
+    ~OpenGLStreamBuffer();
+
+    OpenGLStreamBuffer(const OpenGLStreamBuffer &other) = delete;
+    OpenGLStreamBuffer &operator=(const OpenGLStreamBuffer &other) = delete;
+
+    /**
+     * \brief Look up glBufferStorage through \a loader for the current
+     * context; the OpenGL 3.3 loader does not provide it.
+     *
+     * \param loader The function the OpenGL loader was initialized with.
+     * \return Return \c true If the context is OpenGL 4.4 or later and the
+     * entry point was found. Otherwise return \c false, and buffers are
+     * mapped frame by frame.
+     */
+    static bool load(GLADloadproc loader) noexcept;
+    /**
+     * \brief Whether load found glBufferStorage, so buffers created from now
+     * on are mapped persistent.
+     *
+     * \return Return \c true If they are. Otherwise return \c false.
+     */
+    static bool available() noexcept;
+
+    /**
+     * \brief Move to the next region, waiting for the GPU to finish the
+     * frame that last used it.
+     */
+    void beginFrame() noexcept;
+    /**
+     * \brief Reserve \a size bytes of the current region, starting at a
+     * multiple of \a alignment.
+     *
+     * \param offset Set to the offset of the range within the buffer, for
+     * binding it or reading it in a draw.
+     * \return Where to write the range, or \c nullptr if the region is full.
+     */
+    void *allocate(GLsizeiptr size, GLsizeiptr alignment,
+                   GLintptr &offset) noexcept;
+    /**
+     * \brief Make the writes of the frame visible to the GPU. Call after the
+     * last allocate of the frame and before the draws reading it.
+     *
+     * \par Note:
+     * A coherent persistent mapping needs nothing; a region mapped for the
+     * frame is unmapped, and allocate returns \c nullptr until the next
+     * frame.
+     */
+    void flush() noexcept;
+    /**
+     * \brief Fence the current region after the commands of the frame.
+     */
+    void endFrame() noexcept;
+
+    /**
+     * \brief Bind the buffer to its type.
+     */
+    void bind() noexcept;
+    /**
+     * \brief Gets the underlying buffer object.
+     */
+    OpenGLBufferObject &buffer() noexcept;
+
+    /**
+     * \brief Gets the counters so far.
+     */
+    const Statistics &statistics() const noexcept;
+
+private:
+    /**
+     * \brief Map the current region unless the buffer is persistent.
+     */
+    void mapRegion() noexcept;
+
+    /**
+     * \brief The buffer holding every region.
+     */
+    OpenGLBufferObject buffer_;
+    /**
+     * \brief The mapping of the whole buffer if persistent, otherwise of the
+     * current region while it is being written.
+     */
+    unsigned char *mapping_;
+    /**
+     * \brief Region written by the current frame.
+     */
+    GLuint region_;
+    /**
+     * \brief Bytes of the current region allocated so far.
+     */
+    GLsizeiptr used_;
+    /**
+     * \brief Fence of the frame that last wrote each region; null if none.
+     */
+    std::vector<GLsync> fences_;
+
+    /**
+     * \brief Counters so far.
+     */
+    Statistics statistics_;
+};
+
+} // namespace OpenGL
+
+#endif // HOMEWORK01_OPENGL_OPENGLSTREAMBUFFER_HPP_
@@ -0,0 +1,169 @@
+#include "OpenGLStateCache.hpp"
+
+#include "Utils/Global.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OpenGL
+{
+
+template <typename Block>
+constexpr GLuint OpenGLUniformBuffer<Block>::streamRegionCount;
+
+template <typename Block>
+OpenGLUniformBuffer<Block>::OpenGLUniformBuffer(GLuint binding,
+                                                std::size_t capacity)
+    : stream_{nullptr}, buffer_{nullptr}, binding_{binding}, alignment_{1},
+      stride_{sizeof(Block)}, capacity_{std::max<std::size_t>(capacity, 1)},
+      offset_{0}, frameOpen_{false}, staging_{}, statistics_{}
+{
+    GLint alignment{1};
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment_ = static_cast<std::size_t>(std::max(alignment, 1));
+    stride_ = Detail::std140Align(sizeof(Block), alignment_);
+
+    allocate();
+}
+
+// A region is a whole number of strides, so every region, and with it every
+// block, starts aligned.
+template <typename Block>
+inline void OpenGLUniformBuffer<Block>::allocate()
+{
+    const GLsizeiptr size{static_cast<GLsizeiptr>(capacity_ * stride_)};
+    if (OpenGLStreamBuffer::available())
+    {
+        stream_.reset(new OpenGLStreamBuffer{OpenGLBufferObject::UniformBuffer,
+                                             size, streamRegionCount});
+        frameOpen_ = false;
+        statistics_.streamed = true;
+        return;
+    }
+
+    if (!buffer_)
+    {
+        buffer_.reset(new OpenGLBufferObject{OpenGLBufferObject::UniformBuffer,
+                                             OpenGLBufferObject::DynamicDraw});
+    }
+    buffer_->bind();
+    buffer_->allocateBufferData(nullptr, size);
+    buffer_->release();
+}
+
+template <typename Block>
+inline std::size_t OpenGLUniformBuffer<Block>::append(const Block &block)
+{
+    const std::size_t index{size()};
+    staging_.resize(staging_.size() + stride_);
+    std::memcpy(staging_.data() + index * stride_, &block, sizeof(Block));
+    return index;
+}
+
+template <typename Block>
+inline void OpenGLUniformBuffer<Block>::bind(std::size_t index) noexcept
+{
+    PROGRAM_ASSERT(index < size());
+
+    OpenGLStateCache::bindBufferRange(
+        GL_UNIFORM_BUFFER, binding_, buffer().id(),
+        offset_ + static_cast<GLintptr>(index * stride_),
+        static_cast<GLsizeiptr>(sizeof(Block)));
+    ++statistics_.bindCount;
+}
+
+template <typename Block>
+inline GLuint OpenGLUniformBuffer<Block>::binding() const noexcept
+{
+    return binding_;
+}
+
+template <typename Block>
+inline OpenGLBufferObject &OpenGLUniformBuffer<Block>::buffer() noexcept
+{
+    return stream_ ? stream_->buffer() : *buffer_;
+}
+
+template <typename Block>
+inline void OpenGLUniformBuffer<Block>::clear() noexcept
+{
+    staging_.clear();
+}
+
+template <typename Block>
+inline std::size_t OpenGLUniformBuffer<Block>::size() const noexcept
+{
+    return staging_.size() / stride_;
+}
+
+template <typename Block>
+inline const typename OpenGLUniformBuffer<Block>::Statistics &
+OpenGLUniformBuffer<Block>::statistics() const noexcept
+{
+    return statistics_;
+}
+
+template <typename Block>
+inline std::size_t OpenGLUniformBuffer<Block>::stride() const noexcept
+{
+    return stride_;
+}
+
+// A streamed upload fences the region of the last one, after the draws that
+// read it, and copies the blocks into the next region once the GPU is done
+// with it. Without a stream, respecifying the storage lets the driver hand
+// out fresh memory instead of waiting for draws of the last frame that
+// still read the old blocks.
+template <typename Block>
+inline void OpenGLUniformBuffer<Block>::upload() noexcept
+{
+    if (capacity_ < size())
+    {
+        while (capacity_ < size())
+        {
+            capacity_ *= 2;
+        }
+        if (stream_)
+        {
+            allocate();
+        }
+    }
+
+    offset_ = 0;
+    if (stream_)
+    {
+        if (frameOpen_)
+        {
+            stream_->endFrame();
+        }
+        stream_->beginFrame();
+        frameOpen_ = true;
+        if (!staging_.empty())
+        {
+            void *data{stream_->allocate(
+                static_cast<GLsizeiptr>(staging_.size()),
+                static_cast<GLsizeiptr>(alignment_), offset_)};
+            PROGRAM_ASSERT(data != nullptr);
+            std::memcpy(data, staging_.data(), staging_.size());
+        }
+        stream_->flush();
+    }
+    else
+    {
+        buffer_->bind();
+        buffer_->allocateBufferData(
+            nullptr, static_cast<GLsizeiptr>(capacity_ * stride_));
+        if (!staging_.empty())
+        {
+            buffer_->writeBufferSubData(
+                0, staging_.data(), static_cast<GLsizeiptr>(staging_.size()));
+        }
+        buffer_->release();
+    }
+
+    statistics_.blockCount = size();
+    statistics_.uploadBytes = staging_.size();
+    statistics_.bindCount = 0;
+}
+
+} // namespace OpenGL
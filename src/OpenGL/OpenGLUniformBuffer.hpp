@@ -0,0 +1,222 @@
+#ifndef HOMEWORK01_OPENGL_OPENGLUNIFORMBUFFER_HPP_
+#define HOMEWORK01_OPENGL_OPENGLUNIFORMBUFFER_HPP_
+
+#include "OpenGLBufferObject.hpp"
+#include "OpenGLStd140Layout.hpp"
+#include "OpenGLStreamBuffer.hpp"
+
+#include "glad/glad.h"
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace OpenGL
+{
+
+/**
+ * \brief Counters of an OpenGLUniformBuffer.
+ */
+struct OpenGLUniformBufferStatistics
+{
+    /**
+     * \brief Blocks sent by the last upload.
+     */
+    std::size_t blockCount;
+    /**
+     * \brief Bytes sent by the last upload.
+     */
+    std::size_t uploadBytes;
+    /**
+     * \brief Ranges bound to the binding point since the last upload.
+     */
+    std::size_t bindCount;
+    /**
+     * \brief Whether uploads go to a persistent mapped stream, rather than
+     * orphaned storage.
+     */
+    bool streamed;
+};
+
+/**
+ * \brief This class represents an array of uniform blocks of type \a Block in
+ * one buffer object, bound a block at a time to a fixed binding point.
+ *
+ * \details Blocks are appended on the CPU and sent together by one upload.
+ * With glBufferStorage, see OpenGLStreamBuffer::load, each upload is copied
+ * into the next region of a persistent mapped OpenGLStreamBuffer, fenced
+ * once the following upload comes, so the GPU may still read the blocks of
+ * the frames in flight and the upload makes no call into the driver.
+ * Otherwise each upload orphans the storage of one buffer object. Each
+ * block starts at a multiple of \c GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, so
+ * any of them can be bound with \c glBindBufferRange. A program reads the
+ * bound block once its block is mapped to the binding point, see
+ * OpenGLShaderProgram::bindUniformBlock, so one upload serves every program.
+ *
+ * \a Block has to be standard layout, name its std140 layout as \c
+ * Block::Layout, an OpenGLStd140Layout, and have the size of that layout. Its
+ * member offsets are checked where it is defined, with
+ * OpenGLStd140Layout::matches.
+ *
+ * \code{.cpp}
+ * objects.clear();
+ * for (const Object &object : scene)
+ * {
+ *     indices.push_back(objects.append(object.block()));
+ * }
+ * objects.upload();
+ * for (std::size_t i{0}; i < scene.size(); ++i)
+ * {
+ *     objects.bind(indices[i]);
+ *     // Draw scene[i].
+ * }
+ * \endcode
+ *
+ * \par Warning:
+ * This class is not thread safe. Please use it under the same thread which
+ * creates OpenGL content.
+ *
+ * \sa OpenGLStd140Layout
+ */
+template <typename Block>
+class OpenGLUniformBuffer
+{
+    static_assert(std::is_standard_layout<Block>::value,
+                  "A uniform block has to be standard layout");
+    static_assert(sizeof(Block) == Block::Layout::size(),
+                  "A uniform block has to have the size of its std140 layout");
+
+public:
+    using Statistics = OpenGLUniformBufferStatistics;
+
+    /**
+     * \brief Initializes a new instance of the OpenGLUniformBuffer class for
+     * the binding point \a binding, with room for \a capacity blocks.
+     *
+     * \exception OpenGLException Buffer failed to instantiate.
+     */
+    explicit OpenGLUniformBuffer(GLuint binding, std::size_t capacity = 1);
+
+    OpenGLUniformBuffer(const OpenGLUniformBuffer &other) = delete;
+    OpenGLUniformBuffer &operator=(const OpenGLUniformBuffer &other) = delete;
+
+    /**
+     * \brief Append \a block to the blocks of the next upload.
+     *
+     * \param block Specified block.
+     * \return The index to bind the block with.
+     */
+    std::size_t append(const Block &block);
+    /**
+     * \brief Remove every block, to append those of a new frame.
+     */
+    void clear() noexcept;
+    /**
+     * \brief Send the blocks appended since the last clear to the buffer
+     * object, growing it if they do not fit.
+     *
+     * \par Note:
+     * Every draw reading the blocks of an upload has to be issued before
+     * the next upload, which fences them.
+     */
+    void upload() noexcept;
+    /**
+     * \brief Bind the block at \a index to the binding point.
+     *
+     * \param index The index append returned.
+     */
+    void bind(std::size_t index = 0) noexcept;
+
+    /**
+     * \brief Gets the binding point of the OpenGLUniformBuffer.
+     *
+     * \return Specified binding point.
+     */
+    GLuint binding() const noexcept;
+    /**
+     * \brief Gets the number of blocks appended since the last clear.
+     *
+     * \return Specified number.
+     */
+    std::size_t size() const noexcept;
+    /**
+     * \brief Gets the distance between two blocks in the buffer object.
+     *
+     * \return Specified distance in bytes.
+     */
+    std::size_t stride() const noexcept;
+    /**
+     * \brief Gets the counters of the OpenGLUniformBuffer.
+     *
+     * \return Specified statistics.
+     */
+    const Statistics &statistics() const noexcept;
+
+private:
+    /**
+     * \brief The region count of the stream, the uploads in flight.
+     */
+    static constexpr GLuint streamRegionCount{3};
+
+    /**
+     * \brief Create the stream or the buffer object, with room for \a
+     * capacity_ blocks.
+     */
+    void allocate();
+    /**
+     * \brief Gets the buffer object the blocks are bound from.
+     *
+     * \return Specified buffer object.
+     */
+    OpenGLBufferObject &buffer() noexcept;
+
+    /**
+     * \brief The stream holding the blocks of the uploads in flight; null
+     * without glBufferStorage.
+     */
+    std::unique_ptr<OpenGLStreamBuffer> stream_;
+    /**
+     * \brief The buffer object holding the blocks when there is no stream.
+     */
+    std::unique_ptr<OpenGLBufferObject> buffer_;
+    /**
+     * \brief The binding point the blocks are bound to.
+     */
+    GLuint binding_;
+    /**
+     * \brief The offset alignment of uniform buffer ranges.
+     */
+    std::size_t alignment_;
+    /**
+     * \brief The size of a block rounded up to the offset alignment.
+     */
+    std::size_t stride_;
+    /**
+     * \brief The number of blocks the buffer object, or a region of the
+     * stream, has room for.
+     */
+    std::size_t capacity_;
+    /**
+     * \brief Where the blocks of the last upload start in the buffer object.
+     */
+    GLintptr offset_;
+    /**
+     * \brief Whether the stream has a frame to fence at the next upload.
+     */
+    bool frameOpen_;
+    /**
+     * \brief The blocks of the next upload, \a stride_ bytes apart.
+     */
+    std::vector<unsigned char> staging_;
+    /**
+     * \brief The counters of the OpenGLUniformBuffer.
+     */
+    Statistics statistics_;
+};
+
+} // namespace OpenGL
+
+#include "OpenGLUniformBuffer-inl.hpp"
+
+#endif // HOMEWORK01_OPENGL_OPENGLUNIFORMBUFFER_HPP_
@@ -0,0 +1,80 @@
+#ifndef HOMEWORK01_OPENGL_UNIFORMNAME_HPP_
+#define HOMEWORK01_OPENGL_UNIFORMNAME_HPP_
+
+#include <cstdint>
+
+namespace OpenGL
+{
+
+namespace Detail
+{
+
+/**
+ * \brief FNV-1a hash of the null-terminated \a name, usable in constant
+ * expressions.
+ */
+constexpr std::uint32_t hashUniformName(const char *name,
+                                        std::uint32_t hash = 2166136261u)
+{
+    return *name ? hashUniformName(name + 1,
+                                   (hash ^ static_cast<std::uint8_t>(*name)) *
+                                       16777619u)
+                 : hash;
+}
+
+} // namespace Detail
+
+/**
+ * \brief This class represents the name of a uniform together with its hash.
+ *
+ * \details A name converts implicitly from a string, so a string literal can
+ * still be passed to OpenGLShaderProgram::setValue. Declaring the name as a
+ * \c constexpr object hashes it at compile time.
+ *
+ * \par Note:
+ * The name is not copied, so the string has to outlive the object.
+ *
+ * \sa OpenGLShaderProgram
+ */
+class OpenGLUniformName
+{
+public:
+    /**
+     * \brief Initializes a new instance of the OpenGLUniformName class with
+     * \a name.
+     *
+     * \param name The name of the uniform in the shader.
+     */
+    constexpr OpenGLUniformName(const char *name) noexcept
+        : name_{name}, hash_{Detail::hashUniformName(name)}
+    {
+    }
+
+    /**
+     * \brief Gets the name of the uniform.
+     *
+     * \return Specified name.
+     */
+    constexpr const char *name() const noexcept { return name_; }
+    /**
+     * \brief Gets the hash of the name.
+     *
+     * \return Specified hash.
+     */
+    constexpr std::uint32_t hash() const noexcept { return hash_; }
+
+private:
+    /**
+     * \brief The name of the uniform.
+     */
+    const char *name_;
+
+    /**
+     * \brief The hash of the name.
+     */
+    std::uint32_t hash_;
+};
+
+} // namespace OpenGL
+
+#endif // HOMEWORK01_OPENGL_UNIFORMNAME_HPP_
@@ -1,373 +1,1231 @@
-#include "OpenGLWindow.hpp"
-
-#include "Model/TextureFactory.hpp"
-#include "OpenGL/OpenGLException.hpp"
-#include "Utils/Compilers.hpp"
-#include "Utils/Global.hpp"
-#include "Utils/StringFormat/StringFormat.hpp"
-
-#include "glm/gtc/matrix_transform.hpp"
-#include "glm/gtc/type_ptr.hpp"
-#include "glm/mat4x4.hpp"
-
-#include "imgui/imgui_impl_glfw.h"
-#include "imgui/imgui_impl_opengl3.h"
-
-#include "tiny_obj_loader.h"
-
-#include <iostream>
-#include <utility>
-#include <vector>
-
-namespace Detail
-{
-
-bool compileShaders(OpenGL::OpenGLShaderProgram &program,
-                    const char *vertexShaderFile,
-                    const char *fragmentShaderFile = nullptr,
-                    const char *geometryShaderFile = nullptr);
-void frameBufferSizeCallback(GLFWwindow *window, int width, int height);
-
-bool compileShaders(OpenGL::OpenGLShaderProgram &program,
-                    const char *vertexShaderFile,
-                    const char *fragmentShaderFile,
-                    const char *geometryShaderFile)
-{
-    if (!program.addShaderFromFile(OpenGL::OpenGLShader::Type::Vertex,
-                                   vertexShaderFile))
-    {
-        return false;
-    }
-
-    if (fragmentShaderFile &&
-
-        !program.addShaderFromFile(OpenGL::OpenGLShader::Type::Fragment,
-                                   fragmentShaderFile))
-    {
-        return false;
-    }
-
-    if (geometryShaderFile &&
-        !program.addShaderFromFile(OpenGL::OpenGLShader::Type::Geometry,
-                                   geometryShaderFile))
-    {
-        return false;
-    }
-
-    program.link();
-    if (!program.linkStatus())
-    {
-        return false;
-    }
-
-    return true;
-}
-
-void frameBufferSizeCallback(GLFWwindow *window, int width, int height)
-{
-    if (window)
-    {
-    }
-    glViewport(0, 0, width, height);
-}
-
-} // namespace Detail
-
-OpenGLWindow::OpenGLWindow(glm::ivec2 windowSize, std::string title,
-                           glm::ivec2 openglVersion)
-    : window_{nullptr}, size_{windowSize}, title_{title},
-      version_{openglVersion}, models_{}, renderMode_{RenderMode::Fill},
-      backgroundColor_{0}, lookAt_{0}, cameraPosition_{lookAt_ + glm::vec3{8}}
-{
-    create();
-}
-
-OpenGLWindow::~OpenGLWindow() { destroy(); }
-
-bool OpenGLWindow::addModel(const char *modelSource, const char *textureSource,
-                            OpenGL::OpenGLShaderProgram &program)
-{
-    std::vector<tinyobj::shape_t> shapes;
-    std::vector<tinyobj::material_t> materials;
-    std::string errorMessage;
-
-    auto success =
-        tinyobj::LoadObj(shapes, materials, errorMessage, modelSource);
-
-    if (!success)
-    {
-        std::cerr << "[Error]" << errorMessage.c_str();
-
-        return false;
-    }
-
-    std::vector<float> positions;
-    std::vector<float> normals;
-    std::vector<float> textureCoordinates;
-    std::vector<unsigned int> indices;
-
-    for (auto &shape : shapes)
-    {
-        positions.insert(positions.end(), shape.mesh.positions.begin(),
-                         shape.mesh.positions.end());
-        if (!shape.mesh.normals.empty())
-        {
-            normals.insert(normals.end(), shape.mesh.normals.begin(),
-                           shape.mesh.normals.end());
-        }
-
-        if (!shape.mesh.texcoords.empty())
-        {
-            textureCoordinates.insert(textureCoordinates.end(),
-                                      shape.mesh.texcoords.begin(),
-                                      shape.mesh.texcoords.end());
-        }
-
-        indices.insert(indices.end(), shape.mesh.indices.begin(),
-                       shape.mesh.indices.end());
-    }
-
-    std::unique_ptr<OpenGL::OpenGLTexture> texture;
-    std::unique_ptr<Model::Mesh> mesh;
-
-    if (textureSource)
-    {
-        texture = Model::TextureFactory::loadFromFile(textureSource);
-        mesh.reset(new Model::Mesh{positions, normals, textureCoordinates,
-                                   indices, program, texture.get()});
-
-        textures.push_back(std::move(texture));
-    }
-    else
-    {
-        mesh.reset(new Model::Mesh{positions, normals, textureCoordinates,
-                                   indices, program});
-    }
-
-    models_.push_back(std::move(mesh));
-
-    return true;
-}
-
-OpenGL::OpenGLShaderProgram *
-OpenGLWindow::addShader(const char *vertexShaderSource,
-                        const char *fragmentShaderSource,
-                        const char *geometryShaderSource)
-{
-    std::unique_ptr<OpenGL::OpenGLShaderProgram> program{
-        new OpenGL::OpenGLShaderProgram{}};
-    if (!Detail::compileShaders(*program, vertexShaderSource,
-                                fragmentShaderSource, geometryShaderSource))
-    {
-        return nullptr;
-    }
-    shaders_.push_back(std::move(program));
-
-    return shaders_.back().get();
-}
-
-float OpenGLWindow::aspectRatio() const noexcept
-{
-    return static_cast<float>(width()) / static_cast<float>(height());
-}
-
-void OpenGLWindow::create()
-{
-    if (!initializeOpenGL())
-    {
-        throw OpenGL::OpenGLException{"Failed to initialize OpenGL"};
-    }
-
-    if (!createWindow())
-    {
-        glfwTerminate();
-        throw OpenGL::OpenGLException{"Failed to Create GLFW window"};
-    }
-
-    if (!initializeGLAD())
-    {
-        glfwTerminate();
-        throw OpenGL::OpenGLException{"Failed to initialize GLAD"};
-    }
-
-    initializeImgui();
-
-    glEnable(GL_DEPTH_TEST);
-}
-
-void OpenGLWindow::clearColor()
-{
-    glClearColor(backgroundColor_.x, backgroundColor_.y, backgroundColor_.z,
-                 backgroundColor_.w);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-}
-
-bool OpenGLWindow::createWindow()
-{
-    window_ =
-        glfwCreateWindow(width(), height(), title_.c_str(), nullptr, nullptr);
-    if (!window_)
-    {
-        return false;
-    }
-    glfwMakeContextCurrent(window_);
-    glfwSetFramebufferSizeCallback(window_, Detail::frameBufferSizeCallback);
-
-    return true;
-}
-
-void OpenGLWindow::destroy()
-{
-    for (auto &model : models_)
-    {
-        model.reset(nullptr);
-    }
-    models_.clear();
-
-    for (auto &texture : textures)
-    {
-        texture.reset(nullptr);
-    }
-    textures.clear();
-
-    shaders_.clear();
-
-    destroyImgui();
-    destroyOpenGL();
-}
-
-void OpenGLWindow::destroyImgui()
-{
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplGlfw_Shutdown();
-    ImGui::DestroyContext();
-}
-
-void OpenGLWindow::destroyOpenGL()
-{
-    glfwDestroyWindow(window_);
-    glfwTerminate();
-}
-
-int OpenGLWindow::height() const noexcept { return size_.y; }
-
-bool OpenGLWindow::initializeGLAD()
-{
-    return gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
-}
-
-void OpenGLWindow::initializeImgui()
-{
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-
-    ImGuiIO &io = ImGui::GetIO();
-    PROGRAM_MAYBE_UNUSED(io)
-
-    ImGui::StyleColorsDark();
-
-    ImGui_ImplGlfw_InitForOpenGL(window_, true);
-    ImGui_ImplOpenGL3_Init(
-        StringFormat::StringFormat("#version %d%d0", version_.x, version_.y)
-            .c_str());
-}
-
-bool OpenGLWindow::initializeOpenGL()
-{
-    if (!glfwInit())
-    {
-        return false;
-    }
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version_[0]);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version_[1]);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
-#ifdef __APPLE__
-    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#endif
-
-    return true;
-}
-
-void OpenGLWindow::processInput() { shouldExit(); }
-
-void OpenGLWindow::shouldExit()
-{
-    if (glfwGetKey(window_, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-    {
-        glfwSetWindowShouldClose(window_, true);
-    }
-}
-
-void OpenGLWindow::startRender() { windowRenderLoop(); }
-
-int OpenGLWindow::width() const noexcept { return size_.x; }
-
-void OpenGLWindow::windowImguiGeneralSetting()
-{
-    ImGui::Begin("Setting");
-    ImGui::ColorEdit4("Background color", glm::value_ptr(backgroundColor_));
-    ImGui::SliderFloat3("Camera Position", glm::value_ptr(cameraPosition_),
-                        -20.0f, 20.0f);
-    ImGui::SliderFloat3("Look At", glm::value_ptr(lookAt_), -20.0f, 20.0f);
-
-    const char *items[] = {"Line", "Fill"};
-    int current_item = renderMode_;
-    ImGui::Combo("combo", &current_item, items, IM_ARRAYSIZE(items));
-
-    if (current_item != renderMode_)
-    {
-        glPolygonMode(GL_FRONT_AND_BACK, GL_LINE + current_item);
-        renderMode_ = static_cast<RenderMode>(current_item);
-    }
-
-    ImGui::End();
-}
-
-void OpenGLWindow::windowRenderLateUpdate() {}
-
-void OpenGLWindow::windowRenderImguiUpdate()
-{
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplGlfw_NewFrame();
-    ImGui::NewFrame();
-
-    windowImguiGeneralSetting();
-
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-}
-
-void OpenGLWindow::windowRenderLoop()
-{
-    while (!(glfwWindowShouldClose(window_)))
-    {
-        processInput();
-        clearColor();
-
-        windowRenderUpdate();
-        windowRenderLateUpdate();
-
-        windowRenderImguiUpdate();
-
-        glfwSwapBuffers(window_);
-        glfwPollEvents();
-    }
-}
-
-void OpenGLWindow::windowRenderUpdate()
-{
-    PRAGMA_WARNING_PUSH
-    PRAGMA_WARNING_DISABLE_CONSTANTCONDITIONAL
-    glm::mat4 view = glm::lookAt(cameraPosition_, lookAt_, glm::vec3{0, 1, 0}) *
-                     glm::mat4(1);
-    PRAGMA_WARNING_POP
-
-    glm::mat4 projection{
-        glm::perspective(glm::radians(45.0f), aspectRatio(), 0.1f, 100.0f)};
-
-    for (auto &model : models_)
-    {
-        model->draw(view, projection);
-    }
-}
+#include "OpenGLWindow.hpp"
+
+#include "Model/ChunkedMeshBuilder.hpp"
+#include "Model/GltfLoader.hpp"
+#include "Model/GltfMeshFactory.hpp"
+#include "Model/MeshCache.hpp"
+#include "Model/MeshOptimizer.hpp"
+#include "Model/MeshSimplifier.hpp"
+#include "Model/MeshletBuilder.hpp"
+#include "Model/NormalGenerator.hpp"
+#include "Model/ObjLoader.hpp"
+#include "Model/PlyLoader.hpp"
+#include "Model/StlLoader.hpp"
+#include "Model/TangentGenerator.hpp"
+#include "Model/TextureFactory.hpp"
+#include "OpenGL/OpenGLDrawIndirect.hpp"
+#include "OpenGL/OpenGLException.hpp"
+#include "OpenGL/OpenGLStateCache.hpp"
+#include "OpenGL/OpenGLStreamBuffer.hpp"
+#include "Utils/Compilers.hpp"
+#include "Utils/Global.hpp"
+#include "Utils/Performance/Stopwatch.hpp"
+#include "Utils/StringFormat/StringFormat.hpp"
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/type_ptr.hpp"
+#include "glm/geometric.hpp"
+#include "glm/mat4x4.hpp"
+
+#include "imgui/imgui_impl_glfw.h"
+#include "imgui/imgui_impl_opengl3.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace Detail
+{
+
+// Camera of windowRenderUpdate.
+constexpr float fieldOfView{45.0f};
+constexpr float nearPlane{0.1f};
+constexpr float farPlane{100.0f};
+// Triangles of a model without normals meeting at a sharper angle keep
+// separate vertex normals.
+constexpr float creaseAngle{60.0f};
+// The one uniform of the programs outside the Camera and Object blocks,
+// pointed at the unit OpenGLTexture::bind() uses by default.
+constexpr OpenGL::OpenGLUniformName objectTextureUniform{"objectTexture"};
+constexpr int objectTextureUnit{0};
+
+bool compileShaders(OpenGL::OpenGLShaderProgram &program,
+                    const char *vertexShaderFile,
+                    const char *fragmentShaderFile = nullptr,
+                    const char *geometryShaderFile = nullptr);
+void frameBufferSizeCallback(GLFWwindow *window, int width, int height);
+bool hasExtension(const char *fileName, const char *extension);
+template <typename Loader, typename Destination>
+bool loadModel(const char *modelSource, Destination &destination);
+bool loadMeshData(const char *modelSource, Model::MeshData &meshData);
+std::size_t selectLevelOfDetail(const Model::Mesh &mesh,
+                                const glm::vec3 &cameraPosition,
+                                float projectionScale, float pixelError);
+
+bool compileShaders(OpenGL::OpenGLShaderProgram &program,
+                    const char *vertexShaderFile,
+                    const char *fragmentShaderFile,
+                    const char *geometryShaderFile)
+{
+    if (!program.addShaderFromFile(OpenGL::OpenGLShader::Type::Vertex,
+                                   vertexShaderFile))
+    {
+        return false;
+    }
+
+    if (fragmentShaderFile &&
+
+        !program.addShaderFromFile(OpenGL::OpenGLShader::Type::Fragment,
+                                   fragmentShaderFile))
+    {
+        return false;
+    }
+
+    if (geometryShaderFile &&
+        !program.addShaderFromFile(OpenGL::OpenGLShader::Type::Geometry,
+                                   geometryShaderFile))
+    {
+        return false;
+    }
+
+    program.link();
+    if (!program.linkStatus())
+    {
+        return false;
+    }
+
+    return true;
+}
+
+void frameBufferSizeCallback(GLFWwindow *window, int width, int height)
+{
+    if (window)
+    {
+    }
+    glViewport(0, 0, width, height);
+}
+
+bool hasExtension(const char *fileName, const char *extension)
+{
+    const std::size_t nameLength{std::strlen(fileName)};
+    const std::size_t extensionLength{std::strlen(extension)};
+
+    return nameLength >= extensionLength &&
+           std::equal(extension, extension + extensionLength,
+                      fileName + nameLength - extensionLength,
+                      [](char a, char b) {
+                          return std::tolower(static_cast<unsigned char>(a)) ==
+                                 std::tolower(static_cast<unsigned char>(b));
+                      });
+}
+
+template <typename Loader, typename Destination>
+bool loadModel(const char *modelSource, Destination &destination)
+{
+    Loader loader;
+
+    if (!loader.load(modelSource, destination))
+    {
+        std::cerr << "[Error]" << loader.errorMessage().c_str();
+
+        return false;
+    }
+
+    // Problems that did not stop the load, such as a missing material file.
+    if (!loader.errorMessage().empty())
+    {
+        std::cerr << "[Warning]" << loader.errorMessage().c_str();
+    }
+
+    const typename Loader::Statistics &statistics{loader.statistics()};
+    std::cout << "Loaded " << modelSource << ": " << statistics.vertexCount
+              << " vertices, " << statistics.triangleCount << " triangles in "
+              << statistics.loadMilliseconds << " ms ("
+              << statistics.triangleCount /
+                     std::max(statistics.loadMilliseconds * 1e-3, 1e-9)
+              << " triangles/s, peak RSS "
+              << statistics.peakResidentSetSize / (1024 * 1024) << " MiB)"
+              << std::endl;
+
+    return true;
+}
+
+// Reads an STL or OBJ model and prepares it as the cache stores it: with
+// normals, tangents when it has texture coordinates, and optimized order.
+bool loadMeshData(const char *modelSource, Model::MeshData &meshData)
+{
+    const bool loaded{
+        hasExtension(modelSource, ".stl")
+            ? loadModel<Model::StlLoader>(modelSource, meshData)
+            : loadModel<Model::ObjLoader>(modelSource, meshData)};
+    if (!loaded)
+    {
+        return false;
+    }
+
+    // Like the optimized order below, generated normals are cached.
+    if (meshData.normals.empty())
+    {
+        Model::NormalGenerator generator{Model::NormalWeighting::AreaAngle,
+                                         creaseAngle};
+        generator.generate(meshData);
+        const Model::NormalGenerator::Statistics &statistics{
+            generator.statistics()};
+        std::cout << "Generated normals for " << modelSource << " in "
+                  << statistics.generateMilliseconds << " ms, "
+                  << statistics.splitVertexCount
+                  << " vertices split at creases" << std::endl;
+    }
+
+    // Tangents for normal mapping need texture coordinates to follow.
+    if (meshData.tangents.empty() && !meshData.textureCoordinates.empty())
+    {
+        Model::TangentGenerator generator;
+        if (generator.generate(meshData))
+        {
+            const Model::TangentGenerator::Statistics &statistics{
+                generator.statistics()};
+            std::cout << "Generated tangents for " << modelSource << " in "
+                      << statistics.generateMilliseconds << " ms, "
+                      << statistics.splitVertexCount
+                      << " vertices split at mirrored UVs, "
+                      << statistics.degenerateTriangleCount
+                      << " triangles without UV area" << std::endl;
+        }
+    }
+
+    // The cache stores the optimized order, so this runs once per model.
+    Model::MeshOptimizer optimizer;
+    optimizer.optimize(meshData);
+    const Model::MeshOptimizer::Statistics &statistics{
+        optimizer.statistics()};
+    std::cout << "Optimized " << modelSource << " in "
+              << statistics.optimizeMilliseconds << " ms: ACMR "
+              << statistics.before.averageCacheMissRatio << " -> "
+              << statistics.after.averageCacheMissRatio << ", ATVR "
+              << statistics.before.averageTransformToVertexRatio << " -> "
+              << statistics.after.averageTransformToVertexRatio
+              << ", overfetch " << statistics.before.overfetch << " -> "
+              << statistics.after.overfetch << ", "
+              << statistics.clusterCount << " overdraw clusters"
+              << std::endl;
+    return true;
+}
+
+// The coarsest level whose error, projected at the distance of the nearest
+// point of the bounding sphere, stays within pixelError.
+std::size_t selectLevelOfDetail(const Model::Mesh &mesh,
+                                const glm::vec3 &cameraPosition,
+                                float projectionScale, float pixelError)
+{
+    const std::vector<Model::LevelOfDetail> &levels{mesh.levelsOfDetail()};
+    if (levels.size() < 2)
+    {
+        return 0;
+    }
+
+    const glm::mat4 model{mesh.model()};
+    // Errors grow with the largest scale of the model matrix.
+    const float scale{std::max({glm::length(glm::vec3{model[0]}),
+                                glm::length(glm::vec3{model[1]}),
+                                glm::length(glm::vec3{model[2]})})};
+    const Model::BoundingSphere sphere{mesh.worldBoundingSphere()};
+    const float distance{std::max(
+        glm::length(sphere.center - cameraPosition) - sphere.radius,
+        nearPlane)};
+
+    std::size_t level{0};
+    while (level + 1 < levels.size() &&
+           levels[level + 1].error * scale * projectionScale / distance <=
+               pixelError)
+    {
+        ++level;
+    }
+    return level;
+}
+
+} // namespace Detail
+
+OpenGLWindow::OpenGLWindow(glm::ivec2 windowSize, std::string title,
+                           glm::ivec2 openglVersion)
+    : window_{nullptr}, size_{windowSize}, title_{title},
+      version_{openglVersion}, vertexHeap_{}, indexHeap_{}, models_{},
+      arena_{}, arenaEntries_{},
+      chunkedModels_{}, cameraBlocks_{}, objectBlocks_{},
+      renderMode_{RenderMode::Fill}, backfaceCulling_{true},
+      frustumCuller_{}, modelVisible_{}, submission_{Submission::Instanced},
+      drawMilliseconds_{0.0}, drawCallCount_{0},
+      lodPixelError_{1.0f}, pick_{false, false, 0, Model::RayHit{}, 0.0},
+      mousePressed_{false},
+      backgroundColor_{0}, lookAt_{0},
+      cameraPosition_{lookAt_ + glm::vec3{8}}
+{
+    create();
+}
+
+OpenGLWindow::~OpenGLWindow() { destroy(); }
+
+bool OpenGLWindow::addModel(const char *modelSource, const char *textureSource,
+                            OpenGL::OpenGLShaderProgram &program,
+                            Model::VertexCompression compression)
+{
+    std::unique_ptr<OpenGL::OpenGLTexture> texture;
+    std::unique_ptr<Model::Mesh> mesh;
+
+    if (Detail::hasExtension(modelSource, ".gltf") ||
+        Detail::hasExtension(modelSource, ".glb"))
+    {
+        // glTF brings its own materials and images, and its buffer views are
+        // uploaded as they are, so it bypasses the cache too.
+        Model::GltfScene scene;
+        if (!Detail::loadModel<Model::GltfLoader>(modelSource, scene))
+        {
+            return false;
+        }
+
+        Model::GltfMeshes gltf{Model::GltfMeshFactory::create(scene, program)};
+        std::move(gltf.textures.begin(), gltf.textures.end(),
+                  std::back_inserter(textures));
+        std::move(gltf.meshes.begin(), gltf.meshes.end(),
+                  std::back_inserter(models_));
+        arenaEntries_.resize(models_.size(),
+                             ArenaEntry{false, 0, {}, {}});
+
+        return true;
+    }
+
+    if (textureSource)
+    {
+        texture = Model::TextureFactory::loadFromFile(textureSource);
+    }
+
+    if (Detail::hasExtension(modelSource, ".ply"))
+    {
+        // PLY is streamed chunk by chunk straight into the GPU buffers, so
+        // the model is never resident on the host and is not cached.
+        mesh.reset(new Model::Mesh{program, texture.get(),
+                                   Model::Mesh::VertexLayoutMode::Interleaved});
+        if (!Detail::loadModel<Model::PlyLoader>(modelSource, *mesh))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        Model::MeshCache cache;
+        Model::MeshData meshData;
+        std::vector<unsigned char> packedVertices;
+        Model::VertexImage vertexImage{};
+
+        const bool cached{cache.open(modelSource)};
+
+        if (cached)
+        {
+            std::cout << "Loaded " << modelSource << " from "
+                      << Model::MeshCache::cachePath(modelSource) << ": "
+                      << cache.view().vertexCount << " vertices, "
+                      << cache.view().indexCount / 3 << " triangles"
+                      << std::endl;
+        }
+        else
+        {
+            if (!Detail::loadMeshData(modelSource, meshData))
+            {
+                return false;
+            }
+
+            // The cache also keeps the vertices as they are uploaded, which
+            // a cache hit then does straight from the mapping.
+            vertexImage = Model::Mesh::packVertices(
+                meshData.view(), compression, packedVertices);
+            if (!Model::MeshCache::write(modelSource, meshData, &vertexImage))
+            {
+                std::cerr << "[Warning] Cannot write mesh cache "
+                          << Model::MeshCache::cachePath(modelSource)
+                          << std::endl;
+            }
+        }
+
+        const Model::MeshView view{cached ? cache.view() : meshData.view()};
+        // Every stream is read for shading, which favours one interleaved
+        // buffer (see VertexLayoutBenchmark). Models share the buffers of
+        // the heaps, so many small parts take a few buffer objects.
+        if (!vertexHeap_)
+        {
+            vertexHeap_.reset(new Model::BufferHeap{
+                OpenGL::OpenGLBufferObject::Type::ArrayBuffer});
+            indexHeap_.reset(new Model::BufferHeap{
+                OpenGL::OpenGLBufferObject::Type::ElementArrayBuffer});
+        }
+        // Vertices packed for another compression are packed again.
+        mesh.reset(new Model::Mesh{
+            view, *vertexHeap_, *indexHeap_, program, texture.get(),
+            compression, cached ? cache.vertexImage() : &vertexImage});
+        addMaterials(view, *mesh);
+
+        Performance::Stopwatch stopwatch;
+        mesh->setMeshlets(Model::MeshletBuilder{}.build(view));
+        std::cout << "Built " << mesh->meshlets().size() << " meshlets in "
+                  << stopwatch.elapsedMilliseconds() << " ms" << std::endl;
+
+        stopwatch.restart();
+        mesh->setLevelsOfDetail(Model::MeshSimplifier::buildChain(view));
+        std::cout << "Built " << mesh->levelsOfDetail().size()
+                  << " levels of detail in " << stopwatch.elapsedMilliseconds()
+                  << " ms:";
+        for (const Model::LevelOfDetail &level : mesh->levelsOfDetail())
+        {
+            std::cout << " " << level.indexCount / 3;
+        }
+        std::cout << " triangles" << std::endl;
+
+        std::shared_ptr<Model::TriangleBvh> bvh{new Model::TriangleBvh{}};
+        bvh->build(view);
+        const Model::TriangleBvh::Statistics &bvhStatistics{
+            bvh->statistics()};
+        std::cout << "Built triangle BVH: " << bvhStatistics.nodeCount
+                  << " nodes, " << bvhStatistics.leafCount
+                  << " leaves, depth " << bvhStatistics.depth << " in "
+                  << bvhStatistics.buildMilliseconds << " ms" << std::endl;
+        mesh->setTriangleBvh(std::move(bvh));
+
+        // The arena takes the geometry at full detail, from the cache and
+        // only once it is selected, in the compression of the first model,
+        // with the materials of the mesh.
+        if (OpenGL::OpenGLDrawIndirect::available())
+        {
+            if (!arena_)
+            {
+                arena_.reset(new Model::GeometryArena{program, compression});
+            }
+            arenaEntries_.resize(models_.size(),
+                                 ArenaEntry{false, 0, {}, {}});
+            arenaEntries_.push_back(ArenaEntry{false, 0, {}, modelSource});
+        }
+
+        if (compression != Model::VertexCompression::None)
+        {
+            const Model::QuantizationReport &report{
+                mesh->quantizationReport()};
+            std::cout << "Compressed vertices " << report.vertexBytes
+                      << " -> " << report.compressedVertexBytes
+                      << " bytes, indices " << report.indexBytes << " -> "
+                      << report.compressedIndexBytes
+                      << " bytes, max error: position "
+                      << report.maximumPositionError << ", normal "
+                      << report.maximumNormalError << " deg, uv "
+                      << report.maximumTextureCoordinateError << std::endl;
+        }
+    }
+
+    if (texture)
+    {
+        textures.push_back(std::move(texture));
+    }
+    models_.push_back(std::move(mesh));
+    arenaEntries_.resize(models_.size(), ArenaEntry{false, 0, {}, {}});
+
+    return true;
+}
+
+// Gives every material of the model its diffuse color and map. The maps are
+// decoded in parallel and each file is loaded once.
+void OpenGLWindow::addMaterials(const Model::MeshView &view, Model::Mesh &mesh)
+{
+    if (!view.materialCount)
+    {
+        return;
+    }
+
+    std::vector<std::string> fileNames;
+    std::vector<std::size_t> textureIndices(view.materialCount);
+    for (std::size_t i{0}; i < view.materialCount; ++i)
+    {
+        const std::string &fileName{view.materials[i].diffuseTexture};
+        textureIndices[i] = static_cast<std::size_t>(
+            std::find(fileNames.begin(), fileNames.end(), fileName) -
+            fileNames.begin());
+        if (!fileName.empty() && textureIndices[i] == fileNames.size())
+        {
+            fileNames.push_back(fileName);
+        }
+    }
+
+    std::vector<std::unique_ptr<OpenGL::OpenGLTexture>> materialTextures{
+        Model::TextureFactory::loadFromFiles(fileNames)};
+
+    std::vector<Model::Mesh::MaterialState> materials;
+    materials.reserve(view.materialCount);
+    for (std::size_t i{0}; i < view.materialCount; ++i)
+    {
+        const Model::Material &material{view.materials[i]};
+        OpenGL::OpenGLTexture *texture{nullptr};
+        if (!material.diffuseTexture.empty())
+        {
+            texture = materialTextures[textureIndices[i]].get();
+            if (!texture)
+            {
+                std::cerr << "[Warning] Cannot load texture "
+                          << material.diffuseTexture << std::endl;
+            }
+        }
+        materials.push_back(Model::Mesh::MaterialState{
+            texture, glm::vec4{material.diffuseColor, 1.0f}});
+    }
+    mesh.setMaterials(std::move(materials));
+
+    for (auto &texture : materialTextures)
+    {
+        if (texture)
+        {
+            textures.push_back(std::move(texture));
+        }
+    }
+}
+
+// In the arena every instance is a draw of its own.
+void OpenGLWindow::addArenaDraws(std::size_t model)
+{
+    const Model::Mesh &mesh{*models_[model]};
+    ArenaEntry &entry{arenaEntries_[model]};
+    for (Model::GeometryArena::Draw draw : entry.draws)
+    {
+        arena_->removeDraw(draw);
+    }
+    entry.draws.clear();
+
+    if (!mesh.instances())
+    {
+        entry.draws.push_back(arena_->addDraw(entry.geometry, mesh.model()));
+        return;
+    }
+    for (const glm::mat4 &instance : mesh.instances()->models())
+    {
+        entry.draws.push_back(
+            arena_->addDraw(entry.geometry, mesh.model() * instance));
+    }
+}
+
+bool OpenGLWindow::addChunkedModel(const char *modelSource,
+                                   const char *textureSource,
+                                   OpenGL::OpenGLShaderProgram &program,
+                                   std::size_t budgetBytes)
+{
+    std::unique_ptr<OpenGL::OpenGLTexture> texture;
+
+    if (textureSource)
+    {
+        texture = Model::TextureFactory::loadFromFile(textureSource);
+    }
+
+    std::unique_ptr<Model::ChunkedMesh> mesh{
+        new Model::ChunkedMesh{program, texture.get(), budgetBytes}};
+
+    if (!mesh->open(modelSource))
+    {
+        // Preprocessing pass. PLY streams straight into the partitioner; the
+        // other formats are partitioned from their cache or loaded mesh.
+        Model::ChunkedMeshBuilder builder{modelSource};
+        Model::MeshCache cache;
+        Model::MeshData meshData;
+
+        if (Detail::hasExtension(modelSource, ".ply"))
+        {
+            if (!Detail::loadModel<Model::PlyLoader>(modelSource, builder))
+            {
+                return false;
+            }
+        }
+        else if (cache.open(modelSource))
+        {
+            builder.build(cache.view());
+        }
+        else
+        {
+            const bool loaded{
+                Detail::hasExtension(modelSource, ".stl")
+                    ? Detail::loadModel<Model::StlLoader>(modelSource,
+                                                          meshData)
+                    : Detail::loadModel<Model::ObjLoader>(modelSource,
+                                                          meshData)};
+            if (!loaded)
+            {
+                return false;
+            }
+            builder.build(meshData.view());
+        }
+
+        if (!builder.good() || !mesh->open(modelSource))
+        {
+            std::cerr << "[Error]" << builder.errorMessage()
+                      << mesh->errorMessage();
+            return false;
+        }
+
+        std::cout << "Partitioned " << modelSource << " into "
+                  << builder.chunkCount() << " chunks in "
+                  << Model::ChunkedMeshBuilder::chunkPath(modelSource)
+                  << std::endl;
+    }
+
+    if (texture)
+    {
+        textures.push_back(std::move(texture));
+    }
+    chunkedModels_.push_back(std::move(mesh));
+
+    return true;
+}
+
+OpenGL::OpenGLShaderProgram *
+OpenGLWindow::addShader(const char *vertexShaderSource,
+                        const char *fragmentShaderSource,
+                        const char *geometryShaderSource)
+{
+    std::unique_ptr<OpenGL::OpenGLShaderProgram> program{
+        new OpenGL::OpenGLShaderProgram{}};
+    if (!Detail::compileShaders(*program, vertexShaderSource,
+                                fragmentShaderSource, geometryShaderSource))
+    {
+        return nullptr;
+    }
+    program->bindUniformBlock("Camera", Model::cameraBlockBinding);
+    program->bindUniformBlock("Object", Model::objectBlockBinding);
+    // Set through the uniform table, which skips it while it holds.
+    program->use();
+    program->setValue(Detail::objectTextureUniform, Detail::objectTextureUnit);
+    shaders_.push_back(std::move(program));
+
+    return shaders_.back().get();
+}
+
+float OpenGLWindow::aspectRatio() const noexcept
+{
+    return static_cast<float>(width()) / static_cast<float>(height());
+}
+
+void OpenGLWindow::create()
+{
+    if (!initializeOpenGL())
+    {
+        throw OpenGL::OpenGLException{"Failed to initialize OpenGL"};
+    }
+
+    if (!createWindow())
+    {
+        glfwTerminate();
+        throw OpenGL::OpenGLException{"Failed to Create GLFW window"};
+    }
+
+    if (!initializeGLAD())
+    {
+        glfwTerminate();
+        throw OpenGL::OpenGLException{"Failed to initialize GLAD"};
+    }
+
+    initializeImgui();
+}
+
+void OpenGLWindow::clearColor()
+{
+    glClearColor(backgroundColor_.x, backgroundColor_.y, backgroundColor_.z,
+                 backgroundColor_.w);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+bool OpenGLWindow::createWindow()
+{
+    window_ =
+        glfwCreateWindow(width(), height(), title_.c_str(), nullptr, nullptr);
+    if (!window_)
+    {
+        return false;
+    }
+    glfwMakeContextCurrent(window_);
+    glfwSetFramebufferSizeCallback(window_, Detail::frameBufferSizeCallback);
+
+    return true;
+}
+
+void OpenGLWindow::destroy()
+{
+    for (auto &model : models_)
+    {
+        model.reset(nullptr);
+    }
+    models_.clear();
+    vertexHeap_.reset();
+    indexHeap_.reset();
+    arenaEntries_.clear();
+    arena_.reset();
+    chunkedModels_.clear();
+    frustumCuller_.clear();
+
+    for (auto &texture : textures)
+    {
+        texture.reset(nullptr);
+    }
+    textures.clear();
+
+    shaders_.clear();
+    cameraBlocks_.reset();
+    objectBlocks_.reset();
+
+    destroyImgui();
+    destroyOpenGL();
+}
+
+void OpenGLWindow::destroyImgui()
+{
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplGlfw_Shutdown();
+    ImGui::DestroyContext();
+}
+
+void OpenGLWindow::destroyOpenGL()
+{
+    glfwDestroyWindow(window_);
+    glfwTerminate();
+}
+
+// Packs the models not in the arena yet from their caches, which hold them
+// as they were uploaded. A cache gone stale or missing since the model was
+// added is rebuilt from the source; only a model that no longer loads stays
+// drawn on its own.
+void OpenGLWindow::fillArena()
+{
+    for (std::size_t i{0}; i < arenaEntries_.size(); ++i)
+    {
+        ArenaEntry &entry{arenaEntries_[i]};
+        if (entry.resident || entry.source.empty())
+        {
+            continue;
+        }
+
+        Model::MeshCache cache;
+        Model::MeshData meshData;
+        const bool cached{cache.open(entry.source.c_str())};
+        if (!cached)
+        {
+            std::cerr << "[Warning] No valid mesh cache of " << entry.source
+                      << ", loading it again" << std::endl;
+            if (!Detail::loadMeshData(entry.source.c_str(), meshData))
+            {
+                std::cerr << "[Warning] Cannot load " << entry.source
+                          << ", it stays out of the arena" << std::endl;
+                entry.source.clear();
+                continue;
+            }
+            if (!Model::MeshCache::write(entry.source.c_str(), meshData))
+            {
+                std::cerr << "[Warning] Cannot write mesh cache "
+                          << Model::MeshCache::cachePath(entry.source.c_str())
+                          << std::endl;
+            }
+        }
+
+        // Sub-meshes without a material texture use the one of the mesh, as
+        // Mesh::draw() does.
+        const Model::Mesh &mesh{*models_[i]};
+        std::vector<Model::GeometryArena::Material> materials;
+        for (const Model::Mesh::MaterialState &material : mesh.materials())
+        {
+            materials.push_back(arena_->addMaterial(
+                material.texture ? material.texture : mesh.texture(),
+                material.color));
+        }
+        entry.geometry = arena_->addGeometry(
+            cached ? cache.view() : meshData.view(), materials,
+            arena_->addMaterial(mesh.texture(), mesh.color()));
+        entry.resident = true;
+        addArenaDraws(i);
+    }
+}
+
+int OpenGLWindow::height() const noexcept { return size_.y; }
+
+void OpenGLWindow::layOutInstances(std::size_t count)
+{
+    if (models_.empty() || !count)
+    {
+        return;
+    }
+
+    Model::Mesh &mesh{*models_.back()};
+    const Model::Bounds &bounds{mesh.bounds()};
+    const glm::vec3 extent{bounds.maximum - bounds.minimum};
+    const float spacing{1.5f * std::max({extent.x, extent.y, extent.z})};
+    const std::size_t side{static_cast<std::size_t>(
+        std::ceil(std::sqrt(static_cast<double>(count))))};
+    const float origin{-0.5f * spacing * static_cast<float>(side - 1)};
+
+    for (std::size_t i{0}; i < count; ++i)
+    {
+        const glm::vec3 offset{
+            origin + spacing * static_cast<float>(i % side), 0.0f,
+            origin + spacing * static_cast<float>(i / side)};
+        mesh.addInstance(glm::translate(glm::mat4{1}, offset));
+    }
+
+    if (arenaEntries_.back().resident)
+    {
+        addArenaDraws(models_.size() - 1);
+    }
+    std::cout << "Laid out " << count << " instances on a " << side << " x "
+              << side << " grid" << std::endl;
+}
+
+bool OpenGLWindow::initializeGLAD()
+{
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+    {
+        return false;
+    }
+
+    // Optional; without it models are only drawn one by one.
+    if (!OpenGL::OpenGLDrawIndirect::load((GLADloadproc)glfwGetProcAddress))
+    {
+        std::cout << "Multi-draw indirect needs OpenGL 4.3, the shared "
+                     "geometry arena is off"
+                  << std::endl;
+    }
+    // Optional; without it streamed buffers are mapped frame by frame.
+    if (!OpenGL::OpenGLStreamBuffer::load((GLADloadproc)glfwGetProcAddress))
+    {
+        std::cout << "Persistent mapping needs OpenGL 4.4, streamed buffers "
+                     "are mapped every frame"
+                  << std::endl;
+    }
+    return true;
+}
+
+void OpenGLWindow::initializeImgui()
+{
+    IMGUI_CHECKVERSION();
+    ImGui::CreateContext();
+
+    ImGuiIO &io = ImGui::GetIO();
+    PROGRAM_MAYBE_UNUSED(io)
+
+    ImGui::StyleColorsDark();
+
+    ImGui_ImplGlfw_InitForOpenGL(window_, true);
+    ImGui_ImplOpenGL3_Init(
+        StringFormat::StringFormat("#version %d%d0", version_.x, version_.y)
+            .c_str());
+}
+
+bool OpenGLWindow::initializeOpenGL()
+{
+    if (!glfwInit())
+    {
+        return false;
+    }
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version_[0]);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version_[1]);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+
+#ifdef __APPLE__
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#endif
+
+    return true;
+}
+
+void OpenGLWindow::processInput()
+{
+    shouldExit();
+    shouldPick();
+}
+
+glm::mat4 OpenGLWindow::projectionMatrix() const
+{
+    return glm::perspective(glm::radians(Detail::fieldOfView), aspectRatio(),
+                            Detail::nearPlane, Detail::farPlane);
+}
+
+void OpenGLWindow::shouldExit()
+{
+    if (glfwGetKey(window_, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    {
+        glfwSetWindowShouldClose(window_, true);
+    }
+}
+
+// A left click outside the ImGui windows casts a ray through the cursor
+// into every model that has a triangle hierarchy.
+void OpenGLWindow::shouldPick()
+{
+    const bool pressed{glfwGetMouseButton(window_, GLFW_MOUSE_BUTTON_LEFT) ==
+                       GLFW_PRESS};
+    const bool clicked{pressed && !mousePressed_};
+    mousePressed_ = pressed;
+    if (!clicked || ImGui::GetIO().WantCaptureMouse)
+    {
+        return;
+    }
+
+    double x;
+    double y;
+    glfwGetCursorPos(window_, &x, &y);
+    const glm::vec2 device{
+        2.0f * static_cast<float>(x) / static_cast<float>(width()) - 1.0f,
+        1.0f - 2.0f * static_cast<float>(y) / static_cast<float>(height())};
+
+    // From the near plane at 0 to the far plane at 1.
+    const glm::mat4 inverse{glm::inverse(projectionMatrix() * viewMatrix())};
+    glm::vec4 nearPoint{inverse * glm::vec4{device, -1.0f, 1.0f}};
+    glm::vec4 farPoint{inverse * glm::vec4{device, 1.0f, 1.0f}};
+    nearPoint /= nearPoint.w;
+    farPoint /= farPoint.w;
+    Model::Ray ray{glm::vec3{nearPoint}, glm::vec3{farPoint - nearPoint},
+                   0.0f, 1.0f};
+
+    Performance::Stopwatch stopwatch;
+    pick_ = Pick{true, false, 0, Model::RayHit{}, 0.0};
+    for (std::size_t i{0}; i < models_.size(); ++i)
+    {
+        Model::RayHit hit;
+        if (models_[i]->pick(ray, hit))
+        {
+            pick_.hit = true;
+            pick_.model = i;
+            pick_.rayHit = hit;
+            ray.maximumDistance = hit.distance;
+        }
+    }
+    pick_.milliseconds = stopwatch.elapsedMilliseconds();
+}
+
+void OpenGLWindow::startRender() { windowRenderLoop(); }
+
+glm::mat4 OpenGLWindow::viewMatrix() const
+{
+    PRAGMA_WARNING_PUSH
+    PRAGMA_WARNING_DISABLE_CONSTANTCONDITIONAL
+    return glm::lookAt(cameraPosition_, lookAt_, glm::vec3{0, 1, 0}) *
+           glm::mat4(1);
+    PRAGMA_WARNING_POP
+}
+
+int OpenGLWindow::width() const noexcept { return size_.x; }
+
+void OpenGLWindow::windowImguiGeneralSetting()
+{
+    ImGui::Begin("Setting");
+    ImGui::ColorEdit4("Background color", glm::value_ptr(backgroundColor_));
+    ImGui::SliderFloat3("Camera Position", glm::value_ptr(cameraPosition_),
+                        -20.0f, 20.0f);
+    ImGui::SliderFloat3("Look At", glm::value_ptr(lookAt_), -20.0f, 20.0f);
+
+    const char *items[] = {"Line", "Fill"};
+    int current_item = renderMode_;
+    ImGui::Combo("combo", &current_item, items, IM_ARRAYSIZE(items));
+
+    renderMode_ = static_cast<RenderMode>(current_item);
+
+    if (ImGui::Checkbox("Backface cluster culling", &backfaceCulling_))
+    {
+        for (const auto &model : models_)
+        {
+            model->setBackfaceCulling(backfaceCulling_);
+        }
+    }
+
+    if (pick_.hit)
+    {
+        ImGui::Text("Picked model %zu, triangle %u, UV (%.4f, %.4f) in %.3f ms",
+                    pick_.model, pick_.rayHit.triangle,
+                    static_cast<double>(pick_.rayHit.textureCoordinate.x),
+                    static_cast<double>(pick_.rayHit.textureCoordinate.y),
+                    pick_.milliseconds);
+    }
+    else if (pick_.picked)
+    {
+        ImGui::Text("Picked nothing in %.3f ms", pick_.milliseconds);
+    }
+
+    ImGui::SliderFloat("LOD pixel error", &lodPixelError_, 0.0f, 16.0f);
+    for (std::size_t i{0}; i < models_.size(); ++i)
+    {
+        const std::vector<Model::LevelOfDetail> &levels{
+            models_[i]->levelsOfDetail()};
+        if (levels.empty())
+        {
+            continue;
+        }
+
+        std::string triangles;
+        for (const Model::LevelOfDetail &level : levels)
+        {
+            triangles += StringFormat::StringFormat(
+                triangles.empty() ? "%zu" : " / %zu", level.indexCount / 3);
+        }
+        const std::size_t current{models_[i]->levelOfDetail()};
+        ImGui::Text("Model %zu: LOD %zu of %zu, %zu triangles drawn", i,
+                    current, levels.size(), levels[current].indexCount / 3);
+        ImGui::Text("  LOD triangles: %s", triangles.c_str());
+    }
+
+    const Model::FrustumCuller::Statistics &frustumStatistics{
+        frustumCuller_.statistics()};
+    ImGui::Text("Models: %zu visible, %zu culled, cull %.3f ms",
+                frustumStatistics.visibleCount, frustumStatistics.culledCount,
+                frustumStatistics.cullMilliseconds);
+    std::size_t instanceCount{0};
+    for (const auto &model : models_)
+    {
+        instanceCount += model->instances() ? model->instances()->size() : 0;
+    }
+    if (instanceCount)
+    {
+        ImGui::Text("Instances: %zu", instanceCount);
+    }
+    if (vertexHeap_)
+    {
+        const Model::BufferHeap::Statistics vertexStatistics{
+            vertexHeap_->statistics()};
+        const Model::BufferHeap::Statistics indexStatistics{
+            indexHeap_->statistics()};
+        ImGui::Text("Buffer heaps: %zu blocks, %zu ranges, %.1f / %.1f MiB",
+                    vertexStatistics.blockCount + indexStatistics.blockCount,
+                    vertexStatistics.rangeCount + indexStatistics.rangeCount,
+                    static_cast<double>(vertexStatistics.usedBytes +
+                                        indexStatistics.usedBytes) /
+                        (1024.0 * 1024.0),
+                    static_cast<double>(vertexStatistics.reservedBytes +
+                                        indexStatistics.reservedBytes) /
+                        (1024.0 * 1024.0));
+        ImGui::Text("  Free ranges: %zu, fragmentation %.1f%% / %.1f%%",
+                    vertexStatistics.freeRangeCount +
+                        indexStatistics.freeRangeCount,
+                    100.0 * vertexStatistics.fragmentation,
+                    100.0 * indexStatistics.fragmentation);
+    }
+    const char *submissions[] = {"Draw per instance", "Instanced",
+                                 "Shared arena (MDI)"};
+    int submission{static_cast<int>(submission_)};
+    if (ImGui::Combo("Submission", &submission, submissions, arena_ ? 3 : 2))
+    {
+        submission_ = static_cast<Submission>(submission);
+        if (submission_ == Submission::Arena)
+        {
+            fillArena();
+        }
+    }
+    ImGui::Text("Draw calls: %zu, submission %.3f ms", drawCallCount_,
+                drawMilliseconds_);
+    if (objectBlocks_)
+    {
+        const Model::ObjectUniformBuffer::Statistics &objectStatistics{
+            objectBlocks_->statistics()};
+        ImGui::Text("Object blocks: %zu in one upload of %zu bytes, %zu binds"
+                    ", %s",
+                    objectStatistics.blockCount, objectStatistics.uploadBytes,
+                    objectStatistics.bindCount,
+                    objectStatistics.streamed ? "streamed" : "orphaned");
+    }
+    const OpenGL::OpenGLStateCache::Statistics &stateStatistics{
+        OpenGL::OpenGLStateCache::statistics()};
+    ImGui::Text("State changes: %zu issued, %zu filtered",
+                stateStatistics.issuedCount, stateStatistics.filteredCount);
+    if (arena_)
+    {
+        const Model::GeometryArena::Statistics &arenaStatistics{
+            arena_->statistics()};
+        ImGui::Text("Arena: %zu geometries, %zu draws of %zu parts, "
+                    "%zu vertices",
+                    arenaStatistics.geometryCount, arenaStatistics.drawCount,
+                    arenaStatistics.partCount, arenaStatistics.vertexCount);
+        ImGui::Text("  %zu parts visible, %zu culled",
+                    arenaStatistics.visiblePartCount,
+                    arenaStatistics.culledPartCount);
+        // glTF, PLY and chunked models, and those that failed to load again,
+        // are still drawn one by one.
+        const std::size_t outside{
+            chunkedModels_.size() +
+            static_cast<std::size_t>(std::count_if(
+                arenaEntries_.begin(), arenaEntries_.end(),
+                [](const ArenaEntry &entry) { return !entry.resident; }))};
+        ImGui::Text("  %zu models drawn outside it", outside);
+        const OpenGL::OpenGLStreamBuffer::Statistics &streamStatistics{
+            arena_->streamStatistics()};
+        ImGui::Text("  Commands streamed: %td bytes/frame, %s",
+                    streamStatistics.frameBytes,
+                    streamStatistics.persistent ? "persistent" : "mapped");
+        ImGui::Text("  Stalls: %zu in %zu frames, %.3f ms",
+                    streamStatistics.stallCount, streamStatistics.frameCount,
+                    streamStatistics.stallMilliseconds);
+    }
+
+    Model::MeshletCullStatistics culled{};
+    for (const auto &model : models_)
+    {
+        const Model::MeshletCullStatistics &statistics{
+            model->meshletStatistics()};
+        culled.meshletCount += statistics.meshletCount;
+        culled.frustumCulled += statistics.frustumCulled;
+        culled.backfaceCulled += statistics.backfaceCulled;
+        culled.drawCount += statistics.drawCount;
+        culled.cullMilliseconds += statistics.cullMilliseconds;
+    }
+    if (culled.meshletCount)
+    {
+        ImGui::Text("Meshlets: %zu, culled %zu frustum, %zu backface",
+                    culled.meshletCount, culled.frustumCulled,
+                    culled.backfaceCulled);
+        ImGui::Text("Meshlet draws: %zu ranges, cull %.3f ms",
+                    culled.drawCount, culled.cullMilliseconds);
+    }
+
+    for (const auto &model : chunkedModels_)
+    {
+        const Model::ChunkedMesh::Statistics &statistics{model->statistics()};
+        ImGui::Text("Chunks resident: %zu / %zu", statistics.residentChunks,
+                    statistics.chunkCount);
+        ImGui::Text("Resident: %.1f / %.1f MiB",
+                    static_cast<double>(statistics.residentBytes) /
+                        (1024.0 * 1024.0),
+                    static_cast<double>(statistics.budgetBytes) /
+                        (1024.0 * 1024.0));
+        ImGui::Text("Page-in: %.2f ms (average %.2f, max %.2f)",
+                    statistics.lastPageInMilliseconds,
+                    statistics.averagePageInMilliseconds,
+                    statistics.maximumPageInMilliseconds);
+    }
+
+    ImGui::End();
+}
+
+void OpenGLWindow::windowRenderLateUpdate() {}
+
+void OpenGLWindow::windowRenderImguiUpdate()
+{
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplGlfw_NewFrame();
+    ImGui::NewFrame();
+
+    windowImguiGeneralSetting();
+
+    ImGui::Render();
+    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+}
+
+void OpenGLWindow::windowRenderLoop()
+{
+    while (!(glfwWindowShouldClose(window_)))
+    {
+        processInput();
+        clearColor();
+
+        windowRenderUpdate();
+        windowRenderLateUpdate();
+
+        windowRenderImguiUpdate();
+        OpenGL::OpenGLStateCache::endFrame();
+
+        glfwSwapBuffers(window_);
+        glfwPollEvents();
+    }
+}
+
+void OpenGLWindow::windowRenderUpdate()
+{
+    Performance::Stopwatch stopwatch;
+
+    // Set every frame; the state cache drops them while they hold.
+    OpenGL::OpenGLStateCache::setDepthTest(true);
+    OpenGL::OpenGLStateCache::setPolygonMode(
+        renderMode_ == RenderMode::Line ? GL_LINE : GL_FILL);
+
+    glm::mat4 view{viewMatrix()};
+    glm::mat4 projection{projectionMatrix()};
+
+    const float projectionScale{
+        static_cast<float>(height()) /
+        (2.0f * std::tan(0.5f * glm::radians(Detail::fieldOfView)))};
+    for (std::size_t i{frustumCuller_.size()}; i < models_.size(); ++i)
+    {
+        frustumCuller_.add(models_[i]->worldBounds(),
+                           models_[i]->worldBoundingSphere());
+    }
+    frustumCuller_.cull(projection * view, modelVisible_);
+
+    if (!cameraBlocks_)
+    {
+        cameraBlocks_.reset(
+            new Model::CameraUniformBuffer{Model::cameraBlockBinding});
+        objectBlocks_.reset(new Model::ObjectUniformBuffer{
+            Model::objectBlockBinding, models_.size()});
+    }
+    cameraBlocks_->clear();
+    cameraBlocks_->append(Model::CameraBlock{
+        view, projection, projection * view, glm::vec4{cameraPosition_, 1}});
+    cameraBlocks_->upload();
+    cameraBlocks_->bind();
+
+    // Models in the arena are culled by it, draw by draw.
+    const bool arena{submission_ == Submission::Arena && arena_};
+    objectBlocks_->clear();
+    for (std::size_t i{0}; i < models_.size(); ++i)
+    {
+        if (!modelVisible_[i] || (arena && arenaEntries_[i].resident))
+        {
+            continue;
+        }
+
+        Model::Mesh &model{*models_[i]};
+        model.setLevelOfDetail(Detail::selectLevelOfDetail(
+            model, cameraPosition_, projectionScale, lodPixelError_));
+        model.writeObjects(*objectBlocks_,
+                           submission_ == Submission::Separate);
+    }
+    if (arena)
+    {
+        arena_->writeObjects(*objectBlocks_);
+    }
+    for (auto &model : chunkedModels_)
+    {
+        model->update(cameraPosition_);
+        model->writeObjects(*objectBlocks_);
+    }
+    objectBlocks_->upload();
+
+    drawCallCount_ = 0;
+    for (std::size_t i{0}; i < models_.size(); ++i)
+    {
+        if (!modelVisible_[i] || (arena && arenaEntries_[i].resident))
+        {
+            continue;
+        }
+
+        Model::Mesh &model{*models_[i]};
+        if (submission_ == Submission::Separate)
+        {
+            model.drawSeparately(view, projection);
+        }
+        else
+        {
+            model.draw(view, projection);
+        }
+        drawCallCount_ += model.drawCallCount();
+    }
+
+    if (arena)
+    {
+        arena_->draw(view, projection);
+        drawCallCount_ += arena_->statistics().submissionCount;
+    }
+
+    for (auto &model : chunkedModels_)
+    {
+        model->draw(view, projection);
+    }
+
+    drawMilliseconds_ = stopwatch.elapsedMilliseconds();
+}
@@ -1,93 +1,179 @@
-#ifndef HOMEWORK01_WINDOW_HPP_
-#define HOMEWORK01_WINDOW_HPP_
-
-#include "Model/Mesh.hpp"
-#include "OpenGL/OpenGLShaderProgram.hpp"
-#include "OpenGL/OpenGLTexture.hpp"
-
-#include "glad/glad.h"
-
-#include "GLFW/glfw3.h"
-
-#include "glm/vec2.hpp"
-#include "glm/vec3.hpp"
-#include "glm/vec4.hpp"
-
-#include <memory>
-#include <string>
-
-class OpenGLWindow
-{
-private:
-    enum RenderMode
-    {
-        Line = 0,
-        Fill = 1
-    };
-
-public:
-    explicit OpenGLWindow(glm::ivec2 windowSize, std::string title,
-                          glm::ivec2 openglVersion);
-    ~OpenGLWindow();
-
-    OpenGLWindow(OpenGLWindow &&other) = delete;
-    OpenGLWindow &operator=(OpenGLWindow &&other) = delete;
-    OpenGLWindow(const OpenGLWindow &other) = delete;
-    OpenGLWindow &operator=(const OpenGLWindow &other) = delete;
-
-    void create();
-    void startRender();
-
-    bool addModel(const char *modelSource, const char *textureSource,
-                  OpenGL::OpenGLShaderProgram &program);
-    OpenGL::OpenGLShaderProgram *
-    addShader(const char *vertexShaderSource, const char *fragmentShaderSource,
-              const char *geometryShaderSource = nullptr);
-
-private:
-    bool createWindow();
-    bool initializeGLAD();
-    void initializeImgui();
-    bool initializeOpenGL();
-
-    void destroy();
-    void destroyGLAD();
-    void destroyImgui();
-    void destroyOpenGL();
-
-    void windowRenderLoop();
-    void windowRenderUpdate();
-    void windowRenderLateUpdate();
-    void windowRenderImguiUpdate();
-
-    void windowImguiGeneralSetting();
-
-    void clearColor();
-
-    void processInput();
-    void shouldExit();
-    void shouldShowPolygonMode();
-
-    float aspectRatio() const noexcept;
-    int height() const noexcept;
-    int width() const noexcept;
-
-    GLFWwindow *window_;
-
-    glm::ivec2 size_;
-    std::string title_;
-    glm::ivec2 version_;
-
-    std::vector<std::unique_ptr<Model::Mesh>> models_;
-    std::vector<std::unique_ptr<OpenGL::OpenGLTexture>> textures;
-    std::vector<std::unique_ptr<OpenGL::OpenGLShaderProgram>> shaders_;
-
-    RenderMode renderMode_;
-
-    glm::vec4 backgroundColor_;
-
-    glm::vec3 lookAt_;
-    glm::vec3 cameraPosition_;
-};
-
-#endif // HOMEWORK01_WINDOW_HPP_
+#ifndef HOMEWORK01_WINDOW_HPP_
+#define HOMEWORK01_WINDOW_HPP_
+
+#include "Model/BufferHeap.hpp"
+#include "Model/ChunkedMesh.hpp"
+#include "Model/FrustumCuller.hpp"
+#include "Model/GeometryArena.hpp"
+#include "Model/Mesh.hpp"
+#include "Model/UniformBlocks.hpp"
+#include "OpenGL/OpenGLShaderProgram.hpp"
+#include "OpenGL/OpenGLTexture.hpp"
+
+#include "glad/glad.h"
+
+#include "GLFW/glfw3.h"
+
+#include "glm/mat4x4.hpp"
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "glm/vec4.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+class OpenGLWindow
+{
+private:
+    enum RenderMode
+    {
+        Line = 0,
+        Fill = 1
+    };
+
+    // How models are handed to OpenGL: instanced meshes with a draw per
+    // instance or one instanced draw, or the models held in the arena with
+    // one multi-draw indirect per texture.
+    enum class Submission
+    {
+        Separate = 0,
+        Instanced = 1,
+        Arena = 2
+    };
+
+    // Where a model lives in the geometry arena, if it does.
+    struct ArenaEntry
+    {
+        bool resident;
+        Model::GeometryArena::Geometry geometry;
+        std::vector<Model::GeometryArena::Draw> draws;
+        // Model whose mesh cache, or the model itself when the cache is not
+        // valid, fills the arena once it is selected; empty when the model
+        // cannot be packed.
+        std::string source;
+    };
+
+    // Outcome of the last click on the scene.
+    struct Pick
+    {
+        bool picked;
+        bool hit;
+        std::size_t model;
+        Model::RayHit rayHit;
+        double milliseconds;
+    };
+
+public:
+    explicit OpenGLWindow(glm::ivec2 windowSize, std::string title,
+                          glm::ivec2 openglVersion);
+    ~OpenGLWindow();
+
+    OpenGLWindow(OpenGLWindow &&other) = delete;
+    OpenGLWindow &operator=(OpenGLWindow &&other) = delete;
+    OpenGLWindow(const OpenGLWindow &other) = delete;
+    OpenGLWindow &operator=(const OpenGLWindow &other) = delete;
+
+    void create();
+    void startRender();
+
+    // compression applies to models loaded whole, not to streamed PLY.
+    bool addModel(const char *modelSource, const char *textureSource,
+                  OpenGL::OpenGLShaderProgram &program,
+                  Model::VertexCompression compression =
+                      Model::VertexCompression::None);
+    // Out-of-core mode: the model is partitioned into spatial chunks on disk
+    // once, and at most budgetBytes of them are resident at a time.
+    bool addChunkedModel(const char *modelSource, const char *textureSource,
+                         OpenGL::OpenGLShaderProgram &program,
+                         std::size_t budgetBytes);
+    // Draws the last model added by addModel as count instances on a square
+    // grid in the xz plane, the way parts repeat in a plant layout.
+    void layOutInstances(std::size_t count);
+    OpenGL::OpenGLShaderProgram *
+    addShader(const char *vertexShaderSource, const char *fragmentShaderSource,
+              const char *geometryShaderSource = nullptr);
+
+private:
+    bool createWindow();
+    bool initializeGLAD();
+    void initializeImgui();
+    bool initializeOpenGL();
+
+    void addMaterials(const Model::MeshView &view, Model::Mesh &mesh);
+    void addArenaDraws(std::size_t model);
+    void fillArena();
+
+    void destroy();
+    void destroyGLAD();
+    void destroyImgui();
+    void destroyOpenGL();
+
+    void windowRenderLoop();
+    void windowRenderUpdate();
+    void windowRenderLateUpdate();
+    void windowRenderImguiUpdate();
+
+    void windowImguiGeneralSetting();
+
+    void clearColor();
+
+    void processInput();
+    void shouldExit();
+    void shouldPick();
+    void shouldShowPolygonMode();
+
+    float aspectRatio() const noexcept;
+    int height() const noexcept;
+    int width() const noexcept;
+    glm::mat4 projectionMatrix() const;
+    glm::mat4 viewMatrix() const;
+
+    GLFWwindow *window_;
+
+    glm::ivec2 size_;
+    std::string title_;
+    glm::ivec2 version_;
+
+    // Vertices and indices of the static models loaded whole, which live in
+    // ranges of these rather than buffer objects of their own.
+    std::unique_ptr<Model::BufferHeap> vertexHeap_;
+    std::unique_ptr<Model::BufferHeap> indexHeap_;
+    std::vector<std::unique_ptr<Model::Mesh>> models_;
+    // Static models loaded whole are also packed here, when the context
+    // has multi-draw indirect and the arena is first selected. Entries
+    // follow models_.
+    std::unique_ptr<Model::GeometryArena> arena_;
+    std::vector<ArenaEntry> arenaEntries_;
+    std::vector<std::unique_ptr<Model::ChunkedMesh>> chunkedModels_;
+    std::vector<std::unique_ptr<OpenGL::OpenGLTexture>> textures;
+    std::vector<std::unique_ptr<OpenGL::OpenGLShaderProgram>> shaders_;
+    // The Camera block and the Object blocks of everything drawn, rebuilt
+    // and uploaded once a frame before the first draw.
+    std::unique_ptr<Model::CameraUniformBuffer> cameraBlocks_;
+    std::unique_ptr<Model::ObjectUniformBuffer> objectBlocks_;
+
+    RenderMode renderMode_;
+    bool backfaceCulling_;
+    // World bounds of models_, in the same order; models are not moved once
+    // added.
+    Model::FrustumCuller frustumCuller_;
+    std::vector<unsigned char> modelVisible_;
+    Submission submission_;
+    // CPU time of the last windowRenderUpdate, culling and draw calls, and
+    // the GL draw calls it issued.
+    double drawMilliseconds_;
+    std::size_t drawCallCount_;
+    // Largest geometric error a level of detail may show, in pixels.
+    float lodPixelError_;
+    Pick pick_;
+    bool mousePressed_;
+
+    glm::vec4 backgroundColor_;
+
+    glm::vec3 lookAt_;
+    glm::vec3 cameraPosition_;
+};
+
+#endif // HOMEWORK01_WINDOW_HPP_
@@ -1,26 +1,71 @@
-#version 330 core
-
-layout(location = 0) in vec3 position;
-layout(location = 1) in vec3 normal;
-layout(location = 2) in vec2 textureCoordinate;
-
-out VertexToFragment
-{
-    vec3 worldPosition;
-    vec3 normal;
-    vec2 textureCoordinate;
-}
-vertexToFragment;
-
-uniform mat4 mvp;
-
-void main()
-{
-    vec4 pos = mvp * vec4(position, 1.0);
-
-    vertexToFragment.worldPosition = pos.xyz;
-    vertexToFragment.normal = normal;
-    vertexToFragment.textureCoordinate = textureCoordinate;
-
-    gl_Position = pos;
-}
+#version 330 core
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec2 textureCoordinate;
+layout(location = 3) in vec4 color;
+// Tangent in xyz and the sign of the bitangent, cross(normal, tangent), in w.
+layout(location = 4) in vec4 tangent;
+// Model matrix of the instance; read only when instanced is set.
+layout(location = 5) in mat4 instanceModel;
+
+out VertexToFragment
+{
+    vec3 worldPosition;
+    vec3 normal;
+    vec2 textureCoordinate;
+    vec4 color;
+    vec4 tangent;
+}
+vertexToFragment;
+
+// Written once a frame, at binding 0, for every program.
+layout(std140) uniform Camera
+{
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    vec4 eyePosition;
+}
+camera;
+
+// One per draw, at binding 1; the layout is checked against ObjectBlock.
+layout(std140) uniform Object
+{
+    mat4 model;
+    // Decoding of quantized attributes; identity for float attributes.
+    vec3 positionOffset;
+    bool octahedralNormals;
+    vec3 positionScale;
+    bool instanced;
+    vec2 textureCoordinateOffset;
+    vec2 textureCoordinateScale;
+}
+object;
+
+vec3 octahedralDecode(vec2 encoded)
+{
+    vec3 n = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
+
+void main()
+{
+    vec3 modelPosition =
+        object.positionOffset + object.positionScale * position;
+    mat4 model = object.instanced ? object.model * instanceModel : object.model;
+    vec4 pos = camera.viewProjection * (model * vec4(modelPosition, 1.0));
+
+    vertexToFragment.worldPosition = pos.xyz;
+    vertexToFragment.normal =
+        object.octahedralNormals ? octahedralDecode(normal.xy) : normal;
+    vertexToFragment.textureCoordinate =
+        object.textureCoordinateOffset +
+        object.textureCoordinateScale * textureCoordinate;
+    vertexToFragment.color = color;
+    vertexToFragment.tangent = tangent;
+
+    gl_Position = pos;
+}
@@ -0,0 +1,68 @@
+#include "Base64.hpp"
+
+namespace Base64
+{
+
+namespace Detail
+{
+
+int decodeCharacter(char c) noexcept;
+
+inline int decodeCharacter(char c) noexcept
+{
+    if (c >= 'A' && c <= 'Z')
+    {
+        return c - 'A';
+    }
+    if (c >= 'a' && c <= 'z')
+    {
+        return c - 'a' + 26;
+    }
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0' + 52;
+    }
+    if (c == '+')
+    {
+        return 62;
+    }
+    if (c == '/')
+    {
+        return 63;
+    }
+    return -1;
+}
+
+} // namespace Detail
+
+bool Decode(const char *text, std::size_t size,
+            std::vector<unsigned char> &bytes)
+{
+    bytes.clear();
+    bytes.reserve(size / 4 * 3 + 3);
+
+    unsigned int bits{0};
+    int bitCount{0};
+
+    for (std::size_t i{0}; i < size && text[i] != '='; ++i)
+    {
+        const int value{Detail::decodeCharacter(text[i])};
+        if (value < 0)
+        {
+            return false;
+        }
+
+        bits = (bits << 6) | static_cast<unsigned int>(value);
+        bitCount += 6;
+        if (bitCount >= 8)
+        {
+            bitCount -= 8;
+            bytes.push_back(static_cast<unsigned char>(bits >> bitCount));
+            bits &= (1u << bitCount) - 1;
+        }
+    }
+
+    return true;
+}
+
+} // namespace Base64
@@ -0,0 +1,17 @@
+#ifndef HOMEWORK01_UTILS_BASE64_BASE64_HPP_
+#define HOMEWORK01_UTILS_BASE64_BASE64_HPP_
+
+#include <cstddef>
+#include <vector>
+
+namespace Base64
+{
+
+// Decodes standard base64 text, with or without padding. Returns false on a
+// character outside the alphabet.
+bool Decode(const char *text, std::size_t size,
+            std::vector<unsigned char> &bytes);
+
+} // namespace Base64
+
+#endif // HOMEWORK01_UTILS_BASE64_BASE64_HPP_
@@ -0,0 +1,13 @@
+#include "FilePath.hpp"
+
+namespace FileIO
+{
+
+std::string DirectoryOf(const std::string &fileName)
+{
+    const std::size_t slash{fileName.find_last_of("/\\")};
+    return slash == std::string::npos ? std::string{}
+                                      : fileName.substr(0, slash + 1);
+}
+
+} // namespace FileIO
@@ -0,0 +1,15 @@
+#ifndef HOMEWORK01_UTILS_FILEIO_FILEPATH_HPP_
+#define HOMEWORK01_UTILS_FILEIO_FILEPATH_HPP_
+
+#include <string>
+
+namespace FileIO
+{
+
+// Leading part of fileName up to and including the last path separator, or
+// an empty string when fileName has no directory part.
+std::string DirectoryOf(const std::string &fileName);
+
+} // namespace FileIO
+
+#endif // HOMEWORK01_UTILS_FILEIO_FILEPATH_HPP_
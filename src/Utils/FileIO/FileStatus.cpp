@@ -0,0 +1,44 @@
+#include "FileStatus.hpp"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+namespace FileIO
+{
+
+bool GetFileStatus(const char *fileName, FileStatus &status)
+{
+#if defined(_WIN32)
+    struct _stat64 fileStatus;
+    if (_stat64(fileName, &fileStatus) != 0)
+    {
+        return false;
+    }
+
+    status.size = static_cast<std::uint64_t>(fileStatus.st_size);
+    status.modifiedTime =
+        static_cast<std::int64_t>(fileStatus.st_mtime) * 1000000000;
+#else
+    struct stat fileStatus;
+    if (stat(fileName, &fileStatus) != 0)
+    {
+        return false;
+    }
+
+    status.size = static_cast<std::uint64_t>(fileStatus.st_size);
+#if defined(__APPLE__)
+    status.modifiedTime =
+        static_cast<std::int64_t>(fileStatus.st_mtimespec.tv_sec) *
+            1000000000 +
+        fileStatus.st_mtimespec.tv_nsec;
+#else
+    status.modifiedTime =
+        static_cast<std::int64_t>(fileStatus.st_mtim.tv_sec) * 1000000000 +
+        fileStatus.st_mtim.tv_nsec;
+#endif
+#endif
+
+    return true;
+}
+
+} // namespace FileIO
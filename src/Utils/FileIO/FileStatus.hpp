@@ -0,0 +1,20 @@
+#ifndef HOMEWORK01_UTILS_FILEIO_FILESTATUS_HPP_
+#define HOMEWORK01_UTILS_FILEIO_FILESTATUS_HPP_
+
+#include <cstdint>
+
+namespace FileIO
+{
+
+struct FileStatus
+{
+    std::uint64_t size;
+    // Last modification time in nanoseconds since the epoch.
+    std::int64_t modifiedTime;
+};
+
+bool GetFileStatus(const char *fileName, FileStatus &status);
+
+} // namespace FileIO
+
+#endif // HOMEWORK01_UTILS_FILEIO_FILESTATUS_HPP_
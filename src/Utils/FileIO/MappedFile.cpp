@@ -0,0 +1,216 @@
+#include "MappedFile.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <utility>
+
+namespace FileIO
+{
+
+MappedFile::MappedFile() noexcept
+    : data_{nullptr}, size_{0}, open_{false}
+#if defined(_WIN32)
+      ,
+      file_{nullptr}, mapping_{nullptr}
+#endif
+{
+}
+
+MappedFile::MappedFile(const char *fileName) noexcept : MappedFile{}
+{
+    open(fileName);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : data_{other.data_}, size_{other.size_}, open_{other.open_}
+#if defined(_WIN32)
+      ,
+      file_{other.file_}, mapping_{other.mapping_}
+#endif
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.open_ = false;
+#if defined(_WIN32)
+    other.file_ = nullptr;
+    other.mapping_ = nullptr;
+#endif
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        tidy();
+
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(open_, other.open_);
+#if defined(_WIN32)
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#endif
+    }
+
+    return *this;
+}
+
+MappedFile::~MappedFile() { tidy(); }
+
+const char *MappedFile::begin() const noexcept { return data_; }
+
+void MappedFile::close() noexcept { tidy(); }
+
+const char *MappedFile::data() const noexcept { return data_; }
+
+const char *MappedFile::end() const noexcept { return data_ + size_; }
+
+bool MappedFile::isOpen() const noexcept { return open_; }
+
+#if defined(_WIN32)
+
+bool MappedFile::open(const char *fileName) noexcept
+{
+    tidy();
+
+    HANDLE file{CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr)};
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    file_ = file;
+    size_ = static_cast<std::size_t>(fileSize.QuadPart);
+    open_ = true;
+
+    // A zero-length file cannot be mapped, but it is still a valid file.
+    if (size_ == 0)
+    {
+        return true;
+    }
+
+    mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping_)
+    {
+        tidy();
+        return false;
+    }
+
+    data_ = static_cast<const char *>(
+        MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!data_)
+    {
+        tidy();
+        return false;
+    }
+
+    return true;
+}
+
+void MappedFile::tidy() noexcept
+{
+    if (data_)
+    {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_)
+    {
+        CloseHandle(mapping_);
+    }
+    if (file_)
+    {
+        CloseHandle(file_);
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+    file_ = nullptr;
+    mapping_ = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const char *fileName) noexcept
+{
+    tidy();
+
+    const int file{::open(fileName, O_RDONLY)};
+    if (file < 0)
+    {
+        return false;
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    size_ = static_cast<std::size_t>(status.st_size);
+    open_ = true;
+
+    if (size_ == 0)
+    {
+        ::close(file);
+        return true;
+    }
+
+    void *address{mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file, 0)};
+
+    // The mapping keeps its own reference to the file.
+    ::close(file);
+
+    if (address == MAP_FAILED)
+    {
+        size_ = 0;
+        open_ = false;
+        return false;
+    }
+
+    madvise(address, size_, MADV_SEQUENTIAL);
+    data_ = static_cast<const char *>(address);
+
+    return true;
+}
+
+void MappedFile::tidy() noexcept
+{
+    if (data_)
+    {
+        munmap(const_cast<char *>(data_), size_);
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    open_ = false;
+}
+
+#endif
+
+std::size_t MappedFile::size() const noexcept { return size_; }
+
+} // namespace FileIO
@@ -0,0 +1,49 @@
+#ifndef HOMEWORK01_UTILS_FILEIO_MAPPEDFILE_HPP_
+#define HOMEWORK01_UTILS_FILEIO_MAPPEDFILE_HPP_
+
+#include <cstddef>
+
+namespace FileIO
+{
+
+// Read-only view of a whole file mapped into the address space. The content
+// is only valid while the object is alive and open.
+class MappedFile
+{
+public:
+    explicit MappedFile() noexcept;
+    explicit MappedFile(const char *fileName) noexcept;
+
+    MappedFile(MappedFile &&other) noexcept;
+    MappedFile &operator=(MappedFile &&other) noexcept;
+    ~MappedFile();
+
+    MappedFile(const MappedFile &other) = delete;
+    MappedFile &operator=(const MappedFile &other) = delete;
+
+    bool open(const char *fileName) noexcept;
+    void close() noexcept;
+
+    bool isOpen() const noexcept;
+
+    const char *begin() const noexcept;
+    const char *end() const noexcept;
+    const char *data() const noexcept;
+    std::size_t size() const noexcept;
+
+private:
+    void tidy() noexcept;
+
+    const char *data_;
+    std::size_t size_;
+    bool open_;
+
+#if defined(_WIN32)
+    void *file_;
+    void *mapping_;
+#endif
+};
+
+} // namespace FileIO
+
+#endif // HOMEWORK01_UTILS_FILEIO_MAPPEDFILE_HPP_
@@ -0,0 +1,138 @@
+#include "Hash.hpp"
+
+#include "Utils/FileIO/MappedFile.hpp"
+
+#include <cstring>
+
+namespace Hash
+{
+
+namespace Detail
+{
+
+constexpr std::uint64_t prime1{0x9E3779B185EBCA87ull};
+constexpr std::uint64_t prime2{0xC2B2AE3D27D4EB4Full};
+constexpr std::uint64_t prime3{0x165667B19E3779F9ull};
+constexpr std::uint64_t prime4{0x85EBCA77C2B2AE63ull};
+constexpr std::uint64_t prime5{0x27D4EB2F165667C5ull};
+
+std::uint64_t rotateLeft(std::uint64_t value, int count) noexcept;
+std::uint64_t read64(const unsigned char *p) noexcept;
+std::uint32_t read32(const unsigned char *p) noexcept;
+std::uint64_t round(std::uint64_t accumulator, std::uint64_t input) noexcept;
+std::uint64_t mergeRound(std::uint64_t accumulator,
+                         std::uint64_t value) noexcept;
+
+inline std::uint64_t rotateLeft(std::uint64_t value, int count) noexcept
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+inline std::uint64_t read64(const unsigned char *p) noexcept
+{
+    std::uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::uint32_t read32(const unsigned char *p) noexcept
+{
+    std::uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t round(std::uint64_t accumulator,
+                           std::uint64_t input) noexcept
+{
+    accumulator += input * prime2;
+    accumulator = rotateLeft(accumulator, 31);
+    return accumulator * prime1;
+}
+
+inline std::uint64_t mergeRound(std::uint64_t accumulator,
+                                std::uint64_t value) noexcept
+{
+    accumulator ^= round(0, value);
+    return accumulator * prime1 + prime4;
+}
+
+} // namespace Detail
+
+std::uint64_t HashBytes(const void *data, std::size_t size,
+                        std::uint64_t seed) noexcept
+{
+    const unsigned char *p{static_cast<const unsigned char *>(data)};
+    const unsigned char *const end{p + size};
+    std::uint64_t hash;
+
+    if (size >= 32)
+    {
+        std::uint64_t v1{seed + Detail::prime1 + Detail::prime2};
+        std::uint64_t v2{seed + Detail::prime2};
+        std::uint64_t v3{seed};
+        std::uint64_t v4{seed - Detail::prime1};
+
+        for (const unsigned char *limit{end - 32}; p <= limit; p += 32)
+        {
+            v1 = Detail::round(v1, Detail::read64(p));
+            v2 = Detail::round(v2, Detail::read64(p + 8));
+            v3 = Detail::round(v3, Detail::read64(p + 16));
+            v4 = Detail::round(v4, Detail::read64(p + 24));
+        }
+
+        hash = Detail::rotateLeft(v1, 1) + Detail::rotateLeft(v2, 7) +
+               Detail::rotateLeft(v3, 12) + Detail::rotateLeft(v4, 18);
+        hash = Detail::mergeRound(hash, v1);
+        hash = Detail::mergeRound(hash, v2);
+        hash = Detail::mergeRound(hash, v3);
+        hash = Detail::mergeRound(hash, v4);
+    }
+    else
+    {
+        hash = seed + Detail::prime5;
+    }
+
+    hash += static_cast<std::uint64_t>(size);
+
+    for (; p + 8 <= end; p += 8)
+    {
+        hash ^= Detail::round(0, Detail::read64(p));
+        hash = Detail::rotateLeft(hash, 27) * Detail::prime1 + Detail::prime4;
+    }
+
+    if (p + 4 <= end)
+    {
+        hash ^= static_cast<std::uint64_t>(Detail::read32(p)) * Detail::prime1;
+        hash = Detail::rotateLeft(hash, 23) * Detail::prime2 + Detail::prime3;
+        p += 4;
+    }
+
+    for (; p < end; ++p)
+    {
+        hash ^= static_cast<std::uint64_t>(*p) * Detail::prime5;
+        hash = Detail::rotateLeft(hash, 11) * Detail::prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= Detail::prime2;
+    hash ^= hash >> 29;
+    hash *= Detail::prime3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+bool HashFile(const char *fileName, std::uint64_t &hash)
+{
+    FileIO::MappedFile file;
+    if (!file.open(fileName))
+    {
+        return false;
+    }
+
+    hash = HashBytes(file.data(), file.size());
+    return true;
+}
+
+} // namespace Hash
@@ -0,0 +1,19 @@
+#ifndef HOMEWORK01_UTILS_HASH_HASH_HPP_
+#define HOMEWORK01_UTILS_HASH_HASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Hash
+{
+
+// 64-bit XXH64 digest of size bytes at data.
+std::uint64_t HashBytes(const void *data, std::size_t size,
+                        std::uint64_t seed = 0) noexcept;
+
+// Digest of a whole file, read through a memory mapping.
+bool HashFile(const char *fileName, std::uint64_t &hash);
+
+} // namespace Hash
+
+#endif // HOMEWORK01_UTILS_HASH_HASH_HPP_
@@ -0,0 +1,433 @@
+#include "Json.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+namespace Json
+{
+
+namespace Detail
+{
+
+// Recursive descent parser. Nesting is limited so that a hostile document
+// cannot exhaust the stack.
+class Parser
+{
+public:
+    explicit Parser(const char *begin, const char *end) noexcept
+        : begin_{begin}, p_{begin}, end_{end}, depth_{0}
+    {
+    }
+
+    bool parse(Value &value)
+    {
+        skipWhitespace();
+        if (!parseValue(value))
+        {
+            return false;
+        }
+        skipWhitespace();
+        return p_ == end_;
+    }
+
+    std::size_t offset() const noexcept
+    {
+        return static_cast<std::size_t>(p_ - begin_);
+    }
+
+private:
+    static constexpr int maximumDepth{256};
+
+    void skipWhitespace() noexcept
+    {
+        while (p_ < end_ &&
+               (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r'))
+        {
+            ++p_;
+        }
+    }
+
+    bool consume(char c) noexcept
+    {
+        skipWhitespace();
+        if (p_ < end_ && *p_ == c)
+        {
+            ++p_;
+            return true;
+        }
+        return false;
+    }
+
+    bool literal(const char *text) noexcept
+    {
+        const std::size_t length{std::strlen(text)};
+        if (static_cast<std::size_t>(end_ - p_) < length ||
+            std::memcmp(p_, text, length) != 0)
+        {
+            return false;
+        }
+        p_ += length;
+        return true;
+    }
+
+    bool parseValue(Value &value)
+    {
+        skipWhitespace();
+        if (p_ == end_)
+        {
+            return false;
+        }
+
+        switch (*p_)
+        {
+        case '{':
+            return parseObject(value);
+        case '[':
+            return parseArray(value);
+        case '"':
+            value.type_ = Value::Type::String;
+            return parseString(value.string_);
+        case 't':
+            value.type_ = Value::Type::Boolean;
+            value.boolean_ = true;
+            return literal("true");
+        case 'f':
+            value.type_ = Value::Type::Boolean;
+            value.boolean_ = false;
+            return literal("false");
+        case 'n':
+            value.type_ = Value::Type::Null;
+            return literal("null");
+        default:
+            return parseNumber(value);
+        }
+    }
+
+    bool parseObject(Value &value)
+    {
+        if (++depth_ > maximumDepth)
+        {
+            return false;
+        }
+
+        ++p_;
+        value.type_ = Value::Type::Object;
+
+        if (!consume('}'))
+        {
+            do
+            {
+                skipWhitespace();
+                std::string key;
+                if (!parseString(key) || !consume(':'))
+                {
+                    return false;
+                }
+                value.members_.emplace_back(std::move(key), Value{});
+                if (!parseValue(value.members_.back().second))
+                {
+                    return false;
+                }
+            } while (consume(','));
+
+            if (!consume('}'))
+            {
+                return false;
+            }
+        }
+
+        --depth_;
+        return true;
+    }
+
+    bool parseArray(Value &value)
+    {
+        if (++depth_ > maximumDepth)
+        {
+            return false;
+        }
+
+        ++p_;
+        value.type_ = Value::Type::Array;
+
+        if (!consume(']'))
+        {
+            do
+            {
+                value.elements_.emplace_back();
+                if (!parseValue(value.elements_.back()))
+                {
+                    return false;
+                }
+            } while (consume(','));
+
+            if (!consume(']'))
+            {
+                return false;
+            }
+        }
+
+        --depth_;
+        return true;
+    }
+
+    bool parseHex(unsigned int &code) noexcept
+    {
+        if (end_ - p_ < 4)
+        {
+            return false;
+        }
+
+        code = 0;
+        for (int i{0}; i < 4; ++i, ++p_)
+        {
+            const char c{*p_};
+            code <<= 4;
+            if (c >= '0' && c <= '9')
+            {
+                code |= static_cast<unsigned int>(c - '0');
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                code |= static_cast<unsigned int>(c - 'a' + 10);
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                code |= static_cast<unsigned int>(c - 'A' + 10);
+            }
+            else
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string &text, unsigned int code)
+    {
+        if (code < 0x80)
+        {
+            text += static_cast<char>(code);
+        }
+        else if (code < 0x800)
+        {
+            text += static_cast<char>(0xC0 | (code >> 6));
+            text += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else if (code < 0x10000)
+        {
+            text += static_cast<char>(0xE0 | (code >> 12));
+            text += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            text += static_cast<char>(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            text += static_cast<char>(0xF0 | (code >> 18));
+            text += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            text += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            text += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parseString(std::string &text)
+    {
+        if (p_ == end_ || *p_ != '"')
+        {
+            return false;
+        }
+
+        for (++p_; p_ < end_ && *p_ != '"';)
+        {
+            if (*p_ != '\\')
+            {
+                text += *p_++;
+                continue;
+            }
+
+            if (++p_ == end_)
+            {
+                return false;
+            }
+
+            const char escape{*p_++};
+            switch (escape)
+            {
+            case '"':
+            case '\\':
+            case '/':
+                text += escape;
+                break;
+            case 'b':
+                text += '\b';
+                break;
+            case 'f':
+                text += '\f';
+                break;
+            case 'n':
+                text += '\n';
+                break;
+            case 'r':
+                text += '\r';
+                break;
+            case 't':
+                text += '\t';
+                break;
+            case 'u':
+            {
+                unsigned int code;
+                if (!parseHex(code))
+                {
+                    return false;
+                }
+                // Surrogate pair.
+                if (code >= 0xD800 && code < 0xDC00 && end_ - p_ >= 6 &&
+                    p_[0] == '\\' && p_[1] == 'u')
+                {
+                    p_ += 2;
+                    unsigned int low;
+                    if (!parseHex(low) || low < 0xDC00 || low >= 0xE000)
+                    {
+                        return false;
+                    }
+                    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                }
+                appendUtf8(text, code);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+
+        if (p_ == end_)
+        {
+            return false;
+        }
+        ++p_;
+        return true;
+    }
+
+    bool parseNumber(Value &value)
+    {
+        // strtod needs a terminated string; numbers are short.
+        char buffer[64];
+        std::size_t length{0};
+        while (p_ + length < end_ && length < sizeof(buffer) - 1 &&
+               (std::strchr("+-.eE", p_[length]) ||
+                (p_[length] >= '0' && p_[length] <= '9')))
+        {
+            buffer[length] = p_[length];
+            ++length;
+        }
+        buffer[length] = '\0';
+
+        char *numberEnd{nullptr};
+        value.type_ = Value::Type::Number;
+        value.number_ = std::strtod(buffer, &numberEnd);
+        if (length == 0 || numberEnd != buffer + length)
+        {
+            return false;
+        }
+
+        p_ += length;
+        return true;
+    }
+
+    const char *begin_;
+    const char *p_;
+    const char *end_;
+    int depth_;
+};
+
+} // namespace Detail
+
+Value::Value() noexcept
+    : type_{Type::Null}, boolean_{false}, number_{0.0}, string_{},
+      elements_{}, members_{}
+{
+}
+
+bool Value::boolean(bool fallback) const noexcept
+{
+    return type_ == Type::Boolean ? boolean_ : fallback;
+}
+
+bool Value::contains(const char *key) const noexcept
+{
+    return !(*this)[key].isNull();
+}
+
+long long Value::integer(long long fallback) const noexcept
+{
+    return type_ == Type::Number ? static_cast<long long>(std::floor(number_))
+                                 : fallback;
+}
+
+bool Value::isArray() const noexcept { return type_ == Type::Array; }
+
+bool Value::isNull() const noexcept { return type_ == Type::Null; }
+
+bool Value::isNumber() const noexcept { return type_ == Type::Number; }
+
+bool Value::isObject() const noexcept { return type_ == Type::Object; }
+
+bool Value::isString() const noexcept { return type_ == Type::String; }
+
+const Value &Value::null() noexcept
+{
+    static const Value value;
+    return value;
+}
+
+double Value::number(double fallback) const noexcept
+{
+    return type_ == Type::Number ? number_ : fallback;
+}
+
+const Value &Value::operator[](std::size_t index) const noexcept
+{
+    return index < elements_.size() ? elements_[index] : null();
+}
+
+const Value &Value::operator[](const char *key) const noexcept
+{
+    for (const auto &member : members_)
+    {
+        if (member.first == key)
+        {
+            return member.second;
+        }
+    }
+    return null();
+}
+
+std::size_t Value::size() const noexcept
+{
+    return type_ == Type::Array    ? elements_.size()
+           : type_ == Type::Object ? members_.size()
+                                   : 0;
+}
+
+const std::string &Value::string() const noexcept { return string_; }
+
+Value::Type Value::type() const noexcept { return type_; }
+
+bool Parse(const char *begin, const char *end, Value &value,
+           std::string &errorMessage)
+{
+    value = Value{};
+
+    Detail::Parser parser{begin, end};
+    if (!parser.parse(value))
+    {
+        errorMessage =
+            "JSON syntax error at byte " + std::to_string(parser.offset());
+        value = Value{};
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace Json
@@ -0,0 +1,74 @@
+#ifndef HOMEWORK01_UTILS_JSON_JSON_HPP_
+#define HOMEWORK01_UTILS_JSON_JSON_HPP_
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Json
+{
+
+namespace Detail
+{
+class Parser;
+} // namespace Detail
+
+// Read-only JSON document node. Looking up a missing member or element
+// yields a null value, so optional fields can be read without checks.
+class Value
+{
+public:
+    enum class Type
+    {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    explicit Value() noexcept;
+
+    Type type() const noexcept;
+    bool isNull() const noexcept;
+    bool isNumber() const noexcept;
+    bool isString() const noexcept;
+    bool isArray() const noexcept;
+    bool isObject() const noexcept;
+
+    bool boolean(bool fallback = false) const noexcept;
+    double number(double fallback = 0.0) const noexcept;
+    // Integer value, or fallback when the value is not a number.
+    long long integer(long long fallback = 0) const noexcept;
+    const std::string &string() const noexcept;
+
+    // Element or member count, 0 for scalars.
+    std::size_t size() const noexcept;
+    bool contains(const char *key) const noexcept;
+
+    const Value &operator[](std::size_t index) const noexcept;
+    const Value &operator[](const char *key) const noexcept;
+
+private:
+    friend class Detail::Parser;
+
+    static const Value &null() noexcept;
+
+    Type type_;
+    bool boolean_;
+    double number_;
+    std::string string_;
+    std::vector<Value> elements_;
+    std::vector<std::pair<std::string, Value>> members_;
+};
+
+// Parses the UTF-8 text in [begin, end). On failure errorMessage names the
+// offending byte offset.
+bool Parse(const char *begin, const char *end, Value &value,
+           std::string &errorMessage);
+
+} // namespace Json
+
+#endif // HOMEWORK01_UTILS_JSON_JSON_HPP_
@@ -0,0 +1,58 @@
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Parallel
+{
+
+inline unsigned int HardwareThreadCount() noexcept
+{
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+inline unsigned int ResolveThreadCount(unsigned int threadCount) noexcept
+{
+    return threadCount ? threadCount : HardwareThreadCount();
+}
+
+template <typename Function>
+void ParallelFor(std::size_t count, unsigned int threadCount,
+                 Function function)
+{
+    const std::size_t workerCount{
+        std::min<std::size_t>(ResolveThreadCount(threadCount), count)};
+
+    if (workerCount <= 1)
+    {
+        for (std::size_t i{0}; i < count; ++i)
+        {
+            function(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t i{next++}; i < count; i = next++)
+        {
+            function(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(workerCount - 1);
+    for (std::size_t i{1}; i < workerCount; ++i)
+    {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+} // namespace Parallel
@@ -0,0 +1,31 @@
+#ifndef HOMEWORK01_UTILS_PARALLEL_PARALLELFOR_HPP_
+#define HOMEWORK01_UTILS_PARALLEL_PARALLELFOR_HPP_
+
+#include <cstddef>
+
+namespace Parallel
+{
+
+// Number of hardware threads, at least 1.
+inline unsigned int HardwareThreadCount() noexcept;
+
+// Resolves a requested thread count, where 0 means every hardware thread.
+inline unsigned int ResolveThreadCount(unsigned int threadCount) noexcept;
+
+/**
+ * @brief Call \a function(i) for every i in [0, count) on up to
+ * \a threadCount threads, the calling thread included.
+ * @details
+ *     Tasks are handed out one at a time in increasing order, so uneven tasks
+ *     balance themselves. The call returns once every task has finished.
+ *     \a function must not throw.
+ */
+template <typename Function>
+void ParallelFor(std::size_t count, unsigned int threadCount,
+                 Function function);
+
+} // namespace Parallel
+
+#include "ParallelFor-inl.hpp"
+
+#endif // HOMEWORK01_UTILS_PARALLEL_PARALLELFOR_HPP_
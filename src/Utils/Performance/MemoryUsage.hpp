@@ -0,0 +1,15 @@
+#ifndef HOMEWORK01_UTILS_PERFORMANCE_MEMORYUSAGE_HPP_
+#define HOMEWORK01_UTILS_PERFORMANCE_MEMORYUSAGE_HPP_
+
+#include <cstddef>
+
+namespace Performance
+{
+
+// Peak resident set size of the current process in bytes, or 0 when the
+// platform does not report it.
+std::size_t PeakResidentSetSize() noexcept;
+
+} // namespace Performance
+
+#endif // HOMEWORK01_UTILS_PERFORMANCE_MEMORYUSAGE_HPP_
@@ -0,0 +1,31 @@
+#ifndef HOMEWORK01_UTILS_PERFORMANCE_STOPWATCH_HPP_
+#define HOMEWORK01_UTILS_PERFORMANCE_STOPWATCH_HPP_
+
+#include <chrono>
+
+namespace Performance
+{
+
+class Stopwatch
+{
+public:
+    using ClockType = std::chrono::steady_clock;
+
+    explicit Stopwatch() noexcept : start_{ClockType::now()} {}
+
+    void restart() noexcept { start_ = ClockType::now(); }
+
+    double elapsedMilliseconds() const noexcept
+    {
+        return std::chrono::duration<double, std::milli>(ClockType::now() -
+                                                         start_)
+            .count();
+    }
+
+private:
+    ClockType::time_point start_;
+};
+
+} // namespace Performance
+
+#endif // HOMEWORK01_UTILS_PERFORMANCE_STOPWATCH_HPP_
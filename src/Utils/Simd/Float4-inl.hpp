@@ -0,0 +1,244 @@
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace Simd
+{
+
+#if !PROGRAM_SIMD_SSE2
+namespace Detail
+{
+
+inline std::uint32_t bits(float value) noexcept
+{
+    std::uint32_t result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+inline float fromBits(std::uint32_t value) noexcept
+{
+    float result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+inline float mask(bool value) noexcept
+{
+    return fromBits(value ? ~std::uint32_t{0} : 0u);
+}
+
+template <typename Operation>
+inline Float4 apply(Float4 lhs, Float4 rhs, Operation operation) noexcept
+{
+    Float4 result;
+    for (int i{0}; i < 4; ++i)
+    {
+        result.value[i] = operation(lhs.value[i], rhs.value[i]);
+    }
+    return result;
+}
+
+} // namespace Detail
+#endif
+
+inline Float4 load(const float *source) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_loadu_ps(source)};
+#else
+    return Float4{{source[0], source[1], source[2], source[3]}};
+#endif
+}
+
+inline void store(float *destination, Float4 value) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    _mm_storeu_ps(destination, value.value);
+#else
+    std::memcpy(destination, value.value, sizeof(value.value));
+#endif
+}
+
+inline Float4 broadcast(float value) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_set1_ps(value)};
+#else
+    return Float4{{value, value, value, value}};
+#endif
+}
+
+inline Float4 set(float x, float y, float z, float w) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_setr_ps(x, y, z, w)};
+#else
+    return Float4{{x, y, z, w}};
+#endif
+}
+
+inline Float4 operator+(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_add_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs, [](float a, float b) { return a + b; });
+#endif
+}
+
+inline Float4 operator-(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_sub_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs, [](float a, float b) { return a - b; });
+#endif
+}
+
+inline Float4 operator*(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_mul_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs, [](float a, float b) { return a * b; });
+#endif
+}
+
+inline Float4 operator/(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_div_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs, [](float a, float b) { return a / b; });
+#endif
+}
+
+inline Float4 abs(Float4 value) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_andnot_ps(_mm_set1_ps(-0.0f), value.value)};
+#else
+    return Detail::apply(value, value,
+                         [](float a, float) { return std::fabs(a); });
+#endif
+}
+
+inline Float4 max(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_max_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs,
+                         [](float a, float b) { return a > b ? a : b; });
+#endif
+}
+
+inline Float4 min(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_min_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs,
+                         [](float a, float b) { return a < b ? a : b; });
+#endif
+}
+
+inline Float4 sqrt(Float4 value) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_sqrt_ps(value.value)};
+#else
+    return Detail::apply(value, value,
+                         [](float a, float) { return std::sqrt(a); });
+#endif
+}
+
+// Abramowitz and Stegun 4.4.45 on |value|, mirrored for negative values.
+inline Float4 acos(Float4 value) noexcept
+{
+    const Float4 x{abs(value)};
+    const Float4 polynomial{
+        ((broadcast(-0.0187293f) * x + broadcast(0.0742610f)) * x +
+         broadcast(-0.2121144f)) *
+            x +
+        broadcast(1.5707288f)};
+    const Float4 result{sqrt(max(broadcast(1.0f) - x, broadcast(0.0f))) *
+                        polynomial};
+    return select(lessThan(value, broadcast(0.0f)),
+                  broadcast(3.14159265f) - result, result);
+}
+
+inline Float4 lessThan(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_cmplt_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs,
+                         [](float a, float b) { return Detail::mask(a < b); });
+#endif
+}
+
+inline Float4 lessEqual(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_cmple_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs,
+                         [](float a, float b) { return Detail::mask(a <= b); });
+#endif
+}
+
+inline Float4 maskAnd(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_and_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs, [](float a, float b) {
+        return Detail::fromBits(Detail::bits(a) & Detail::bits(b));
+    });
+#endif
+}
+
+inline Float4 maskOr(Float4 lhs, Float4 rhs) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_or_ps(lhs.value, rhs.value)};
+#else
+    return Detail::apply(lhs, rhs, [](float a, float b) {
+        return Detail::fromBits(Detail::bits(a) | Detail::bits(b));
+    });
+#endif
+}
+
+inline Float4 select(Float4 mask, Float4 whenTrue, Float4 whenFalse) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return Float4{_mm_or_ps(_mm_and_ps(mask.value, whenTrue.value),
+                            _mm_andnot_ps(mask.value, whenFalse.value))};
+#else
+    Float4 result;
+    for (int i{0}; i < 4; ++i)
+    {
+        result.value[i] = Detail::bits(mask.value[i]) ? whenTrue.value[i]
+                                                      : whenFalse.value[i];
+    }
+    return result;
+#endif
+}
+
+inline int moveMask(Float4 mask) noexcept
+{
+#if PROGRAM_SIMD_SSE2
+    return _mm_movemask_ps(mask.value);
+#else
+    int result{0};
+    for (int i{0}; i < 4; ++i)
+    {
+        result |= static_cast<int>(Detail::bits(mask.value[i]) >> 31) << i;
+    }
+    return result;
+#endif
+}
+
+} // namespace Simd
@@ -0,0 +1,63 @@
+#ifndef HOMEWORK01_UTILS_SIMD_FLOAT4_HPP_
+#define HOMEWORK01_UTILS_SIMD_FLOAT4_HPP_
+
+// clang-format off
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PROGRAM_SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define PROGRAM_SIMD_SSE2 0
+#endif
+// clang-format on
+
+namespace Simd
+{
+
+/**
+ * @brief Four floats processed together, in one SSE register where SSE2 is
+ * available and as a plain array otherwise.
+ * @details
+ *     Comparisons return masks with every bit of a lane set where they hold,
+ *     meant for select() and moveMask().
+ */
+struct Float4
+{
+#if PROGRAM_SIMD_SSE2
+    __m128 value;
+#else
+    float value[4];
+#endif
+};
+
+inline Float4 load(const float *source) noexcept;
+inline void store(float *destination, Float4 value) noexcept;
+inline Float4 broadcast(float value) noexcept;
+inline Float4 set(float x, float y, float z, float w) noexcept;
+
+inline Float4 operator+(Float4 lhs, Float4 rhs) noexcept;
+inline Float4 operator-(Float4 lhs, Float4 rhs) noexcept;
+inline Float4 operator*(Float4 lhs, Float4 rhs) noexcept;
+inline Float4 operator/(Float4 lhs, Float4 rhs) noexcept;
+
+inline Float4 abs(Float4 value) noexcept;
+inline Float4 max(Float4 lhs, Float4 rhs) noexcept;
+inline Float4 min(Float4 lhs, Float4 rhs) noexcept;
+inline Float4 sqrt(Float4 value) noexcept;
+// Within 7e-5 radians of std::acos on [-1, 1].
+inline Float4 acos(Float4 value) noexcept;
+
+inline Float4 lessThan(Float4 lhs, Float4 rhs) noexcept;
+inline Float4 lessEqual(Float4 lhs, Float4 rhs) noexcept;
+inline Float4 maskAnd(Float4 lhs, Float4 rhs) noexcept;
+inline Float4 maskOr(Float4 lhs, Float4 rhs) noexcept;
+// Lanes of whenTrue where mask is set and of whenFalse elsewhere.
+inline Float4 select(Float4 mask, Float4 whenTrue, Float4 whenFalse) noexcept;
+// Bit i is set if lane i of mask is.
+inline int moveMask(Float4 mask) noexcept;
+
+} // namespace Simd
+
+#include "Float4-inl.hpp"
+
+#endif // HOMEWORK01_UTILS_SIMD_FLOAT4_HPP_